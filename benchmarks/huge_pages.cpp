@@ -0,0 +1,189 @@
+// TLB cost of scene-sized buffers with and without huge pages.
+//
+// Gathers Gaussian attributes by random primitive id (the access pattern of
+// binning and rasterization on large scenes) from a buffer allocated with each
+// huge_pages::Mode, and reports the wall time and the dTLB load misses counted
+// with perf_event_open next to the delta against regular pages.
+//
+// usage: huge_pages [buffer MiB = 1024] [gathers in millions = 64]
+//
+// dTLB counters need perf access (kernel.perf_event_paranoid <= 2 for user
+// space counting) and are reported as "n/a" otherwise.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "tinyrend/core/huge_pages.h"
+#include "tinyrend/core/thread_pool.h"
+
+using namespace tinyrend;
+
+// dTLB load misses of the thread that creates the counter, user space only.
+// perf `inherit` only follows threads created after the counter is opened, so
+// the pool workers, which already exist, each open their own counter.
+class TlbMissCounter {
+  public:
+    TlbMissCounter() {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~TlbMissCounter() {
+        if (fd_ >= 0)
+            close(fd_);
+    }
+
+    bool available() const { return fd_ >= 0; }
+    void start() {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    uint64_t stop() {
+        uint64_t count = 0;
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count))
+                count = 0;
+        }
+        return count;
+    }
+
+  private:
+    int fd_ = -1;
+};
+
+struct Result {
+    double seconds = 0.0;
+    uint64_t tlb_misses = 0;
+    size_t huge_bytes = 0;
+    huge_pages::Mode backing = huge_pages::Mode::OFF;
+};
+
+// One counter per pool worker plus one for the calling thread, which runs the
+// loop itself when the pool has a single worker.
+class PoolTlbMissCounter {
+  public:
+    explicit PoolTlbMissCounter(thread_pool::ThreadPool &pool)
+        : pool_(pool), counters_(pool.size() + 1) {
+        pool_.run([&](size_t w) { counters_[w] = std::make_unique<TlbMissCounter>(); });
+        counters_.back() = std::make_unique<TlbMissCounter>();
+    }
+
+    bool available() const {
+        for (auto const &c : counters_) {
+            if (!c->available())
+                return false;
+        }
+        return true;
+    }
+    void start() {
+        pool_.run([&](size_t w) { counters_[w]->start(); });
+        counters_.back()->start();
+    }
+    uint64_t stop() {
+        std::vector<uint64_t> counts(counters_.size(), 0);
+        pool_.run([&](size_t w) { counts[w] = counters_[w]->stop(); });
+        counts.back() = counters_.back()->stop();
+        uint64_t total = 0;
+        for (uint64_t c : counts)
+            total += c;
+        return total;
+    }
+
+  private:
+    thread_pool::ThreadPool &pool_;
+    std::vector<std::unique_ptr<TlbMissCounter>> counters_;
+};
+
+static auto run(huge_pages::Mode mode, size_t bytes, size_t n_gathers) -> Result {
+    auto &pool = thread_pool::global_pool();
+    Result r;
+    const size_t huge_before = huge_pages::anon_huge_bytes();
+    auto buffer = huge_pages::Buffer::allocate(bytes, mode);
+    r.backing = buffer.backing();
+    auto *attributes = static_cast<float *>(buffer.data());
+    const size_t n_floats = bytes / sizeof(float);
+    const size_t n_primitives = n_floats / 16; // 16 floats per Gaussian
+    pool.parallel_for(n_floats, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            attributes[i] = float(i & 1023);
+    });
+    const size_t huge_after = huge_pages::anon_huge_bytes();
+    r.huge_bytes = huge_after > huge_before ? huge_after - huge_before : 0;
+
+    PoolTlbMissCounter counter(pool);
+    std::atomic<uint64_t> checksum{0};
+    const auto t0 = std::chrono::steady_clock::now();
+    counter.start();
+    pool.parallel_for(n_gathers, [&](size_t begin, size_t end) {
+        uint64_t state = 0x9E3779B97F4A7C15ull * (begin + 1);
+        float sum = 0.f;
+        for (size_t i = begin; i < end; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            const float *g = attributes + (state % n_primitives) * 16;
+            sum += g[0] + g[3] + g[7] + g[10]; // mean, quat, scale, opacity
+        }
+        checksum.fetch_add(uint64_t(sum));
+    });
+    r.tlb_misses = counter.stop();
+    const auto t1 = std::chrono::steady_clock::now();
+    r.seconds = std::chrono::duration<double>(t1 - t0).count();
+    if (checksum.load() == 1) // keep the gathers alive
+        printf("unreachable\n");
+    if (!counter.available())
+        r.tlb_misses = UINT64_MAX;
+    return r;
+}
+
+int main(int argc, char **argv) {
+    const size_t mib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024;
+    const size_t millions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    const size_t bytes = mib << 20, n_gathers = millions * 1000000;
+    printf("buffer %zu MiB, %zu M random gathers, %zu threads\n",
+           mib, millions, thread_pool::global_pool().size());
+
+    const char *names[] = {"off", "thp", "hugetlb"};
+    Result base;
+    for (auto mode : {huge_pages::Mode::OFF,
+                      huge_pages::Mode::TRANSPARENT,
+                      huge_pages::Mode::EXPLICIT}) {
+        const Result r = run(mode, bytes, n_gathers);
+        if (mode == huge_pages::Mode::OFF)
+            base = r;
+        printf("%-8s backing %-8s %8.3f s  %6zu MiB in THP  dTLB misses ",
+               names[int(mode)], names[int(r.backing)], r.seconds, r.huge_bytes >> 20);
+        if (r.tlb_misses == UINT64_MAX) {
+            printf("n/a\n");
+            continue;
+        }
+        printf("%14llu", (unsigned long long)r.tlb_misses);
+        if (mode != huge_pages::Mode::OFF && base.tlb_misses > 0) {
+            const double delta = double(r.tlb_misses) - double(base.tlb_misses);
+            printf("  (%+.1f%% vs off)", 100.0 * delta / double(base.tlb_misses));
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -1,21 +1,51 @@
-import os
+"""Compiled backends of tinyrend.
+
+- ``_cpu``: torch-free CPU module built ahead of time by CMake
+  (``cmake -DBUILD_PYTHON=ON``, see DEV.md). Importing it compiles nothing and
+  does not import torch.
+- ``_C``: torch extension with the CUDA kernels and the autograd wrappers.
+  It is JIT-compiled with ``torch.utils.cpp_extension.load`` the first time it
+  is accessed, so code that only uses ``_cpu`` never pays for the compile or
+  for importing torch.
+"""
+
 import glob
+import importlib
+import os
+
+CURRENT_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_ROOT = os.path.dirname(os.path.dirname(CURRENT_DIR))
+
+
+def load_cpu_module():
+    """Import the prebuilt torch-free CPU module."""
+    try:
+        if __package__:
+            return importlib.import_module("._tinyrend_cpu", __package__)
+        return importlib.import_module("_tinyrend_cpu")
+    except ImportError as e:
+        raise ImportError(
+            "tinyrend CPU module not found; build it with "
+            "`cmake -DBUILD_PYTHON=ON` (see DEV.md)"
+        ) from e
 
-from torch.utils.cpp_extension import load
 
 def build_extension():
-    CURRENT_DIR = os.path.dirname(os.path.abspath(__file__))
-    REPO_ROOT = os.path.dirname(os.path.dirname(CURRENT_DIR))
+    from torch.utils.cpp_extension import CUDA_HOME, load
+
+    # Without a CUDA toolkit only the CPU paths of bindings.cpp are built.
+    with_cuda = CUDA_HOME is not None
+
+    sources = [os.path.join(CURRENT_DIR, "bindings.cpp")]
+    if with_cuda:
+        sources += list(glob.glob(os.path.join(REPO_ROOT, "launcher", "tinyrend", "**/*.cu"), recursive=True))
 
-    sources = [os.path.join(CURRENT_DIR, "bindings.cpp")] 
-    sources += list(glob.glob(os.path.join(REPO_ROOT, "launcher", "tinyrend", "**/*.cu"), recursive=True))
-    
     extra_include_paths = [
         os.path.join(REPO_ROOT, "include"),
         os.path.join(REPO_ROOT, "launcher"),
         os.path.join(REPO_ROOT, "third_party", "glm"),
     ]
-    extra_cflags = ["-O3"]
+    extra_cflags = ["-O3"] + (["-DTINYREND_WITH_CUDA"] if with_cuda else [])
     extra_cuda_cflags = ["-O3", "-use_fast_math", "--extended-lambda"]
 
     return load(
@@ -27,4 +57,14 @@ def build_extension():
         verbose=True,
     )
 
-_C = build_extension()
\ No newline at end of file
+
+def __getattr__(name):
+    # Load the backends lazily (PEP 562), on first `_backend._C` / `_backend._cpu`.
+    if name == "_C":
+        module = build_extension()
+    elif name == "_cpu":
+        module = load_cpu_module()
+    else:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    globals()[name] = module
+    return module
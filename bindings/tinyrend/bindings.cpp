@@ -1,8 +1,16 @@
+// Torch extension: autograd wrappers around the CUDA launchers. Built by
+// _backend.py; without a CUDA toolkit (no TINYREND_WITH_CUDA) only the CPU
+// paths are compiled. For torch-free CPU use see cpu_module.cpp.
 #include <torch/extension.h>
-#include <c10/cuda/CUDAGuard.h> 
 #include <glm/glm.hpp>
 
+#ifdef TINYREND_WITH_CUDA
+#include <c10/cuda/CUDAGuard.h>
 #include "tinyrend/launcher.h"
+#else
+#include "tinyrend/camera/fisheye.h"
+#include "tinyrend/kernel_launcher.cuh"
+#endif
 
 torch::Tensor fisheye_project(
     torch::Tensor camera_points,
@@ -12,19 +20,51 @@ torch::Tensor fisheye_project(
     auto n_elements = camera_points.numel() / camera_points.size(-1);
     auto image_points = torch::empty_like(focal_lengths);
     
-    #define LAUNCH_KERNEL(USE_CUDA) \
-        tinyrend::camera::fisheye::launch_project<USE_CUDA>( \
+    // float64 inputs (calibration) run the double-precision instantiation
+    #define LAUNCH_KERNEL(USE_CUDA, T) \
+        tinyrend::camera::fisheye::launch_project<USE_CUDA, T>( \
             n_elements, \
-            reinterpret_cast<const glm::fvec3*>(camera_points.data_ptr<float>()), \
-            reinterpret_cast<const glm::fvec2*>(focal_lengths.data_ptr<float>()), \
-            reinterpret_cast<const glm::fvec2*>(principal_points.data_ptr<float>()), \
-            reinterpret_cast<glm::fvec2*>(image_points.data_ptr<float>()))
+            reinterpret_cast<const glm::vec<3, T>*>(camera_points.data_ptr<T>()), \
+            reinterpret_cast<const glm::vec<2, T>*>(focal_lengths.data_ptr<T>()), \
+            reinterpret_cast<const glm::vec<2, T>*>(principal_points.data_ptr<T>()), \
+            reinterpret_cast<glm::vec<2, T>*>(image_points.data_ptr<T>()))
+    auto const is_double = camera_points.scalar_type() == torch::kFloat64;
 
     if (camera_points.device().is_cuda()) {
+#ifdef TINYREND_WITH_CUDA
         const at::cuda::OptionalCUDAGuard device_guard(camera_points.device());
-        LAUNCH_KERNEL(true);
+        if (is_double) {
+            LAUNCH_KERNEL(true, double);
+        } else {
+            LAUNCH_KERNEL(true, float);
+        }
+#else
+        throw std::runtime_error("tinyrend was built without CUDA");
+#endif
     } else {
-        LAUNCH_KERNEL(false);
+#ifdef TINYREND_WITH_CUDA
+        if (is_double) {
+            LAUNCH_KERNEL(false, double);
+        } else {
+            LAUNCH_KERNEL(false, float);
+        }
+#else
+        auto const run = [&](auto zero) {
+            using T = decltype(zero);
+            auto const p = reinterpret_cast<const glm::vec<3, T>*>(camera_points.data_ptr<T>());
+            auto const f = reinterpret_cast<const glm::vec<2, T>*>(focal_lengths.data_ptr<T>());
+            auto const c = reinterpret_cast<const glm::vec<2, T>*>(principal_points.data_ptr<T>());
+            auto const out = reinterpret_cast<glm::vec<2, T>*>(image_points.data_ptr<T>());
+            tinyrend::launch_linear_kernel<false>(n_elements, [=](size_t idx) {
+                out[idx] = tinyrend::camera::fisheye::project(p[idx], f[idx], c[idx]);
+            });
+        };
+        if (is_double) {
+            run(0.0);
+        } else {
+            run(0.f);
+        }
+#endif
     }
 
     #undef LAUNCH_KERNEL
@@ -49,6 +89,7 @@ public:
         auto render_alpha = torch::empty({n_images, image_height, image_width, 1}, opt);
         
         if (opacities.device().is_cuda()) {
+#ifdef TINYREND_WITH_CUDA
             const at::cuda::OptionalCUDAGuard device_guard(opacities.device());
             tinyrend::rasterization::launch_simple_planer_forward(
                 n_primitives,
@@ -62,6 +103,9 @@ public:
                 isect_prefix_sum_per_tile.data_ptr<uint32_t>(),
                 render_alpha.data_ptr<float>()
             );
+#else
+            throw std::runtime_error("tinyrend was built without CUDA");
+#endif
         } else {
             throw std::runtime_error("Not implemented for CPU");
         }
@@ -99,6 +143,7 @@ public:
         auto v_render_alpha = grad_outputs[0];
 
         if (opacities.device().is_cuda()) {
+#ifdef TINYREND_WITH_CUDA
             const at::cuda::OptionalCUDAGuard device_guard(opacities.device());
             tinyrend::rasterization::launch_simple_planer_backward(
                 n_primitives,
@@ -114,6 +159,9 @@ public:
                 v_render_alpha.data_ptr<float>(),
                 v_opacity.data_ptr<float>()
             );
+#else
+            throw std::runtime_error("tinyrend was built without CUDA");
+#endif
         } else {
             throw std::runtime_error("Not implemented for CPU");
         }
@@ -0,0 +1,147 @@
+"""Torch-free CPU renderer entry points.
+
+Inputs may be NumPy arrays or any DLPack producer on the CPU (e.g. a torch
+CPU tensor); they are viewed as NumPy arrays without copying. Arrays that are
+not C-contiguous or not of the expected dtype are converted, which copies.
+Outputs are NumPy arrays.
+"""
+
+import numpy as np
+
+try:
+    from . import _backend
+except ImportError:
+    import _backend
+
+
+def as_array(x, dtype):
+    """Zero-copy NumPy view of `x` (copies only if dtype or layout differ)."""
+    if x is None:
+        return None
+    if not isinstance(x, np.ndarray) and hasattr(x, "__dlpack__"):
+        x = np.from_dlpack(x)
+    return np.ascontiguousarray(x, dtype=dtype)
+
+
+def fisheye_project(camera_points, focal_lengths, principal_points):
+    """Project camera-space points [..., 3] with the fisheye model -> [..., 2].
+
+    float64 camera points are projected in double precision (the output is
+    float64 too); anything else in float32.
+    """
+    camera_points = as_array(camera_points, None)
+    dtype = np.float64 if camera_points.dtype == np.float64 else np.float32
+    return _backend._cpu.fisheye_project(
+        as_array(camera_points, dtype),
+        as_array(focal_lengths, dtype),
+        as_array(principal_points, dtype),
+    )
+
+
+def projection_forward(
+    camera_types,
+    intrinsics,
+    world_to_cameras,
+    means,
+    quats,
+    scales,
+    width,
+    height,
+    near_plane=0.01,
+    far_plane=1e10,
+    margin_factor=0.15,
+    distortion_coeffs=None,
+    world_to_cameras1=None,
+    shutter_types=None,
+    use_ut=False,
+    activate=False,
+):
+    """Project Gaussians into a batch of cameras of mixed types.
+
+    With `activate`, `quats` may be unnormalized and `scales` are log scales;
+    they are activated in the same pass that reads them.
+
+    Returns (means2d [C, N, 2], depths [C, N], covars2d [C, N, 2, 2],
+    valid_flags [C, N]).
+    """
+    return _backend._cpu.projection_forward(
+        as_array(camera_types, np.int32),
+        as_array(intrinsics, np.float32),
+        as_array(world_to_cameras, np.float32),
+        as_array(means, np.float32),
+        as_array(quats, np.float32),
+        as_array(scales, np.float32),
+        width,
+        height,
+        near_plane,
+        far_plane,
+        margin_factor,
+        as_array(distortion_coeffs, np.float32),
+        as_array(world_to_cameras1, np.float32),
+        as_array(shutter_types, np.int32),
+        use_ut,
+        activate,
+    )
+
+
+def activate_attributes(means, quats, scales, opacities=None):
+    """Activate AoS parameters into SoA columns in one pass.
+
+    Takes means [N, 3], quats [N, 4], log scales [N, 3] and opacity logits [N].
+    Returns (means [3, N], normalized quats [4, N], scales [3, N],
+    opacities [N] or None).
+    """
+    return _backend._cpu.activate_attributes(
+        as_array(means, np.float32),
+        as_array(quats, np.float32),
+        as_array(scales, np.float32),
+        as_array(opacities, np.float32),
+    )
+
+
+def activate_attributes_backward(
+    means, quats, scales, opacities, v_means, v_quats, v_scales, v_opacities=None
+):
+    """Gradients of `activate_attributes` with respect to its AoS inputs.
+
+    Takes the forward inputs and the SoA gradients [3, N], [4, N], [3, N], [N].
+    Returns (v_means [N, 3], v_quats [N, 4], v_scales [N, 3],
+    v_opacities [N] or None).
+    """
+    return _backend._cpu.activate_attributes_backward(
+        as_array(means, np.float32),
+        as_array(quats, np.float32),
+        as_array(scales, np.float32),
+        as_array(opacities, np.float32),
+        as_array(v_means, np.float32),
+        as_array(v_quats, np.float32),
+        as_array(v_scales, np.float32),
+        as_array(v_opacities, np.float32),
+    )
+
+
+def bin_primitives(
+    means2d,
+    radii,
+    depths,
+    image_width,
+    image_height,
+    image_ids=None,
+    n_images=1,
+    tile_width=16,
+    tile_height=16,
+    sort_by_depth=True,
+):
+    """Per-tile intersection lists: (isect_primitive_ids, isect_prefix_sum_per_tile)."""
+    return _backend._cpu.bin_primitives(
+        as_array(means2d, np.float32),
+        as_array(radii, np.float32),
+        as_array(depths, np.float32),
+        as_array(image_ids, np.uint32),
+        n_images,
+        image_width,
+        image_height,
+        tile_width,
+        tile_height,
+        sort_by_depth,
+    )
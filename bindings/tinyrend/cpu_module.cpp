@@ -0,0 +1,420 @@
+// Torch-free CPU extension, built ahead of time by CMake (-DBUILD_PYTHON=ON).
+//
+// Arrays are taken through the Python buffer protocol (NumPy arrays, or any
+// DLPack producer converted with numpy.from_dlpack on the Python side) and are
+// never copied: inputs must already be C-contiguous with the expected dtype,
+// otherwise a TypeError is raised. Outputs are freshly allocated NumPy arrays.
+// The GIL is released while the C++ code runs.
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "tinyrend/attributes.h"
+#include "tinyrend/camera/fisheye.h"
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/impl_batched.cuh"
+#include "tinyrend/rasterization/binning.h"
+
+namespace py = pybind11;
+
+namespace {
+
+// Pointer to the data of `buffer`, checked to be C-contiguous of type T with
+// the given number of elements (0 = any).
+template <typename T>
+auto buffer_ptr(const py::buffer &buffer, const char *name, size_t numel = 0)
+    -> T * {
+    auto const info = buffer.request();
+    if (!info.item_type_is_equivalent_to<T>())
+        throw py::type_error(
+            std::string(name) + ": expected dtype " +
+            py::format_descriptor<T>::format() + ", got " + info.format
+        );
+    py::ssize_t stride = info.itemsize;
+    for (py::ssize_t d = info.ndim; d-- > 0;) {
+        if (info.shape[d] != 1 && info.strides[d] != stride)
+            throw py::type_error(std::string(name) + ": expected a C-contiguous array");
+        stride *= info.shape[d];
+    }
+    if (numel != 0 && size_t(info.size) != numel)
+        throw py::value_error(
+            std::string(name) + ": expected " + std::to_string(numel) +
+            " elements, got " + std::to_string(info.size)
+        );
+    return static_cast<T *>(info.ptr);
+}
+
+template <typename T>
+auto optional_ptr(const py::object &obj, const char *name, size_t numel) -> const T * {
+    return obj.is_none() ? nullptr : buffer_ptr<T>(obj.cast<py::buffer>(), name, numel);
+}
+
+template <typename T>
+auto fisheye_project_impl(
+    const py::buffer &camera_points,   // [..., 3]
+    const py::buffer &focal_lengths,   // [..., 2]
+    const py::buffer &principal_points // [..., 2]
+) -> py::array_t<T> {
+    auto const info = camera_points.request();
+    const size_t n = size_t(info.size) / 3;
+    auto const *p = buffer_ptr<T>(camera_points, "camera_points", 3 * n);
+    auto const *f = buffer_ptr<T>(focal_lengths, "focal_lengths", 2 * n);
+    auto const *c = buffer_ptr<T>(principal_points, "principal_points", 2 * n);
+    std::vector<py::ssize_t> shape(info.shape.begin(), info.shape.end());
+    shape.back() = 2;
+    py::array_t<T> image_points(shape);
+    T *out = image_points.mutable_data();
+    {
+        py::gil_scoped_release release;
+        tinyrend::thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto const ip = tinyrend::camera::fisheye::project(
+                    glm::vec<3, T>(p[3 * i], p[3 * i + 1], p[3 * i + 2]),
+                    glm::vec<2, T>(f[2 * i], f[2 * i + 1]),
+                    glm::vec<2, T>(c[2 * i], c[2 * i + 1])
+                );
+                out[2 * i] = ip.x;
+                out[2 * i + 1] = ip.y;
+            }
+        });
+    }
+    return image_points;
+}
+
+// float64 camera points select the double-precision model (calibration); all
+// three arrays must then be float64.
+auto fisheye_project(
+    const py::buffer &camera_points,
+    const py::buffer &focal_lengths,
+    const py::buffer &principal_points
+) -> py::array {
+    if (camera_points.request().item_type_is_equivalent_to<double>())
+        return fisheye_project_impl<double>(
+            camera_points, focal_lengths, principal_points
+        );
+    return fisheye_project_impl<float>(camera_points, focal_lengths, principal_points);
+}
+
+auto projection_forward(
+    const py::buffer &camera_types,     // [n_cameras] int32 CameraType tags
+    const py::buffer &intrinsics,       // [n_cameras, 3, 3]
+    const py::buffer &world_to_cameras, // [n_cameras, 4, 4]
+    const py::buffer &means,            // [n_gaussians, 3]
+    const py::buffer &quats,            // [n_gaussians, 4]
+    const py::buffer &scales,           // [n_gaussians, 3]
+    const uint32_t width,
+    const uint32_t height,
+    const float near_plane,
+    const float far_plane,
+    const float margin_factor,
+    const py::object &distortion_coeffs, // [n_cameras, 12] or None
+    const py::object &world_to_cameras1, // [n_cameras, 4, 4] or None
+    const py::object &shutter_types,     // [n_cameras] int32 or None
+    const bool use_ut,
+    const bool activate // quats unnormalized, scales in log space
+) -> py::tuple {
+    using namespace tinyrend::impl;
+    using ShutterType = tinyrend::camera::shutter::Type;
+    const size_t n_cameras = size_t(camera_types.request().size);
+    const size_t n_gaussians = size_t(means.request().size) / 3;
+
+    auto const *tags = buffer_ptr<int32_t>(camera_types, "camera_types", n_cameras);
+    std::vector<CameraType> types(n_cameras);
+    for (size_t c = 0; c < n_cameras; ++c)
+        types[c] = static_cast<CameraType>(tags[c]);
+    auto const groups = group_cameras_by_type(n_cameras, types.data());
+
+    std::vector<ShutterType> shutters;
+    if (!shutter_types.is_none()) {
+        auto const *tag =
+            optional_ptr<int32_t>(shutter_types, "shutter_types", n_cameras);
+        for (size_t c = 0; c < n_cameras; ++c) {
+            if (tag[c] < 0 || tag[c] > int32_t(ShutterType::ROLLING_RIGHT_TO_LEFT))
+                throw py::value_error("shutter_types: unknown shutter type tag");
+            shutters.push_back(static_cast<ShutterType>(tag[c]));
+        }
+    }
+
+    auto const *K = buffer_ptr<float>(intrinsics, "intrinsics", 9 * n_cameras);
+    auto const *w2c0 =
+        buffer_ptr<float>(world_to_cameras, "world_to_cameras", 16 * n_cameras);
+    auto const *w2c1 =
+        optional_ptr<float>(world_to_cameras1, "world_to_cameras1", 16 * n_cameras);
+    auto const *coeffs = optional_ptr<float>(
+        distortion_coeffs, "distortion_coeffs", N_DISTORTION_COEFFS * n_cameras
+    );
+    auto const *mu = buffer_ptr<float>(means, "means", 3 * n_gaussians);
+    auto const *q = buffer_ptr<float>(quats, "quats", 4 * n_gaussians);
+    auto const *s = buffer_ptr<float>(scales, "scales", 3 * n_gaussians);
+
+    const auto C = py::ssize_t(n_cameras), N = py::ssize_t(n_gaussians);
+    py::array_t<float> means2d({C, N, py::ssize_t(2)});
+    py::array_t<float> depths({C, N});
+    py::array_t<float> covars2d({C, N, py::ssize_t(2), py::ssize_t(2)});
+    py::array_t<bool> valid_flags({C, N});
+    {
+        py::gil_scoped_release release;
+        std::vector<float> activated;
+        if (activate) {
+            // one fused pass instead of normalizing / exponentiating separately
+            activated.resize(7 * n_gaussians);
+            auto const *raw_q = q, *raw_s = s;
+            q = activated.data();
+            s = activated.data() + 4 * n_gaussians;
+            tinyrend::attributes::activate(
+                {n_gaussians, mu, raw_q, raw_s, nullptr},
+                activated.data(),
+                activated.data() + 4 * n_gaussians,
+                nullptr
+            );
+        }
+        auto *launch = use_ut ? &launch_projection_forward_batched<false, true>
+                              : &launch_projection_forward_batched<false, false>;
+        launch(
+            groups,
+            groups.order.data(),
+            K,
+            coeffs,
+            w2c0,
+            w2c1,
+            shutters.empty() ? nullptr : shutters.data(),
+            width,
+            height,
+            near_plane,
+            far_plane,
+            margin_factor,
+            n_gaussians,
+            mu,
+            q,
+            s,
+            means2d.mutable_data(),
+            depths.mutable_data(),
+            covars2d.mutable_data(),
+            valid_flags.mutable_data()
+        );
+    }
+    return py::make_tuple(means2d, depths, covars2d, valid_flags);
+}
+
+auto bin_primitives(
+    const py::buffer &means2d,   // [n_primitives, 2]
+    const py::buffer &radii,     // [n_primitives, 2]
+    const py::buffer &depths,    // [n_primitives]
+    const py::object &image_ids, // [n_primitives] uint32 or None
+    const uint32_t n_images,
+    const uint32_t image_width,
+    const uint32_t image_height,
+    const uint32_t tile_width,
+    const uint32_t tile_height,
+    const bool sort_by_depth
+) -> py::tuple {
+    using namespace tinyrend::rasterization;
+    const size_t n = size_t(depths.request().size);
+    BinningConfig cfg;
+    cfg.n_images = n_images;
+    cfg.image_width = image_width;
+    cfg.image_height = image_height;
+    cfg.tile_width = tile_width;
+    cfg.tile_height = tile_height;
+    cfg.sort_by_depth = sort_by_depth;
+    auto const *m = buffer_ptr<float>(means2d, "means2d", 2 * n);
+    auto const *r = buffer_ptr<float>(radii, "radii", 2 * n);
+    auto const *d = buffer_ptr<float>(depths, "depths", n);
+    auto const *ids = optional_ptr<uint32_t>(image_ids, "image_ids", n);
+
+    BinningResult result;
+    {
+        py::gil_scoped_release release;
+        result = tinyrend::rasterization::bin_primitives(n, m, r, d, ids, cfg);
+    }
+    // hand the vectors over without copying
+    auto const to_array = [](std::vector<uint32_t> &&v) {
+        auto *owner = new std::vector<uint32_t>(std::move(v));
+        py::capsule free_owner(owner, [](void *p) {
+            delete static_cast<std::vector<uint32_t> *>(p);
+        });
+        return py::array_t<uint32_t>(owner->size(), owner->data(), free_owner);
+    };
+    return py::make_tuple(
+        to_array(std::move(result.isect_primitive_ids)),
+        to_array(std::move(result.isect_prefix_sum_per_tile))
+    );
+}
+
+// Column-major [3, N] / [4, N] / [N] output arrays viewed as SoA columns.
+struct SoAArrays {
+    py::array_t<float> means, quats, scales, opacities;
+    tinyrend::attributes::SoAGaussians view;
+
+    SoAArrays(py::ssize_t n, bool with_opacities)
+        : means({py::ssize_t(3), n}), quats({py::ssize_t(4), n}),
+          scales({py::ssize_t(3), n}), opacities(with_opacities ? n : 0) {
+        for (int k = 0; k < 3; ++k) {
+            view.means[k] = means.mutable_data() + k * n;
+            view.scales[k] = scales.mutable_data() + k * n;
+        }
+        for (int k = 0; k < 4; ++k)
+            view.quats[k] = quats.mutable_data() + k * n;
+        view.opacities = with_opacities ? opacities.mutable_data() : nullptr;
+    }
+};
+
+auto raw_gaussians(
+    const py::buffer &means,      // [n_gaussians, 3]
+    const py::buffer &quats,      // [n_gaussians, 4]
+    const py::buffer &scales,     // [n_gaussians, 3] log scales
+    const py::object &opacities   // [n_gaussians] logits or None
+) -> tinyrend::attributes::RawGaussians {
+    const size_t n = size_t(means.request().size) / 3;
+    return {
+        n,
+        buffer_ptr<float>(means, "means", 3 * n),
+        buffer_ptr<float>(quats, "quats", 4 * n),
+        buffer_ptr<float>(scales, "scales", 3 * n),
+        optional_ptr<float>(opacities, "opacities", n)
+    };
+}
+
+auto activate_attributes(
+    const py::buffer &means,
+    const py::buffer &quats,
+    const py::buffer &scales,
+    const py::object &opacities
+) -> py::tuple {
+    auto const raw = raw_gaussians(means, quats, scales, opacities);
+    SoAArrays out(py::ssize_t(raw.n_gaussians), raw.opacities != nullptr);
+    {
+        py::gil_scoped_release release;
+        tinyrend::attributes::activate_to_soa(raw, out.view);
+    }
+    return py::make_tuple(
+        out.means,
+        out.quats,
+        out.scales,
+        raw.opacities != nullptr ? py::object(out.opacities) : py::none()
+    );
+}
+
+auto activate_attributes_backward(
+    const py::buffer &means,
+    const py::buffer &quats,
+    const py::buffer &scales,
+    const py::object &opacities,
+    const py::buffer &v_means,    // [3, n_gaussians]
+    const py::buffer &v_quats,    // [4, n_gaussians]
+    const py::buffer &v_scales,   // [3, n_gaussians]
+    const py::object &v_opacities // [n_gaussians] or None
+) -> py::tuple {
+    auto const raw = raw_gaussians(means, quats, scales, opacities);
+    const size_t n = raw.n_gaussians;
+    tinyrend::attributes::SoAGaussians v;
+    auto *vm = buffer_ptr<float>(v_means, "v_means", 3 * n);
+    auto *vq = buffer_ptr<float>(v_quats, "v_quats", 4 * n);
+    auto *vs = buffer_ptr<float>(v_scales, "v_scales", 3 * n);
+    for (int k = 0; k < 3; ++k) {
+        v.means[k] = vm + k * n;
+        v.scales[k] = vs + k * n;
+    }
+    for (int k = 0; k < 4; ++k)
+        v.quats[k] = vq + k * n;
+    // the columns are only read
+    v.opacities =
+        const_cast<float *>(optional_ptr<float>(v_opacities, "v_opacities", n));
+
+    const auto N = py::ssize_t(n);
+    py::array_t<float> g_means({N, py::ssize_t(3)});
+    py::array_t<float> g_quats({N, py::ssize_t(4)});
+    py::array_t<float> g_scales({N, py::ssize_t(3)});
+    py::array_t<float> g_opacities(raw.opacities != nullptr ? N : 0);
+    {
+        py::gil_scoped_release release;
+        tinyrend::attributes::activate_to_soa_vjp(
+            raw,
+            v,
+            g_means.mutable_data(),
+            g_quats.mutable_data(),
+            g_scales.mutable_data(),
+            raw.opacities != nullptr ? g_opacities.mutable_data() : nullptr
+        );
+    }
+    return py::make_tuple(
+        g_means,
+        g_quats,
+        g_scales,
+        raw.opacities != nullptr ? py::object(g_opacities) : py::none()
+    );
+}
+
+} // namespace
+
+PYBIND11_MODULE(_tinyrend_cpu, m) {
+    m.doc() = "tinyrend CPU backend (no torch dependency)";
+    m.def(
+        "fisheye_project",
+        &fisheye_project,
+        py::arg("camera_points"),
+        py::arg("focal_lengths"),
+        py::arg("principal_points")
+    );
+    m.def(
+        "projection_forward",
+        &projection_forward,
+        py::arg("camera_types"),
+        py::arg("intrinsics"),
+        py::arg("world_to_cameras"),
+        py::arg("means"),
+        py::arg("quats"),
+        py::arg("scales"),
+        py::arg("width"),
+        py::arg("height"),
+        py::arg("near_plane") = 0.01f,
+        py::arg("far_plane") = 1e10f,
+        py::arg("margin_factor") = 0.15f,
+        py::arg("distortion_coeffs") = py::none(),
+        py::arg("world_to_cameras1") = py::none(),
+        py::arg("shutter_types") = py::none(),
+        py::arg("use_ut") = false,
+        py::arg("activate") = false
+    );
+    m.def(
+        "activate_attributes",
+        &activate_attributes,
+        py::arg("means"),
+        py::arg("quats"),
+        py::arg("scales"),
+        py::arg("opacities") = py::none()
+    );
+    m.def(
+        "activate_attributes_backward",
+        &activate_attributes_backward,
+        py::arg("means"),
+        py::arg("quats"),
+        py::arg("scales"),
+        py::arg("opacities"),
+        py::arg("v_means"),
+        py::arg("v_quats"),
+        py::arg("v_scales"),
+        py::arg("v_opacities") = py::none()
+    );
+    m.def(
+        "bin_primitives",
+        &bin_primitives,
+        py::arg("means2d"),
+        py::arg("radii"),
+        py::arg("depths"),
+        py::arg("image_ids") = py::none(),
+        py::arg("n_images") = 1,
+        py::arg("image_width") = 0,
+        py::arg("image_height") = 0,
+        py::arg("tile_width") = 16,
+        py::arg("tile_height") = 16,
+        py::arg("sort_by_depth") = true
+    );
+    m.def("num_threads", []() { return tinyrend::thread_pool::global_pool().size(); });
+}
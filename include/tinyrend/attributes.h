@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "tinyrend/core/huge_pages.h"
+#include "tinyrend/core/thread_pool.h"
+
+namespace tinyrend::attributes {
+
+/*
+    Fused activation of the per-Gaussian parameters.
+
+    Callers store the optimized parameters as arrays of structures, [N, 3]
+    means, [N, 4] quaternions, [N, 3] log scales and [N] opacity logits. The
+    renderer consumes activated values
+
+        quat    = q / |q|           (0 if q = 0)
+        scale   = exp(log_scale)
+        opacity = sigmoid(logit)
+
+    and its vectorized CPU paths want one contiguous column per component.
+    `activate_to_soa` reads the AoS parameters once and writes the activated
+    columns; `activate_to_soa_vjp` reads the column gradients once and writes
+    the AoS parameter gradients through the activation Jacobians. Both run on
+    the thread pool in blocks whose AoS rows stay in L1 while each component
+    loop runs over contiguous memory, so the pass is bandwidth bound.
+
+    `activate` is the same pass for the AoS launchers: it writes activated
+    [N, 4] / [N, 3] / [N] arrays (means need no activation and are used in
+    place).
+*/
+
+/// \brief Optimizer-side parameters, arrays of structures.
+struct RawGaussians {
+    size_t n_gaussians = 0;
+    const float *means = nullptr;     // [n_gaussians, 3]
+    const float *quats = nullptr;     // [n_gaussians, 4], (w, x, y, z), any norm
+    const float *scales = nullptr;    // [n_gaussians, 3], log scales
+    const float *opacities = nullptr; // [n_gaussians] logits, or nullptr
+};
+
+/// \brief Activated attributes (or their gradients), one [n_gaussians] column
+/// per component. Null opacity column = no opacities.
+struct SoAGaussians {
+    float *means[3] = {};
+    float *quats[4] = {};
+    float *scales[3] = {};
+    float *opacities = nullptr;
+};
+
+/// \brief Owning SoA storage: all columns in one (huge-page capable) block,
+/// each padded to a multiple of 16 floats so every column starts on a cache
+/// line boundary relative to the block.
+class SoAStorage {
+  public:
+    explicit SoAStorage(size_t n_gaussians, bool with_opacities = true)
+        : n_(n_gaussians),
+          data_(STRIDE_COLUMNS * pitch(n_gaussians), 0.f) {
+        const size_t p = pitch(n_gaussians);
+        float *base = data_.data();
+        for (int k = 0; k < 3; ++k)
+            view_.means[k] = base + k * p;
+        for (int k = 0; k < 4; ++k)
+            view_.quats[k] = base + (3 + k) * p;
+        for (int k = 0; k < 3; ++k)
+            view_.scales[k] = base + (7 + k) * p;
+        view_.opacities = with_opacities ? base + 10 * p : nullptr;
+    }
+
+    size_t size() const { return n_; }
+    const SoAGaussians &view() const { return view_; }
+
+  private:
+    static constexpr size_t STRIDE_COLUMNS = 11;
+    static size_t pitch(size_t n) { return huge_pages::round_up(n, 16); }
+
+    size_t n_;
+    std::vector<float, huge_pages::Allocator<float>> data_;
+    SoAGaussians view_;
+};
+
+namespace detail {
+
+constexpr size_t BLOCK = 256;
+
+inline float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+// 1 / |q| of the quaternions [start, start + nb) into `inv` (0 for q = 0),
+// deinterleaving them into `q`.
+inline void load_quats(
+    const float *quats, size_t start, size_t nb, float (*q)[BLOCK], float *inv
+) {
+    for (int k = 0; k < 4; ++k)
+        for (size_t j = 0; j < nb; ++j)
+            q[k][j] = quats[4 * (start + j) + k];
+    for (size_t j = 0; j < nb; ++j) {
+        auto const sq = q[0][j] * q[0][j] + q[1][j] * q[1][j] + q[2][j] * q[2][j] +
+                        q[3][j] * q[3][j];
+        inv[j] = sq > 0.f ? 1.f / std::sqrt(sq) : 0.f;
+    }
+}
+
+} // namespace detail
+
+/// \brief Activate AoS parameters into SoA columns in one pass.
+///
+/// \param raw Parameters; `raw.opacities` may be null (then `out.opacities`
+///   is not written)
+/// \param out Columns of at least `raw.n_gaussians` floats each
+inline void activate_to_soa(
+    const RawGaussians &raw,
+    const SoAGaussians &out,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    using detail::BLOCK;
+    const size_t n_blocks = (raw.n_gaussians + BLOCK - 1) / BLOCK;
+    pool.parallel_for(n_blocks, [&](size_t begin, size_t end) {
+        alignas(64) float q[4][BLOCK], inv[BLOCK];
+        for (size_t b = begin; b < end; ++b) {
+            const size_t start = b * BLOCK;
+            const size_t nb = std::min(BLOCK, raw.n_gaussians - start);
+            for (int k = 0; k < 3; ++k) {
+                float *mean = out.means[k] + start;
+                float *scale = out.scales[k] + start;
+                for (size_t j = 0; j < nb; ++j)
+                    mean[j] = raw.means[3 * (start + j) + k];
+                for (size_t j = 0; j < nb; ++j)
+                    scale[j] = std::exp(raw.scales[3 * (start + j) + k]);
+            }
+            detail::load_quats(raw.quats, start, nb, q, inv);
+            for (int k = 0; k < 4; ++k) {
+                float *quat = out.quats[k] + start;
+                for (size_t j = 0; j < nb; ++j)
+                    quat[j] = q[k][j] * inv[j];
+            }
+            if (raw.opacities != nullptr && out.opacities != nullptr) {
+                for (size_t i = start; i < start + nb; ++i)
+                    out.opacities[i] = detail::sigmoid(raw.opacities[i]);
+            }
+        }
+    });
+}
+
+/// \brief Activate AoS parameters into AoS outputs in one pass, for the
+/// launchers that take [N, 4] quats and [N, 3] scales. Null outputs (or a
+/// null `raw.opacities`) are skipped.
+inline void activate(
+    const RawGaussians &raw,
+    float *quats,
+    float *scales,
+    float *opacities,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    using detail::BLOCK;
+    const size_t n_blocks = (raw.n_gaussians + BLOCK - 1) / BLOCK;
+    pool.parallel_for(n_blocks, [&](size_t begin, size_t end) {
+        alignas(64) float q[4][BLOCK], inv[BLOCK];
+        for (size_t b = begin; b < end; ++b) {
+            const size_t start = b * BLOCK;
+            const size_t nb = std::min(BLOCK, raw.n_gaussians - start);
+            if (quats != nullptr) {
+                detail::load_quats(raw.quats, start, nb, q, inv);
+                for (size_t j = 0; j < nb; ++j)
+                    for (int k = 0; k < 4; ++k)
+                        quats[4 * (start + j) + k] = q[k][j] * inv[j];
+            }
+            if (scales != nullptr) {
+                for (size_t i = 3 * start; i < 3 * (start + nb); ++i)
+                    scales[i] = std::exp(raw.scales[i]);
+            }
+            if (raw.opacities != nullptr && opacities != nullptr) {
+                for (size_t i = start; i < start + nb; ++i)
+                    opacities[i] = detail::sigmoid(raw.opacities[i]);
+            }
+        }
+    });
+}
+
+/// \brief Gradients of `activate_to_soa`: SoA gradients of the activated
+/// attributes to AoS gradients of the parameters, in one pass.
+///
+/// \param raw Parameters the forward pass was run on
+/// \param v_out Column gradients (read only); a null opacity column means
+///   zero opacity gradients
+/// \param v_means, v_quats, v_scales [N, 3], [N, 4], [N, 3] outputs
+/// \param v_opacities [N] output, or nullptr
+inline void activate_to_soa_vjp(
+    const RawGaussians &raw,
+    const SoAGaussians &v_out,
+    float *v_means,
+    float *v_quats,
+    float *v_scales,
+    float *v_opacities,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    using detail::BLOCK;
+    const size_t n_blocks = (raw.n_gaussians + BLOCK - 1) / BLOCK;
+    pool.parallel_for(n_blocks, [&](size_t begin, size_t end) {
+        alignas(64) float q[4][BLOCK], inv[BLOCK], dot[BLOCK];
+        for (size_t b = begin; b < end; ++b) {
+            const size_t start = b * BLOCK;
+            const size_t nb = std::min(BLOCK, raw.n_gaussians - start);
+            for (int k = 0; k < 3; ++k) {
+                const float *v_mean = v_out.means[k] + start;
+                const float *v_scale = v_out.scales[k] + start;
+                for (size_t j = 0; j < nb; ++j)
+                    v_means[3 * (start + j) + k] = v_mean[j];
+                // d exp(s) / ds = exp(s)
+                for (size_t j = 0; j < nb; ++j) {
+                    const size_t i = 3 * (start + j) + k;
+                    v_scales[i] = v_scale[j] * std::exp(raw.scales[i]);
+                }
+            }
+
+            // d (q / |q|) / dq = (I - qn qnᵀ) / |q|
+            detail::load_quats(raw.quats, start, nb, q, inv);
+            for (int k = 0; k < 4; ++k)
+                for (size_t j = 0; j < nb; ++j)
+                    q[k][j] *= inv[j];
+            std::fill(dot, dot + nb, 0.f);
+            for (int k = 0; k < 4; ++k) {
+                const float *v_quat = v_out.quats[k] + start;
+                for (size_t j = 0; j < nb; ++j)
+                    dot[j] += v_quat[j] * q[k][j];
+            }
+            for (int k = 0; k < 4; ++k) {
+                const float *v_quat = v_out.quats[k] + start;
+                for (size_t j = 0; j < nb; ++j)
+                    v_quats[4 * (start + j) + k] =
+                        (v_quat[j] - dot[j] * q[k][j]) * inv[j];
+            }
+
+            // d sigmoid(x) / dx = o (1 - o)
+            if (raw.opacities != nullptr && v_opacities != nullptr) {
+                for (size_t i = start; i < start + nb; ++i) {
+                    auto const o = detail::sigmoid(raw.opacities[i]);
+                    v_opacities[i] = v_out.opacities != nullptr
+                                         ? v_out.opacities[i] * o * (1.f - o)
+                                         : 0.f;
+                }
+            }
+        }
+    });
+}
+
+} // namespace tinyrend::attributes
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "tinyrend/camera/pinhole.h"
+#include "tinyrend/core/thread_pool.h"
+
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace tinyrend::camera::batched {
+
+/*
+    Batched projection of many points through one camera, for calibration.
+
+    Calibration refines a single set of intrinsics against thousands of
+    observed points, in double precision. Calling the per-point models in a
+    loop leaves the vector units idle: every point pays the full latency of
+    its polynomial chain. Here the points are processed in blocks of 256 on
+    the thread pool. Each block is deinterleaved from [N, 3] into one column
+    per coordinate, the model is evaluated by branch-free loops over the
+    columns, and the results are interleaved back into [N, 2]. For doubles
+    with AVX, the distortion polynomials are evaluated 4 points at a time
+    with explicit intrinsics (plain multiplies and adds, in the order of the
+    scalar loops); the remaining points and other types use the scalar
+    loops. The libm calls of the fisheye model (sqrt, atan) run in their own
+    loop between the polynomial loops.
+
+    The results match `pinhole::project` / `fisheye::project` with the same
+    intrinsics up to rounding (contracted multiply-adds); points the scalar
+    models reject are written as (0, 0) with `valid` = false.
+*/
+
+/// \brief Distorted pinhole intrinsics (see `pinhole::project`).
+template <typename T> struct PinholeIntrinsics {
+    std::array<T, 2> focal_length{};
+    std::array<T, 2> principal_point{};
+    std::array<T, 6> radial_coeffs{};     // k1..k6
+    std::array<T, 2> tangential_coeffs{}; // p1, p2
+    std::array<T, 4> thin_prism_coeffs{}; // s1..s4
+    T min_radial_dist = pinhole::DEFAULT_MIN_RADIAL_DIST;
+    T max_radial_dist = std::numeric_limits<T>::max();
+};
+
+/// \brief Distorted fisheye intrinsics (see `fisheye::project`).
+template <typename T> struct FisheyeIntrinsics {
+    std::array<T, 2> focal_length{};
+    std::array<T, 2> principal_point{};
+    std::array<T, 4> radial_coeffs{}; // k1..k4
+    T min_2d_norm = T(1e-6);
+    T max_theta = std::numeric_limits<T>::max();
+};
+
+namespace detail {
+
+constexpr size_t BLOCK = 256;
+
+// Run `fn(start, nb, x, y)` on blocks of points, with the normalized image
+// coordinates x / z and y / z of the block in `x` and `y`.
+template <typename T, typename Func>
+inline void for_each_block(
+    size_t n, const T *camera_points, thread_pool::ThreadPool &pool, const Func &fn
+) {
+    const size_t n_blocks = (n + BLOCK - 1) / BLOCK;
+    pool.parallel_for(n_blocks, [&](size_t begin, size_t end) {
+        alignas(64) T x[BLOCK], y[BLOCK], z[BLOCK];
+        for (size_t b = begin; b < end; ++b) {
+            const size_t start = b * BLOCK;
+            const size_t nb = std::min(BLOCK, n - start);
+            const T *p = camera_points + 3 * start;
+            for (size_t j = 0; j < nb; ++j) {
+                x[j] = p[3 * j];
+                y[j] = p[3 * j + 1];
+                z[j] = p[3 * j + 2];
+            }
+            for (size_t j = 0; j < nb; ++j) {
+                x[j] /= z[j];
+                y[j] /= z[j];
+            }
+            fn(start, nb, x, y);
+        }
+    });
+}
+
+// image = focal * (u, v) + principal, (0, 0) where invalid.
+template <typename T>
+inline void store_block(
+    size_t nb,
+    const T *u,
+    const T *v,
+    const bool *ok,
+    const std::array<T, 2> &focal_length,
+    const std::array<T, 2> &principal_point,
+    T *image_points,
+    bool *valid
+) {
+    auto const &[fx, fy] = focal_length;
+    auto const &[cx, cy] = principal_point;
+    for (size_t j = 0; j < nb; ++j) {
+        auto const image_x = fx * u[j] + cx;
+        auto const image_y = fy * v[j] + cy;
+        image_points[2 * j] = ok[j] ? image_x : T(0);
+        image_points[2 * j + 1] = ok[j] ? image_y : T(0);
+    }
+    if (valid != nullptr)
+        std::copy(ok, ok + nb, valid);
+}
+
+} // namespace detail
+
+/// \brief Project `n` camera-space points with the distorted pinhole model.
+///
+/// \param camera_points [n, 3] points in camera space
+/// \param intrinsics Camera intrinsics, shared by all points
+/// \param image_points [n, 2] output image points
+/// \param valid [n] output validity flags, or nullptr
+template <typename T>
+inline void pinhole_project(
+    size_t n,
+    const T *camera_points,
+    const PinholeIntrinsics<T> &intrinsics,
+    T *image_points,
+    bool *valid = nullptr,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    auto const &[k1, k2, k3, k4, k5, k6] = intrinsics.radial_coeffs;
+    auto const &[p1, p2] = intrinsics.tangential_coeffs;
+    auto const &[s1, s2, s3, s4] = intrinsics.thin_prism_coeffs;
+    auto const min_dist = intrinsics.min_radial_dist;
+    auto const max_dist = intrinsics.max_radial_dist;
+    auto const block = [&](size_t start, size_t nb, T *x, T *y) {
+        alignas(64) T u[detail::BLOCK], v[detail::BLOCK];
+        alignas(64) bool ok[detail::BLOCK];
+        size_t j = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+        if constexpr (std::is_same_v<T, double>) {
+            auto const c = [](double v) { return _mm256_set1_pd(v); };
+            const __m256d one = c(1), two = c(2);
+            for (; j + 4 <= nb; j += 4) {
+                const __m256d xj = _mm256_load_pd(x + j), yj = _mm256_load_pd(y + j);
+                const __m256d r2 =
+                    _mm256_add_pd(_mm256_mul_pd(xj, xj), _mm256_mul_pd(yj, yj));
+                // 1 + r2 * (a + r2 * (b + r2 * c))
+                auto const poly3 = [&](double a, double b, double cc) {
+                    __m256d p = _mm256_add_pd(c(b), _mm256_mul_pd(r2, c(cc)));
+                    p = _mm256_add_pd(c(a), _mm256_mul_pd(r2, p));
+                    return _mm256_add_pd(one, _mm256_mul_pd(r2, p));
+                };
+                const __m256d icD =
+                    _mm256_div_pd(poly3(k1, k2, k3), poly3(k4, k5, k6));
+                const __m256d axy = _mm256_mul_pd(_mm256_mul_pd(two, xj), yj);
+                const __m256d axx = _mm256_mul_pd(_mm256_mul_pd(two, xj), xj);
+                const __m256d ayy = _mm256_mul_pd(_mm256_mul_pd(two, yj), yj);
+                // p * axy + q * (r2 + a2) + r2 * (s + r2 * t)
+                auto const delta = [&](double p, double q, __m256d a2, double s,
+                                       double t) {
+                    const __m256d d = _mm256_add_pd(
+                        _mm256_mul_pd(c(p), axy),
+                        _mm256_mul_pd(c(q), _mm256_add_pd(r2, a2))
+                    );
+                    const __m256d prism =
+                        _mm256_add_pd(c(s), _mm256_mul_pd(r2, c(t)));
+                    return _mm256_add_pd(d, _mm256_mul_pd(r2, prism));
+                };
+                const __m256d uj = _mm256_add_pd(
+                    _mm256_mul_pd(icD, xj), delta(p1, p2, axx, s1, s2)
+                );
+                const __m256d vj = _mm256_add_pd(
+                    _mm256_mul_pd(icD, yj), delta(p2, p1, ayy, s3, s4)
+                );
+                _mm256_store_pd(u + j, uj);
+                _mm256_store_pd(v + j, vj);
+                const int mask = _mm256_movemask_pd(_mm256_and_pd(
+                    _mm256_cmp_pd(icD, c(min_dist), _CMP_GT_OQ),
+                    _mm256_cmp_pd(icD, c(max_dist), _CMP_LT_OQ)
+                ));
+                for (int k = 0; k < 4; ++k)
+                    ok[j + k] = (mask >> k) & 1;
+            }
+        }
+#endif
+        // same operations as pinhole::distortion, one column at a time
+        for (; j < nb; ++j) {
+            auto const r2 = x[j] * x[j] + y[j] * y[j];
+            auto const icD_num = T(1) + r2 * (k1 + r2 * (k2 + r2 * k3));
+            auto const icD_den = T(1) + r2 * (k4 + r2 * (k5 + r2 * k6));
+            auto const icD = icD_num / icD_den;
+            auto const axy = T(2) * x[j] * y[j];
+            auto const axx = T(2) * x[j] * x[j];
+            auto const ayy = T(2) * y[j] * y[j];
+            auto const delta_x = p1 * axy + p2 * (r2 + axx) + r2 * (s1 + r2 * s2);
+            auto const delta_y = p2 * axy + p1 * (r2 + ayy) + r2 * (s3 + r2 * s4);
+            u[j] = icD * x[j] + delta_x;
+            v[j] = icD * y[j] + delta_y;
+            ok[j] = (icD > min_dist) & (icD < max_dist);
+        }
+        detail::store_block(
+            nb,
+            u,
+            v,
+            ok,
+            intrinsics.focal_length,
+            intrinsics.principal_point,
+            image_points + 2 * start,
+            valid != nullptr ? valid + start : nullptr
+        );
+    };
+    detail::for_each_block(n, camera_points, pool, block);
+}
+
+/// \brief Project `n` camera-space points with the distorted fisheye model.
+///
+/// \param camera_points [n, 3] points in camera space
+/// \param intrinsics Camera intrinsics, shared by all points
+/// \param image_points [n, 2] output image points
+/// \param valid [n] output validity flags, or nullptr
+template <typename T>
+inline void fisheye_project(
+    size_t n,
+    const T *camera_points,
+    const FisheyeIntrinsics<T> &intrinsics,
+    T *image_points,
+    bool *valid = nullptr,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    auto const &[k1, k2, k3, k4] = intrinsics.radial_coeffs;
+    auto const min_norm = intrinsics.min_2d_norm;
+    auto const max_theta = intrinsics.max_theta;
+    auto const block = [&](size_t start, size_t nb, T *x, T *y) {
+        alignas(64) T r[detail::BLOCK], theta[detail::BLOCK];
+        alignas(64) bool ok[detail::BLOCK];
+        // math::numerically_stable_norm2 without the early return; theta holds
+        // 1 + (lo / hi)^2 until the libm loop
+        for (size_t j = 0; j < nb; ++j) {
+            auto const abs_x = std::fabs(x[j]);
+            auto const abs_y = std::fabs(y[j]);
+            auto const lo = std::min(abs_x, abs_y);
+            auto const hi = std::max(abs_x, abs_y);
+            // hi = 0 implies lo = 0, so the ratio is 0 as in the scalar model
+            auto const ratio = lo / std::max(hi, std::numeric_limits<T>::denorm_min());
+            r[j] = hi;
+            theta[j] = T(1) + ratio * ratio;
+        }
+        // libm calls (sqrt sets errno unless -fno-math-errno)
+        for (size_t j = 0; j < nb; ++j) {
+            r[j] *= std::sqrt(theta[j]);
+            theta[j] = std::atan(r[j]);
+        }
+        size_t j = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+        if constexpr (std::is_same_v<T, double>) {
+            auto const c = [](double v) { return _mm256_set1_pd(v); };
+            const __m256d one = c(1);
+            for (; j + 4 <= nb; j += 4) {
+                const __m256d rj = _mm256_load_pd(r + j);
+                const __m256d t = _mm256_load_pd(theta + j);
+                const __m256d t2 = _mm256_mul_pd(t, t);
+                __m256d p = _mm256_add_pd(c(k3), _mm256_mul_pd(t2, c(k4)));
+                p = _mm256_add_pd(c(k2), _mm256_mul_pd(t2, p));
+                p = _mm256_add_pd(c(k1), _mm256_mul_pd(t2, p));
+                p = _mm256_add_pd(one, _mm256_mul_pd(t2, p));
+                const __m256d theta_d = _mm256_mul_pd(t, p);
+                const __m256d scale =
+                    _mm256_div_pd(theta_d, _mm256_max_pd(rj, c(min_norm)));
+                // the scalar blend gives exactly 1 at the center and `scale`
+                // elsewhere, so a select is equivalent here
+                const __m256d center = _mm256_cmp_pd(rj, c(min_norm), _CMP_LT_OQ);
+                const __m256d factor = _mm256_blendv_pd(scale, one, center);
+                _mm256_store_pd(x + j, _mm256_mul_pd(_mm256_load_pd(x + j), factor));
+                _mm256_store_pd(y + j, _mm256_mul_pd(_mm256_load_pd(y + j), factor));
+                const int mask = _mm256_movemask_pd(_mm256_or_pd(
+                    center, _mm256_cmp_pd(t, c(max_theta), _CMP_NGT_UQ)
+                ));
+                for (int k = 0; k < 4; ++k)
+                    ok[j + k] = (mask >> k) & 1;
+            }
+        }
+#endif
+        for (; j < nb; ++j) {
+            // Points at the image center are not distorted. Blend instead of
+            // select (floating-point selects are not if-converted under
+            // -ftrapping-math): max(r, min_norm) = r off center, and keeps the
+            // unused scale finite at the center.
+            auto const center = r[j] < min_norm;
+            auto const keep = center ? T(1) : T(0);
+            auto const t = theta[j];
+            auto const t2 = t * t;
+            auto const theta_d =
+                t * (T(1) + t2 * (k1 + t2 * (k2 + t2 * (k3 + t2 * k4))));
+            auto const scale = theta_d / std::max(r[j], min_norm);
+            auto const factor = keep + (T(1) - keep) * scale;
+            x[j] *= factor;
+            y[j] *= factor;
+            ok[j] = center | !(t > max_theta);
+        }
+        detail::store_block(
+            nb,
+            x,
+            y,
+            ok,
+            intrinsics.focal_length,
+            intrinsics.principal_point,
+            image_points + 2 * start,
+            valid != nullptr ? valid + start : nullptr
+        );
+    };
+    detail::for_each_block(n, camera_points, pool, block);
+}
+
+} // namespace tinyrend::camera::batched
@@ -16,12 +16,13 @@ namespace tinyrend::camera::orthogonal {
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \param principal_point Principal point in pixels (cx, cy)
 /// \return Projected 2D point in image space
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project(
-    glm::fvec3 const &camera_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &principal_point
-) -> glm::fvec2 {
-    auto const xy = glm::fvec2(camera_point);
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &principal_point
+) -> glm::vec<2, T> {
+    auto const xy = glm::vec<2, T>(camera_point);
     auto const image_point = focal_length * xy + principal_point;
     return image_point;
 }
@@ -30,10 +31,12 @@ GSPLAT_HOST_DEVICE inline auto project(
 /// \param camera_point 3D point in camera space (x, y, z)
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \return Jacobian of the projection function
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_jac(
-    glm::fvec3 const &camera_point, glm::fvec2 const &focal_length
-) -> glm::fmat3x2 {
-    auto const J = glm::fmat3x2{focal_length[0], 0.f, 0.f, focal_length[1], 0.f, 0.f};
+    glm::vec<3, T> const &camera_point, glm::vec<2, T> const &focal_length
+) -> glm::mat<3, 2, T> {
+    auto const J =
+        glm::mat<3, 2, T>{focal_length[0], 0.f, 0.f, focal_length[1], 0.f, 0.f};
     return J;
 }
 
@@ -41,11 +44,12 @@ GSPLAT_HOST_DEVICE inline auto project_jac(
 /// \param camera_point 3D point in camera space (x, y, z)
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \return Array of two 3x3 Hessian matrices (H1 = ∂²u/∂p², H2 = ∂²v/∂p²)
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_hess(
-    glm::fvec3 const &camera_point, glm::fvec2 const &focal_length
-) -> std::array<glm::fmat3x3, 2> {
+    glm::vec<3, T> const &camera_point, glm::vec<2, T> const &focal_length
+) -> std::array<glm::mat<3, 3, T>, 2> {
     // Hessian is zero for orthogonal projection
-    return {glm::fmat3x3{}, glm::fmat3x3{}};
+    return {glm::mat<3, 3, T>{}, glm::mat<3, 3, T>{}};
 }
 
 /// \brief Unproject a 2D image point to a ray in camera space.
@@ -53,14 +57,15 @@ GSPLAT_HOST_DEVICE inline auto project_hess(
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \param principal_point Principal point in pixels (cx, cy)
 /// \return Ray in camera space (origin, direction)
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto unproject(
-    glm::fvec2 const &image_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &principal_point
-) -> std::pair<glm::fvec3, glm::fvec3> {
+    glm::vec<2, T> const &image_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &principal_point
+) -> std::pair<glm::vec<3, T>, glm::vec<3, T>> {
     auto const xy = (image_point - principal_point) / focal_length;
-    auto const origin = glm::fvec3{xy[0], xy[1], 0.f};
-    auto const dir = glm::fvec3{0.f, 0.f, 1.f};
+    auto const origin = glm::vec<3, T>{xy[0], xy[1], 0.f};
+    auto const dir = glm::vec<3, T>{0.f, 0.f, 1.f};
     return {origin, dir};
 }
 
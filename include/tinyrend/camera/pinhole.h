@@ -12,6 +12,8 @@
 
 namespace tinyrend::camera::pinhole {
 
+using math::type_identity_t;
+
 GSPLAT_HOST_DEVICE constexpr float DEFAULT_MIN_RADIAL_DIST = 0.8f;
 GSPLAT_HOST_DEVICE constexpr float DEFAULT_MAX_RADIAL_DIST =
     std::numeric_limits<float>::max();
@@ -21,12 +23,13 @@ GSPLAT_HOST_DEVICE constexpr float DEFAULT_MAX_RADIAL_DIST =
 // Where:
 //      icD_num = 1 + k1 * r2 + k2 * r4 + k3 * r6
 //      icD_den = 1 + k4 * r2 + k5 * r4 + k6 * r6
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto compute_icD(
-    const float r2, const std::array<float, 6> &radial_coeffs
-) -> std::pair<float, float> {
+    const type_identity_t<T> r2, const std::array<T, 6> &radial_coeffs
+) -> std::pair<T, T> {
     auto const &[k1, k2, k3, k4, k5, k6] = radial_coeffs;
-    auto const icD_num = tinyrend::math::eval_poly_horner<4>({1.f, k1, k2, k3}, r2);
-    auto const icD_den = tinyrend::math::eval_poly_horner<4>({1.f, k4, k5, k6}, r2);
+    auto const icD_num = tinyrend::math::eval_poly_horner<4, T>({1.f, k1, k2, k3}, r2);
+    auto const icD_den = tinyrend::math::eval_poly_horner<4, T>({1.f, k4, k5, k6}, r2);
     return {icD_num, icD_den};
 }
 
@@ -34,17 +37,18 @@ GSPLAT_HOST_DEVICE inline auto compute_icD(
 // Compute the gradient of the radial distortion factor icD w.r.t. r2
 // Where:
 //      r2 = x^2 + y^2
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto gradient_icD(
-    const float r2,
-    const float icD_den,
-    const float icD_num,
-    const std::array<float, 6> &radial_coeffs
-) -> float {
+    const type_identity_t<T> r2,
+    const type_identity_t<T> icD_den,
+    const type_identity_t<T> icD_num,
+    const std::array<T, 6> &radial_coeffs
+) -> T {
     auto const &[k1, k2, k3, k4, k5, k6] = radial_coeffs;
     auto const d_icD_num =
-        tinyrend::math::eval_poly_horner<3>({k1, 2.f * k2, 3.f * k3}, r2);
+        tinyrend::math::eval_poly_horner<3, T>({k1, 2.f * k2, 3.f * k3}, r2);
     auto const d_icD_den =
-        tinyrend::math::eval_poly_horner<3>({k4, 2.f * k5, 3.f * k6}, r2);
+        tinyrend::math::eval_poly_horner<3, T>({k4, 2.f * k5, 3.f * k6}, r2);
     auto const d_icD_dr2 =
         (d_icD_num * icD_den - icD_num * d_icD_den) / (icD_den * icD_den);
     return d_icD_dr2; // d(icD) / d(r2)
@@ -52,12 +56,13 @@ GSPLAT_HOST_DEVICE inline auto gradient_icD(
 
 /// @private
 // Compute the shifting in the distortion: delta.
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto compute_delta(
-    const glm::fvec2 xy,
-    const float r2,
-    const std::array<float, 2> &tangential_coeffs,
-    const std::array<float, 4> &thin_prism_coeffs
-) -> glm::fvec2 {
+    const glm::vec<2, T> xy,
+    const type_identity_t<T> r2,
+    const std::array<T, 2> &tangential_coeffs,
+    const std::array<T, 4> &thin_prism_coeffs
+) -> glm::vec<2, T> {
     auto const &[p1, p2] = tangential_coeffs;
     auto const &[s1, s2, s3, s4] = thin_prism_coeffs;
     auto const axy = 2.f * xy[0] * xy[1];
@@ -65,17 +70,18 @@ GSPLAT_HOST_DEVICE inline auto compute_delta(
     auto const ayy = 2.f * xy[1] * xy[1];
     auto const delta_x = p1 * axy + p2 * (r2 + axx) + r2 * (s1 + r2 * s2);
     auto const delta_y = p2 * axy + p1 * (r2 + ayy) + r2 * (s3 + r2 * s4);
-    return glm::fvec2{delta_x, delta_y};
+    return glm::vec<2, T>{delta_x, delta_y};
 }
 
 /// @private
 // Compute the Jacobian of the shifting distortion: d(delta) / d(xy)
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto jacobian_delta(
-    const glm::fvec2 xy,
-    const float r2,
-    const std::array<float, 2> &tangential_coeffs,
-    const std::array<float, 4> &thin_prism_coeffs
-) -> glm::fmat2 {
+    const glm::vec<2, T> xy,
+    const type_identity_t<T> r2,
+    const std::array<T, 2> &tangential_coeffs,
+    const std::array<T, 4> &thin_prism_coeffs
+) -> glm::mat<2, 2, T> {
     auto const &[p1, p2] = tangential_coeffs;
     auto const &[s1, s2, s3, s4] = thin_prism_coeffs;
     auto const p1x = 2.f * p1 * xy[0], p2x = 2.f * p2 * xy[0];
@@ -87,7 +93,7 @@ GSPLAT_HOST_DEVICE inline auto jacobian_delta(
     auto const d_delta_y_dx = p2y + p1x + xy[0] * d_sy_dr2;
     auto const d_delta_y_dy = p2x + p1y * 3.f + xy[1] * d_sy_dr2;
     // column-major order
-    return glm::fmat2{d_delta_x_dx, d_delta_y_dx, d_delta_x_dy, d_delta_y_dy};
+    return glm::mat<2, 2, T>{d_delta_x_dx, d_delta_y_dx, d_delta_x_dy, d_delta_y_dy};
 }
 
 /// \brief Compute the distortion: uv = icD * xy + delta
@@ -100,20 +106,21 @@ GSPLAT_HOST_DEVICE inline auto jacobian_delta(
 /// \param max_radial_dist Maximum radial distortion threshold for numerical stability.
 /// Default value is max float.
 /// \return Pair of distorted 2D point and validity flag
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto distortion(
-    const glm::fvec2 &xy,
-    const std::array<float, 6> &radial_coeffs,
-    const std::array<float, 2> &tangential_coeffs,
-    const std::array<float, 4> &thin_prism_coeffs,
-    const float &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
-    const float &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
-) -> std::pair<glm::fvec2, bool> {
+    const glm::vec<2, T> &xy,
+    const std::array<T, 6> &radial_coeffs,
+    const std::array<T, 2> &tangential_coeffs,
+    const std::array<T, 4> &thin_prism_coeffs,
+    const type_identity_t<T> &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    const type_identity_t<T> &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> std::pair<glm::vec<2, T>, bool> {
     auto const r2 = glm::dot(xy, xy);
     auto const &[icD_num, icD_den] = compute_icD(r2, radial_coeffs);
     auto const icD = icD_num / icD_den;
     auto const valid_flag = (icD > min_radial_dist) && (icD < max_radial_dist);
     if (!valid_flag)
-        return {glm::fvec2{}, false};
+        return {glm::vec<2, T>{}, false};
     auto const delta = compute_delta(xy, r2, tangential_coeffs, thin_prism_coeffs);
     auto const uv = icD * xy + delta;
     return {uv, true};
@@ -130,27 +137,28 @@ GSPLAT_HOST_DEVICE inline auto distortion(
 /// Default value is max float.
 /// \return Tuple containing the 2x2 Jacobian matrix, radial distortion factor icD,
 /// squared radius r2, and validity flag
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto distortion_jac(
-    const glm::fvec2 &xy,
-    const std::array<float, 6> &radial_coeffs,
-    const std::array<float, 2> &tangential_coeffs,
-    const std::array<float, 4> &thin_prism_coeffs,
-    const float &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
-    const float &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
-) -> std::tuple<glm::fmat2, float, float, bool> {
+    const glm::vec<2, T> &xy,
+    const std::array<T, 6> &radial_coeffs,
+    const std::array<T, 2> &tangential_coeffs,
+    const std::array<T, 4> &thin_prism_coeffs,
+    const type_identity_t<T> &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    const type_identity_t<T> &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> std::tuple<glm::mat<2, 2, T>, T, T, bool> {
     // Compute the distortion icD
     auto const r2 = glm::dot(xy, xy);
     auto const &[icD_num, icD_den] = compute_icD(r2, radial_coeffs);
     auto const icD = icD_num / icD_den;
     auto const valid_flag = (icD > min_radial_dist) && (icD < max_radial_dist);
     if (!valid_flag)
-        return {glm::fmat2(0.f), 0.f, 0.f, false};
+        return {glm::mat<2, 2, T>(0.f), 0.f, 0.f, false};
 
     // Compute the Jacobian: J = J(icD) * diag(xy) + diag(icD) + J(delta)
     auto const d_icD_dr2 = gradient_icD(r2, icD_den, icD_num, radial_coeffs);
     auto const d_icD_dxy = 2.f * d_icD_dr2 * xy;
     auto const J_delta = jacobian_delta(xy, r2, tangential_coeffs, thin_prism_coeffs);
-    auto const J = glm::fmat2{
+    auto const J = glm::mat<2, 2, T>{
         icD + xy[0] * d_icD_dxy[0] + J_delta[0][0],
         xy[1] * d_icD_dxy[0] + J_delta[0][1],
         xy[0] * d_icD_dxy[1] + J_delta[1][0],
@@ -170,23 +178,23 @@ GSPLAT_HOST_DEVICE inline auto distortion_jac(
 /// \param max_radial_dist Maximum radial distortion threshold for numerical stability.
 /// Default value is max float.
 /// \return Pair of undistorted 2D point and convergence flag
-template <size_t N_ITER = 20>
+template <size_t N_ITER = 20, typename T = float>
 GSPLAT_HOST_DEVICE inline auto undistortion(
-    const glm::fvec2 &uv,
-    const std::array<float, 6> &radial_coeffs,
-    const std::array<float, 2> &tangential_coeffs,
-    const std::array<float, 4> &thin_prism_coeffs,
-    const float &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
-    const float &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
-) -> std::pair<glm::fvec2, bool> {
+    const glm::vec<2, T> &uv,
+    const std::array<T, 6> &radial_coeffs,
+    const std::array<T, 2> &tangential_coeffs,
+    const std::array<T, 4> &thin_prism_coeffs,
+    const type_identity_t<T> &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    const type_identity_t<T> &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> std::pair<glm::vec<2, T>, bool> {
     // define the residual and Jacobian of the equation
     auto const func = [&uv,
                        &radial_coeffs,
                        &tangential_coeffs,
                        &thin_prism_coeffs,
                        &min_radial_dist,
-                       &max_radial_dist](const glm::fvec2 &xy
-                      ) -> std::pair<glm::fvec2, glm::fmat2> {
+                       &max_radial_dist](const glm::vec<2, T> &xy
+                      ) -> std::pair<glm::vec<2, T>, glm::mat<2, 2, T>> {
         auto const &[J, icD, r2, valid_flag] = distortion_jac(
             xy,
             radial_coeffs,
@@ -196,7 +204,7 @@ GSPLAT_HOST_DEVICE inline auto undistortion(
             max_radial_dist
         );
         if (!valid_flag)
-            return {glm::fvec2{}, glm::fmat2{}};
+            return {glm::vec<2, T>{}, glm::mat<2, 2, T>{}};
         auto const delta = compute_delta(xy, r2, tangential_coeffs, thin_prism_coeffs);
         auto const residual = icD * xy + delta - uv;
         return {residual, J};
@@ -211,12 +219,13 @@ GSPLAT_HOST_DEVICE inline auto undistortion(
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \param principal_point Principal point in pixels (cx, cy)
 /// \return Projected 2D point in image space
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project(
-    glm::fvec3 const &camera_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &principal_point
-) -> glm::fvec2 {
-    auto const xy = glm::fvec2(camera_point) / camera_point.z;
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &principal_point
+) -> glm::vec<2, T> {
+    auto const xy = glm::vec<2, T>(camera_point) / camera_point.z;
     auto const image_point = focal_length * xy + principal_point;
     return image_point;
 }
@@ -226,16 +235,17 @@ GSPLAT_HOST_DEVICE inline auto project(
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \param v_image_point gradient of the image point dl/d(image_point)
 /// \return The gradient of the camera point dl/d(camera_point)
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_vjp(
-    glm::fvec3 const &camera_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &v_image_point
-) -> glm::fvec3 {
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &v_image_point
+) -> glm::vec<3, T> {
     auto const rz = 1.0f / camera_point.z;
-    auto const xy = glm::fvec2(camera_point) * rz;
+    auto const xy = glm::vec<2, T>(camera_point) * rz;
     auto const v_xy = v_image_point * focal_length;
     auto const v_xy_rz = v_xy * rz;
-    auto const v_camera_point = glm::fvec3{
+    auto const v_camera_point = glm::vec<3, T>{
         v_xy_rz[0],
         v_xy_rz[1],
         -v_xy_rz[0] * xy[0] - v_xy_rz[1] * xy[1],
@@ -247,20 +257,23 @@ GSPLAT_HOST_DEVICE inline auto project_vjp(
 /// \param camera_point 3D point in camera space (x, y, z)
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \return Array of two 3x3 Hessian matrices (H1 = ∂²u/∂p², H2 = ∂²v/∂p²)
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_hess(
-    glm::fvec3 const &camera_point, glm::fvec2 const &focal_length
-) -> std::array<glm::fmat3x3, 2> {
+    glm::vec<3, T> const &camera_point, glm::vec<2, T> const &focal_length
+) -> std::array<glm::mat<3, 3, T>, 2> {
     auto const rz = 1.f / camera_point.z;
     auto const rz2 = rz * rz;
-    auto const xy = glm::fvec2(camera_point) * rz;
+    auto const xy = glm::vec<2, T>(camera_point) * rz;
 
     auto const fxrz2 = focal_length[0] * rz2;
     auto const fyrz2 = focal_length[1] * rz2;
 
-    auto const H1 =
-        glm::fmat3x3{0.f, 0.f, -fxrz2, 0.f, 0.f, 0.f, -fxrz2, 0.f, 2.f * fxrz2 * xy[0]};
-    auto const H2 =
-        glm::fmat3x3{0.f, 0.f, 0.f, 0.f, 0.f, -fyrz2, 0.f, -fyrz2, 2.f * fyrz2 * xy[1]};
+    auto const H1 = glm::mat<3, 3, T>{
+        0.f, 0.f, -fxrz2, 0.f, 0.f, 0.f, -fxrz2, 0.f, 2.f * fxrz2 * xy[0]
+    };
+    auto const H2 = glm::mat<3, 3, T>{
+        0.f, 0.f, 0.f, 0.f, 0.f, -fyrz2, 0.f, -fyrz2, 2.f * fyrz2 * xy[1]
+    };
     return {H1, H2};
 }
 
@@ -269,13 +282,14 @@ GSPLAT_HOST_DEVICE inline auto project_hess(
 /// \param camera_point 3D point in camera space (x, y, z)
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \return 3x2 Jacobian matrix
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_jac(
-    glm::fvec3 const &camera_point, glm::fvec2 const &focal_length
-) -> glm::fmat3x2 {
+    glm::vec<3, T> const &camera_point, glm::vec<2, T> const &focal_length
+) -> glm::mat<3, 2, T> {
     auto const rz = 1.0f / camera_point.z;
-    auto const xy = glm::fvec2(camera_point) * rz;
+    auto const xy = glm::vec<2, T>(camera_point) * rz;
     auto const focal_length_rz = focal_length * rz;
-    auto const J = glm::fmat3x2{
+    auto const J = glm::mat<3, 2, T>{
         focal_length_rz[0],
         0.f,
         0.f,
@@ -291,19 +305,20 @@ GSPLAT_HOST_DEVICE inline auto project_jac(
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \param v_J gradient of the Jacobian matrix dl/d(J)
 /// \return The gradient of the camera point dl/d(camera_point)
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_jac_vjp(
-    glm::fvec3 const &camera_point,
-    glm::fvec2 const &focal_length,
-    glm::fmat3x2 const &v_J
-) -> glm::fvec3 {
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    glm::mat<3, 2, T> const &v_J
+) -> glm::vec<3, T> {
     auto const rz = 1.f / camera_point.z;
     auto const rz2 = rz * rz;
-    auto const xy = glm::fvec2(camera_point) * rz;
+    auto const xy = glm::vec<2, T>(camera_point) * rz;
 
     auto const fxrz2 = focal_length[0] * rz2;
     auto const fyrz2 = focal_length[1] * rz2;
 
-    auto const v_camera_point = glm::fvec3{
+    auto const v_camera_point = glm::vec<3, T>{
         -fxrz2 * v_J[2][0],
         -fyrz2 * v_J[2][1],
         -fxrz2 * v_J[0][0] - fyrz2 * v_J[1][1] + 2.f * fxrz2 * xy[0] * v_J[2][0] +
@@ -325,17 +340,18 @@ GSPLAT_HOST_DEVICE inline auto project_jac_vjp(
 /// \param max_radial_dist Maximum radial distortion threshold for numerical stability.
 /// Default value is max float.
 /// \return Pair of projected 2D point and validity flag
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project(
-    glm::fvec3 const &camera_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &principal_point,
-    std::array<float, 6> const &radial_coeffs,
-    std::array<float, 2> const &tangential_coeffs,
-    std::array<float, 4> const &thin_prism_coeffs,
-    float const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
-    float const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
-) -> std::pair<glm::fvec2, bool> {
-    auto const xy = glm::fvec2(camera_point) / camera_point.z;
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &principal_point,
+    std::array<T, 6> const &radial_coeffs,
+    std::array<T, 2> const &tangential_coeffs,
+    std::array<T, 4> const &thin_prism_coeffs,
+    type_identity_t<T> const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    type_identity_t<T> const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> std::pair<glm::vec<2, T>, bool> {
+    auto const xy = glm::vec<2, T>(camera_point) / camera_point.z;
     auto const &[uv, valid_flag] = distortion(
         xy,
         radial_coeffs,
@@ -345,7 +361,7 @@ GSPLAT_HOST_DEVICE inline auto project(
         max_radial_dist
     );
     if (!valid_flag)
-        return {glm::fvec2{}, false};
+        return {glm::vec<2, T>{}, false};
     auto const image_point = focal_length * uv + principal_point;
     return {image_point, true};
 }
@@ -362,17 +378,18 @@ GSPLAT_HOST_DEVICE inline auto project(
 /// \param max_radial_dist Maximum radial distortion threshold for numerical stability.
 /// Default value is max float.
 /// \return Pair of 3x2 Jacobian matrix and validity flag
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto project_jac(
-    glm::fvec3 const &camera_point,
-    glm::fvec2 const &focal_length,
-    std::array<float, 6> const &radial_coeffs,
-    std::array<float, 2> const &tangential_coeffs,
-    std::array<float, 4> const &thin_prism_coeffs,
-    float const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
-    float const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
-) -> std::pair<glm::fmat3x2, bool> {
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    std::array<T, 6> const &radial_coeffs,
+    std::array<T, 2> const &tangential_coeffs,
+    std::array<T, 4> const &thin_prism_coeffs,
+    type_identity_t<T> const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    type_identity_t<T> const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> std::pair<glm::mat<3, 2, T>, bool> {
     auto const rz = 1.0f / camera_point.z;
-    auto const xy = glm::fvec2(camera_point) * rz;
+    auto const xy = glm::vec<2, T>(camera_point) * rz;
 
     auto const &[J_uv_xy, icD, r2, valid_flag] = distortion_jac(
         xy,
@@ -383,15 +400,15 @@ GSPLAT_HOST_DEVICE inline auto project_jac(
         max_radial_dist
     );
     if (!valid_flag)
-        return {glm::fmat3x2{}, false};
+        return {glm::mat<3, 2, T>{}, false};
 
-    auto const J_xy = glm::fmat2{
+    auto const J_xy = glm::mat<2, 2, T>{
         focal_length[0] * J_uv_xy[0][0],
         focal_length[1] * J_uv_xy[0][1],
         focal_length[0] * J_uv_xy[1][0],
         focal_length[1] * J_uv_xy[1][1],
     };
-    auto const J_xy_point = glm::fmat3x2{
+    auto const J_xy_point = glm::mat<3, 2, T>{
         rz,
         0.f,
         0.f,
@@ -403,19 +420,116 @@ GSPLAT_HOST_DEVICE inline auto project_jac(
     return {J, true};
 }
 
+/// \brief Compute vector-Jacobian product for dl/d(J) of the pinhole projection
+/// with lens distortion: dl/d(input) = dl/d(J) * H
+/// \param camera_point 3D point in camera space (x, y, z)
+/// \param focal_length Focal length in pixels (fx, fy)
+/// \param radial_coeffs Radial distortion coefficients (k1, k2, k3, k4, k5, k6)
+/// \param tangential_coeffs Tangential distortion coefficients (p1, p2)
+/// \param thin_prism_coeffs Thin prism distortion coefficients (s1, s2, s3, s4)
+/// \param v_J gradient of the Jacobian matrix dl/d(J)
+/// \param min_radial_dist Minimum radial distortion threshold for numerical stability.
+/// Default value is 0.8f.
+/// \param max_radial_dist Maximum radial distortion threshold for numerical stability.
+/// Default value is max float.
+/// \return The gradient of the camera point dl/d(camera_point); zero where the
+/// distortion is invalid
+template <typename T = float>
+GSPLAT_HOST_DEVICE inline auto project_jac_vjp(
+    glm::vec<3, T> const &camera_point,
+    glm::vec<2, T> const &focal_length,
+    std::array<T, 6> const &radial_coeffs,
+    std::array<T, 2> const &tangential_coeffs,
+    std::array<T, 4> const &thin_prism_coeffs,
+    glm::mat<3, 2, T> const &v_J,
+    type_identity_t<T> const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    type_identity_t<T> const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> glm::vec<3, T> {
+    // J = diag(f) * D(xy) * A(p), with D = d(uv) / d(xy) and A = d(xy) / d(p)
+    auto const rz = 1.f / camera_point.z;
+    auto const rz2 = rz * rz;
+    auto const xy = glm::vec<2, T>(camera_point) * rz;
+    auto const &[D, icD, r2, valid_flag] = distortion_jac(
+        xy,
+        radial_coeffs,
+        tangential_coeffs,
+        thin_prism_coeffs,
+        min_radial_dist,
+        max_radial_dist
+    );
+    if (!valid_flag)
+        return glm::vec<3, T>(0.f);
+    auto const A = glm::mat<3, 2, T>{rz, 0.f, 0.f, rz, -xy[0] * rz, -xy[1] * rz};
+    auto const F = glm::mat<2, 2, T>{focal_length[0], 0.f, 0.f, focal_length[1]};
+
+    // gradients of the factors: v_D = F * v_J * A^T, v_A = D^T * F * v_J
+    auto const v_D = F * v_J * glm::transpose(A);
+    auto const v_A = glm::transpose(D) * F * v_J;
+
+    // A depends on the point directly
+    auto v_camera_point = glm::vec<3, T>{
+        -rz2 * v_A[2][0],
+        -rz2 * v_A[2][1],
+        -rz2 * (v_A[0][0] + v_A[1][1]) +
+            2.f * rz2 * (xy[0] * v_A[2][0] + xy[1] * v_A[2][1]),
+    };
+
+    // D depends on xy: D = icD * I + 2 * icD' * xy * xy^T + J(delta), where
+    // icD' = d(icD) / d(r2)
+    auto const &[k1, k2, k3, k4, k5, k6] = radial_coeffs;
+    auto const &[icD_num, icD_den] = compute_icD(r2, radial_coeffs);
+    auto const d_icD = gradient_icD(r2, icD_den, icD_num, radial_coeffs);
+    auto const d_den =
+        tinyrend::math::eval_poly_horner<3, T>({k4, 2.f * k5, 3.f * k6}, r2);
+    auto const dd_num = 2.f * k2 + 6.f * k3 * r2;
+    auto const dd_den = 2.f * k5 + 6.f * k6 * r2;
+    auto const dd_icD =
+        (dd_num - icD * dd_den) / icD_den - 2.f * d_den * d_icD / icD_den;
+    auto const trace = v_D[0][0] + v_D[1][1];
+    auto const xGx = glm::dot(xy, v_D * xy);
+    auto v_xy = (2.f * d_icD * trace + 4.f * dd_icD * xGx) * xy +
+                2.f * d_icD * (v_D * xy + glm::transpose(v_D) * xy);
+
+    // second derivatives of the tangential and thin prism shift
+    auto const &[p1, p2] = tangential_coeffs;
+    auto const &[s1, s2, s3, s4] = thin_prism_coeffs;
+    auto const a = 2.f * (s1 + 2.f * s2 * r2), b = 2.f * (s3 + 2.f * s4 * r2);
+    auto const xx = xy[0] * xy[0], xy_ = xy[0] * xy[1], yy = xy[1] * xy[1];
+    auto const H_x = glm::mat<2, 2, T>{
+        6.f * p2 + a + 8.f * s2 * xx,
+        2.f * p1 + 8.f * s2 * xy_,
+        2.f * p1 + 8.f * s2 * xy_,
+        2.f * p2 + a + 8.f * s2 * yy,
+    };
+    auto const H_y = glm::mat<2, 2, T>{
+        2.f * p1 + b + 8.f * s4 * xx,
+        2.f * p2 + 8.f * s4 * xy_,
+        2.f * p2 + 8.f * s4 * xy_,
+        6.f * p1 + b + 8.f * s4 * yy,
+    };
+    // row i of v_D pairs with the Hessian of delta_i
+    v_xy += H_x * glm::vec<2, T>(v_D[0][0], v_D[1][0]) +
+            H_y * glm::vec<2, T>(v_D[0][1], v_D[1][1]);
+
+    // chain through xy = A * p
+    v_camera_point += glm::transpose(A) * v_xy;
+    return v_camera_point;
+}
+
 /// \brief Unproject a 2D point from image space to camera space
 /// using pinhole projection
 /// \param image_point 2D point in image space
 /// \param focal_length Focal length in pixels (fx, fy)
 /// \param principal_point Principal point in pixels (cx, cy)
 /// \return ray direction in camera space
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto unproject(
-    glm::fvec2 const &image_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &principal_point
-) -> glm::fvec3 {
+    glm::vec<2, T> const &image_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &principal_point
+) -> glm::vec<3, T> {
     auto const uv = (image_point - principal_point) / focal_length;
-    auto const dir = glm::fvec3{uv[0], uv[1], 1.0f};
+    auto const dir = glm::vec<3, T>{uv[0], uv[1], 1.0f};
     // normalize
     return glm::normalize(dir);
 }
@@ -433,16 +547,17 @@ GSPLAT_HOST_DEVICE inline auto unproject(
 /// \param max_radial_dist Maximum radial distortion threshold for numerical stability.
 /// Default value is max float.
 /// \return Pair of ray direction and validity flag
+template <typename T = float>
 GSPLAT_HOST_DEVICE inline auto unproject(
-    glm::fvec2 const &image_point,
-    glm::fvec2 const &focal_length,
-    glm::fvec2 const &principal_point,
-    std::array<float, 6> const &radial_coeffs,
-    std::array<float, 2> const &tangential_coeffs,
-    std::array<float, 4> const &thin_prism_coeffs,
-    float const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
-    float const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
-) -> std::pair<glm::fvec3, bool> {
+    glm::vec<2, T> const &image_point,
+    glm::vec<2, T> const &focal_length,
+    glm::vec<2, T> const &principal_point,
+    std::array<T, 6> const &radial_coeffs,
+    std::array<T, 2> const &tangential_coeffs,
+    std::array<T, 4> const &thin_prism_coeffs,
+    type_identity_t<T> const &min_radial_dist = DEFAULT_MIN_RADIAL_DIST,
+    type_identity_t<T> const &max_radial_dist = DEFAULT_MAX_RADIAL_DIST
+) -> std::pair<glm::vec<3, T>, bool> {
     auto const uv = (image_point - principal_point) / focal_length;
     auto const &[xy, valid_flag] = undistortion(
         uv,
@@ -453,8 +568,8 @@ GSPLAT_HOST_DEVICE inline auto unproject(
         max_radial_dist
     );
     if (!valid_flag)
-        return {glm::fvec3{}, false};
-    auto const dir = glm::fvec3{xy[0], xy[1], 1.0f};
+        return {glm::vec<3, T>{}, false};
+    auto const dir = glm::vec<3, T>{xy[0], xy[1], 1.0f};
     // normalize
     return {glm::normalize(dir), true};
 }
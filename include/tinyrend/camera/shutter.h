@@ -55,6 +55,107 @@ GSPLAT_HOST_DEVICE inline auto relative_frame_time(
     return t;
 }
 
+/// \brief Compute the gradient of the relative frame time w.r.t. the image point
+/// \details Treats the exposure time as continuous in the image coordinate, i.e.
+/// ignores the per-row quantization of `relative_frame_time`.
+/// \param resolution Image resolution (width, height)
+/// \param shutter_type Type of shutter being used
+/// \return d(t) / d(image_point), zero for a global shutter
+GSPLAT_HOST_DEVICE inline auto relative_frame_time_grad(
+    const std::array<uint32_t, 2> &resolution, const Type &shutter_type
+) -> glm::fvec2 {
+    auto const inv_w = 1.f / (resolution[0] - 1);
+    auto const inv_h = 1.f / (resolution[1] - 1);
+    switch (shutter_type) {
+    case Type::ROLLING_TOP_TO_BOTTOM:
+        return {0.f, inv_h};
+    case Type::ROLLING_LEFT_TO_RIGHT:
+        return {inv_w, 0.f};
+    case Type::ROLLING_BOTTOM_TO_TOP:
+        return {0.f, -inv_h};
+    case Type::ROLLING_RIGHT_TO_LEFT:
+        return {-inv_w, 0.f};
+    default:
+        return {0.f, 0.f};
+    }
+}
+
+/// \brief Compute the velocity of a camera-space point during the exposure
+/// \details The poses are interpolated as in `se3::interpolate`, i.e.
+/// R(t) = R_start Exp(t phi) with phi the rotation vector of R_startᵀ R_end,
+/// and a linear translation. Hence d(R(t) x + t(t)) / dt = R(t) (phi × x) +
+/// (t_end - t_start).
+/// \param world_point 3D point in world space
+/// \param pose_r Camera rotation at exposure time
+/// \param pose_r_start Camera rotation at start of frame
+/// \param pose_t_start Camera translation at start of frame
+/// \param pose_r_end Camera rotation at end of frame
+/// \param pose_t_end Camera translation at end of frame
+/// \return d(camera_point) / d(t)
+GSPLAT_HOST_DEVICE inline auto camera_point_velocity(
+    const glm::fvec3 &world_point,
+    const glm::fmat3 &pose_r,
+    const glm::fmat3 &pose_r_start,
+    const glm::fvec3 &pose_t_start,
+    const glm::fmat3 &pose_r_end,
+    const glm::fvec3 &pose_t_end
+) -> glm::fvec3 {
+    // rotation vector of the relative rotation (log map)
+    auto const R_rel = glm::transpose(pose_r_start) * pose_r_end;
+    auto const axis = glm::fvec3(
+        R_rel[1][2] - R_rel[2][1], R_rel[2][0] - R_rel[0][2], R_rel[0][1] - R_rel[1][0]
+    ); // 2 sin(angle) * unit axis
+    auto const cos_angle =
+        std::clamp(0.5f * (R_rel[0][0] + R_rel[1][1] + R_rel[2][2] - 1.f), -1.f, 1.f);
+    auto const angle = std::acos(cos_angle);
+    auto const sin_angle = std::sin(angle);
+    auto const phi =
+        sin_angle > 1e-6f ? axis * (0.5f * angle / sin_angle) : 0.5f * axis;
+    return pose_r * glm::cross(phi, world_point) + (pose_t_end - pose_t_start);
+}
+
+/// \brief Compute the correction of the image Jacobian for the coupling between
+/// exposure time and image point
+/// \details The image point u solves u = project(R(t) x + t(t)) with
+/// t = time(u). Differentiating through this fixed point gives
+/// (I - b gᵀ) du = J dp, with b = J v the image velocity and g the frame time
+/// gradient, so du = A J dp with A = I + b gᵀ / (1 - gᵀ b). When gᵀ b >= 1 the
+/// fixed point is not attracting and the identity is returned.
+/// \param project_jac Jacobian of the camera projection at the camera point
+/// \param velocity Camera point velocity, see `camera_point_velocity`
+/// \param time_grad Frame time gradient, see `relative_frame_time_grad`
+/// \return The 2x2 correction A
+GSPLAT_HOST_DEVICE inline auto rolling_shutter_correction(
+    const glm::fmat3x2 &project_jac,
+    const glm::fvec3 &velocity,
+    const glm::fvec2 &time_grad
+) -> glm::fmat2 {
+    auto const b = project_jac * velocity;
+    auto const denom = 1.f - glm::dot(time_grad, b);
+    if (!(denom > 1e-6f)) {
+        return glm::fmat2(1.f);
+    }
+    return glm::fmat2(1.f) + glm::outerProduct(b, time_grad) / denom;
+}
+
+/// \brief Compute the Jacobian of the rolling-shutter projection w.r.t. the
+/// world point: d(image_point) / d(world_point) = A J R, see
+/// `rolling_shutter_correction`
+/// \param project_jac Jacobian of the camera projection at the camera point
+/// \param pose_r Camera rotation at exposure time
+/// \param velocity Camera point velocity, see `camera_point_velocity`
+/// \param time_grad Frame time gradient, see `relative_frame_time_grad`
+/// \return d(image_point) / d(world_point)
+GSPLAT_HOST_DEVICE inline auto rolling_shutter_jac(
+    const glm::fmat3x2 &project_jac,
+    const glm::fmat3 &pose_r,
+    const glm::fvec3 &velocity,
+    const glm::fvec2 &time_grad
+) -> glm::fmat3x2 {
+    return rolling_shutter_correction(project_jac, velocity, time_grad) *
+           (project_jac * pose_r);
+}
+
 /// \brief Result structure for point_world_to_image function
 /// \tparam RotationType Type of rotation representation (glm::fmat3 or glm::fquat)
 template <typename RotationType> struct PointWorldToImageResult {
@@ -124,6 +225,9 @@ GSPLAT_HOST_DEVICE inline auto point_world_to_image(
     }
 
     // Iterate to converge to the correct image point
+    auto const interpolate_pose = tinyrend::se3::PoseInterpolator<RotationType>(
+        pose_r_start, pose_t_start, pose_r_end, pose_t_end
+    );
     auto image_point_rs = init_image_point;
     glm::fvec3 camera_point_rs;
     bool valid_flag_rs;
@@ -132,9 +236,7 @@ GSPLAT_HOST_DEVICE inline auto point_world_to_image(
 #pragma unroll
     for (auto j = 0; j < N_ITER; ++j) {
         auto const t = relative_frame_time(image_point_rs, resolution, shutter_type);
-        std::tie(pose_r_rs, pose_t_rs) = tinyrend::se3::interpolate(
-            t, pose_r_start, pose_t_start, pose_r_end, pose_t_end
-        );
+        std::tie(pose_r_rs, pose_t_rs) = interpolate_pose(t);
         camera_point_rs =
             tinyrend::se3::transform_point(pose_r_rs, pose_t_rs, world_point);
         std::tie(image_point_rs, valid_flag_rs) = project_fn(camera_point_rs);
@@ -148,4 +250,92 @@ GSPLAT_HOST_DEVICE inline auto point_world_to_image(
     };
 }
 
+/// \brief Camera poses sampled per image row (or column) of a rolling shutter
+/// \details A non-owning view, e.g. of the tables built by
+/// `trajectory::PoseTableStorage`. Entry `i` holds the world-to-camera pose at
+/// relative frame time i / (n_rows - 1), so with one entry per image row (per
+/// column for horizontal shutters) a lookup returns the exact exposure pose.
+/// `n_rows` must be at least 1; `PoseTableStorage::view` rejects empty tables.
+struct PoseTable {
+    const glm::fmat3 *rotations = nullptr;    ///< [n_rows]
+    const glm::fvec3 *translations = nullptr; ///< [n_rows]
+    uint32_t n_rows = 0;
+    std::array<uint32_t, 2> resolution = {0, 0}; ///< Image resolution (width, height)
+    Type shutter_type = Type::GLOBAL;
+
+    /// \brief Look up the pose at which an image point is exposed
+    /// \param image_point 2D point in image space
+    /// \return Pair of rotation and translation
+    GSPLAT_HOST_DEVICE auto operator()(const glm::fvec2 &image_point) const
+        -> std::pair<glm::fmat3, glm::fvec3> {
+        auto const t = relative_frame_time(image_point, resolution, shutter_type);
+        auto const row = std::clamp(t, 0.f, 1.f) * float(n_rows - 1) + 0.5f;
+        auto const i = std::min(static_cast<uint32_t>(row), n_rows - 1);
+        return {rotations[i], translations[i]};
+    }
+};
+
+/// \brief Project a world point to an image point using a per-row pose table
+/// \details Same fixed-point solve as the two-pose version, but each iteration
+/// is a table lookup regardless of how the trajectory was represented.
+/// \tparam N_ITER Number of iterations for convergence
+/// \tparam Func Type of projection function
+/// \param project_fn Function to project a camera point to an image point
+/// \param world_point 3D point in world space
+/// \param poses Pose table of the frame
+/// \return PointWorldToImageResult containing the projected results
+template <size_t N_ITER = 10, typename Func>
+GSPLAT_HOST_DEVICE inline auto point_world_to_image(
+    Func project_fn, const glm::fvec3 &world_point, const PoseTable &poses
+) -> PointWorldToImageResult<glm::fmat3> {
+    // Initialize with the first exposed row, or the last one
+    glm::fvec2 image_point_rs;
+    bool valid_flag_rs = false;
+    for (auto const i : {0u, poses.n_rows - 1}) {
+        auto const camera_point = tinyrend::se3::transform_point(
+            poses.rotations[i], poses.translations[i], world_point
+        );
+        std::tie(image_point_rs, valid_flag_rs) = project_fn(camera_point);
+        if (valid_flag_rs)
+            break;
+    }
+    if (!valid_flag_rs) {
+        return PointWorldToImageResult<glm::fmat3>{};
+    }
+
+    glm::fvec3 camera_point_rs;
+    glm::fmat3 pose_r_rs;
+    glm::fvec3 pose_t_rs;
+#pragma unroll
+    for (size_t j = 0; j < N_ITER; ++j) {
+        std::tie(pose_r_rs, pose_t_rs) = poses(image_point_rs);
+        camera_point_rs =
+            tinyrend::se3::transform_point(pose_r_rs, pose_t_rs, world_point);
+        std::tie(image_point_rs, valid_flag_rs) = project_fn(camera_point_rs);
+        if (!valid_flag_rs) {
+            return PointWorldToImageResult<glm::fmat3>{};
+        }
+    }
+    return PointWorldToImageResult<glm::fmat3>{
+        image_point_rs, camera_point_rs, pose_r_rs, pose_t_rs, true
+    };
+}
+
+/// \brief Transform the camera ray of an image point to world space, using
+/// the pose at which that point is exposed
+/// \param poses Pose table of the frame
+/// \param image_point 2D point in image space
+/// \param camera_ray_o Ray origin in camera space (e.g. from `unproject`)
+/// \param camera_ray_d Ray direction in camera space
+/// \return Tuple of ray origin and direction in world space
+GSPLAT_HOST_DEVICE inline auto image_point_to_world_ray(
+    const PoseTable &poses,
+    const glm::fvec2 &image_point,
+    const glm::fvec3 &camera_ray_o,
+    const glm::fvec3 &camera_ray_d
+) -> std::tuple<glm::fvec3, glm::fvec3> {
+    auto const [pose_r, pose_t] = poses(image_point);
+    return tinyrend::se3::invtransform_ray(pose_r, pose_t, camera_ray_o, camera_ray_d);
+}
+
 } // namespace tinyrend::camera::shutter
\ No newline at end of file
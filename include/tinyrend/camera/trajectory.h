@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "tinyrend/camera/shutter.h"
+#include "tinyrend/core/macros.h" // for GSPLAT_HOST_DEVICE
+#include "tinyrend/core/se3.h"
+
+namespace tinyrend::camera::trajectory {
+
+/*
+    Continuous-time camera trajectories for rolling shutters.
+
+    A trajectory is a uniform cumulative cubic B-spline over N >= 4 pose
+    knots (world-to-camera, knot k at time t0 + k * dt). Rotation and
+    translation are splined separately (SO(3) x R^3):
+
+        q(u) = q_{i-1} * prod_{j=1..3} exp(B_j(u) * log(q_{i+j-2}^-1 q_{i+j-1}))
+        p(u) = p_{i-1} + sum_{j=1..3} B_j(u) * (p_{i+j-1} - p_{i+j-2})
+
+    with the cumulative basis B_1 = (5 + 3u - 3u^2 + u^3) / 6,
+    B_2 = (1 + 3u + 3u^2 - 2u^3) / 6 and B_3 = u^3 / 6. The curve is C2 and
+    defined on [t0 + dt, t0 + (N - 2) dt]; times outside are clamped.
+
+    Evaluating the spline costs three quaternion exp/log per call, so a frame
+    samples it once per image row into a `shutter::PoseTable`, and the
+    per-point fixed-point solve and ray generation only do table lookups.
+*/
+
+/// \brief Quaternion logarithm: half the rotation vector (shortest path)
+GSPLAT_HOST_DEVICE inline auto quat_log(glm::fquat q) -> glm::fvec3 {
+    if (q.w < 0.f) {
+        q = -q;
+    }
+    auto const v = glm::fvec3(q.x, q.y, q.z);
+    auto const norm = glm::length(v);
+    if (norm < 1e-8f) {
+        return v;
+    }
+    return v * (std::atan2(norm, q.w) / norm);
+}
+
+/// \brief Quaternion exponential of a pure quaternion (half rotation vector)
+GSPLAT_HOST_DEVICE inline auto quat_exp(const glm::fvec3 &v) -> glm::fquat {
+    auto const norm = glm::length(v);
+    if (norm < 1e-8f) {
+        return glm::normalize(glm::fquat(1.f, v.x, v.y, v.z));
+    }
+    auto const s = std::sin(norm) / norm;
+    return glm::fquat(std::cos(norm), v.x * s, v.y * s, v.z * s);
+}
+
+/// \brief Uniform cumulative cubic B-spline trajectory in SO(3) x R^3
+class BSplineTrajectory {
+  public:
+    /// \param rotations Knot rotations, world-to-camera [N]
+    /// \param translations Knot translations, world-to-camera [N]
+    /// \param t0 Time of the first knot
+    /// \param dt Time between knots (> 0)
+    /// \throws std::invalid_argument on fewer than 4 knots, mismatched sizes or
+    /// non-positive dt
+    BSplineTrajectory(
+        std::vector<glm::fquat> rotations,
+        std::vector<glm::fvec3> translations,
+        float t0,
+        float dt
+    )
+        : rotations_(std::move(rotations)), translations_(std::move(translations)),
+          t0_(t0), dt_(dt) {
+        if (rotations_.size() < 4 || rotations_.size() != translations_.size())
+            throw std::invalid_argument(
+                "a cubic B-spline trajectory needs at least 4 knots"
+            );
+        if (!(dt_ > 0.f))
+            throw std::invalid_argument("knot spacing must be positive");
+        // log of the relative rotations between consecutive knots
+        deltas_.resize(rotations_.size() - 1);
+        for (size_t k = 0; k + 1 < rotations_.size(); ++k)
+            deltas_[k] = quat_log(glm::conjugate(rotations_[k]) * rotations_[k + 1]);
+    }
+
+    /// \brief Start of the valid time range
+    auto t_min() const -> float { return t0_ + dt_; }
+
+    /// \brief End of the valid time range
+    auto t_max() const -> float { return t0_ + float(rotations_.size() - 2) * dt_; }
+
+    /// \brief Evaluate the pose at time `t` (clamped to [t_min, t_max])
+    /// \return Pair of rotation matrix and translation
+    auto evaluate(float t) const -> std::pair<glm::fmat3, glm::fvec3> {
+        auto const s = (std::clamp(t, t_min(), t_max()) - t0_) / dt_;
+        // segment i uses knots i-1 .. i+2
+        auto const i = std::clamp<size_t>(size_t(s), 1, rotations_.size() - 3);
+        auto const u = s - float(i);
+        auto const u2 = u * u, u3 = u2 * u;
+        const float B[3] = {
+            (5.f + 3.f * u - 3.f * u2 + u3) / 6.f,
+            (1.f + 3.f * u + 3.f * u2 - 2.f * u3) / 6.f,
+            u3 / 6.f,
+        };
+        auto rot = rotations_[i - 1];
+        auto transl = translations_[i - 1];
+        for (size_t j = 0; j < 3; ++j) {
+            rot = rot * quat_exp(B[j] * deltas_[i - 1 + j]);
+            transl += B[j] * (translations_[i + j] - translations_[i - 1 + j]);
+        }
+        return {glm::mat3_cast(glm::normalize(rot)), transl};
+    }
+
+  private:
+    std::vector<glm::fquat> rotations_;
+    std::vector<glm::fvec3> translations_;
+    std::vector<glm::fvec3> deltas_; // [N - 1]
+    float t0_;
+    float dt_;
+};
+
+/// \brief Owning per-row pose table of one frame
+struct PoseTableStorage {
+    std::vector<glm::fmat3> rotations;
+    std::vector<glm::fvec3> translations;
+    std::array<uint32_t, 2> resolution = {0, 0};
+    shutter::Type shutter_type = shutter::Type::GLOBAL;
+
+    /// \brief Non-owning view for `shutter::point_world_to_image` (host memory)
+    /// \throws std::invalid_argument if the table is empty or the rotation and
+    /// translation counts differ
+    auto view() const -> shutter::PoseTable {
+        if (rotations.empty() || rotations.size() != translations.size())
+            throw std::invalid_argument(
+                "a pose table needs at least one row and one translation per rotation"
+            );
+        return {
+            rotations.data(),
+            translations.data(),
+            static_cast<uint32_t>(rotations.size()),
+            resolution,
+            shutter_type
+        };
+    }
+};
+
+/// \brief Sample a trajectory once per exposed image row (or column)
+/// \param trajectory Camera trajectory
+/// \param t_start Time at which the first row is exposed
+/// \param t_end Time at which the last row is exposed
+/// \param resolution Image resolution (width, height)
+/// \param shutter_type Rolling shutter direction
+/// \return Pose table with one entry per row of the shutter direction (a single
+/// entry at `t_start` for a global shutter)
+inline auto build_pose_table(
+    const BSplineTrajectory &trajectory,
+    float t_start,
+    float t_end,
+    const std::array<uint32_t, 2> &resolution,
+    shutter::Type shutter_type
+) -> PoseTableStorage {
+    PoseTableStorage table;
+    table.resolution = resolution;
+    table.shutter_type = shutter_type;
+    uint32_t n_rows = 1;
+    if (shutter_type == shutter::Type::ROLLING_TOP_TO_BOTTOM ||
+        shutter_type == shutter::Type::ROLLING_BOTTOM_TO_TOP) {
+        n_rows = resolution[1];
+    } else if (shutter_type != shutter::Type::GLOBAL) {
+        n_rows = resolution[0];
+    }
+    n_rows = std::max<uint32_t>(n_rows, 1);
+    table.rotations.resize(n_rows);
+    table.translations.resize(n_rows);
+    for (uint32_t r = 0; r < n_rows; ++r) {
+        auto const ratio = n_rows > 1 ? float(r) / float(n_rows - 1) : 0.f;
+        std::tie(table.rotations[r], table.translations[r]) =
+            trajectory.evaluate(t_start + ratio * (t_end - t_start));
+    }
+    return table;
+}
+
+} // namespace tinyrend::camera::trajectory
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__CUDACC__)
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+#endif
+
+#if !defined(__CUDA_ARCH__) && (defined(__SSE2__) || defined(__F16C__))
+#include <immintrin.h>
+#endif
+
+#include "tinyrend/core/macros.h"
+#include "tinyrend/kernel_launcher.cuh"
+
+namespace tinyrend {
+
+/*
+    16-bit storage types for feature buffers.
+
+    `f16` (IEEE binary16) and `bf16` (bfloat16) only hold the bits; they
+    convert implicitly from and to float with round-to-nearest-even, so
+    kernels load them into fp32 registers, accumulate in fp32 and round once
+    on store. f16 keeps 11 bits of mantissa but saturates at 65504; bf16 keeps
+    the fp32 range with 8 bits of mantissa, which suits unnormalized neural
+    features and gradients.
+
+    Gradients summed over many pixels must not be accumulated in 16 bits:
+    every add would round the running sum, and small contributions vanish.
+    Backward passes accumulate into an fp32 buffer instead, which
+    `round_accumulator` rounds to the storage type once at the end.
+
+    On device the conversions use the CUDA intrinsics. On CPU, the bulk
+    converters in `tinyrend::precision` use F16C / AVX-512 (f16) and
+    AVX-512 BF16 / SSE2 (bf16) when the translation unit is compiled for
+    them, and a scalar bit-exact fallback otherwise.
+*/
+
+namespace precision::detail {
+
+inline GSPLAT_HOST_DEVICE auto float_bits(float f) -> uint32_t {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline GSPLAT_HOST_DEVICE auto bits_float(uint32_t u) -> float {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+inline GSPLAT_HOST_DEVICE auto float_to_f16_bits(float f) -> uint16_t {
+#if defined(__CUDA_ARCH__)
+    return __half_as_ushort(__float2half_rn(f));
+#else
+    uint32_t u = float_bits(f);
+    const uint32_t sign = (u >> 16) & 0x8000u;
+    u &= 0x7fffffffu;
+    uint32_t h;
+    if (u >= 0x47800000u) {
+        // >= 65536, inf or nan
+        h = u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    } else if (u < 0x38800000u) {
+        // subnormal half: let the fp32 adder round at the 2^-24 position
+        h = float_bits(bits_float(u) + 0.5f) - 0x3f000000u;
+    } else {
+        // rebias the exponent and round the 13 dropped bits to nearest even
+        const uint32_t odd = (u >> 13) & 1u;
+        h = (u + 0xc8000fffu + odd) >> 13;
+    }
+    return uint16_t(h | sign);
+#endif
+}
+
+inline GSPLAT_HOST_DEVICE auto f16_bits_to_float(uint16_t h) -> float {
+#if defined(__CUDA_ARCH__)
+    return __half2float(__ushort_as_half(h));
+#else
+    uint32_t u = uint32_t(h & 0x7fffu) << 13;
+    const uint32_t exponent = u & 0x0f800000u;
+    u += 0x38000000u; // 127 - 15
+    float f;
+    if (exponent == 0x0f800000u) {
+        f = bits_float(u + 0x38000000u); // inf or nan
+    } else if (exponent == 0) {
+        f = bits_float(u + 0x00800000u) - bits_float(0x38800000u); // subnormal
+    } else {
+        f = bits_float(u);
+    }
+    return bits_float(float_bits(f) | uint32_t(h & 0x8000u) << 16);
+#endif
+}
+
+inline GSPLAT_HOST_DEVICE auto float_to_bf16_bits(float f) -> uint16_t {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+    return __bfloat16_as_ushort(__float2bfloat16_rn(f));
+#else
+    const uint32_t u = float_bits(f);
+    if ((u & 0x7fffffffu) > 0x7f800000u)
+        return uint16_t((u >> 16) | 0x40u); // keep nan quiet
+    return uint16_t((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+#endif
+}
+
+inline GSPLAT_HOST_DEVICE auto bf16_bits_to_float(uint16_t b) -> float {
+    return bits_float(uint32_t(b) << 16);
+}
+
+} // namespace precision::detail
+
+/// \brief IEEE binary16 storage.
+struct f16 {
+    uint16_t bits;
+
+    f16() = default;
+    GSPLAT_HOST_DEVICE f16(float f) : bits(precision::detail::float_to_f16_bits(f)) {}
+    GSPLAT_HOST_DEVICE operator float() const {
+        return precision::detail::f16_bits_to_float(bits);
+    }
+};
+
+/// \brief bfloat16 storage (the upper half of an fp32).
+struct bf16 {
+    uint16_t bits;
+
+    bf16() = default;
+    GSPLAT_HOST_DEVICE bf16(float f) : bits(precision::detail::float_to_bf16_bits(f)) {}
+    GSPLAT_HOST_DEVICE operator float() const {
+        return precision::detail::bf16_bits_to_float(bits);
+    }
+};
+
+static_assert(sizeof(f16) == 2 && sizeof(bf16) == 2, "16-bit storage types");
+
+namespace precision {
+
+/// \brief Widen `n` f16 values to float.
+inline void to_float(const f16 *in, float *out, size_t n) {
+    size_t i = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX512F__)
+    for (; i + 16 <= n; i += 16) {
+        auto const h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+    }
+#elif !defined(__CUDA_ARCH__) && defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        auto const h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = float(in[i]);
+}
+
+/// \brief Round `n` floats to f16 (nearest even).
+inline void from_float(const float *in, f16 *out, size_t n) {
+    size_t i = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX512F__)
+    for (; i + 16 <= n; i += 16) {
+        auto const h =
+            _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), h);
+    }
+#elif !defined(__CUDA_ARCH__) && defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        auto const h =
+            _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = f16(in[i]);
+}
+
+/// \brief Widen `n` bf16 values to float.
+inline void to_float(const bf16 *in, float *out, size_t n) {
+    size_t i = 0;
+#if !defined(__CUDA_ARCH__) && defined(__SSE2__)
+    // bf16 is the upper half of an fp32: interleave with zero low halves
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        auto const b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(out + i), _mm_unpacklo_epi16(zero, b)
+        );
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(out + i + 4), _mm_unpackhi_epi16(zero, b)
+        );
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = float(in[i]);
+}
+
+/// \brief Round `n` floats to bf16 (nearest even).
+inline void from_float(const float *in, bf16 *out, size_t n) {
+    size_t i = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX512BF16__)
+    for (; i + 16 <= n; i += 16) {
+        auto const b = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i));
+        std::memcpy(out + i, &b, sizeof(b));
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = bf16(in[i]);
+}
+
+inline void to_float(const float *in, float *out, size_t n) {
+    if (in != out)
+        std::memcpy(out, in, n * sizeof(float));
+}
+
+inline void from_float(const float *in, float *out, size_t n) { to_float(in, out, n); }
+
+/// \brief Round the fp32 accumulator `acc[0, n)` to the storage type `out`, once.
+template <bool USE_CUDA, typename T>
+void round_accumulator(const float *acc, T *out, size_t n) {
+    if constexpr (USE_CUDA) {
+        tinyrend::launch_linear_kernel<true>(
+            n, [acc, out] GSPLAT_HOST_DEVICE(size_t i) { out[i] = T(acc[i]); }
+        );
+    } else {
+        thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+            from_float(acc + begin, out + begin, end - begin);
+        });
+    }
+}
+
+} // namespace precision
+
+} // namespace tinyrend
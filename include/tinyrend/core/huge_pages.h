@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace tinyrend::huge_pages {
+
+/// \brief Backing of large host buffers (scene attributes, intersection lists).
+///
+/// Gaussian attributes and intersection lists are gathered by primitive id,
+/// so a multi-GB buffer touches far more 4 KiB pages than the TLB can cover.
+/// Backing it with 2 MiB pages divides the number of TLB entries it needs by
+/// 512.
+///
+/// - OFF: regular pages.
+/// - TRANSPARENT: 2 MiB aligned and advised with `madvise(MADV_HUGEPAGE)`;
+///   the kernel backs it with huge pages when THP is in "madvise" or
+///   "always" mode and contiguous memory is available.
+/// - EXPLICIT: `MAP_HUGETLB` pages from the hugetlbfs pool
+///   (`vm.nr_hugepages`); falls back to TRANSPARENT if the pool is empty.
+///
+/// Every mode falls back to regular pages silently, so it is always safe to
+/// request huge pages.
+enum class Mode { OFF, TRANSPARENT, EXPLICIT };
+
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+constexpr size_t SMALL_PAGE_SIZE = 4096;
+
+inline constexpr auto round_up(size_t bytes, size_t alignment) -> size_t {
+    return (bytes + alignment - 1) / alignment * alignment;
+}
+
+/// \brief Parse a mode name: "off", "thp" / "transparent", "hugetlb" /
+/// "explicit". Unknown names map to OFF.
+inline auto parse_mode(const char *name) -> Mode {
+    if (name == nullptr)
+        return Mode::OFF;
+    if (std::strcmp(name, "thp") == 0 || std::strcmp(name, "transparent") == 0)
+        return Mode::TRANSPARENT;
+    if (std::strcmp(name, "hugetlb") == 0 || std::strcmp(name, "explicit") == 0)
+        return Mode::EXPLICIT;
+    return Mode::OFF;
+}
+
+/// \brief Process-wide default, set with TINYREND_HUGE_PAGES (default "off").
+inline auto default_mode() -> Mode {
+    static const Mode mode = parse_mode(std::getenv("TINYREND_HUGE_PAGES"));
+    return mode;
+}
+
+/// \brief Advise the kernel to back the 2 MiB aligned part of
+/// [ptr, ptr + bytes) with transparent huge pages. Call before first touch.
+/// \return Whether the advice was accepted
+inline auto advise(void *ptr, size_t bytes) -> bool {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    auto const begin = round_up(reinterpret_cast<size_t>(ptr), HUGE_PAGE_SIZE);
+    auto const end = (reinterpret_cast<size_t>(ptr) + bytes) / HUGE_PAGE_SIZE *
+                     HUGE_PAGE_SIZE;
+    if (end <= begin)
+        return false;
+    return madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE) == 0;
+#else
+    (void)ptr;
+    (void)bytes;
+    return false;
+#endif
+}
+
+/// \brief Allocate `bytes` with `std::aligned_alloc` so it can be released
+/// with `std::free`. Buffers of at least one huge page are 2 MiB aligned and
+/// advised when `mode` is not OFF (EXPLICIT is treated as TRANSPARENT: the
+/// hugetlbfs pool cannot back malloc'ed memory).
+inline auto aligned_alloc(size_t bytes, Mode mode = default_mode()) -> void * {
+    const bool huge = mode != Mode::OFF && bytes >= HUGE_PAGE_SIZE;
+    const size_t alignment = huge ? HUGE_PAGE_SIZE : SMALL_PAGE_SIZE;
+    const size_t size = round_up(std::max<size_t>(bytes, 1), alignment);
+    void *ptr = std::aligned_alloc(alignment, size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    if (huge)
+        advise(ptr, size);
+    return ptr;
+}
+
+/// \brief Anonymous memory mapping backed according to a `Mode`.
+///
+/// `backing()` reports what was actually obtained after fallbacks
+/// (TRANSPARENT means the advice was accepted, not that the kernel found
+/// contiguous memory; see /proc/self/smaps for AnonHugePages).
+class Buffer {
+  public:
+    Buffer() = default;
+
+    /// \brief Map `bytes` of zeroed memory.
+    /// \throws std::bad_alloc if no memory can be mapped at all
+    static Buffer allocate(size_t bytes, Mode mode = default_mode()) {
+        Buffer b;
+        if (bytes == 0)
+            return b;
+#ifdef __linux__
+#ifdef MAP_HUGETLB
+        if (mode == Mode::EXPLICIT) {
+            const size_t size = round_up(bytes, HUGE_PAGE_SIZE);
+            void *ptr = mmap(
+                nullptr,
+                size,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                -1,
+                0
+            );
+            if (ptr != MAP_FAILED)
+                return Buffer(ptr, size, Mode::EXPLICIT);
+        }
+#endif
+        if (mode != Mode::OFF && bytes >= HUGE_PAGE_SIZE) {
+            // Over-reserve by one huge page and trim to a 2 MiB boundary.
+            const size_t size = round_up(bytes, HUGE_PAGE_SIZE);
+            void *raw = mmap(
+                nullptr,
+                size + HUGE_PAGE_SIZE,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS,
+                -1,
+                0
+            );
+            if (raw != MAP_FAILED) {
+                auto *base = static_cast<char *>(raw);
+                auto *ptr = reinterpret_cast<char *>(
+                    round_up(reinterpret_cast<size_t>(base), HUGE_PAGE_SIZE)
+                );
+                if (ptr > base)
+                    munmap(base, size_t(ptr - base));
+                const size_t tail = size_t(base + HUGE_PAGE_SIZE - ptr);
+                if (tail > 0)
+                    munmap(ptr + size, tail);
+                const bool advised = advise(ptr, size);
+                return Buffer(ptr, size, advised ? Mode::TRANSPARENT : Mode::OFF);
+            }
+        }
+        const size_t size = round_up(bytes, SMALL_PAGE_SIZE);
+        void *ptr = mmap(
+            nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+        );
+        if (ptr == MAP_FAILED)
+            throw std::bad_alloc();
+        return Buffer(ptr, size, Mode::OFF);
+#else
+        (void)mode;
+        void *ptr = std::calloc(1, bytes);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return Buffer(ptr, bytes, Mode::OFF);
+#endif
+    }
+
+    ~Buffer() { reset(); }
+
+    Buffer(Buffer &&o) noexcept
+        : data_(std::exchange(o.data_, nullptr)), bytes_(std::exchange(o.bytes_, 0)),
+          backing_(o.backing_) {}
+    Buffer &operator=(Buffer &&o) noexcept {
+        if (this != &o) {
+            reset();
+            data_ = std::exchange(o.data_, nullptr);
+            bytes_ = std::exchange(o.bytes_, 0);
+            backing_ = o.backing_;
+        }
+        return *this;
+    }
+    Buffer(const Buffer &) = delete;
+    Buffer &operator=(const Buffer &) = delete;
+
+    void *data() const { return data_; }
+    /// \brief Mapped size (the request rounded up to the page size).
+    size_t size() const { return bytes_; }
+    Mode backing() const { return backing_; }
+
+    void reset() {
+        if (data_ != nullptr) {
+#ifdef __linux__
+            munmap(data_, bytes_);
+#else
+            std::free(data_);
+#endif
+        }
+        data_ = nullptr;
+        bytes_ = 0;
+        backing_ = Mode::OFF;
+    }
+
+  private:
+    Buffer(void *data, size_t bytes, Mode backing)
+        : data_(data), bytes_(bytes), backing_(backing) {}
+
+    void *data_ = nullptr;
+    size_t bytes_ = 0;
+    Mode backing_ = Mode::OFF;
+};
+
+/// \brief STL allocator for large temporary arrays (e.g. intersection lists):
+/// allocations of at least one huge page go through `aligned_alloc` with the
+/// allocator's mode, smaller ones through `std::malloc`.
+template <typename T> struct Allocator {
+    using value_type = T;
+
+    Mode mode = default_mode();
+
+    Allocator() = default;
+    explicit Allocator(Mode m) : mode(m) {}
+    template <typename U> Allocator(const Allocator<U> &o) : mode(o.mode) {}
+
+    T *allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (bytes >= HUGE_PAGE_SIZE)
+            return static_cast<T *>(huge_pages::aligned_alloc(bytes, mode));
+        void *ptr = std::malloc(std::max<size_t>(bytes, 1));
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T *>(ptr);
+    }
+    void deallocate(T *p, size_t) { std::free(p); }
+
+    template <typename U> bool operator==(const Allocator<U> &) const { return true; }
+    template <typename U> bool operator!=(const Allocator<U> &) const { return false; }
+};
+
+/// \brief Bytes of this process's anonymous memory currently backed by
+/// transparent huge pages (AnonHugePages in /proc/self/smaps_rollup), or 0 if
+/// unavailable.
+inline auto anon_huge_bytes() -> size_t {
+    FILE *f = std::fopen("/proc/self/smaps_rollup", "r");
+    if (f == nullptr)
+        return 0;
+    char line[256];
+    size_t kb = 0;
+    while (std::fgets(line, sizeof(line), f) != nullptr) {
+        if (std::sscanf(line, "AnonHugePages: %zu kB", &kb) == 1)
+            break;
+    }
+    std::fclose(f);
+    return kb * 1024;
+}
+
+} // namespace tinyrend::huge_pages
@@ -1,12 +1,37 @@
 #pragma once
 
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <glm/glm.hpp>
+#include <limits>
 
 #include "tinyrend/core/macros.h"
 
 namespace tinyrend::math {
 
+// The helpers below and the camera models are templated on the scalar type T
+// (float for rendering, double for calibration). T is deduced from the vector
+// and array arguments; scalar arguments are `type_identity_t<T>` so that
+// passing a float literal to a double model (or the reverse) does not make the
+// deduction ambiguous. Where T cannot be deduced (all-braced arguments) it
+// defaults to float, which keeps existing call sites unchanged.
+
+template <typename T> struct type_identity {
+    using type = T;
+};
+template <typename T> using type_identity_t = typename type_identity<T>::type;
+
+/// Scalar type of a scalar or glm vector type.
+template <typename X> struct scalar_of {
+    using type = X;
+};
+template <glm::length_t L, typename T, glm::qualifier Q>
+struct scalar_of<glm::vec<L, T, Q>> {
+    using type = T;
+};
+template <typename X> using scalar_of_t = typename scalar_of<X>::type;
+
 inline GSPLAT_HOST_DEVICE float rsqrtf(const float x) {
 #ifdef __CUDACC__
     return ::rsqrtf(x); // use CUDA's fast rsqrtf()
@@ -15,23 +40,35 @@ inline GSPLAT_HOST_DEVICE float rsqrtf(const float x) {
 #endif
 }
 
-inline GSPLAT_HOST_DEVICE float numerically_stable_norm2(float x, float y) {
+/// Reciprocal square root, overloaded for float and double.
+inline GSPLAT_HOST_DEVICE float rsqrt(const float x) { return rsqrtf(x); }
+
+inline GSPLAT_HOST_DEVICE double rsqrt(const double x) {
+#ifdef __CUDACC__
+    return ::rsqrt(x);
+#else
+    return 1.0 / std::sqrt(x);
+#endif
+}
+
+template <typename T>
+inline GSPLAT_HOST_DEVICE T numerically_stable_norm2(T x, type_identity_t<T> y) {
     // Computes 2-norm of a [x,y] vector in a numerically stable way
     auto const abs_x = std::fabs(x);
     auto const abs_y = std::fabs(y);
     auto const min = std::fmin(abs_x, abs_y);
     auto const max = std::fmax(abs_x, abs_y);
 
-    if (max <= 0.f)
-        return 0.f;
+    if (max <= T(0))
+        return T(0);
 
     auto const min_max_ratio = min / max;
-    return max * std::sqrt(1.f + min_max_ratio * min_max_ratio);
+    return max * std::sqrt(T(1) + min_max_ratio * min_max_ratio);
 }
 
-template <size_t N_COEFFS>
-inline GSPLAT_HOST_DEVICE float
-eval_poly_horner(std::array<float, N_COEFFS> const &poly, float x) {
+template <size_t N_COEFFS, typename T = float>
+inline GSPLAT_HOST_DEVICE T
+eval_poly_horner(std::array<T, N_COEFFS> const &poly, type_identity_t<T> x) {
     // Evaluates a polynomial y=f(x) with
     //
     // f(x) = c_0*x^0 + c_1*x^1 + c_2*x^2 + c_3*x^3 + c_4*x^4 ...
@@ -41,36 +78,35 @@ eval_poly_horner(std::array<float, N_COEFFS> const &poly, float x) {
     //
     // The degree of the polynomial is N_COEFFS - 1
 
-    auto y = float{0};
+    auto y = T{0};
     for (auto cit = poly.rbegin(); cit != poly.rend(); ++cit)
         y = x * y + (*cit);
     return y;
 }
 
-template <size_t SKIP_FIRST_N = 0, size_t N>
-inline GSPLAT_HOST_DEVICE bool is_all_zero(std::array<float, N> const &arr) {
+template <size_t SKIP_FIRST_N = 0, size_t N, typename T>
+inline GSPLAT_HOST_DEVICE bool is_all_zero(std::array<T, N> const &arr) {
 #pragma unroll
     for (size_t i = SKIP_FIRST_N; i < N; ++i) {
-        if (fabsf(arr[i]) >= std::numeric_limits<float>::epsilon())
+        if (std::fabs(arr[i]) >= std::numeric_limits<T>::epsilon())
             return false;
     }
     return true;
 }
 
-template <glm::length_t L, glm::qualifier Q = glm::defaultp>
-inline GSPLAT_HOST_DEVICE glm::vec<L, float, Q>
-safe_normalize(const glm::vec<L, float, Q> &x) {
-    const float l2 = glm::dot(x, x);
-    return (l2 > 0.0f) ? (x * rsqrtf(l2)) : x;
+template <glm::length_t L, typename T, glm::qualifier Q = glm::defaultp>
+inline GSPLAT_HOST_DEVICE glm::vec<L, T, Q> safe_normalize(const glm::vec<L, T, Q> &x) {
+    const T l2 = glm::dot(x, x);
+    return (l2 > T(0)) ? (x * rsqrt(l2)) : x;
 }
 
-template <glm::length_t L, glm::qualifier Q = glm::defaultp>
-inline GSPLAT_HOST_DEVICE glm::vec<L, float, Q>
-safe_normalize_vjp(const glm::vec<L, float, Q> &x, const glm::vec<L, float, Q> &v_out) {
-    const float l2 = glm::dot(x, x);
-    if (l2 > 0.0f) {
-        const float il = rsqrtf(l2);
-        const float il3 = il * il * il;
+template <glm::length_t L, typename T, glm::qualifier Q = glm::defaultp>
+inline GSPLAT_HOST_DEVICE glm::vec<L, T, Q>
+safe_normalize_vjp(const glm::vec<L, T, Q> &x, const glm::vec<L, T, Q> &v_out) {
+    const T l2 = glm::dot(x, x);
+    if (l2 > T(0)) {
+        const T il = rsqrt(l2);
+        const T il3 = il * il * il;
         return il * v_out - il3 * glm::dot(v_out, x) * x;
     }
     return v_out;
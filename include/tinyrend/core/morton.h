@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "tinyrend/core/macros.h"
+#include "tinyrend/core/thread_pool.h"
+
+namespace tinyrend::morton {
+
+/// \brief Spread the lower 21 bits of `x` so that there are two zero bits
+/// between consecutive bits.
+inline GSPLAT_HOST_DEVICE uint64_t expand_bits_3d(uint64_t x) {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffull;
+    x = (x | x << 16) & 0x1f0000ff0000ffull;
+    x = (x | x << 8) & 0x100f00f00f00f00full;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+    x = (x | x << 2) & 0x1249249249249249ull;
+    return x;
+}
+
+/// \brief 3D Morton (Z-order) code of integer cell coordinates (< 2^21).
+inline GSPLAT_HOST_DEVICE uint64_t morton_encode(uint32_t x, uint32_t y, uint32_t z) {
+    return expand_bits_3d(x) | (expand_bits_3d(y) << 1) | (expand_bits_3d(z) << 2);
+}
+
+/// \brief 3D Hilbert index of integer cell coordinates on a 2^bits grid.
+///
+/// Uses Skilling's transpose algorithm ("Programming the Hilbert curve",
+/// 2004): consecutive indices always map to face-adjacent cells, which gives
+/// slightly better locality than Morton order at a few more operations.
+inline GSPLAT_HOST_DEVICE uint64_t
+hilbert_encode(uint32_t x, uint32_t y, uint32_t z, uint32_t bits) {
+    uint32_t X[3] = {x, y, z};
+    const uint32_t M = 1u << (bits - 1);
+    // Inverse undo
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                const uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+    // Gray encode
+    for (int i = 1; i < 3; ++i)
+        X[i] ^= X[i - 1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q)
+            t ^= Q - 1;
+    }
+    for (int i = 0; i < 3; ++i)
+        X[i] ^= t;
+    // Interleave the transposed representation, X[0] holding the top bit.
+    uint64_t key = 0;
+    for (int b = static_cast<int>(bits) - 1; b >= 0; --b) {
+        for (int i = 0; i < 3; ++i)
+            key = (key << 1) | ((X[i] >> b) & 1u);
+    }
+    return key;
+}
+
+enum class Curve { MORTON, HILBERT };
+
+/// \brief Space-filling-curve key of every point, quantized to a 2^bits grid
+/// over the bounding box of the points.
+///
+/// \param n Number of points
+/// \param points Positions [n, 3]
+/// \param keys Output keys [n]
+/// \param curve Morton or Hilbert
+/// \param bits Bits per axis (1..21)
+inline void compute_keys(
+    size_t n,
+    const float *points,
+    uint64_t *keys,
+    Curve curve = Curve::MORTON,
+    uint32_t bits = 10
+) {
+    bits = std::clamp<uint32_t>(bits, 1, 21);
+    auto &pool = thread_pool::global_pool();
+
+    // Bounding box, reduced per worker.
+    std::vector<float> lo(pool.size() * 3, std::numeric_limits<float>::max());
+    std::vector<float> hi(pool.size() * 3, std::numeric_limits<float>::lowest());
+    pool.run([&](size_t w) {
+        const auto [begin, end] = pool.partition(n, w);
+        for (size_t i = begin; i < end; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                lo[3 * w + k] = std::min(lo[3 * w + k], points[3 * i + k]);
+                hi[3 * w + k] = std::max(hi[3 * w + k], points[3 * i + k]);
+            }
+        }
+    });
+    float bmin[3], scale[3];
+    const float cells = float((1u << bits) - 1);
+    for (int k = 0; k < 3; ++k) {
+        float l = std::numeric_limits<float>::max(), h = std::numeric_limits<float>::lowest();
+        for (size_t w = 0; w < pool.size(); ++w) {
+            l = std::min(l, lo[3 * w + k]);
+            h = std::max(h, hi[3 * w + k]);
+        }
+        bmin[k] = l;
+        scale[k] = h > l ? cells / (h - l) : 0.f;
+    }
+
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t c[3];
+            for (int k = 0; k < 3; ++k) {
+                const float v = (points[3 * i + k] - bmin[k]) * scale[k];
+                // NaN / inf positions are clamped into the grid.
+                c[k] = v > 0.f ? static_cast<uint32_t>(std::min(v, cells)) : 0u;
+            }
+            keys[i] = curve == Curve::MORTON ? morton_encode(c[0], c[1], c[2])
+                                             : hilbert_encode(c[0], c[1], c[2], bits);
+        }
+    });
+}
+
+/// \brief Stable parallel LSD radix sort of `keys`, returning the permutation
+/// `perm` such that `keys[perm[0]] <= keys[perm[1]] <= ...`.
+///
+/// \param n Number of keys
+/// \param keys Keys [n]
+/// \param key_bits Number of significant low bits in the keys
+/// \return Permutation [n]
+inline std::vector<uint32_t>
+sort_permutation(size_t n, const uint64_t *keys, uint32_t key_bits = 64) {
+    constexpr uint32_t RADIX_BITS = 11;
+    constexpr uint32_t RADIX = 1u << RADIX_BITS;
+    auto &pool = thread_pool::global_pool();
+    const size_t n_workers = pool.size();
+
+    std::vector<uint32_t> perm(n), tmp(n);
+    std::vector<uint64_t> k_cur(keys, keys + n), k_tmp(n);
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            perm[i] = static_cast<uint32_t>(i);
+    });
+
+    std::vector<size_t> hist(n_workers * RADIX);
+    for (uint32_t shift = 0; shift < key_bits; shift += RADIX_BITS) {
+        // Per-worker digit histograms over the static partition.
+        pool.run([&](size_t w) {
+            size_t *h = &hist[w * RADIX];
+            std::fill(h, h + RADIX, 0);
+            const auto [begin, end] = pool.partition(n, w);
+            for (size_t i = begin; i < end; ++i)
+                h[(k_cur[i] >> shift) & (RADIX - 1)] += 1;
+        });
+        // Exclusive scan in (digit, worker) order keeps the sort stable.
+        size_t running = 0;
+        for (uint32_t d = 0; d < RADIX; ++d) {
+            for (size_t w = 0; w < n_workers; ++w) {
+                const size_t c = hist[w * RADIX + d];
+                hist[w * RADIX + d] = running;
+                running += c;
+            }
+        }
+        pool.run([&](size_t w) {
+            size_t *h = &hist[w * RADIX];
+            const auto [begin, end] = pool.partition(n, w);
+            for (size_t i = begin; i < end; ++i) {
+                const size_t dst = h[(k_cur[i] >> shift) & (RADIX - 1)]++;
+                k_tmp[dst] = k_cur[i];
+                tmp[dst] = perm[i];
+            }
+        });
+        std::swap(k_cur, k_tmp);
+        std::swap(perm, tmp);
+    }
+    return perm;
+}
+
+/// \brief A buffer of `n` elements of `bytes_per_element` bytes each.
+struct Buffer {
+    void *data;
+    size_t bytes_per_element;
+};
+
+/// \brief Reorder every buffer in place: new element `i` = old element `perm[i]`.
+///
+/// Use this for all SoA attribute buffers as well as optimizer state (e.g.
+/// Adam moments) so they stay aligned with the primitives.
+inline void apply_permutation(
+    size_t n, const uint32_t *perm, const std::vector<Buffer> &buffers
+) {
+    std::vector<char> scratch;
+    for (const auto &buf : buffers) {
+        const size_t bpe = buf.bytes_per_element;
+        scratch.resize(n * bpe);
+        const char *src = static_cast<const char *>(buf.data);
+        thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                std::memcpy(&scratch[i * bpe], src + size_t(perm[i]) * bpe, bpe);
+        });
+        char *dst = static_cast<char *>(buf.data);
+        thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+            std::memcpy(dst + begin * bpe, &scratch[begin * bpe], (end - begin) * bpe);
+        });
+    }
+}
+
+/// \brief Inverse of a permutation: `inv[perm[i]] = i`. Useful to remap
+/// indices held outside the reordered buffers.
+inline std::vector<uint32_t> invert_permutation(size_t n, const uint32_t *perm) {
+    std::vector<uint32_t> inv(n);
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            inv[perm[i]] = static_cast<uint32_t>(i);
+    });
+    return inv;
+}
+
+/// \brief Sort primitives spatially and reorder their buffers in place.
+///
+/// \param n Number of primitives
+/// \param means Positions [n, 3] (reordered too if listed in `buffers`)
+/// \param buffers All per-primitive buffers to reorder
+/// \param curve Morton or Hilbert
+/// \param bits Bits per axis of the quantization grid
+/// \return Permutation applied (new index -> old index)
+inline std::vector<uint32_t> reorder(
+    size_t n,
+    const float *means,
+    const std::vector<Buffer> &buffers,
+    Curve curve = Curve::MORTON,
+    uint32_t bits = 10
+) {
+    bits = std::clamp<uint32_t>(bits, 1, 21);
+    std::vector<uint64_t> keys(n);
+    compute_keys(n, means, keys.data(), curve, bits);
+    auto perm = sort_permutation(n, keys.data(), 3 * bits);
+    apply_permutation(n, perm.data(), buffers);
+    return perm;
+}
+
+} // namespace tinyrend::morton
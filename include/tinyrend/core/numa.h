@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace tinyrend::numa {
+
+/// \brief CPU topology of the machine, grouped by NUMA node (socket).
+///
+/// Only CPUs that the current process is allowed to run on (as reported by
+/// `sched_getaffinity`) are listed, so `taskset` / cgroup restrictions are
+/// respected.
+struct Topology {
+    /// cpus[node] = list of logical CPU ids on that node.
+    std::vector<std::vector<int>> cpus;
+
+    size_t n_nodes() const { return cpus.size(); }
+
+    size_t n_cpus() const {
+        size_t n = 0;
+        for (auto const &c : cpus)
+            n += c.size();
+        return n;
+    }
+};
+
+/// \brief Parse a Linux cpulist string such as "0-15,32-47".
+/// \param str cpulist string
+/// \return List of CPU ids
+inline std::vector<int> parse_cpulist(const std::string &str) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos < str.size()) {
+        size_t end = str.find(',', pos);
+        if (end == std::string::npos)
+            end = str.size();
+        const std::string item = str.substr(pos, end - pos);
+        const size_t dash = item.find('-');
+        char *tail = nullptr;
+        if (dash == std::string::npos) {
+            const long c = std::strtol(item.c_str(), &tail, 10);
+            if (tail != item.c_str())
+                cpus.push_back(static_cast<int>(c));
+        } else {
+            const long lo = std::strtol(item.substr(0, dash).c_str(), nullptr, 10);
+            const long hi = std::strtol(item.substr(dash + 1).c_str(), nullptr, 10);
+            for (long c = lo; c <= hi; ++c)
+                cpus.push_back(static_cast<int>(c));
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+namespace detail {
+
+inline bool read_first_line(const std::string &path, std::string &line) {
+    FILE *f = std::fopen(path.c_str(), "r");
+    if (f == nullptr)
+        return false;
+    char buf[4096];
+    const bool ok = std::fgets(buf, sizeof(buf), f) != nullptr;
+    std::fclose(f);
+    if (!ok)
+        return false;
+    line = buf;
+    while (!line.empty() && (line.back() == '\n' || line.back() == ' '))
+        line.pop_back();
+    return true;
+}
+
+inline bool is_cpu_allowed(int cpu) {
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+        return true;
+    return cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &mask);
+#else
+    return true;
+#endif
+}
+
+} // namespace detail
+
+/// \brief Detect the NUMA topology from sysfs.
+///
+/// Falls back to a single node holding `std::thread::hardware_concurrency()`
+/// CPUs when sysfs is unavailable (non-Linux, containers without /sys).
+///
+/// \return Topology with at least one node and one CPU
+inline Topology detect_topology() {
+    Topology topo;
+    for (int node = 0;; ++node) {
+        std::string line;
+        const std::string path =
+            "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+        if (!detail::read_first_line(path, line))
+            break;
+        std::vector<int> cpus;
+        for (int cpu : parse_cpulist(line)) {
+            if (detail::is_cpu_allowed(cpu))
+                cpus.push_back(cpu);
+        }
+        if (!cpus.empty())
+            topo.cpus.push_back(std::move(cpus));
+    }
+    if (topo.cpus.empty()) {
+        std::vector<int> cpus;
+        const int n = std::max(1u, std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu < n; ++cpu) {
+            if (detail::is_cpu_allowed(cpu))
+                cpus.push_back(cpu);
+        }
+        if (cpus.empty())
+            cpus.push_back(0);
+        topo.cpus.push_back(std::move(cpus));
+    }
+    return topo;
+}
+
+/// \brief Cached topology of the current process.
+inline const Topology &topology() {
+    static const Topology topo = detect_topology();
+    return topo;
+}
+
+/// \brief Pin the calling thread to a single logical CPU.
+/// \param cpu Logical CPU id
+/// \return true on success (always false on non-Linux platforms)
+inline bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace tinyrend::numa
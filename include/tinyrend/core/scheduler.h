@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "tinyrend/core/thread_pool.h"
+
+namespace tinyrend::scheduler {
+
+/// \brief Priority class of a render context. Lower value = served first.
+enum class Priority { INTERACTIVE = 0, BATCH = 1 };
+
+/// \brief Latency summary of the frames of one context, in milliseconds.
+struct LatencyStats {
+    size_t n_frames = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    double mean_queue_ms = 0.0; // submit -> first tile batch started
+};
+
+/// \brief A submitted frame: `n_tiles` calls of `tile_fn(tile_id)`.
+class Frame {
+  public:
+    /// \brief Block until every tile has run. Rethrows the first tile error.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return done_; });
+        if (error_)
+            std::rethrow_exception(error_);
+    }
+
+    bool done() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return done_;
+    }
+
+    /// \brief Submit-to-completion latency (valid after `wait`).
+    double latency_ms() const {
+        return std::chrono::duration<double, std::milli>(finish_ - submit_).count();
+    }
+
+  private:
+    friend class Scheduler;
+    using Clock = std::chrono::steady_clock;
+
+    size_t context = 0;
+    size_t n_tiles = 0;
+    size_t next_tile = 0;     // guarded by the scheduler lock
+    size_t tiles_left = 0;    // guarded by the scheduler lock
+    bool started = false;     // guarded by the scheduler lock
+    std::function<void(size_t)> tile_fn;
+    Clock::time_point submit_, start_, finish_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_ = false;
+    std::exception_ptr error_;
+};
+
+/// \brief Shared CPU executor for concurrent render contexts.
+///
+/// Frames run on the workers of a `thread_pool::ThreadPool` (the global pool
+/// by default), so render contexts and CPU kernels share one set of threads,
+/// and a `parallel_for` issued from a tile runs inline on its worker. Frames
+/// are split into batches of `tiles_per_batch` tiles; every batch is a task
+/// posted to the pool, which picks the batch when it starts. A newly
+/// submitted interactive frame thus preempts running batch work at the next
+/// tile boundary, and `run` jobs of the pool interleave with the batches.
+/// Selection is strict priority across classes and weighted fair queueing
+/// (smallest virtual time, advanced by tiles / weight) among the contexts of
+/// one class.
+class Scheduler {
+  public:
+    using ContextId = size_t;
+
+    /// \param tiles_per_batch Preemption granularity
+    /// \param pool Thread pool the tiles run on
+    explicit Scheduler(
+        size_t tiles_per_batch = 4,
+        thread_pool::ThreadPool &pool = thread_pool::global_pool()
+    )
+        : tiles_per_batch_(std::max<size_t>(tiles_per_batch, 1)), pool_(pool) {}
+
+    /// Queued frames are run to completion before the scheduler goes away.
+    ~Scheduler() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return n_runners_ == 0; });
+    }
+
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+
+    size_t size() const { return pool_.size(); }
+
+    /// \brief Register a render context.
+    /// \param priority Priority class
+    /// \param weight Share of the class when several contexts are busy
+    ContextId create_context(Priority priority, float weight = 1.0f) {
+        if (!(weight > 0.0f))
+            throw std::invalid_argument("context weight must be positive");
+        std::lock_guard<std::mutex> lock(mutex_);
+        contexts_.push_back(Context{priority, weight});
+        return contexts_.size() - 1;
+    }
+
+    /// \brief Enqueue a frame of `n_tiles` tiles on `context`.
+    std::shared_ptr<Frame>
+    submit(ContextId context, size_t n_tiles, std::function<void(size_t)> tile_fn) {
+        auto frame = std::make_shared<Frame>();
+        frame->context = context;
+        frame->n_tiles = n_tiles;
+        frame->tiles_left = n_tiles;
+        frame->tile_fn = std::move(tile_fn);
+        frame->submit_ = Frame::Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Context &ctx = contexts_.at(context);
+            if (n_tiles == 0) {
+                frame->start_ = frame->finish_ = frame->submit_;
+                finish(ctx, *frame);
+                return frame;
+            }
+            if (ctx.frames.empty()) {
+                // Re-entering the active set: no credit for time spent idle.
+                ctx.vtime = std::max(ctx.vtime, class_clock_[static_cast<int>(ctx.priority)]);
+            }
+            ctx.frames.push_back(frame);
+            // One runner per worker at most; idle runners have returned.
+            for (; n_runners_ < pool_.size(); ++n_runners_)
+                pool_.post([this] { run_batch(); });
+        }
+        return frame;
+    }
+
+    /// \brief Latency statistics over the last `window` frames of `context`.
+    LatencyStats stats(ContextId context) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Context &ctx = contexts_.at(context);
+        LatencyStats s;
+        s.n_frames = ctx.n_finished;
+        if (ctx.latencies.empty())
+            return s;
+        std::vector<double> sorted(ctx.latencies.begin(), ctx.latencies.end());
+        std::sort(sorted.begin(), sorted.end());
+        auto quantile = [&](double q) {
+            const size_t i = static_cast<size_t>(q * (sorted.size() - 1) + 0.5);
+            return sorted[std::min(i, sorted.size() - 1)];
+        };
+        double sum = 0.0, queue_sum = 0.0;
+        for (double v : ctx.latencies)
+            sum += v;
+        for (double v : ctx.queue_delays)
+            queue_sum += v;
+        s.mean_ms = sum / ctx.latencies.size();
+        s.mean_queue_ms = queue_sum / ctx.queue_delays.size();
+        s.p50_ms = quantile(0.50);
+        s.p99_ms = quantile(0.99);
+        s.max_ms = sorted.back();
+        return s;
+    }
+
+    static constexpr size_t window = 1024;
+
+  private:
+    struct Context {
+        Priority priority = Priority::BATCH;
+        float weight = 1.0f;
+        double vtime = 0.0;
+        std::deque<std::shared_ptr<Frame>> frames = {};
+        size_t n_finished = 0;
+        std::deque<double> latencies = {};
+        std::deque<double> queue_delays = {};
+    };
+
+    struct Batch {
+        std::shared_ptr<Frame> frame;
+        size_t begin = 0, end = 0;
+    };
+
+    // Pick the next batch. Called with mutex_ held.
+    bool pick(Batch &batch) {
+        Context *best = nullptr;
+        for (auto &ctx : contexts_) {
+            if (ctx.frames.empty())
+                continue;
+            // Skip contexts whose queued frames are fully handed out.
+            bool has_tiles = false;
+            for (const auto &f : ctx.frames) {
+                if (f->next_tile < f->n_tiles) {
+                    has_tiles = true;
+                    break;
+                }
+            }
+            if (!has_tiles)
+                continue;
+            if (best == nullptr || ctx.priority < best->priority ||
+                (ctx.priority == best->priority && ctx.vtime < best->vtime))
+                best = &ctx;
+        }
+        if (best == nullptr)
+            return false;
+        for (const auto &f : best->frames) {
+            if (f->next_tile < f->n_tiles) {
+                batch.frame = f;
+                break;
+            }
+        }
+        Frame &f = *batch.frame;
+        if (!f.started) {
+            f.started = true;
+            f.start_ = Frame::Clock::now();
+        }
+        batch.begin = f.next_tile;
+        batch.end = std::min(f.n_tiles, f.next_tile + tiles_per_batch_);
+        f.next_tile = batch.end;
+        class_clock_[static_cast<int>(best->priority)] = best->vtime;
+        best->vtime += static_cast<double>(batch.end - batch.begin) / best->weight;
+        return true;
+    }
+
+    // Record completion. Called with mutex_ held.
+    void finish(Context &ctx, Frame &frame) {
+        frame.finish_ = Frame::Clock::now();
+        auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+        ctx.latencies.push_back(ms(frame.finish_ - frame.submit_));
+        ctx.queue_delays.push_back(ms(frame.start_ - frame.submit_));
+        if (ctx.latencies.size() > window) {
+            ctx.latencies.pop_front();
+            ctx.queue_delays.pop_front();
+        }
+        ctx.n_finished += 1;
+        auto it = std::find_if(ctx.frames.begin(), ctx.frames.end(), [&](const auto &f) {
+            return f.get() == &frame;
+        });
+        if (it != ctx.frames.end())
+            ctx.frames.erase(it);
+        std::lock_guard<std::mutex> lock(frame.mutex_);
+        frame.done_ = true;
+        frame.cv_.notify_all();
+    }
+
+    // Pool task: run one batch, then post itself again so the worker returns
+    // to the pool between batches. Returns for good once nothing is queued.
+    void run_batch() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Batch batch;
+        if (!pick(batch)) {
+            n_runners_ -= 1;
+            if (n_runners_ == 0)
+                cv_.notify_all();
+            return;
+        }
+
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            for (size_t t = batch.begin; t < batch.end; ++t)
+                batch.frame->tile_fn(t);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        Frame &f = *batch.frame;
+        if (error) {
+            std::lock_guard<std::mutex> frame_lock(f.mutex_);
+            if (!f.error_)
+                f.error_ = error;
+        }
+        f.tiles_left -= batch.end - batch.begin;
+        if (f.tiles_left == 0)
+            finish(contexts_[f.context], f);
+        lock.unlock();
+        pool_.post([this] { run_batch(); });
+    }
+
+    size_t tiles_per_batch_;
+    thread_pool::ThreadPool &pool_;
+    size_t n_runners_ = 0; // batch tasks posted to the pool and not yet returned
+    std::deque<Context> contexts_;
+    double class_clock_[2] = {0.0, 0.0}; // virtual time of the last dispatch per class
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_; // signals n_runners_ == 0
+};
+
+} // namespace tinyrend::scheduler
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <glm/glm.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp> // glm slerp
+#include <type_traits>
+#include <utility>
+
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
 
 #include "tinyrend/core/macros.h" // for GSPLAT_HOST_DEVICE
 
@@ -48,6 +55,84 @@ GSPLAT_HOST_DEVICE inline auto interpolate(
     return {glm::mat3_cast(rot), transl};
 }
 
+/// \brief Upper bound of the rotation error of normalized lerp vs. slerp
+/// \details For a relative rotation angle `angle` (radians, <= 1), nlerp deviates
+/// from slerp by at most angle^3 / 240 radians over ratio in [0, 1].
+/// \param angle Rotation angle between the two poses
+/// \return Maximum rotation error in radians
+GSPLAT_HOST_DEVICE inline auto nlerp_max_error(const float angle) -> float {
+    return angle * angle * angle / 240.f;
+}
+
+/// \brief Interpolate two rotations with normalized lerp (shortest path)
+/// \param ratio Interpolation ratio (0 for rot1, 1 for rot2)
+/// \param rot1 First rotation as quaternion
+/// \param rot2 Second rotation as quaternion
+/// \return Interpolated rotation, see `nlerp_max_error` for its accuracy
+GSPLAT_HOST_DEVICE inline auto
+nlerp(const float ratio, const glm::fquat &rot1, const glm::fquat &rot2) -> glm::fquat {
+    auto const rot2_ = glm::dot(rot1, rot2) < 0.f ? -rot2 : rot2;
+    return glm::normalize((1.f - ratio) * rot1 + ratio * rot2_);
+}
+
+/// \brief Repeated interpolation between two fixed SE(3) poses
+/// \details Converts the rotations to quaternions once and chooses the method
+/// once per pose pair: normalized lerp when its error bound is below
+/// `max_error`, slerp otherwise. With matrix rotations this saves the two
+/// `quat_cast` of `interpolate` per call, and nlerp avoids the trigonometry of
+/// slerp. Typical use is a rolling shutter, where the poses are fixed per
+/// camera and the ratio varies per point.
+/// \tparam RotationType Type of rotation representation (glm::fmat3 or glm::fquat)
+template <typename RotationType> struct PoseInterpolator {
+    glm::fquat rot1;
+    glm::fquat rot2; // on the same hemisphere as rot1
+    glm::fvec3 transl1;
+    glm::fvec3 transl2;
+    bool use_nlerp;
+
+    /// \param rot1 First rotation
+    /// \param transl1 First translation
+    /// \param rot2 Second rotation
+    /// \param transl2 Second translation
+    /// \param max_error Largest rotation error (radians) accepted from nlerp
+    GSPLAT_HOST_DEVICE PoseInterpolator(
+        const RotationType &rot1,
+        const glm::fvec3 &transl1,
+        const RotationType &rot2,
+        const glm::fvec3 &transl2,
+        const float max_error = 1e-6f
+    )
+        : transl1(transl1), transl2(transl2) {
+        if constexpr (std::is_same_v<RotationType, glm::fmat3>) {
+            this->rot1 = glm::quat_cast(rot1);
+            this->rot2 = glm::quat_cast(rot2);
+        } else {
+            this->rot1 = rot1;
+            this->rot2 = rot2;
+        }
+        auto const cos_half_angle = glm::dot(this->rot1, this->rot2);
+        if (cos_half_angle < 0.f) {
+            this->rot2 = -this->rot2;
+        }
+        auto const angle = 2.f * std::acos(std::min(std::abs(cos_half_angle), 1.f));
+        use_nlerp = angle <= 1.f && nlerp_max_error(angle) <= max_error;
+    }
+
+    /// \param ratio Interpolation ratio (0 for pose1, 1 for pose2)
+    /// \return Pair of interpolated rotation and translation
+    GSPLAT_HOST_DEVICE auto operator()(const float ratio) const
+        -> std::pair<RotationType, glm::fvec3> {
+        auto const rot = use_nlerp ? nlerp(ratio, rot1, rot2)
+                                   : glm::slerp(rot1, rot2, ratio);
+        auto const transl = (1.f - ratio) * transl1 + ratio * transl2;
+        if constexpr (std::is_same_v<RotationType, glm::fmat3>) {
+            return {glm::mat3_cast(rot), transl};
+        } else {
+            return {rot, transl};
+        }
+    }
+};
+
 /// \brief Transform a point using SE(3) matrix
 /// \param rot Rotation matrix
 /// \param transl Translation vector
@@ -229,4 +314,176 @@ invtransform_covar(const glm::fquat &rot, const glm::fmat3 &covar) -> glm::fmat3
     return glm::transpose(R) * covar * R;
 }
 
+/*
+    Batched transforms of many elements by one pose. Elements are stored as
+    structure of arrays: component `k` of element `i` is at `ptr[k * n + i]`.
+    With AVX, 8 elements are transformed per iteration (same operations as the
+    scalar loop, which handles the tail). Input and output may alias.
+*/
+
+/// \brief Transform a batch of points using SE(3) matrix
+/// \param rot Rotation matrix
+/// \param transl Translation vector
+/// \param n Number of points
+/// \param points Points to transform [3, n]
+/// \param out Transformed points [3, n]
+inline auto transform_points(
+    const glm::fmat3 &rot,
+    const glm::fvec3 &transl,
+    const size_t n,
+    const float *points,
+    float *out
+) -> void {
+    const float *x = points, *y = points + n, *z = points + 2 * n;
+    float *ox = out, *oy = out + n, *oz = out + 2 * n;
+    // glm is column-major: rot[c][r]
+    const float r00 = rot[0][0], r01 = rot[1][0], r02 = rot[2][0];
+    const float r10 = rot[0][1], r11 = rot[1][1], r12 = rot[2][1];
+    const float r20 = rot[0][2], r21 = rot[1][2], r22 = rot[2][2];
+    const float t0 = transl[0], t1 = transl[1], t2 = transl[2];
+    size_t i = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+    {
+        // r * p + t for one output row, 8 points at a time
+        auto const row = [](const float *rt, __m256 px, __m256 py, __m256 pz) {
+            auto const v = _mm256_add_ps(
+                _mm256_mul_ps(_mm256_set1_ps(rt[0]), px),
+                _mm256_mul_ps(_mm256_set1_ps(rt[1]), py)
+            );
+            return _mm256_add_ps(
+                _mm256_add_ps(v, _mm256_mul_ps(_mm256_set1_ps(rt[2]), pz)),
+                _mm256_set1_ps(rt[3])
+            );
+        };
+        const float rt[3][4] = {
+            {r00, r01, r02, t0}, {r10, r11, r12, t1}, {r20, r21, r22, t2}
+        };
+        for (; i + 8 <= n; i += 8) {
+            auto const px = _mm256_loadu_ps(x + i);
+            auto const py = _mm256_loadu_ps(y + i);
+            auto const pz = _mm256_loadu_ps(z + i);
+            _mm256_storeu_ps(ox + i, row(rt[0], px, py, pz));
+            _mm256_storeu_ps(oy + i, row(rt[1], px, py, pz));
+            _mm256_storeu_ps(oz + i, row(rt[2], px, py, pz));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const float px = x[i], py = y[i], pz = z[i];
+        ox[i] = r00 * px + r01 * py + r02 * pz + t0;
+        oy[i] = r10 * px + r11 * py + r12 * pz + t1;
+        oz[i] = r20 * px + r21 * py + r22 * pz + t2;
+    }
+}
+
+/// \brief Transform a batch of directions using SE(3) matrix
+/// \param rot Rotation matrix
+/// \param n Number of directions
+/// \param dirs Directions to transform [3, n]
+/// \param out Transformed directions [3, n]
+inline auto
+transform_dirs(const glm::fmat3 &rot, const size_t n, const float *dirs, float *out)
+    -> void {
+    transform_points(rot, glm::fvec3(0.f), n, dirs, out);
+}
+
+/// \brief Transform a batch of rays using SE(3) matrix
+/// \param rot Rotation matrix
+/// \param transl Translation vector
+/// \param n Number of rays
+/// \param ray_o Ray origins [3, n]
+/// \param ray_d Ray directions [3, n]
+/// \param out_o Transformed ray origins [3, n]
+/// \param out_d Transformed ray directions [3, n]
+inline auto transform_rays(
+    const glm::fmat3 &rot,
+    const glm::fvec3 &transl,
+    const size_t n,
+    const float *ray_o,
+    const float *ray_d,
+    float *out_o,
+    float *out_d
+) -> void {
+    transform_points(rot, transl, n, ray_o, out_o);
+    transform_dirs(rot, n, ray_d, out_d);
+}
+
+/// \brief Transform a batch of covariance matrices using SE(3) matrix
+/// \details Computes R Σ Rᵀ for symmetric Σ stored by its upper triangle
+/// (xx, xy, xz, yy, yz, zz).
+/// \param rot Rotation matrix
+/// \param n Number of covariance matrices
+/// \param covars Covariance matrices to transform [6, n]
+/// \param out Transformed covariance matrices [6, n]
+inline auto transform_covars(
+    const glm::fmat3 &rot, const size_t n, const float *covars, float *out
+) -> void {
+    float r[3][3]; // row-major copy
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            r[i][j] = rot[j][i];
+    size_t i = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+    {
+        __m256 rv[3][3];
+        for (int a = 0; a < 3; ++a)
+            for (int b = 0; b < 3; ++b)
+                rv[a][b] = _mm256_set1_ps(r[a][b]);
+        auto const dot3 = [](__m256 a0, __m256 a1, __m256 a2, __m256 b0, __m256 b1,
+                             __m256 b2) {
+            return _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1)),
+                _mm256_mul_ps(a2, b2)
+            );
+        };
+        for (; i + 8 <= n; i += 8) {
+            __m256 c[3][3];
+            c[0][0] = _mm256_loadu_ps(covars + i);
+            c[0][1] = c[1][0] = _mm256_loadu_ps(covars + n + i);
+            c[0][2] = c[2][0] = _mm256_loadu_ps(covars + 2 * n + i);
+            c[1][1] = _mm256_loadu_ps(covars + 3 * n + i);
+            c[1][2] = c[2][1] = _mm256_loadu_ps(covars + 4 * n + i);
+            c[2][2] = _mm256_loadu_ps(covars + 5 * n + i);
+            __m256 m[3][3]; // R Σ
+            for (int a = 0; a < 3; ++a)
+                for (int b = 0; b < 3; ++b)
+                    m[a][b] = dot3(
+                        rv[a][0], rv[a][1], rv[a][2], c[0][b], c[1][b], c[2][b]
+                    );
+            auto const entry = [&](int a, int b) {
+                return dot3(m[a][0], m[a][1], m[a][2], rv[b][0], rv[b][1], rv[b][2]);
+            };
+            _mm256_storeu_ps(out + i, entry(0, 0));
+            _mm256_storeu_ps(out + n + i, entry(0, 1));
+            _mm256_storeu_ps(out + 2 * n + i, entry(0, 2));
+            _mm256_storeu_ps(out + 3 * n + i, entry(1, 1));
+            _mm256_storeu_ps(out + 4 * n + i, entry(1, 2));
+            _mm256_storeu_ps(out + 5 * n + i, entry(2, 2));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const float c[3][3] = {
+            {covars[i], covars[n + i], covars[2 * n + i]},
+            {covars[n + i], covars[3 * n + i], covars[4 * n + i]},
+            {covars[2 * n + i], covars[4 * n + i], covars[5 * n + i]},
+        };
+        // m = R Σ
+        float m[3][3];
+        for (int a = 0; a < 3; ++a)
+            for (int b = 0; b < 3; ++b)
+                m[a][b] = r[a][0] * c[0][b] + r[a][1] * c[1][b] + r[a][2] * c[2][b];
+        // out = m Rᵀ, upper triangle only
+        auto const entry = [&](int a, int b) {
+            return m[a][0] * r[b][0] + m[a][1] * r[b][1] + m[a][2] * r[b][2];
+        };
+        out[i] = entry(0, 0);
+        out[n + i] = entry(0, 1);
+        out[2 * n + i] = entry(0, 2);
+        out[3 * n + i] = entry(1, 1);
+        out[4 * n + i] = entry(1, 2);
+        out[5 * n + i] = entry(2, 2);
+    }
+}
+
 } // namespace tinyrend::se3
\ No newline at end of file
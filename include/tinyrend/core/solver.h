@@ -11,26 +11,31 @@
 
 namespace tinyrend::solver {
 
-template <size_t DIM> struct NewtonSolverResult;
+// All solvers are templated on the scalar type T (float or double), deduced
+// from the initial guess / polynomial and defaulting to float; see math.h.
+using math::type_identity_t;
 
-template <> struct NewtonSolverResult<1> {
-    using dtype = float;
+template <size_t DIM, typename T = float> struct NewtonSolverResult;
+
+template <typename T> struct NewtonSolverResult<1, T> {
+    using dtype = T;
     dtype x;
     bool converged;
 };
 
-template <> struct NewtonSolverResult<2> {
-    using dtype = glm::fvec2;
+template <typename T> struct NewtonSolverResult<2, T> {
+    using dtype = glm::vec<2, T>;
     dtype x;
     bool converged;
 };
 
 template <
     size_t N_ITER,
-    typename Func> // Func(float x) -> pair<float, float> = {residual, dfdx}
+    typename Func, // Func(T x) -> pair<T, T> = {residual, dfdx}
+    typename T = float>
 inline GSPLAT_HOST_DEVICE auto newton_1d(
-    const Func &f, const float &x0, const float epsilon = 1e-6f
-) -> NewtonSolverResult<1> {
+    const Func &f, const T &x0, const type_identity_t<T> epsilon = T(1e-6)
+) -> NewtonSolverResult<1, T> {
     auto x = x0;
     auto converged = false;
 
@@ -51,10 +56,11 @@ inline GSPLAT_HOST_DEVICE auto newton_1d(
 
 template <
     size_t N_ITER,
-    typename Func> // Func(xy) -> pair<residual[2], jacobian[2][2]>
+    typename Func, // Func(xy) -> pair<residual[2], jacobian[2][2]>
+    typename T = float>
 inline GSPLAT_HOST_DEVICE auto newton_2d(
-    const Func &f, const glm::fvec2 &x0, float epsilon = 1e-6f
-) -> NewtonSolverResult<2> {
+    const Func &f, const glm::vec<2, T> &x0, type_identity_t<T> epsilon = T(1e-6)
+) -> NewtonSolverResult<2, T> {
     auto x = x0;
     auto converged = false;
 
@@ -74,12 +80,15 @@ inline GSPLAT_HOST_DEVICE auto newton_2d(
     return {x, converged};
 }
 
-template <size_t DIM, size_t N_ITER, typename Func>
-inline GSPLAT_HOST_DEVICE auto newton(
-    const Func &f,
-    typename NewtonSolverResult<DIM>::dtype x0,
-    const float epsilon = 1e-6f
-) -> NewtonSolverResult<DIM> {
+template <
+    size_t DIM,
+    size_t N_ITER,
+    typename Func,
+    typename X = typename NewtonSolverResult<DIM>::dtype,
+    typename T = math::scalar_of_t<X>>
+inline GSPLAT_HOST_DEVICE auto
+newton(const Func &f, const X &x0, const type_identity_t<T> epsilon = T(1e-6))
+    -> NewtonSolverResult<DIM, T> {
     static_assert(DIM == 1 || DIM == 2, "Only 1D and 2D supported");
 
     if constexpr (DIM == 1) {
@@ -91,53 +100,57 @@ inline GSPLAT_HOST_DEVICE auto newton(
 
 // Solve a linear equation y=c_0+c_1*x and return the minimal positive root.
 // If no positive root exists, return default_value.
-inline GSPLAT_HOST_DEVICE float linear_minimal_positive(
-    std::array<float, 2> const &poly, float y, float default_value
+template <typename T = float>
+inline GSPLAT_HOST_DEVICE T linear_minimal_positive(
+    std::array<T, 2> const &poly, type_identity_t<T> y, type_identity_t<T> default_value
 ) {
     auto const &[c0, c1] = poly;
-    if (c1 == 0.f) {
+    if (c1 == T(0)) {
         return default_value;
     }
     auto const root = (y - c0) / c1;
-    return root > 0.f ? root : default_value;
+    return root > T(0) ? root : default_value;
 }
 
 // Solve a quadratic equation y=c_0+c_1*x+c_2*x^2 and return the minimal
 // positive root. If no positive root exists, return default_value.
-inline GSPLAT_HOST_DEVICE float quadratic_minimal_positive(
-    std::array<float, 3> const &poly, float y, float default_value
+template <typename T = float>
+inline GSPLAT_HOST_DEVICE T quadratic_minimal_positive(
+    std::array<T, 3> const &poly, type_identity_t<T> y, type_identity_t<T> default_value
 ) {
     auto const &[c0, c1, c2] = poly;
-    if (c2 == 0.f) {
+    if (c2 == T(0)) {
         // reduce to y = c0 + c1*x
-        return linear_minimal_positive({c0, c1}, y, default_value);
+        return linear_minimal_positive<T>({c0, c1}, y, default_value);
     } else if (c0 == y) {
         // reduce to x(c1 + c2*x) = 0
-        return linear_minimal_positive({c1, c2}, 0.f, default_value);
+        return linear_minimal_positive<T>({c1, c2}, T(0), default_value);
     }
 
     // normalize the equation to 1 + ax + bx^2 = 0
     auto const a = c1 / (c0 - y);
     auto const b = c2 / (c0 - y);
-    auto const discriminant = a * a - 4.f * b;
-    if (discriminant < 0.f) {
+    auto const discriminant = a * a - T(4) * b;
+    if (discriminant < T(0)) {
         return default_value;
     }
-    auto const root = (-a + std::sqrt(discriminant)) / 2.f;
-    return root > 0.f ? root : default_value;
+    auto const root = (-a + std::sqrt(discriminant)) / T(2);
+    return root > T(0) ? root : default_value;
 }
 
 // Solve a cubic equation y=c_0+c_1*x+c_2*x^2+c_3*x^3 and return the minimal
 // positive root. If no positive root exists, return default_value.
-inline GSPLAT_HOST_DEVICE float
-cubic_minimal_positive(std::array<float, 4> const &poly, float y, float default_value) {
+template <typename T = float>
+inline GSPLAT_HOST_DEVICE T cubic_minimal_positive(
+    std::array<T, 4> const &poly, type_identity_t<T> y, type_identity_t<T> default_value
+) {
     auto const &[c0, c1, c2, c3] = poly;
-    if (c3 == 0.f) {
+    if (c3 == T(0)) {
         // reduce to y = c0 + c1*x + c2*x^2
-        return quadratic_minimal_positive({c0, c1, c2}, y, default_value);
+        return quadratic_minimal_positive<T>({c0, c1, c2}, y, default_value);
     } else if (c0 == y) {
         // reduce to x(c1 + c2*x + c3*x^2) = 0
-        return quadratic_minimal_positive({c1, c2, c3}, 0.f, default_value);
+        return quadratic_minimal_positive<T>({c1, c2, c3}, T(0), default_value);
     }
 
     // normalize the equation to 1 + ax + bx^2 + cx^3 = 0
@@ -145,37 +158,37 @@ cubic_minimal_positive(std::array<float, 4> const &poly, float y, float default_
     auto const b = c2 / (c0 - y);
     auto const c = c3 / (c0 - y);
 
-    float boc = b / c;
-    float boc2 = boc * boc;
+    T boc = b / c;
+    T boc2 = boc * boc;
 
-    float t1 = (9.0f * a * boc - 2.0f * b * boc2 - 27.0f) / c;
-    float t2 = 3.0f * a / c - boc2;
-    float delta = t1 * t1 + 4.0f * t2 * t2 * t2;
+    T t1 = (T(9) * a * boc - T(2) * b * boc2 - T(27)) / c;
+    T t2 = T(3) * a / c - boc2;
+    T delta = t1 * t1 + T(4) * t2 * t2 * t2;
 
-    if (delta >= 0.0f) {
+    if (delta >= T(0)) {
         // One real root case
-        float d2 = std::sqrt(delta);
-        float cube_root = std::cbrt((d2 + t1) / 2.0f);
-        if (cube_root == 0.0f)
+        T d2 = std::sqrt(delta);
+        T cube_root = std::cbrt((d2 + t1) / T(2));
+        if (cube_root == T(0))
             return default_value;
 
-        float soln = (cube_root - (t2 / cube_root) - boc) / 3.0f;
-        return soln > 0.0f ? soln : default_value;
+        T soln = (cube_root - (t2 / cube_root) - boc) / T(3);
+        return soln > T(0) ? soln : default_value;
     } else {
-        constexpr float PI = 3.14159265358979323846f;
-        constexpr float two_third_pi = 2.f * PI / 3.f;
+        constexpr T PI = T(3.14159265358979323846);
+        constexpr T two_third_pi = T(2) * PI / T(3);
 
         // Three real roots case (delta < 0)
-        float theta = std::atan2(std::sqrt(-delta), t1) / 3.0f;
+        T theta = std::atan2(std::sqrt(-delta), t1) / T(3);
 
-        float t3 = 2.0f * std::sqrt(-t2);
-        float min_soln = std::numeric_limits<float>::max();
+        T t3 = T(2) * std::sqrt(-t2);
+        T min_soln = std::numeric_limits<T>::max();
         bool soln_found = false;
 
         for (int i : {-1, 0, 1}) {
-            float angle = theta + i * two_third_pi;
-            float s = (t3 * std::cos(angle) - boc) / 3.0f;
-            if (s > 0.0f) {
+            T angle = theta + T(i) * two_third_pi;
+            T s = (t3 * std::cos(angle) - boc) / T(3);
+            if (s > T(0)) {
                 min_soln = std::min(min_soln, s);
                 soln_found = true;
             }
@@ -190,33 +203,36 @@ cubic_minimal_positive(std::array<float, 4> const &poly, float y, float default_
 //
 // using newton method and return the minimal positive root.
 // If no positive root exists or netwon does not converge, return default_value.
-template <size_t N_ITER = 20, size_t N_COEFFS>
-inline GSPLAT_HOST_DEVICE float polyN_minimal_positive_newton(
-    std::array<float, N_COEFFS> const &poly, float y, float guess, float default_value
+template <size_t N_ITER = 20, size_t N_COEFFS, typename T>
+inline GSPLAT_HOST_DEVICE T polyN_minimal_positive_newton(
+    std::array<T, N_COEFFS> const &poly,
+    type_identity_t<T> y,
+    type_identity_t<T> guess,
+    type_identity_t<T> default_value
 ) {
     // check if all coefficients from x^4 onwards are zero
     if (tinyrend::math::is_all_zero<4, N_COEFFS>(poly)) {
         // reduce to cubic
-        return cubic_minimal_positive(
+        return cubic_minimal_positive<T>(
             {poly[0], poly[1], poly[2], poly[3]}, y, default_value
         );
     }
 
     // compute the derivative of the polynomial
-    auto d_poly = std::array<float, N_COEFFS - 1>{};
+    auto d_poly = std::array<T, N_COEFFS - 1>{};
 #pragma unroll
     for (size_t i = 0; i < N_COEFFS - 1; ++i) {
-        d_poly[i] = (i + 1) * poly[i + 1];
+        d_poly[i] = T(i + 1) * poly[i + 1];
     }
     // define the residual and Jacobian of the equation
-    auto const func = [&y, &poly, &d_poly](const float &x) -> std::pair<float, float> {
+    auto const func = [&y, &poly, &d_poly](const T &x) -> std::pair<T, T> {
         auto const J = tinyrend::math::eval_poly_horner<N_COEFFS - 1>(d_poly, x);
         auto const residual = tinyrend::math::eval_poly_horner<N_COEFFS>(poly, x) - y;
         return {residual, J};
     };
     // solve the equation.
-    auto const &[root, converged] = newton<1, N_ITER>(func, guess, 1e-6f);
-    return (converged && root > 0.f) ? root : default_value;
+    auto const &[root, converged] = newton<1, N_ITER>(func, guess, T(1e-6));
+    return (converged && root > T(0)) ? root : default_value;
 }
 
 // Solve a polynomial y=f(x) with
@@ -226,9 +242,12 @@ inline GSPLAT_HOST_DEVICE float polyN_minimal_positive_newton(
 // and return the minimal positive root. Use analytically derived formula for
 // up to cubic polynomials and newton method for higher order polynomials.
 // If no positive root exists or newton does not converge, return default_value.
-template <size_t N_ITER = 20, size_t N_COEFFS>
-inline GSPLAT_HOST_DEVICE float poly_minimal_positive(
-    std::array<float, N_COEFFS> const &poly, float y, float guess, float default_value
+template <size_t N_ITER = 20, size_t N_COEFFS, typename T>
+inline GSPLAT_HOST_DEVICE T poly_minimal_positive(
+    std::array<T, N_COEFFS> const &poly,
+    type_identity_t<T> y,
+    type_identity_t<T> guess,
+    type_identity_t<T> default_value
 ) {
     if constexpr (N_COEFFS == 1) {
         // f(x) = c_0*x^0
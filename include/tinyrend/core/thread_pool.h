@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tinyrend/core/huge_pages.h"
+#include "tinyrend/core/numa.h"
+
+namespace tinyrend::thread_pool {
+
+/// \brief Persistent pool of CPU workers pinned per NUMA node.
+///
+/// Workers are numbered node-major: workers [0, k0) run on node 0, [k0, k0+k1)
+/// on node 1, and so on. `parallel_for` statically assigns the contiguous
+/// element range `partition(n, w)` to worker `w`, so a buffer initialized with
+/// `first_touch_fill` has its pages resident on the node of the worker that
+/// later processes them. Idle workers steal chunks, first from workers on the
+/// same node and only then from remote nodes.
+class ThreadPool {
+  public:
+    /// \param n_threads Number of workers (0 = one per allowed CPU)
+    /// \param pin Pin each worker to one CPU of its node
+    explicit ThreadPool(size_t n_threads = 0, bool pin = true) {
+        const auto &topo = numa::topology();
+        if (n_threads == 0)
+            n_threads = topo.n_cpus();
+        n_threads = std::max<size_t>(n_threads, 1);
+
+        // Split workers across nodes proportionally to the CPU count per node.
+        const size_t n_cpus = topo.n_cpus();
+        size_t assigned = 0;
+        for (size_t node = 0; node < topo.n_nodes(); ++node) {
+            size_t count = n_threads * topo.cpus[node].size() / n_cpus;
+            if (node + 1 == topo.n_nodes())
+                count = n_threads - assigned;
+            for (size_t i = 0; i < count; ++i) {
+                const auto &cpus = topo.cpus[node];
+                worker_node_.push_back(node);
+                worker_cpu_.push_back(cpus[i % cpus.size()]);
+            }
+            assigned += count;
+        }
+        n_nodes_ = topo.n_nodes();
+
+        // Victim order per worker: same node first (ring), then remote nodes.
+        steal_order_.resize(n_threads);
+        for (size_t w = 0; w < n_threads; ++w) {
+            for (size_t hop = 0; hop < n_nodes_; ++hop) {
+                const size_t node = (worker_node_[w] + hop) % n_nodes_;
+                for (size_t k = 1; k <= n_threads; ++k) {
+                    const size_t v = (w + k) % n_threads;
+                    if (v != w && worker_node_[v] == node)
+                        steal_order_[w].push_back(v);
+                }
+            }
+        }
+
+        ranges_.reset(new Range[n_threads]);
+        workers_.reserve(n_threads);
+        for (size_t w = 0; w < n_threads; ++w) {
+            workers_.emplace_back([this, w, pin] { worker_loop(w, pin); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_cv_.notify_all();
+        for (auto &t : workers_)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers_.size(); }
+    size_t n_nodes() const { return n_nodes_; }
+    size_t node_of(size_t worker) const { return worker_node_[worker]; }
+    int cpu_of(size_t worker) const { return worker_cpu_[worker]; }
+
+    /// \brief Static range [begin, end) of `n` elements owned by `worker`.
+    std::pair<size_t, size_t> partition(size_t n, size_t worker) const {
+        const size_t n_workers = size();
+        const size_t base = n / n_workers, rem = n % n_workers;
+        const size_t begin = base * worker + std::min(worker, rem);
+        return {begin, begin + base + (worker < rem ? 1 : 0)};
+    }
+
+    /// \brief Index of the calling thread within this pool, or -1.
+    long current_worker() const { return tls_pool() == this ? tls_worker() : -1; }
+
+    /// \brief Run `func(worker)` once for every worker index and wait for
+    /// completion.
+    ///
+    /// Calls made from inside a worker of this pool run all indices inline on
+    /// the calling worker, which keeps nested parallelism deadlock-free.
+    void run(const std::function<void(size_t)> &func) {
+        if (current_worker() >= 0) {
+            for (size_t w = 0; w < size(); ++w)
+                func(w);
+            return;
+        }
+        std::lock_guard<std::recursive_mutex> submit_lock(submit_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &func;
+            error_ = nullptr;
+            pending_ = size();
+            ++generation_;
+        }
+        wake_cv_.notify_all();
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_cv_.wait(lock, [this] { return pending_ == 0; });
+            job_ = nullptr;
+            error = error_;
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    /// \brief Queue `task` to run once on some worker, between `run` jobs.
+    ///
+    /// Lets long-lived executors (see core/scheduler.h) share the workers
+    /// instead of starting threads of their own. A task should return after a
+    /// bounded amount of work, since a `run` job waits for every worker, and
+    /// must not throw. Queued tasks still run when the pool is destroyed.
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        wake_cv_.notify_one();
+    }
+
+    /// \brief Parallel loop over [0, n) calling `func(begin, end)` per chunk.
+    ///
+    /// \param n Number of elements
+    /// \param func Callable taking (begin, end)
+    /// \param grain Chunk size for stealing (0 = 1/8 of a worker's range)
+    template <typename Func> void parallel_for(size_t n, Func &&func, size_t grain = 0) {
+        if (n == 0)
+            return;
+        const size_t n_workers = size();
+        if (grain == 0)
+            grain = std::max<size_t>(1, n / (n_workers * 8));
+        if (n_workers == 1 || n <= grain || current_worker() >= 0) {
+            func(size_t(0), n);
+            return;
+        }
+        std::lock_guard<std::recursive_mutex> submit_lock(submit_mutex_);
+        for (size_t w = 0; w < n_workers; ++w) {
+            const auto [begin, end] = partition(n, w);
+            ranges_[w].next.store(begin, std::memory_order_relaxed);
+            ranges_[w].end = end;
+        }
+        run([&](size_t w) {
+            drain(w, grain, func);
+            for (size_t victim : steal_order_[w])
+                drain(victim, grain, func);
+        });
+    }
+
+  private:
+    struct alignas(64) Range {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    template <typename Func> void drain(size_t w, size_t grain, Func &func) {
+        Range &r = ranges_[w];
+        for (;;) {
+            const size_t begin = r.next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= r.end)
+                return;
+            func(begin, std::min(begin + grain, r.end));
+        }
+    }
+
+    static const ThreadPool *&tls_pool() {
+        thread_local const ThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    static long &tls_worker() {
+        thread_local long worker = -1;
+        return worker;
+    }
+
+    void worker_loop(size_t w, bool pin) {
+        if (pin)
+            numa::pin_current_thread(worker_cpu_[w]);
+        tls_pool() = this;
+        tls_worker() = static_cast<long>(w);
+        size_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t)> *job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_cv_.wait(lock, [&] {
+                    return stop_ || generation_ != seen || !tasks_.empty();
+                });
+                // `run` jobs go first: they block their caller on every worker.
+                if (generation_ == seen) {
+                    if (tasks_.empty())
+                        return; // stopping, nothing queued
+                    auto task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                    lock.unlock();
+                    task();
+                    continue;
+                }
+                seen = generation_;
+                job = job_;
+            }
+            try {
+                (*job)(w);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+                done_cv_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::vector<size_t> worker_node_;
+    std::vector<int> worker_cpu_;
+    std::vector<std::vector<size_t>> steal_order_;
+    std::unique_ptr<Range[]> ranges_;
+    size_t n_nodes_ = 1;
+
+    std::recursive_mutex submit_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(size_t)> *job_ = nullptr;
+    std::deque<std::function<void()>> tasks_;
+    std::exception_ptr error_;
+    size_t pending_ = 0;
+    size_t generation_ = 0;
+    bool stop_ = false;
+};
+
+/// \brief Process-wide pool. Size can be overridden with TINYREND_NUM_THREADS.
+inline ThreadPool &global_pool() {
+    static ThreadPool pool([] {
+        const char *env = std::getenv("TINYREND_NUM_THREADS");
+        return env ? static_cast<size_t>(std::strtoul(env, nullptr, 10)) : size_t(0);
+    }());
+    return pool;
+}
+
+/// \brief Parallel loop over [0, n) on the global pool.
+template <typename Func> void parallel_for(size_t n, Func &&func, size_t grain = 0) {
+    global_pool().parallel_for(n, std::forward<Func>(func), grain);
+}
+
+/// \brief Fill `data[0, n)` in parallel so every page is first touched by the
+/// worker (and therefore the NUMA node) that owns it in `parallel_for`.
+template <typename T> void first_touch_fill(T *data, size_t n, const T &value) {
+    auto &pool = global_pool();
+    pool.run([&](size_t w) {
+        const auto [begin, end] = pool.partition(n, w);
+        std::fill(data + begin, data + end, value);
+    });
+}
+
+/// \brief Allocate a page-aligned buffer of `n` elements and initialize it with
+/// `first_touch_fill`. Release with `first_touch_free`.
+///
+/// Buffers of at least 2 MiB are huge-page aligned and advised for transparent
+/// huge pages unless `huge` is OFF (see core/huge_pages.h).
+template <typename T>
+T *first_touch_alloc(
+    size_t n, const T &value = T{}, huge_pages::Mode huge = huge_pages::default_mode()
+) {
+    T *data = static_cast<T *>(huge_pages::aligned_alloc(n * sizeof(T), huge));
+    first_touch_fill(data, n, value);
+    return data;
+}
+
+template <typename T> void first_touch_free(T *data) { std::free(data); }
+
+} // namespace tinyrend::thread_pool
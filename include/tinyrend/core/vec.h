@@ -33,6 +33,16 @@ template <typename T, size_t N> struct alignas(T) vec {
         return result;
     }
 
+    // Element-wise conversion, e.g. between fp32 registers and f16 / bf16 storage
+    template <typename U> __host__ __device__ vec<U, N> cast() const {
+        vec<U, N> result;
+#pragma unroll
+        for (size_t i = 0; i < N; ++i) {
+            result[i] = static_cast<U>(data[i]);
+        }
+        return result;
+    }
+
     // Access operators
     __host__ __device__ T &operator[](size_t i) { return data[i]; }
     __host__ __device__ const T &operator[](size_t i) const { return data[i]; }
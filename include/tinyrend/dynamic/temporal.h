@@ -0,0 +1,460 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#include "tinyrend/core/thread_pool.h"
+
+namespace tinyrend::dynamic {
+
+/*
+    Time-varying Gaussians evaluated at a timestamp.
+
+    Every Gaussian has a temporal centre t_c and extent s_t. At time t, with
+    dt = t - t_c,
+
+        opacity(t) = opacity * exp(-0.5 (dt / s_t)²)
+        mean(t)    = mean + sum_{k=1..D} motion_k dt^k   (D = motion_degree)
+        quat(t)    = normalize(quat + angular_velocity dt)
+        scale(t)   = scale
+
+    A Gaussian with s_t <= 0 or s_t = inf is static in opacity (it never
+    fades) but still moves.
+
+    `build_temporal_index` stores the parameters as structure of arrays and
+    buckets the time axis. A Gaussian is listed in every bucket its active
+    interval |dt| <= s_t sqrt(2 ln(opacity / alpha_min)) overlaps; Gaussians
+    that never fade are kept in a separate list. `evaluate_at` thus only
+    visits the Gaussians of one bucket plus the static ones, drops those below
+    alpha_min at t, and evaluates the rest in blocks: the parameters of a block
+    are gathered into contiguous scratch, where the motion polynomial and the
+    quaternion update and normalization run 8 lanes at a time with AVX. The
+    output is the [n_active, ...] layout the projection takes as input.
+*/
+
+/// \brief Read-only view of the dynamic Gaussians of a sequence.
+struct DynamicGaussians {
+    size_t n_gaussians = 0;
+    uint32_t motion_degree = 0;
+    const float *means = nullptr;              // [n_gaussians, 3] at t_centers
+    const float *motions = nullptr;            // [n_gaussians, motion_degree, 3]
+    const float *quats = nullptr;              // [n_gaussians, 4] at t_centers
+    const float *angular_velocities = nullptr; // [n_gaussians, 4] or nullptr
+    const float *scales = nullptr;             // [n_gaussians, 3]
+    const float *opacities = nullptr;          // [n_gaussians]
+    const float *t_centers = nullptr;          // [n_gaussians]
+    const float *t_scales = nullptr;           // [n_gaussians]
+};
+
+struct TemporalIndexConfig {
+    /// Temporal opacity below which a Gaussian is culled.
+    float alpha_min = 1.f / 255.f;
+    /// Number of time buckets; 0 = about two buckets per mean active interval.
+    uint32_t n_buckets = 0;
+    /// Upper bound on the automatic bucket count.
+    uint32_t max_buckets = 4096;
+};
+
+struct TemporalIndex {
+    float t_begin = 0.f;
+    float bucket_width = 1.f;
+    uint32_t n_buckets = 0;
+    uint32_t motion_degree = 0;
+    float alpha_min = 1.f / 255.f;
+
+    std::vector<uint32_t> bucket_offsets; // [n_buckets + 1]
+    std::vector<uint32_t> bucket_ids;     // [n_entries], ascending per bucket
+    std::vector<uint32_t> static_ids;     // never fade
+
+    // structure of arrays, indexed by Gaussian id
+    std::array<std::vector<float>, 3> mean;
+    std::vector<std::vector<float>> motion; // [motion_degree * 3][n]
+    std::array<std::vector<float>, 4> quat;
+    std::array<std::vector<float>, 4> angular_velocity; // empty if none
+    std::array<std::vector<float>, 3> scale;
+    std::vector<float> opacity;
+    std::vector<float> t_center;
+    std::vector<float> inv_t_scale; // 0 = static
+
+    auto n_gaussians() const -> size_t { return opacity.size(); }
+};
+
+/// \brief Active Gaussians at one timestamp. Buffers are reused across calls.
+struct DynamicFrame {
+    float time = 0.f;
+    size_t n_active = 0;
+    size_t n_candidates = 0;      // Gaussians visited to find the active ones
+    std::vector<uint32_t> ids;    // [n_active] source Gaussian ids
+    std::vector<float> means;     // [n_active, 3]
+    std::vector<float> quats;     // [n_active, 4], normalized
+    std::vector<float> scales;    // [n_active, 3]
+    std::vector<float> opacities; // [n_active], temporal opacity
+
+    // Per-worker culling scratch of `evaluate_at`: (id, dt, opacity) of the
+    // active Gaussians in the worker's candidate range. Kept across calls so
+    // its capacity is reused; only grown with the pool.
+    struct WorkerScratch {
+        std::vector<uint32_t> ids;
+        std::vector<float> dts, opacities;
+    };
+    std::vector<WorkerScratch> scratch;
+};
+
+/// \brief Build the time-bucketed index of a sequence.
+/// \param gaussians Dynamic Gaussians
+/// \param cfg Culling threshold and bucket count
+/// \return Index for `evaluate_at`
+inline auto build_temporal_index(
+    const DynamicGaussians &gaussians, const TemporalIndexConfig &cfg = {}
+) -> TemporalIndex {
+    const size_t n = gaussians.n_gaussians;
+    if (n >= std::numeric_limits<uint32_t>::max())
+        throw std::invalid_argument("build_temporal_index: too many Gaussians");
+    if (gaussians.motion_degree > 0 && gaussians.motions == nullptr)
+        throw std::invalid_argument("build_temporal_index: motions is null");
+
+    TemporalIndex index;
+    index.alpha_min = cfg.alpha_min;
+    index.motion_degree = gaussians.motion_degree;
+    const uint32_t D = gaussians.motion_degree;
+    for (auto &v : index.mean)
+        v.resize(n);
+    index.motion.assign(size_t(D) * 3, std::vector<float>(n));
+    for (auto &v : index.quat)
+        v.resize(n);
+    if (gaussians.angular_velocities != nullptr) {
+        for (auto &v : index.angular_velocity)
+            v.resize(n);
+    }
+    for (auto &v : index.scale)
+        v.resize(n);
+    index.opacity.resize(n);
+    index.t_center.resize(n);
+    index.inv_t_scale.resize(n);
+
+    // transpose to SoA; active half-interval per Gaussian (< 0 = never
+    // active, inf = static)
+    std::vector<float> radius(n);
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                index.mean[k][i] = gaussians.means[3 * i + k];
+                index.scale[k][i] = gaussians.scales[3 * i + k];
+            }
+            for (uint32_t d = 0; d < D; ++d)
+                for (int k = 0; k < 3; ++k)
+                    index.motion[3 * d + k][i] = gaussians.motions[(i * D + d) * 3 + k];
+            auto const *omega = gaussians.angular_velocities;
+            for (int k = 0; k < 4; ++k) {
+                index.quat[k][i] = gaussians.quats[4 * i + k];
+                if (omega != nullptr)
+                    index.angular_velocity[k][i] = omega[4 * i + k];
+            }
+            auto const opacity = gaussians.opacities[i];
+            auto const s = gaussians.t_scales[i];
+            index.opacity[i] = opacity;
+            index.t_center[i] = gaussians.t_centers[i];
+            const bool is_static = !(s > 0.f) || std::isinf(s);
+            index.inv_t_scale[i] = is_static ? 0.f : 1.f / s;
+            if (!(opacity >= cfg.alpha_min))
+                radius[i] = -1.f;
+            else if (is_static)
+                radius[i] = std::numeric_limits<float>::infinity();
+            else
+                radius[i] = s * std::sqrt(2.f * std::log(opacity / cfg.alpha_min));
+        }
+    });
+
+    // time range covered by the fading Gaussians
+    float t_min = std::numeric_limits<float>::infinity();
+    float t_max = -std::numeric_limits<float>::infinity();
+    double sum_length = 0.0;
+    size_t n_fading = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (radius[i] < 0.f)
+            continue;
+        if (std::isinf(radius[i])) {
+            index.static_ids.push_back(uint32_t(i));
+            continue;
+        }
+        t_min = std::min(t_min, index.t_center[i] - radius[i]);
+        t_max = std::max(t_max, index.t_center[i] + radius[i]);
+        sum_length += 2.0 * radius[i];
+        n_fading += 1;
+    }
+    if (n_fading == 0) {
+        index.bucket_offsets.assign(1, 0);
+        return index;
+    }
+
+    uint32_t n_buckets = cfg.n_buckets;
+    const float span = std::max(t_max - t_min, 1e-6f);
+    if (n_buckets == 0) {
+        auto const mean_length = std::max(sum_length / double(n_fading), 1e-6);
+        auto const max_buckets = double(std::max(cfg.max_buckets, 1u));
+        n_buckets = static_cast<uint32_t>(
+            std::clamp(std::ceil(2.0 * span / mean_length), 1.0, max_buckets)
+        );
+    }
+    index.n_buckets = n_buckets;
+    index.t_begin = t_min;
+    index.bucket_width = span / float(n_buckets);
+
+    auto const bucket_range = [&](size_t i) -> std::pair<uint32_t, uint32_t> {
+        auto const to_bucket = [&](float t) -> uint32_t {
+            auto const b = std::floor((t - index.t_begin) / index.bucket_width);
+            return static_cast<uint32_t>(std::clamp(b, 0.f, float(n_buckets - 1)));
+        };
+        return {
+            to_bucket(index.t_center[i] - radius[i]),
+            to_bucket(index.t_center[i] + radius[i]) + 1
+        };
+    };
+
+    // CSR: count, prefix sum, fill (ascending ids per bucket)
+    std::vector<uint32_t> counts(n_buckets, 0);
+    for (size_t i = 0; i < n; ++i) {
+        if (radius[i] < 0.f || std::isinf(radius[i]))
+            continue;
+        auto const [first, last] = bucket_range(i);
+        for (uint32_t b = first; b < last; ++b)
+            counts[b] += 1;
+    }
+    index.bucket_offsets.assign(n_buckets + 1, 0);
+    for (uint32_t b = 0; b < n_buckets; ++b)
+        index.bucket_offsets[b + 1] = index.bucket_offsets[b] + counts[b];
+    index.bucket_ids.resize(index.bucket_offsets.back());
+    std::copy(
+        index.bucket_offsets.begin(), index.bucket_offsets.end() - 1, counts.begin()
+    );
+    for (size_t i = 0; i < n; ++i) {
+        if (radius[i] < 0.f || std::isinf(radius[i]))
+            continue;
+        auto const [first, last] = bucket_range(i);
+        for (uint32_t b = first; b < last; ++b)
+            index.bucket_ids[counts[b]++] = uint32_t(i);
+    }
+    return index;
+}
+
+namespace detail {
+
+// Gaussians per block of `evaluate_active`.
+constexpr size_t EVAL_BLOCK = 64;
+
+// acc[j] = (acc[j] + c[j]) * dt[j]: one Horner step of the motion polynomial.
+inline auto horner_step(float *acc, const float *c, const float *dt, const size_t n)
+    -> void {
+    size_t j = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+    for (; j + 8 <= n; j += 8) {
+        auto const sum =
+            _mm256_add_ps(_mm256_loadu_ps(acc + j), _mm256_loadu_ps(c + j));
+        _mm256_storeu_ps(acc + j, _mm256_mul_ps(sum, _mm256_loadu_ps(dt + j)));
+    }
+#endif
+    for (; j < n; ++j)
+        acc[j] = (acc[j] + c[j]) * dt[j];
+}
+
+// q[j] += c[j] * dt[j]
+inline auto add_product(float *q, const float *c, const float *dt, const size_t n)
+    -> void {
+    size_t j = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+    for (; j + 8 <= n; j += 8) {
+        auto const product =
+            _mm256_mul_ps(_mm256_loadu_ps(c + j), _mm256_loadu_ps(dt + j));
+        _mm256_storeu_ps(q + j, _mm256_add_ps(_mm256_loadu_ps(q + j), product));
+    }
+#endif
+    for (; j < n; ++j)
+        q[j] += c[j] * dt[j];
+}
+
+// norm[j] = 1 / |q_j| (0 for a zero quaternion), q given as 4 component rows.
+inline auto
+inverse_norms(const float (*q)[EVAL_BLOCK], float *norm, const size_t n) -> void {
+    size_t j = 0;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+    for (; j + 8 <= n; j += 8) {
+        auto sq = _mm256_setzero_ps();
+        for (int k = 0; k < 4; ++k) {
+            auto const v = _mm256_loadu_ps(q[k] + j);
+            sq = _mm256_add_ps(sq, _mm256_mul_ps(v, v));
+        }
+        auto const inv = _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(sq));
+        auto const positive = _mm256_cmp_ps(sq, _mm256_setzero_ps(), _CMP_GT_OQ);
+        _mm256_storeu_ps(norm + j, _mm256_and_ps(positive, inv));
+    }
+#endif
+    for (; j < n; ++j) {
+        auto const sq = q[0][j] * q[0][j] + q[1][j] * q[1][j] + q[2][j] * q[2][j] +
+                        q[3][j] * q[3][j];
+        norm[j] = sq > 0.f ? 1.f / std::sqrt(sq) : 0.f;
+    }
+}
+
+// Evaluate `n` active Gaussians (ids, dt, temporal opacity) into the
+// [n, ...] outputs, in blocks of contiguous SoA scratch.
+inline auto evaluate_active(
+    const TemporalIndex &index,
+    const size_t n,
+    const uint32_t *ids,
+    const float *dts,
+    const float *opacities,
+    float *means,
+    float *quats,
+    float *scales,
+    float *out_opacities
+) -> void {
+    constexpr size_t BLOCK = EVAL_BLOCK;
+    const uint32_t D = index.motion_degree;
+    const bool spin = !index.angular_velocity[0].empty();
+    alignas(64) float dt[BLOCK], acc[BLOCK], c[BLOCK], q[4][BLOCK], norm[BLOCK];
+
+    for (size_t start = 0; start < n; start += BLOCK) {
+        const size_t nb = std::min(BLOCK, n - start);
+        const uint32_t *id = ids + start;
+        std::copy(dts + start, dts + start + nb, dt);
+
+        // mean: Horner in dt over the motion polynomial
+        for (int k = 0; k < 3; ++k) {
+            for (size_t j = 0; j < nb; ++j)
+                acc[j] = 0.f;
+            for (uint32_t d = D; d-- > 0;) {
+                auto const &coef = index.motion[3 * d + k];
+                for (size_t j = 0; j < nb; ++j)
+                    c[j] = coef[id[j]];
+                horner_step(acc, c, dt, nb);
+            }
+            auto const &base = index.mean[k];
+            for (size_t j = 0; j < nb; ++j)
+                means[3 * (start + j) + k] = base[id[j]] + acc[j];
+        }
+
+        // rotation: first order in dt, then normalize
+        for (int k = 0; k < 4; ++k) {
+            auto const &base = index.quat[k];
+            for (size_t j = 0; j < nb; ++j)
+                q[k][j] = base[id[j]];
+            if (spin) {
+                auto const &rate = index.angular_velocity[k];
+                for (size_t j = 0; j < nb; ++j)
+                    c[j] = rate[id[j]];
+                add_product(q[k], c, dt, nb);
+            }
+        }
+        inverse_norms(q, norm, nb);
+        for (size_t j = 0; j < nb; ++j)
+            for (int k = 0; k < 4; ++k)
+                quats[4 * (start + j) + k] = q[k][j] * norm[j];
+
+        for (int k = 0; k < 3; ++k) {
+            auto const &base = index.scale[k];
+            for (size_t j = 0; j < nb; ++j)
+                scales[3 * (start + j) + k] = base[id[j]];
+        }
+        std::copy(opacities + start, opacities + start + nb, out_opacities + start);
+    }
+}
+
+} // namespace detail
+
+/// \brief Evaluate the Gaussians active at time `t`.
+///
+/// Only the Gaussians of the bucket containing `t` and the static ones are
+/// visited; the cost does not depend on the length of the sequence.
+/// \param index Index from `build_temporal_index`
+/// \param t Timestamp
+/// \param frame Output; its buffers are reused
+inline auto evaluate_at(const TemporalIndex &index, const float t, DynamicFrame &frame)
+    -> void {
+    frame.time = t;
+
+    // candidates: one bucket, then the static Gaussians
+    const uint32_t *bucket = nullptr;
+    size_t n_bucket = 0;
+    if (index.n_buckets > 0) {
+        auto const b = std::floor((t - index.t_begin) / index.bucket_width);
+        if (b >= 0.f && b < float(index.n_buckets)) {
+            auto const i = static_cast<uint32_t>(b);
+            bucket = index.bucket_ids.data() + index.bucket_offsets[i];
+            n_bucket = index.bucket_offsets[i + 1] - index.bucket_offsets[i];
+        } else if (b == float(index.n_buckets)) {
+            // t exactly at the end of the range
+            auto const i = index.n_buckets - 1;
+            bucket = index.bucket_ids.data() + index.bucket_offsets[i];
+            n_bucket = index.bucket_offsets[i + 1] - index.bucket_offsets[i];
+        }
+    }
+    const size_t n_candidates = n_bucket + index.static_ids.size();
+    frame.n_candidates = n_candidates;
+    auto const candidate = [&](size_t k) -> uint32_t {
+        return k < n_bucket ? bucket[k] : index.static_ids[k - n_bucket];
+    };
+
+    // per worker: cull its candidate range into compact (id, dt, opacity)
+    auto &pool = thread_pool::global_pool();
+    const size_t n_workers = pool.size();
+    if (frame.scratch.size() < n_workers)
+        frame.scratch.resize(n_workers);
+    auto &active = frame.scratch;
+    pool.run([&](size_t w) {
+        auto const [begin, end] = pool.partition(n_candidates, w);
+        auto &a = active[w];
+        a.ids.clear();
+        a.dts.clear();
+        a.opacities.clear();
+        for (size_t k = begin; k < end; ++k) {
+            auto const i = candidate(k);
+            auto const dt = t - index.t_center[i];
+            auto const z = dt * index.inv_t_scale[i];
+            auto const opacity = index.opacity[i] * std::exp(-0.5f * z * z);
+            if (opacity < index.alpha_min)
+                continue;
+            a.ids.push_back(i);
+            a.dts.push_back(dt);
+            a.opacities.push_back(opacity);
+        }
+    });
+
+    std::vector<size_t> offsets(n_workers + 1, 0);
+    for (size_t w = 0; w < n_workers; ++w)
+        offsets[w + 1] = offsets[w] + active[w].ids.size();
+    const size_t n_active = offsets.back();
+    frame.n_active = n_active;
+    frame.ids.resize(n_active);
+    frame.means.resize(3 * n_active);
+    frame.quats.resize(4 * n_active);
+    frame.scales.resize(3 * n_active);
+    frame.opacities.resize(n_active);
+
+    pool.run([&](size_t w) {
+        auto const &a = active[w];
+        auto const o = offsets[w];
+        std::copy(a.ids.begin(), a.ids.end(), frame.ids.begin() + o);
+        detail::evaluate_active(
+            index,
+            a.ids.size(),
+            a.ids.data(),
+            a.dts.data(),
+            a.opacities.data(),
+            frame.means.data() + 3 * o,
+            frame.quats.data() + 4 * o,
+            frame.scales.data() + 3 * o,
+            frame.opacities.data() + o
+        );
+    });
+}
+
+} // namespace tinyrend::dynamic
@@ -7,11 +7,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <glm/glm.hpp>
+#include <stdexcept>
+#include <vector>
+
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
 
 #include "tinyrend/core/macros.h" // for GSPLAT_HOST_DEVICE
+#include "tinyrend/core/thread_pool.h"
 #include "tinyrend/estimator/hermgauss.h"
 
 namespace tinyrend::ghq {
@@ -361,4 +369,198 @@ GSPLAT_HOST_DEVICE inline auto estimate_jacobian_and_hessian(
     return {J, H};
 }
 
+/// @private
+// C[rows x cols] = A[rows x inner] * B[inner x cols], all row-major.
+//
+// Register-blocked: each 4 x 16 tile of C is accumulated over the whole inner
+// dimension before it is stored. With AVX, full tiles are kept in eight 8-wide
+// registers (two per row of C) and updated with FMA where available; edge
+// tiles, and full tiles without AVX, use scalar loops over local arrays.
+inline void gemm_blocked(
+    const int rows,
+    const int inner,
+    const int cols,
+    const float *A,
+    const float *B,
+    float *C
+) {
+    constexpr int TILE_ROWS = 4;
+    constexpr int TILE_COLS = 16;
+    for (int i0 = 0; i0 < rows; i0 += TILE_ROWS) {
+        const int ni = std::min(TILE_ROWS, rows - i0);
+        for (int j0 = 0; j0 < cols; j0 += TILE_COLS) {
+            const int nj = std::min(TILE_COLS, cols - j0);
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+            if (ni == TILE_ROWS && nj == TILE_COLS) {
+                __m256 acc[TILE_ROWS][2];
+                for (int r = 0; r < TILE_ROWS; ++r)
+                    acc[r][0] = acc[r][1] = _mm256_setzero_ps();
+                for (int k = 0; k < inner; ++k) {
+                    const float *b = B + size_t(k) * cols + j0;
+                    auto const b0 = _mm256_loadu_ps(b);
+                    auto const b1 = _mm256_loadu_ps(b + 8);
+                    for (int r = 0; r < TILE_ROWS; ++r) {
+                        auto const a = _mm256_set1_ps(A[size_t(i0 + r) * inner + k]);
+#if defined(__FMA__)
+                        acc[r][0] = _mm256_fmadd_ps(a, b0, acc[r][0]);
+                        acc[r][1] = _mm256_fmadd_ps(a, b1, acc[r][1]);
+#else
+                        acc[r][0] = _mm256_add_ps(acc[r][0], _mm256_mul_ps(a, b0));
+                        acc[r][1] = _mm256_add_ps(acc[r][1], _mm256_mul_ps(a, b1));
+#endif
+                    }
+                }
+                for (int r = 0; r < TILE_ROWS; ++r) {
+                    float *c = C + size_t(i0 + r) * cols + j0;
+                    _mm256_storeu_ps(c, acc[r][0]);
+                    _mm256_storeu_ps(c + 8, acc[r][1]);
+                }
+                continue;
+            }
+#endif
+            float acc[TILE_ROWS][TILE_COLS] = {};
+            if (ni == TILE_ROWS && nj == TILE_COLS) {
+                for (int k = 0; k < inner; ++k) {
+                    const float *b = B + size_t(k) * cols + j0;
+#pragma unroll
+                    for (int r = 0; r < TILE_ROWS; ++r) {
+                        const float a = A[size_t(i0 + r) * inner + k];
+#pragma unroll
+                        for (int c = 0; c < TILE_COLS; ++c) {
+                            acc[r][c] += a * b[c];
+                        }
+                    }
+                }
+            } else {
+                for (int k = 0; k < inner; ++k) {
+                    const float *b = B + size_t(k) * cols + j0;
+                    for (int r = 0; r < ni; ++r) {
+                        const float a = A[size_t(i0 + r) * inner + k];
+                        for (int c = 0; c < nj; ++c) {
+                            acc[r][c] += a * b[c];
+                        }
+                    }
+                }
+            }
+            for (int r = 0; r < ni; ++r) {
+                for (int c = 0; c < nj; ++c) {
+                    C[size_t(i0 + r) * cols + j0 + c] = acc[r][c];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Estimates the Jacobians and Hessians of a function at many points.
+ *
+ * Batched version of `estimate_jacobian_and_hessian` for the CPU. The points
+ * are split over the global thread pool; each worker evaluates the function on
+ * the quadrature nodes of a block of points into a [samples x (points * M)]
+ * matrix and applies the regression coefficients [features x samples] to the
+ * whole block with a single blocked GEMM, instead of one dot product per
+ * point, output dimension and feature.
+ *
+ * @tparam N Input dimension of the function
+ * @tparam M Output dimension of the function
+ * @tparam order Order of the Gauss-Hermite quadrature (default: 3)
+ *
+ * @param f The function to differentiate, `f(x) -> glm::vec<M, float>`; called
+ *     concurrently from several threads
+ * @param n_points Number of points
+ * @param mus The points at which to estimate derivatives [n_points]
+ * @param std_devs The standard deviation for each input dimension [n_points]
+ * @param jacobians Output Jacobians [n_points]
+ * @param hessians Output Hessians [n_points]
+ * @param block_points Number of points per GEMM (default: 64)
+ * @throws std::invalid_argument if block_points is 0
+ */
+template <int N, int M, int order = 3, typename Func>
+inline void estimate_jacobian_and_hessian_batched(
+    Func const &f,
+    const size_t n_points,
+    const glm::vec<N, float> *mus,
+    const glm::vec<N, float> *std_devs,
+    glm::mat<M, N, float> *jacobians,
+    std::array<glm::mat<N, N, float>, M> *hessians,
+    const size_t block_points = 64
+) {
+    if (block_points == 0)
+        throw std::invalid_argument("block_points must be positive");
+    auto const matrices = get_precomputed_matrices<N, order>();
+    constexpr int n_samples = static_cast<int>(matrices.points_std.size());
+    constexpr int n_features = num_quadratic_features<N>();
+
+    // coefficients as a row-major [features x samples] matrix
+    std::vector<float> coefficients(size_t(n_features) * n_samples);
+    for (int i = 0; i < n_features; ++i) {
+        std::copy(
+            matrices.coefficients[i].begin(),
+            matrices.coefficients[i].end(),
+            coefficients.begin() + size_t(i) * n_samples
+        );
+    }
+
+    const size_t n_blocks = (n_points + block_points - 1) / block_points;
+    tinyrend::thread_pool::parallel_for(n_blocks, [&](size_t begin, size_t end) {
+        std::vector<float> outputs(size_t(n_samples) * block_points * M);
+        std::vector<float> theta(size_t(n_features) * block_points * M);
+        for (size_t block = begin; block < end; ++block) {
+            const size_t first = block * block_points;
+            const size_t n = std::min(block_points, n_points - first);
+            const int cols = static_cast<int>(n * M);
+
+            // Evaluate function at all points
+            for (size_t p = 0; p < n; ++p) {
+                auto const &mu = mus[first + p];
+                auto const &std_dev = std_devs[first + p];
+                for (int s = 0; s < n_samples; ++s) {
+                    auto const y = f(mu + matrices.points_std[s] * std_dev);
+                    for (int m = 0; m < M; ++m) {
+                        outputs[size_t(s) * cols + p * M + m] = y[m];
+                    }
+                }
+            }
+
+            // Regression coefficients of the whole block
+            gemm_blocked(
+                n_features,
+                n_samples,
+                cols,
+                coefficients.data(),
+                outputs.data(),
+                theta.data()
+            );
+
+            // Extract Jacobians and Hessians
+            for (size_t p = 0; p < n; ++p) {
+                auto const &std_dev = std_devs[first + p];
+                auto &J = jacobians[first + p];
+                auto &H = hessians[first + p];
+                for (int m = 0; m < M; ++m) {
+                    auto const theta_at = [&](int feature) {
+                        return theta[size_t(feature) * cols + p * M + m];
+                    };
+                    for (int i = 0; i < N; ++i) {
+                        J[m][i] = theta_at(1 + i) / std_dev[i];
+                    }
+                    int k = 0;
+                    for (int i = 0; i < N; ++i) {
+                        for (int j = i; j < N; ++j) {
+                            float coeff =
+                                theta_at(1 + N + k) / (std_dev[i] * std_dev[j]);
+                            if (i == j) {
+                                coeff *= 2.0f;
+                            }
+                            H[m][i][j] = coeff;
+                            H[m][j][i] = coeff; // symmetric
+                            ++k;
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
 } // namespace tinyrend::ghq
\ No newline at end of file
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <array>
+#include <cmath>
 #include <functional>
 #include <glm/glm.hpp>
 #include <tuple>
@@ -24,6 +25,24 @@ template <int M, typename Aux> struct UnscentedTransformResult {
     Aux aux;
 };
 
+/// \brief Sigma points and their images, kept from the forward pass for
+/// `transform_vjp`
+/// \tparam N Input dimension of the function
+/// \tparam M Output dimension of the function
+template <int N, int M> struct UnscentedTransformCache {
+    static constexpr int num_sigma = 2 * N + 1;
+    /// \brief Sigma points: mu, mu + std_dev * sqrt_covar[i], mu - ...
+    glm::vec<N, float> sigma_points[num_sigma];
+    /// \brief Images of the sigma points under the function
+    glm::vec<M, float> transformed_points[num_sigma];
+    float weights_mean[num_sigma];
+    float weights_covar[num_sigma];
+    /// \brief Scale of the sigma points, sqrt(N + lambda)
+    float std_dev;
+    /// \brief Mean of the transformed distribution
+    glm::vec<M, float> mu;
+};
+
 /**
  * @brief Performs the Unscented Transform (UT) on a nonlinear function.
  *
@@ -41,6 +60,8 @@ template <int M, typename Aux> struct UnscentedTransformResult {
  *     (transformed_point, valid_flag, aux_data)
  * @param mu Mean of the input distribution
  * @param sqrt_covar Square root of the input covariance matrix
+ * @param cache If not null, receives the sigma points and their images for
+ *     `transform_vjp` (only meaningful if the transform succeeds)
  * @param alpha Spread of the sigma points (default: 0.1)
  * @param beta Prior knowledge parameter (default: 2.0)
  * @param kappa Secondary scaling parameter (default: 0.0)
@@ -56,6 +77,7 @@ GSPLAT_HOST_DEVICE inline auto transform(
     Func const &f,
     glm::vec<N, float> const &mu,
     glm::mat<N, N, float> const &sqrt_covar,
+    UnscentedTransformCache<N, M> *cache,
     const float &alpha = 0.1f,
     const float &beta = 2.0f,
     const float &kappa = 0.0f
@@ -118,7 +140,144 @@ GSPLAT_HOST_DEVICE inline auto transform(
         covar_ut += weights_covar[i] * glm::outerProduct(diff, diff);
     }
 
+    if (cache != nullptr) {
+#pragma unroll
+        for (int i = 0; i < num_sigma; i++) {
+            cache->sigma_points[i] = sigma_points[i];
+            cache->transformed_points[i] = transformed_points[i];
+            cache->weights_mean[i] = weights_mean[i];
+            cache->weights_covar[i] = weights_covar[i];
+        }
+        cache->std_dev = std_dev;
+        cache->mu = mu_ut;
+    }
+
     return {mu_ut, covar_ut, true, center_aux};
 }
 
+/// \brief Unscented Transform without keeping the sigma points
+template <int N, int M, typename Aux, typename Func>
+GSPLAT_HOST_DEVICE inline auto transform(
+    Func const &f,
+    glm::vec<N, float> const &mu,
+    glm::mat<N, N, float> const &sqrt_covar,
+    const float &alpha = 0.1f,
+    const float &beta = 2.0f,
+    const float &kappa = 0.0f
+) -> UnscentedTransformResult<M, Aux> {
+    return transform<N, M, Aux>(
+        f, mu, sqrt_covar, (UnscentedTransformCache<N, M> *)nullptr, alpha, beta, kappa
+    );
+}
+
+/// \brief Gradients of the inputs of the Unscented Transform
+template <int N> struct UnscentedTransformGradient {
+    glm::vec<N, float> v_mu;
+    glm::mat<N, N, float> v_sqrt_covar;
+};
+
+/**
+ * @brief Vector-Jacobian product of the Unscented Transform, using the sigma
+ * points cached by the forward pass.
+ *
+ * The output gradients are first distributed to the transformed sigma points,
+ *
+ *     v_y_i = wm_i v_mu + wc_i (V + Vᵀ) d_i - wm_i Σ_j wc_j (V + Vᵀ) d_j,
+ *
+ * with d_i = y_i - mu_ut and V = v_covar, then pulled back through the function
+ * by `vjp_f` and through the sigma points to `mu` and `sqrt_covar`.
+ *
+ * @param vjp_f VJP of the function: vjp_f(x, v_y, v_aux) -> glm::vec<N, float>.
+ *     `v_aux` is the gradient of the aux data and is only non-zero for the
+ *     center sigma point (i.e. `AuxGrad{}` for the others).
+ * @param cache Sigma points filled by `transform`
+ * @param v_mu Gradient of the output mean
+ * @param v_covar Gradient of the output covariance
+ * @param v_aux Gradient of the aux data of the center sigma point
+ *
+ * @return Gradients of `mu` and `sqrt_covar`
+ */
+template <int N, int M, typename AuxGrad, typename VjpFunc>
+GSPLAT_HOST_DEVICE inline auto transform_vjp(
+    VjpFunc const &vjp_f,
+    UnscentedTransformCache<N, M> const &cache,
+    glm::vec<M, float> const &v_mu,
+    glm::mat<M, M, float> const &v_covar,
+    AuxGrad const &v_aux = {}
+) -> UnscentedTransformGradient<N> {
+    constexpr int num_sigma = 2 * N + 1;
+
+    // covar_ut = Σ wc_i d_i d_iᵀ, so d(covar_ut) / d(d_i) gives (V + Vᵀ) wc_i d_i
+    auto const v_covar_sym = v_covar + glm::transpose(v_covar);
+    glm::vec<M, float> v_diffs[num_sigma];
+    auto v_mean_from_covar = glm::vec<M, float>{};
+#pragma unroll
+    for (int i = 0; i < num_sigma; i++) {
+        auto const diff = cache.transformed_points[i] - cache.mu;
+        v_diffs[i] = cache.weights_covar[i] * (v_covar_sym * diff);
+        v_mean_from_covar -= v_diffs[i];
+    }
+    auto const v_mean = v_mu + v_mean_from_covar;
+
+    // pull back through the function
+    glm::vec<N, float> v_sigma_points[num_sigma];
+#pragma unroll
+    for (int i = 0; i < num_sigma; i++) {
+        auto const v_point = cache.weights_mean[i] * v_mean + v_diffs[i];
+        if (i == 0) {
+            v_sigma_points[i] = vjp_f(cache.sigma_points[i], v_point, v_aux);
+        } else {
+            v_sigma_points[i] = vjp_f(cache.sigma_points[i], v_point, AuxGrad{});
+        }
+    }
+
+    // pull back through the sigma points
+    UnscentedTransformGradient<N> grad;
+    grad.v_mu = glm::vec<N, float>{};
+#pragma unroll
+    for (int i = 0; i < num_sigma; i++) {
+        grad.v_mu += v_sigma_points[i];
+    }
+#pragma unroll
+    for (int i = 0; i < N; i++) {
+        grad.v_sqrt_covar[i] =
+            cache.std_dev * (v_sigma_points[i + 1] - v_sigma_points[i + 1 + N]);
+    }
+    return grad;
+}
+
+/**
+ * @brief Vector-Jacobian product of the Unscented Transform, re-evaluating the
+ * function at the sigma points instead of caching them from the forward pass.
+ *
+ * Trades 2N+1 extra function evaluations for not storing the cache.
+ *
+ * @param f The function of the forward pass
+ * @param valid_flag Set to false if a sigma point is invalid (gradients are
+ *     then zero)
+ * @see transform_vjp for the remaining parameters
+ */
+template <int N, int M, typename Aux, typename AuxGrad, typename Func, typename VjpFunc>
+GSPLAT_HOST_DEVICE inline auto transform_vjp(
+    Func const &f,
+    VjpFunc const &vjp_f,
+    glm::vec<N, float> const &mu,
+    glm::mat<N, N, float> const &sqrt_covar,
+    glm::vec<M, float> const &v_mu,
+    glm::mat<M, M, float> const &v_covar,
+    AuxGrad const &v_aux,
+    bool &valid_flag,
+    const float &alpha = 0.1f,
+    const float &beta = 2.0f,
+    const float &kappa = 0.0f
+) -> UnscentedTransformGradient<N> {
+    UnscentedTransformCache<N, M> cache;
+    valid_flag =
+        transform<N, M, Aux>(f, mu, sqrt_covar, &cache, alpha, beta, kappa).valid_flag;
+    if (!valid_flag) {
+        return {glm::vec<N, float>{}, glm::mat<N, N, float>{}};
+    }
+    return transform_vjp<N, M, AuxGrad>(vjp_f, cache, v_mu, v_covar, v_aux);
+}
+
 } // namespace tinyrend::ut
@@ -93,7 +93,7 @@ inline GSPLAT_HOST_DEVICE auto quat_scale_to_covar_vjp(
     auto const R = quat_to_rotmat(quat);
     auto const M = glm::fmat3(R[0] * scale[0], R[1] * scale[1], R[2] * scale[2]);
 
-    auto const v_M = v_covar * M + M * glm::transpose(v_covar);
+    auto const v_M = (v_covar + glm::transpose(v_covar)) * M;
     auto const v_R =
         glm::fmat3(v_M[0] * scale[0], v_M[1] * scale[1], v_M[2] * scale[2]);
 
@@ -42,13 +42,23 @@ enum struct CameraType {
 template <CameraType CAMERA_TYPE> struct DistortionParameters {};
 
 template <> struct DistortionParameters<CameraType::PINHOLE> {
-    float *radial_coeffs = nullptr;
-    float *tangential_coeffs = nullptr;
-    float *thin_prism_coeffs = nullptr;
+    const float *radial_coeffs = nullptr;
+    const float *tangential_coeffs = nullptr;
+    const float *thin_prism_coeffs = nullptr;
 };
 
 template <> struct DistortionParameters<CameraType::FISHEYE> {
-    float *radial_coeffs = nullptr;
+    const float *radial_coeffs = nullptr;
+};
+
+template <> struct DistortionParameters<CameraType::DISTORTED_PINHOLE> {
+    const float *radial_coeffs = nullptr;     // [6]
+    const float *tangential_coeffs = nullptr; // [2]
+    const float *thin_prism_coeffs = nullptr; // [4]
+};
+
+template <> struct DistortionParameters<CameraType::DISTORTED_FISHEYE> {
+    const float *radial_coeffs = nullptr; // [4]
 };
 
 struct ProjectionForwardResult {
@@ -132,11 +142,13 @@ GSPLAT_HOST_DEVICE inline auto projection_forward(
             radial_coeffs;
         std::array<float, 2> tangential_coeffs;
         std::array<float, 4> thin_prism_coeffs;
-        if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
+        if constexpr (CAMERA_TYPE == CameraType::PINHOLE ||
+                      CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
             radial_coeffs = make_array<6>(dist_params.radial_coeffs);
             tangential_coeffs = make_array<2>(dist_params.tangential_coeffs);
             thin_prism_coeffs = make_array<4>(dist_params.thin_prism_coeffs);
-        } else if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
+        } else if constexpr (CAMERA_TYPE == CameraType::FISHEYE ||
+                             CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
             radial_coeffs = make_array<4>(dist_params.radial_coeffs);
         }
 
@@ -298,10 +310,31 @@ GSPLAT_HOST_DEVICE inline auto projection_forward(
                 glm::fvec4(quat_ptr[0], quat_ptr[1], quat_ptr[2], quat_ptr[3]);
             auto const scale = glm::fvec3(scale_ptr[0], scale_ptr[1], scale_ptr[2]);
             auto const covar = tinyrend::gaussian::quat_scale_to_covar(quat, scale);
-            // transform covariance to camera space, then to image space
-            auto const covar_c =
-                tinyrend::se3::transform_covar(world_to_camera_R, covar);
-            covar2d = J * covar_c * glm::transpose(J);
+            if (shutter_type == tinyrend::camera::shutter::Type::GLOBAL) {
+                // transform covariance to camera space, then to image space
+                auto const covar_c =
+                    tinyrend::se3::transform_covar(world_to_camera_R, covar);
+                covar2d = J * covar_c * glm::transpose(J);
+            } else {
+                // the exposure time depends on the image point, so project
+                // with the world-to-image Jacobian of the rolling shutter
+                auto const velocity = tinyrend::camera::shutter::camera_point_velocity(
+                    mu,
+                    world_to_camera_R,
+                    world_to_camera_R0,
+                    world_to_camera_t0,
+                    world_to_camera_R1,
+                    world_to_camera_t1
+                );
+                auto const time_grad =
+                    tinyrend::camera::shutter::relative_frame_time_grad(
+                        {width, height}, shutter_type
+                    );
+                auto const J_world = tinyrend::camera::shutter::rolling_shutter_jac(
+                    J, world_to_camera_R, velocity, time_grad
+                );
+                covar2d = J_world * covar * glm::transpose(J_world);
+            }
         }
 
         // reach here mean_ptr valid
@@ -311,316 +344,435 @@ GSPLAT_HOST_DEVICE inline auto projection_forward(
     return {means2d, depth, covar2d, valid_flag};
 }
 
+/// \brief Cheap estimate of the error of the linearized projection, in pixels.
+///
+/// The linearized path (`J Σ Jᵀ`) drops the second-order terms of the camera
+/// model over the Gaussian's footprint. They scale as `f (σ / d)² κ`, where
+/// `σ / d` is the angular size of the Gaussian and `κ` the curvature of the
+/// camera model at its position (perspective off-axis angle, fisheye angle,
+/// distortion polynomial). For rolling shutters the linearized path models
+/// the pose change across the footprint to first order only (see
+/// `shutter::rolling_shutter_jac`); the remainder is estimated as the image
+/// motion during readout, scaled by the footprint's share of the image and by
+/// its angular size. Gaussians with a large estimate are worth the cost of the
+/// unscented transform; the estimate is only a heuristic and does not check
+/// visibility.
+///
+/// \return Estimated error in pixels, or 0 when the mean is behind the camera
+template <CameraType CAMERA_TYPE>
+GSPLAT_HOST_DEVICE inline auto projection_nonlinearity(
+    const float *intrinsic_ptr,        // [3, 3]
+    const float *world_to_camera0_ptr, // [4, 4]
+    const float *world_to_camera1_ptr, // [4, 4]
+    const tinyrend::camera::shutter::Type shutter_type,
+    const uint32_t width,
+    const uint32_t height,
+    const float *mean_ptr,  // [3]
+    const float *scale_ptr, // [3]
+    const DistortionParameters<CAMERA_TYPE> &dist_params = {}
+) -> float {
+    auto const world_to_camera0 = glm::transpose(glm::make_mat4(world_to_camera0_ptr));
+    auto const mu = glm::fvec3(mean_ptr[0], mean_ptr[1], mean_ptr[2]);
+    auto const mu_c = tinyrend::se3::transform_point(
+        glm::fmat3(world_to_camera0), glm::fvec3(world_to_camera0[3]), mu
+    );
+    if (CAMERA_TYPE != CameraType::ORTHO && !(mu_c.z > 0.f)) {
+        return 0.f;
+    }
+    auto const focal = std::max(intrinsic_ptr[0], intrinsic_ptr[4]);
+    auto const sigma = std::max(scale_ptr[0], std::max(scale_ptr[1], scale_ptr[2]));
+
+    // angular footprint and off-axis position
+    auto const dist = glm::length(mu_c);
+    auto const footprint = CAMERA_TYPE == CameraType::ORTHO ? 0.f : sigma / dist;
+    auto const r = glm::length(glm::fvec2(mu_c)) / mu_c.z; // tan of the angle
+    auto const theta = std::atan(r);
+
+    float curvature = 0.f;
+    if constexpr (CAMERA_TYPE == CameraType::PINHOLE ||
+                  CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+        curvature = 1.f + r;
+    } else if constexpr (CAMERA_TYPE == CameraType::FISHEYE ||
+                         CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
+        curvature = 1.f + theta;
+    }
+    // second derivative of the distortion polynomial at the current radius
+    if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+        auto const k = make_array<6>(dist_params.radial_coeffs);
+        auto const p = make_array<2>(dist_params.tangential_coeffs);
+        auto const s = make_array<4>(dist_params.thin_prism_coeffs);
+        auto r_pow = r; // r^(2i - 1)
+        for (int i = 1; i <= 3; ++i) {
+            curvature += (std::abs(k[i - 1]) + std::abs(k[i + 2])) * 2.f * i *
+                         (2.f * i + 1.f) * r_pow;
+            r_pow *= r * r;
+        }
+        curvature += 6.f * (std::abs(p[0]) + std::abs(p[1]));
+        curvature += 2.f * (std::abs(s[0]) + std::abs(s[2])) +
+                     12.f * (std::abs(s[1]) + std::abs(s[3])) * r * r;
+    } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
+        auto const k = make_array<4>(dist_params.radial_coeffs);
+        auto theta_pow = theta; // theta^(2i - 1)
+        for (int i = 1; i <= 4; ++i) {
+            curvature += std::abs(k[i - 1]) * 2.f * i * (2.f * i + 1.f) * theta_pow;
+            theta_pow *= theta * theta;
+        }
+    }
+    auto error = focal * footprint * footprint * curvature;
+
+    if (shutter_type != tinyrend::camera::shutter::Type::GLOBAL) {
+        // image motion of the mean during readout, in pixels
+        auto const world_to_camera1 =
+            glm::transpose(glm::make_mat4(world_to_camera1_ptr));
+        auto const mu_c1 = tinyrend::se3::transform_point(
+            glm::fmat3(world_to_camera1), glm::fvec3(world_to_camera1[3]), mu
+        );
+        auto const motion = CAMERA_TYPE == CameraType::ORTHO
+                                ? focal * glm::length(mu_c1 - mu_c)
+                                : focal * glm::length(mu_c1 - mu_c) / dist;
+        auto const extent =
+            shutter_type == tinyrend::camera::shutter::Type::ROLLING_TOP_TO_BOTTOM ||
+                    shutter_type ==
+                        tinyrend::camera::shutter::Type::ROLLING_BOTTOM_TO_TOP
+                ? float(height)
+                : float(width);
+        auto const footprint_px = CAMERA_TYPE == CameraType::ORTHO
+                                      ? focal * sigma
+                                      : focal * footprint;
+        auto const second_order = CAMERA_TYPE == CameraType::ORTHO ? 1.f : footprint;
+        error += motion * footprint_px / extent * second_order;
+    }
+    return error;
+}
+
 struct ProjectionBackwardResult {
     glm::fvec3 v_mean;
     glm::fvec4 v_quat;
     glm::fvec3 v_scale;
-    glm::fmat4 v_world_to_camera0;
-    glm::fmat4 v_world_to_camera1;
+    glm::fmat4 v_world_to_camera0; // w.r.t. the column-major (glm) matrix
+    glm::fmat4 v_world_to_camera1; // w.r.t. the column-major (glm) matrix
 };
 
-// template <CameraType CAMERA_TYPE, bool USE_UT = false>
-// GSPLAT_HOST_DEVICE inline auto projection_backward(
-//     // inputs
-//     const float *intrinsic_ptr, // [3, 3]
-//     const float near_plane,
-//     const float far_plane,
-//     const float *world_to_camera0_ptr, // [4, 4]
-//     const float *world_to_camera1_ptr, // [4, 4]
-//     const tinyrend::camera::shutter::Type shutter_type,
-//     const uint32_t width,
-//     const uint32_t height,
-//     const float *mean_ptr,  // [3]
-//     const float *quat_ptr,  // [4]
-//     const float *scale_ptr, // [3]
-//     // outputs
-//     float *mean2d_ptr,  // [2]
-//     float *depth_ptr,   // [1]
-//     float *covar2d_ptr, // [2, 2]
-//     // output gradients
-//     float *v_mean2d_ptr,  // [2]
-//     float *v_depth_ptr,   // [1]
-//     float *v_covar2d_ptr, // [2, 2]
-//     // inputs with default values
-//     const float margin_factor = 0.15f,
-//     const DistortionParameters<CAMERA_TYPE> &dist_params = {}
-// ) -> ProjectionBackwardResult {
-
-//     // prepare return values
-//     glm::fvec3 v_mean = {};
-//     glm::fmat3 v_covar = {};
-//     glm::fmat3 v_world_to_camera_R = {};
-//     glm::fvec3 v_world_to_camera_t = {};
-
-//     do {
-//         // load output gradients
-//         auto const v_mean2d = glm::make_vec2(v_mean2d_ptr);
-//         auto const v_depth = v_depth_ptr[0];
-//         auto const v_covar2d = glm::make_mat2(v_covar2d_ptr);
-
-//         glm::fmat3 const world_to_camera_R;
-//         auto const world_to_camera_Rt = glm::transpose(world_to_camera_R);
-
-//         if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
-//             auto const J = tinyrend::camera::fisheye::project_jac(mu, focal_length);
-//             auto const Jt = glm::transpose(J);
-
-//             auto const v_mean_c = Jt * v_mean2d;
-//             v_mean += world_to_camera_Rt * v_mean_c;
-//             v_world_to_camera_R += glm::outerProduct(v_mean_c, mean);
-//             v_world_to_camera_t += v_mean_c;
-
-//             auto const v_covar_c = Jt * v_covar2d * J;
-//             v_covar += world_to_camera_Rt * v_covar_c * world_to_camera_R;
-//             v_world_to_camera_R +=
-//                 v_covar_c * world_to_camera_R * glm::transpose(covar) +
-//                 glm::transpose(v_covar_c) * world_to_camera_R * covar;
-
-//             auto const v_J = v_covar2d * J * glm::transpose(covar) +
-//                              glm::transpose(v_covar2d) * J * covar;
-//             auto const &[H1, H2] = tinyrend::camera::fisheye::project_hess(mu,
-//             focal_length);
-//         }
-
-//         // load extrinsics
-//         // note glm is column-major, and we assume the input is row-major
-//         auto const world_to_camera0 =
-//             glm::transpose(glm::make_mat4(world_to_camera0_ptr));
-//         auto const world_to_camera_R0 = glm::fmat3(world_to_camera0);
-//         auto const world_to_camera_t0 = glm::fvec3(world_to_camera0[3]);
-
-//         // load the second extrinsics for rolling shutter
-//         glm::fmat3 world_to_camera_R1;
-//         glm::fvec3 world_to_camera_t1;
-//         if (shutter_type != tinyrend::camera::shutter::Type::GLOBAL) {
-//             auto const world_to_camera1 =
-//                 glm::transpose(glm::make_mat4(world_to_camera1_ptr));
-//             world_to_camera_R1 = glm::fmat3(world_to_camera1);
-//             world_to_camera_t1 = glm::fvec3(world_to_camera1[3]);
-//         }
-
-//         // transform world to camera
-//         auto const mu = glm::fvec3(mean_ptr[0], mean_ptr[1], mean_ptr[2]);
-//         auto const mu_c0 =
-//             tinyrend::se3::transform_point(world_to_camera_R0, world_to_camera_t0,
-//             mu);
-//         if (shutter_type == tinyrend::camera::shutter::Type::GLOBAL) {
-//             // If point is not in the frustum, skip
-//             if (mu_c0.z < near_plane || mu_c0.z > far_plane) {
-//                 break;
-//             }
-//         } else {
-//             // For rolling shutter, only skip if the point is not in either frustum
-//             auto const mu_c1 = tinyrend::se3::transform_point(
-//                 world_to_camera_R1, world_to_camera_t1, mu
-//             );
-//             if ((mu_c0.z < near_plane || mu_c0.z > far_plane) &&
-//                 (mu_c1.z < near_plane || mu_c1.z > far_plane)) {
-//                 break;
-//             }
-//         }
-
-//         // load intrinsics
-//         auto const focal_length = glm::fvec2(intrinsic_ptr[0], intrinsic_ptr[4]);
-//         auto const principal_point = glm::fvec2(intrinsic_ptr[2], intrinsic_ptr[5]);
-
-//         // load distortion coefficients
-//         std::conditional_t<
-//             CAMERA_TYPE == CameraType::PINHOLE ||
-//                 CAMERA_TYPE == CameraType::DISTORTED_PINHOLE,
-//             std::array<float, 6>,
-//             std::array<float, 4>>
-//             radial_coeffs;
-//         std::array<float, 2> tangential_coeffs;
-//         std::array<float, 4> thin_prism_coeffs;
-//         if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
-//             radial_coeffs = make_array<6>(dist_params.radial_coeffs);
-//             tangential_coeffs = make_array<2>(dist_params.tangential_coeffs);
-//             thin_prism_coeffs = make_array<4>(dist_params.thin_prism_coeffs);
-//         } else if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
-//             radial_coeffs = make_array<4>(dist_params.radial_coeffs);
-//         }
-
-//         // define function to project a camera point to an image point
-//         auto const point_camera_to_image_fn = [&focal_length,
-//                                                &principal_point,
-//                                                &width,
-//                                                &height,
-//                                                &margin_factor,
-//                                                &radial_coeffs,
-//                                                &tangential_coeffs,
-//                                                &thin_prism_coeffs](
-//                                                   const glm::fvec3 &camera_point
-//                                               ) -> std::pair<glm::fvec2, bool> {
-//             // camera to image plane
-//             glm::fvec2 image_point;
-//             bool valid_flag;
-//             if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
-//                 image_point = tinyrend::camera::fisheye::project(
-//                     camera_point, focal_length, principal_point
-//                 );
-//                 valid_flag = true;
-//             } else if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
-//                 image_point = tinyrend::camera::pinhole::project(
-//                     camera_point, focal_length, principal_point
-//                 );
-//                 valid_flag = true;
-//             } else if constexpr (CAMERA_TYPE == CameraType::ORTHO) {
-//                 image_point = tinyrend::camera::orthogonal::project(
-//                     camera_point, focal_length, principal_point
-//                 );
-//                 valid_flag = true;
-//             } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
-//                 auto const &[image_point_, valid_flag_] =
-//                 tinyrend::camera::pinhole::project(
-//                     camera_point,
-//                     focal_length,
-//                     principal_point,
-//                     radial_coeffs,
-//                     tangential_coeffs,
-//                     thin_prism_coeffs
-//                 );
-//                 image_point = image_point_;
-//                 valid_flag = valid_flag_;
-//             } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
-//                 auto const &[image_point_, valid_flag_] =
-//                 tinyrend::camera::fisheye::project(
-//                     camera_point, focal_length, principal_point, radial_coeffs
-//                 );
-//                 image_point = image_point_;
-//                 valid_flag = valid_flag_;
-//             }
-//             if (!valid_flag) {
-//                 return {glm::fvec2{}, false};
-//             }
-//             // check if in image (with a margin)
-//             auto const uv = image_point / glm::fvec2(width, height);
-//             if (uv.x < -margin_factor || uv.x > 1.f + margin_factor ||
-//                 uv.y < -margin_factor || uv.y > 1.f + margin_factor) {
-//                 return {glm::fvec2{}, false};
-//             } else {
-//                 return {image_point, true};
-//             }
-//         };
-
-//         // define function to project a world point to an image point
-//         using AuxData = std::pair<glm::fvec3, glm::fmat3>;
-//         auto const point_world_to_image_fn =
-//             [&point_camera_to_image_fn,
-//              &width,
-//              &height,
-//              &world_to_camera_R0,
-//              &world_to_camera_t0,
-//              &world_to_camera_R1,
-//              &world_to_camera_t1,
-//              &shutter_type](const glm::fvec3 &world_point
-//             ) -> std::tuple<glm::fvec2, bool, AuxData> {
-//             auto const result = tinyrend::camera::shutter::point_world_to_image(
-//                 point_camera_to_image_fn,
-//                 {width, height},
-//                 world_point,
-//                 world_to_camera_R0,
-//                 world_to_camera_t0,
-//                 world_to_camera_R1,
-//                 world_to_camera_t1,
-//                 shutter_type
-//             );
-//             return {
-//                 result.image_point,
-//                 result.valid_flag,
-//                 AuxData{result.camera_point, result.pose_r}
-//             };
-//         };
-
-//         if constexpr (USE_UT) {
-//             // load covariance
-//             auto const quat =
-//                 glm::fvec4(quat_ptr[0], quat_ptr[1], quat_ptr[2], quat_ptr[3]);
-//             auto const scale = glm::fvec3(scale_ptr[0], scale_ptr[1], scale_ptr[2]);
-//             auto const sqrt_covar =
-//                 tinyrend::gaussian::quat_scale_to_scaled_rotmat(quat, scale);
-
-//             // execute the function using unscented transform
-//             auto const result = tinyrend::ut::transform<3, 2, AuxData>(
-//                 point_world_to_image_fn, mu, sqrt_covar
-//             );
-//             if (!result.valid_flag) {
-//                 break;
-//             }
-//             means2d = result.mu;
-//             covar2d = result.covar;
-//             auto const camera_point = result.aux.first;
-//             depth = camera_point.z;
-
-//         } else {
-//             // execute the function
-//             auto const [image_point, image_point_valid_flag, aux] =
-//                 point_world_to_image_fn(mu);
-//             if (!image_point_valid_flag) {
-//                 break;
-//             }
-//             means2d = image_point;
-//             auto const camera_point = std::get<0>(aux);
-//             depth = camera_point.z;
-//             auto const world_to_camera_R = std::get<1>(aux);
-
-//             // project covariance from camera space to image space
-//             glm::fmat3x2 J;
-//             static_assert(
-//                 CAMERA_TYPE != CameraType::DISTORTED_FISHEYE,
-//                 "Jacobian for distorted fisheye is not implemented"
-//             );
-//             if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
-//                 J = tinyrend::camera::fisheye::project_jac(camera_point,
-//                 focal_length);
-//             } else if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
-//                 J = tinyrend::camera::pinhole::project_jac(camera_point,
-//                 focal_length);
-//             } else if constexpr (CAMERA_TYPE == CameraType::ORTHO) {
-//                 J = tinyrend::camera::orthogonal::project_jac(camera_point,
-//                 focal_length);
-//             } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
-//                 auto const &[J_, valid_flag_] =
-//                 tinyrend::camera::pinhole::project_jac(
-//                     camera_point,
-//                     focal_length,
-//                     radial_coeffs,
-//                     tangential_coeffs,
-//                     thin_prism_coeffs
-//                 );
-//                 if (!valid_flag_) {
-//                     break;
-//                 }
-//                 J = J_;
-//             } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
-//                 // TODO: implement
-//             }
-
-//             // load covariance
-//             auto const quat =
-//                 glm::fvec4(quat_ptr[0], quat_ptr[1], quat_ptr[2], quat_ptr[3]);
-//             auto const scale = glm::fvec3(scale_ptr[0], scale_ptr[1], scale_ptr[2]);
-//             auto const covar = tinyrend::gaussian::quat_scale_to_covar(quat, scale);
-//             // transform covariance to camera space, then to image space
-//             auto const covar_c =
-//                 tinyrend::se3::transform_covar(world_to_camera_R, covar);
-//             covar2d = J * covar_c * glm::transpose(J);
-//         }
-
-//         // reach here mean_ptr valid
-//         valid_flag = true;
-//     } while (false);
-
-//     return {means2d, depth, covar2d, valid_flag};
-// }
-
-// struct ProjectionBackwardResult {
-//     glm::fvec3 v_means;
-//     glm::fvec4 v_quats;
-//     glm::fvec3 v_scales;
-//     glm::fmat4 v_viewmats0;
-//     glm::fmat4 v_viewmats1;
-//     glm::fvec2 v_Ks;
-// };
+namespace detail {
+
+// Jacobian of the camera model used by the linearized projection.
+template <CameraType CAMERA_TYPE, typename RadialCoeffs>
+GSPLAT_HOST_DEVICE inline auto camera_project_jac(
+    const glm::fvec3 &camera_point,
+    const glm::fvec2 &focal_length,
+    const RadialCoeffs &radial_coeffs,
+    const std::array<float, 2> &tangential_coeffs,
+    const std::array<float, 4> &thin_prism_coeffs
+) -> std::pair<glm::fmat3x2, bool> {
+    if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
+        return {
+            tinyrend::camera::fisheye::project_jac(camera_point, focal_length), true
+        };
+    } else if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
+        return {
+            tinyrend::camera::pinhole::project_jac(camera_point, focal_length), true
+        };
+    } else if constexpr (CAMERA_TYPE == CameraType::ORTHO) {
+        return {
+            tinyrend::camera::orthogonal::project_jac(camera_point, focal_length), true
+        };
+    } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+        return tinyrend::camera::pinhole::project_jac(
+            camera_point,
+            focal_length,
+            radial_coeffs,
+            tangential_coeffs,
+            thin_prism_coeffs
+        );
+    } else {
+        return {glm::fmat3x2(0.f), false};
+    }
+}
+
+// Gradient of <v_J, J(camera_point)> w.r.t. the camera point.
+template <CameraType CAMERA_TYPE, typename RadialCoeffs>
+GSPLAT_HOST_DEVICE inline auto camera_project_jac_vjp(
+    const glm::fvec3 &camera_point,
+    const glm::fvec2 &focal_length,
+    const RadialCoeffs &radial_coeffs,
+    const std::array<float, 2> &tangential_coeffs,
+    const std::array<float, 4> &thin_prism_coeffs,
+    const glm::fmat3x2 &v_J
+) -> glm::fvec3 {
+    if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
+        return tinyrend::camera::pinhole::project_jac_vjp(
+            camera_point, focal_length, v_J
+        );
+    } else if constexpr (CAMERA_TYPE == CameraType::FISHEYE ||
+                         CAMERA_TYPE == CameraType::ORTHO) {
+        // row i of J is the gradient of image coordinate i, so its derivative
+        // is the Hessian H_i
+        std::array<glm::fmat3, 2> H;
+        if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
+            H = tinyrend::camera::fisheye::project_hess(camera_point, focal_length);
+        } else {
+            H = tinyrend::camera::orthogonal::project_hess(camera_point, focal_length);
+        }
+        auto v_camera_point = glm::fvec3(0.f);
+        for (int i = 0; i < 2; ++i) {
+            v_camera_point += H[i] * glm::fvec3(v_J[0][i], v_J[1][i], v_J[2][i]);
+        }
+        return v_camera_point;
+    } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+        return tinyrend::camera::pinhole::project_jac_vjp(
+            camera_point,
+            focal_length,
+            radial_coeffs,
+            tangential_coeffs,
+            thin_prism_coeffs,
+            v_J
+        );
+    } else {
+        return glm::fvec3(0.f);
+    }
+}
+
+} // namespace detail
+
+/// \brief Backward pass of the linearized `projection_forward`.
+///
+/// Recomputes the forward pass and propagates the gradients of `means2d`,
+/// `depth` and `covar2d` to the Gaussian parameters and to the camera poses.
+/// For rolling shutters the image Jacobian includes the time coupling
+/// (`shutter::rolling_shutter_correction`), which is held constant when
+/// differentiating the covariance, and the gradient of the exposure pose is
+/// split between the two poses by the relative frame time (exact for the
+/// translation, first order for the rotation).
+///
+/// \param v_mean2d_ptr Gradient of the projected mean [2]
+/// \param v_depth_ptr Gradient of the depth [1]
+/// \param v_covar2d_ptr Gradient of the projected covariance [2, 2]
+/// \return Gradients, all zero if the Gaussian was not projected
+template <CameraType CAMERA_TYPE>
+GSPLAT_HOST_DEVICE inline auto projection_backward(
+    const float *intrinsic_ptr, // [3, 3]
+    const float near_plane,
+    const float far_plane,
+    const float *world_to_camera0_ptr, // [4, 4]
+    const float *world_to_camera1_ptr, // [4, 4]
+    const tinyrend::camera::shutter::Type shutter_type,
+    const uint32_t width,
+    const uint32_t height,
+    const float *mean_ptr,      // [3]
+    const float *quat_ptr,      // [4]
+    const float *scale_ptr,     // [3]
+    const float *v_mean2d_ptr,  // [2]
+    const float *v_depth_ptr,   // [1]
+    const float *v_covar2d_ptr, // [2, 2]
+    const float margin_factor = 0.15f,
+    const DistortionParameters<CAMERA_TYPE> &dist_params = {}
+) -> ProjectionBackwardResult {
+    static_assert(
+        CAMERA_TYPE != CameraType::DISTORTED_FISHEYE,
+        "Jacobian for distorted fisheye is not implemented"
+    );
+
+    // prepare return values
+    ProjectionBackwardResult result{
+        glm::fvec3(0.f),
+        glm::fvec4(0.f),
+        glm::fvec3(0.f),
+        glm::fmat4(0.f),
+        glm::fmat4(0.f)
+    };
+
+    do {
+        // load extrinsics
+        // note glm is column-major, and we assume the input is row-major
+        auto const world_to_camera0 =
+            glm::transpose(glm::make_mat4(world_to_camera0_ptr));
+        auto const world_to_camera_R0 = glm::fmat3(world_to_camera0);
+        auto const world_to_camera_t0 = glm::fvec3(world_to_camera0[3]);
+
+        // load the second extrinsics for rolling shutter
+        glm::fmat3 world_to_camera_R1;
+        glm::fvec3 world_to_camera_t1;
+        if (shutter_type != tinyrend::camera::shutter::Type::GLOBAL) {
+            auto const world_to_camera1 =
+                glm::transpose(glm::make_mat4(world_to_camera1_ptr));
+            world_to_camera_R1 = glm::fmat3(world_to_camera1);
+            world_to_camera_t1 = glm::fvec3(world_to_camera1[3]);
+        }
+
+        // same frustum test as the forward pass
+        auto const mu = glm::fvec3(mean_ptr[0], mean_ptr[1], mean_ptr[2]);
+        auto const mu_c0 =
+            tinyrend::se3::transform_point(world_to_camera_R0, world_to_camera_t0, mu);
+        if (shutter_type == tinyrend::camera::shutter::Type::GLOBAL) {
+            if (mu_c0.z < near_plane || mu_c0.z > far_plane) {
+                break;
+            }
+        } else {
+            auto const mu_c1 = tinyrend::se3::transform_point(
+                world_to_camera_R1, world_to_camera_t1, mu
+            );
+            if ((mu_c0.z < near_plane || mu_c0.z > far_plane) &&
+                (mu_c1.z < near_plane || mu_c1.z > far_plane)) {
+                break;
+            }
+        }
+
+        // load intrinsics and distortion coefficients
+        auto const focal_length = glm::fvec2(intrinsic_ptr[0], intrinsic_ptr[4]);
+        auto const principal_point = glm::fvec2(intrinsic_ptr[2], intrinsic_ptr[5]);
+        std::conditional_t<
+            CAMERA_TYPE == CameraType::PINHOLE ||
+                CAMERA_TYPE == CameraType::DISTORTED_PINHOLE,
+            std::array<float, 6>,
+            std::array<float, 4>>
+            radial_coeffs{};
+        std::array<float, 2> tangential_coeffs{};
+        std::array<float, 4> thin_prism_coeffs{};
+        if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+            radial_coeffs = make_array<6>(dist_params.radial_coeffs);
+            tangential_coeffs = make_array<2>(dist_params.tangential_coeffs);
+            thin_prism_coeffs = make_array<4>(dist_params.thin_prism_coeffs);
+        }
+
+        // forward: world point to image point
+        auto const point_camera_to_image_fn =
+            [&](const glm::fvec3 &camera_point) -> std::pair<glm::fvec2, bool> {
+            glm::fvec2 image_point;
+            bool valid_flag = true;
+            if constexpr (CAMERA_TYPE == CameraType::FISHEYE) {
+                image_point = tinyrend::camera::fisheye::project(
+                    camera_point, focal_length, principal_point
+                );
+            } else if constexpr (CAMERA_TYPE == CameraType::PINHOLE) {
+                image_point = tinyrend::camera::pinhole::project(
+                    camera_point, focal_length, principal_point
+                );
+            } else if constexpr (CAMERA_TYPE == CameraType::ORTHO) {
+                image_point = tinyrend::camera::orthogonal::project(
+                    camera_point, focal_length, principal_point
+                );
+            } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+                std::tie(image_point, valid_flag) = tinyrend::camera::pinhole::project(
+                    camera_point,
+                    focal_length,
+                    principal_point,
+                    radial_coeffs,
+                    tangential_coeffs,
+                    thin_prism_coeffs
+                );
+            }
+            if (!valid_flag) {
+                return {glm::fvec2{}, false};
+            }
+            auto const uv = image_point / glm::fvec2(width, height);
+            if (uv.x < -margin_factor || uv.x > 1.f + margin_factor ||
+                uv.y < -margin_factor || uv.y > 1.f + margin_factor) {
+                return {glm::fvec2{}, false};
+            }
+            return {image_point, true};
+        };
+        auto const projected = tinyrend::camera::shutter::point_world_to_image(
+            point_camera_to_image_fn,
+            {width, height},
+            mu,
+            world_to_camera_R0,
+            world_to_camera_t0,
+            world_to_camera_R1,
+            world_to_camera_t1,
+            shutter_type
+        );
+        if (!projected.valid_flag) {
+            break;
+        }
+        auto const camera_point = projected.camera_point;
+        auto const R = projected.pose_r;
+        auto const [J, jac_valid_flag] = detail::camera_project_jac<CAMERA_TYPE>(
+            camera_point,
+            focal_length,
+            radial_coeffs,
+            tangential_coeffs,
+            thin_prism_coeffs
+        );
+        if (!jac_valid_flag) {
+            break;
+        }
+
+        // image Jacobian w.r.t. the camera point at the exposure pose, and the
+        // depth gradient; for rolling shutters both include the time coupling
+        auto A = glm::fmat2(1.f);
+        auto depth_grad = glm::fvec3(0.f, 0.f, 1.f);
+        float ratio = 0.f;
+        if (shutter_type != tinyrend::camera::shutter::Type::GLOBAL) {
+            auto const velocity = tinyrend::camera::shutter::camera_point_velocity(
+                mu,
+                R,
+                world_to_camera_R0,
+                world_to_camera_t0,
+                world_to_camera_R1,
+                world_to_camera_t1
+            );
+            auto const time_grad = tinyrend::camera::shutter::relative_frame_time_grad(
+                {width, height}, shutter_type
+            );
+            A = tinyrend::camera::shutter::rolling_shutter_correction(
+                J, velocity, time_grad
+            );
+            depth_grad += velocity.z * glm::transpose(A * J) * time_grad;
+            ratio = tinyrend::camera::shutter::relative_frame_time(
+                projected.image_point, {width, height}, shutter_type
+            );
+        }
+        auto const Jc = A * J;
+
+        // load covariance and output gradients
+        auto const quat =
+            glm::fvec4(quat_ptr[0], quat_ptr[1], quat_ptr[2], quat_ptr[3]);
+        auto const scale = glm::fvec3(scale_ptr[0], scale_ptr[1], scale_ptr[2]);
+        auto const covar = tinyrend::gaussian::quat_scale_to_covar(quat, scale);
+        auto const covar_c = tinyrend::se3::transform_covar(R, covar);
+        auto const v_mean2d = glm::fvec2(v_mean2d_ptr[0], v_mean2d_ptr[1]);
+        auto const v_depth = v_depth_ptr[0];
+        auto const v_covar2d = glm::make_mat2(v_covar2d_ptr);
+
+        // covar2d = Jc covar_c Jcᵀ
+        auto const v_covar_c = glm::transpose(Jc) * v_covar2d * Jc;
+        auto const v_Jc = (v_covar2d + glm::transpose(v_covar2d)) * Jc * covar_c;
+        auto const v_J = glm::transpose(A) * v_Jc;
+
+        // gradient of the camera point
+        auto const v_camera_point =
+            glm::transpose(Jc) * v_mean2d + v_depth * depth_grad +
+            detail::camera_project_jac_vjp<CAMERA_TYPE>(
+                camera_point,
+                focal_length,
+                radial_coeffs,
+                tangential_coeffs,
+                thin_prism_coeffs,
+                v_J
+            );
+
+        // camera point = R mu + t, covar_c = R covar Rᵀ
+        result.v_mean = glm::transpose(R) * v_camera_point;
+        auto const v_covar = glm::transpose(R) * v_covar_c * R;
+        std::tie(result.v_quat, result.v_scale) =
+            tinyrend::gaussian::quat_scale_to_covar_vjp(quat, scale, v_covar);
+        auto const v_R = glm::outerProduct(v_camera_point, mu) +
+                         (v_covar_c + glm::transpose(v_covar_c)) * R * covar;
+        auto const &v_t = v_camera_point;
+
+        // gradient of the exposure pose, split over the two poses
+        glm::fmat4 v_pose(0.f);
+        for (int c = 0; c < 3; ++c) {
+            v_pose[c] = glm::fvec4(v_R[c], 0.f);
+        }
+        v_pose[3] = glm::fvec4(v_t, 0.f);
+        result.v_world_to_camera0 = (1.f - ratio) * v_pose;
+        if (shutter_type != tinyrend::camera::shutter::Type::GLOBAL) {
+            result.v_world_to_camera1 = ratio * v_pose;
+        }
+    } while (false);
+
+    return result;
+}
 
 } // namespace tinyrend::impl
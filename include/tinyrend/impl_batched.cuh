@@ -0,0 +1,603 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef __CUDACC__
+#include <thrust/device_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/partition.h>
+#include <thrust/sequence.h>
+#endif
+
+#include "tinyrend/camera/shutter.h"
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/impl.h"
+#include "tinyrend/kernel_launcher.cuh"
+
+namespace tinyrend::impl {
+
+/// Number of camera types in `CameraType`.
+constexpr uint32_t N_CAMERA_TYPES = 5;
+
+/// Per-camera distortion coefficient block, interpreted by camera type:
+/// - DISTORTED_PINHOLE: radial [0, 6), tangential [6, 8), thin prism [8, 12)
+/// - DISTORTED_FISHEYE: radial [0, 4)
+/// - other types: unused
+constexpr uint32_t N_DISTORTION_COEFFS = 12;
+
+/// \brief Cameras of a batch grouped by type.
+///
+/// `order[offsets[t] .. offsets[t + 1])` lists the cameras of type `t`, in their
+/// original relative order (the grouping is a stable counting sort).
+struct CameraGroups {
+    std::vector<uint32_t> order;                         // [n_cameras]
+    std::array<uint32_t, N_CAMERA_TYPES + 1> offsets{}; // [n_types + 1]
+};
+
+/// \brief Group cameras by their type tag.
+/// \param n_cameras Number of cameras
+/// \param camera_types Type tag per camera [n_cameras] (host memory)
+/// \return Stable grouping of the cameras
+/// \throws std::invalid_argument on an unknown tag
+inline CameraGroups
+group_cameras_by_type(size_t n_cameras, const CameraType *camera_types) {
+    CameraGroups groups;
+    std::array<uint32_t, N_CAMERA_TYPES> counts{};
+    for (size_t c = 0; c < n_cameras; ++c) {
+        const auto t = static_cast<uint32_t>(camera_types[c]);
+        if (t >= N_CAMERA_TYPES)
+            throw std::invalid_argument("unknown camera type tag");
+        counts[t] += 1;
+    }
+    for (uint32_t t = 0; t < N_CAMERA_TYPES; ++t)
+        groups.offsets[t + 1] = groups.offsets[t] + counts[t];
+    groups.order.resize(n_cameras);
+    auto cursor = groups.offsets;
+    for (size_t c = 0; c < n_cameras; ++c)
+        groups.order[cursor[static_cast<uint32_t>(camera_types[c])]++] = c;
+    return groups;
+}
+
+#define PROJECTION_FORWARD_BATCHED_SIGNATURE                                           \
+    const uint32_t *__restrict__ camera_order, const float *__restrict__ intrinsics,   \
+        const float *__restrict__ distortion_coeffs,                                   \
+        const float *__restrict__ world_to_cameras0,                                   \
+        const float *__restrict__ world_to_cameras1,                                   \
+        const tinyrend::camera::shutter::Type *__restrict__ shutter_types,             \
+        const uint32_t width, const uint32_t height, const float near_plane,           \
+        const float far_plane, const float margin_factor, const size_t n_gaussians,    \
+        const float *__restrict__ means, const float *__restrict__ quats,              \
+        const float *__restrict__ scales, float *__restrict__ means2d,                 \
+        float *__restrict__ depths, float *__restrict__ covars2d,                      \
+        bool *__restrict__ valid_flags
+
+namespace detail {
+
+template <CameraType CAMERA_TYPE>
+GSPLAT_HOST_DEVICE inline auto
+make_distortion_parameters(const float *coeffs) -> DistortionParameters<CAMERA_TYPE> {
+    DistortionParameters<CAMERA_TYPE> dist_params{};
+    if (coeffs == nullptr)
+        return dist_params;
+    if constexpr (CAMERA_TYPE == CameraType::DISTORTED_PINHOLE) {
+        dist_params.radial_coeffs = coeffs;
+        dist_params.tangential_coeffs = coeffs + 6;
+        dist_params.thin_prism_coeffs = coeffs + 8;
+    } else if constexpr (CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
+        dist_params.radial_coeffs = coeffs;
+    }
+    return dist_params;
+}
+
+// Project Gaussians into the cameras `camera_order[begin, end)`, which all
+// have type CAMERA_TYPE, with a single linear launch. Pair `idx` of the group
+// is Gaussian `idx % n_gaussians` in camera `camera_order[begin + idx /
+// n_gaussians]`. Without `pairs` every pair of the group is projected,
+// otherwise only the `n_pairs` pairs listed in `pairs`.
+template <CameraType CAMERA_TYPE, bool USE_CUDA, bool USE_UT>
+void launch_projection_forward_group(
+    const uint32_t begin,
+    const uint32_t end,
+    const size_t *__restrict__ pairs,
+    const size_t n_pairs,
+    PROJECTION_FORWARD_BATCHED_SIGNATURE
+) {
+    // The linearized path has no distorted fisheye Jacobian, so that group
+    // always takes the unscented transform.
+    constexpr bool UT = USE_UT || CAMERA_TYPE == CameraType::DISTORTED_FISHEYE;
+    const size_t n_elements =
+        pairs == nullptr ? size_t(end - begin) * n_gaussians : n_pairs;
+    if (n_elements == 0)
+        return;
+    tinyrend::launch_linear_kernel<USE_CUDA>(
+        n_elements,
+        [=] GSPLAT_HOST_DEVICE(size_t i) {
+            const size_t idx = pairs == nullptr ? i : pairs[i];
+            const uint32_t camera = camera_order[begin + idx / n_gaussians];
+            const size_t g = idx % n_gaussians;
+            // Outputs stay in the caller's camera order.
+            const size_t out = camera * n_gaussians + g;
+            const auto result = projection_forward<CAMERA_TYPE, UT>(
+                intrinsics + camera * 9,
+                near_plane,
+                far_plane,
+                world_to_cameras0 + camera * 16,
+                world_to_cameras1 == nullptr ? nullptr
+                                             : world_to_cameras1 + camera * 16,
+                shutter_types == nullptr ? tinyrend::camera::shutter::Type::GLOBAL
+                                         : shutter_types[camera],
+                width,
+                height,
+                means + g * 3,
+                quats + g * 4,
+                scales + g * 3,
+                margin_factor,
+                make_distortion_parameters<CAMERA_TYPE>(
+                    distortion_coeffs == nullptr
+                        ? nullptr
+                        : distortion_coeffs + camera * N_DISTORTION_COEFFS
+                )
+            );
+            // Culled pairs are zero-filled, so callers may pass uninitialized
+            // outputs.
+            const bool valid = result.valid_flag;
+            valid_flags[out] = valid;
+            means2d[out * 2 + 0] = valid ? result.means2d[0] : 0.f;
+            means2d[out * 2 + 1] = valid ? result.means2d[1] : 0.f;
+            depths[out] = valid ? result.depth : 0.f;
+            covars2d[out * 4 + 0] = valid ? result.covar2d[0][0] : 0.f;
+            covars2d[out * 4 + 1] = valid ? result.covar2d[0][1] : 0.f;
+            covars2d[out * 4 + 2] = valid ? result.covar2d[1][0] : 0.f;
+            covars2d[out * 4 + 3] = valid ? result.covar2d[1][1] : 0.f;
+        }
+    );
+}
+
+// Decide per (camera, Gaussian) pair of the group whether the unscented
+// transform is needed, see `projection_nonlinearity`. Takes only the inputs
+// the estimate reads; the arguments are as in the forward signature.
+template <CameraType CAMERA_TYPE, bool USE_CUDA>
+void launch_classify_group(
+    const uint32_t begin,
+    const uint32_t end,
+    const uint32_t *__restrict__ camera_order,
+    const float *__restrict__ intrinsics,
+    const float *__restrict__ distortion_coeffs,
+    const float *__restrict__ world_to_cameras0,
+    const float *__restrict__ world_to_cameras1,
+    const tinyrend::camera::shutter::Type *__restrict__ shutter_types,
+    const uint32_t width,
+    const uint32_t height,
+    const size_t n_gaussians,
+    const float *__restrict__ means,
+    const float *__restrict__ scales,
+    const float ut_error_threshold,
+    bool *__restrict__ use_ut_flags
+) {
+    const size_t n_elements = size_t(end - begin) * n_gaussians;
+    if (n_elements == 0)
+        return;
+    tinyrend::launch_linear_kernel<USE_CUDA>(
+        n_elements,
+        [=] GSPLAT_HOST_DEVICE(size_t idx) {
+            const uint32_t camera = camera_order[begin + idx / n_gaussians];
+            const size_t g = idx % n_gaussians;
+            const size_t out = camera * n_gaussians + g;
+            if constexpr (CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
+                use_ut_flags[out] = true;
+            } else {
+                const float error = projection_nonlinearity<CAMERA_TYPE>(
+                    intrinsics + camera * 9,
+                    world_to_cameras0 + camera * 16,
+                    world_to_cameras1 == nullptr ? nullptr
+                                                 : world_to_cameras1 + camera * 16,
+                    shutter_types == nullptr ? tinyrend::camera::shutter::Type::GLOBAL
+                                             : shutter_types[camera],
+                    width,
+                    height,
+                    means + g * 3,
+                    scales + g * 3,
+                    make_distortion_parameters<CAMERA_TYPE>(
+                        distortion_coeffs == nullptr
+                            ? nullptr
+                            : distortion_coeffs + camera * N_DISTORTION_COEFFS
+                    )
+                );
+                use_ut_flags[out] = error > ut_error_threshold;
+            }
+        }
+    );
+}
+
+// Pair lists of `launch_projection_forward_adaptive`, in launch memory.
+#ifdef __CUDACC__
+template <bool USE_CUDA>
+using PairList =
+    std::conditional_t<USE_CUDA, thrust::device_vector<size_t>, std::vector<size_t>>;
+#else
+template <bool USE_CUDA> using PairList = std::vector<size_t>;
+#endif
+
+// Stable partition of the group's pairs [0, n_elements) by path: `pairs`
+// receives the linearized pairs followed by the unscented ones, each in
+// increasing order. Returns the number of linearized pairs.
+template <bool USE_CUDA>
+size_t partition_pairs(
+    const uint32_t begin,
+    const size_t n_elements,
+    const uint32_t *__restrict__ camera_order,
+    const size_t n_gaussians,
+    const bool *__restrict__ use_ut_flags,
+    size_t *__restrict__ pairs
+) {
+    auto const use_ut = [=] GSPLAT_HOST_DEVICE(size_t idx) -> bool {
+        const uint32_t camera = camera_order[begin + idx / n_gaussians];
+        return use_ut_flags[camera * n_gaussians + idx % n_gaussians];
+    };
+    if constexpr (USE_CUDA) {
+#ifdef __CUDACC__
+        thrust::sequence(thrust::device, pairs, pairs + n_elements, size_t(0));
+        auto const mid = thrust::stable_partition(
+            thrust::device,
+            pairs,
+            pairs + n_elements,
+            [=] GSPLAT_HOST_DEVICE(size_t idx) { return !use_ut(idx); }
+        );
+        return size_t(mid - pairs);
+#else
+        static_assert(!USE_CUDA, "CUDA launches require compiling with nvcc");
+        return 0;
+#endif
+    } else {
+        // Count the linearized pairs per worker, prefix-sum the counts into
+        // output offsets, then scatter.
+        auto &pool = thread_pool::global_pool();
+        std::vector<size_t> offsets(pool.size() + 1, 0);
+        pool.run([&](size_t w) {
+            const auto [first, last] = pool.partition(n_elements, w);
+            size_t count = 0;
+            for (size_t idx = first; idx < last; ++idx)
+                count += !use_ut(idx);
+            offsets[w + 1] = count;
+        });
+        for (size_t w = 0; w < pool.size(); ++w)
+            offsets[w + 1] += offsets[w];
+        const size_t n_linear = offsets[pool.size()];
+        pool.run([&](size_t w) {
+            const auto [first, last] = pool.partition(n_elements, w);
+            size_t linear = offsets[w];
+            size_t ut = n_linear + (first - offsets[w]);
+            for (size_t idx = first; idx < last; ++idx) {
+                if (use_ut(idx))
+                    pairs[ut++] = idx;
+                else
+                    pairs[linear++] = idx;
+            }
+        });
+        return n_linear;
+    }
+}
+
+#define TINYREND_BATCHED_ARGS                                                          \
+    camera_order, intrinsics, distortion_coeffs, world_to_cameras0, world_to_cameras1, \
+        shutter_types, width, height, near_plane, far_plane, margin_factor,            \
+        n_gaussians, means, quats, scales, means2d, depths, covars2d, valid_flags
+
+} // namespace detail
+
+/// \brief Project Gaussians into a batch of cameras of mixed types.
+///
+/// Cameras are processed per type group (see `group_cameras_by_type`), one
+/// launch per non-empty group, so each launch runs a single instantiation of
+/// `projection_forward`. Outputs are laid out as [n_cameras, n_gaussians, ...]
+/// in the original camera order regardless of the grouping. Every output entry
+/// is written; culled pairs get zeros.
+///
+/// \param groups Grouping of `camera_types`; `camera_order` must hold
+///        `groups.order` in memory accessible by the launch (device memory when
+///        USE_CUDA). n_cameras is `groups.order.size()`.
+/// \param intrinsics [n_cameras, 3, 3]
+/// \param distortion_coeffs [n_cameras, N_DISTORTION_COEFFS] or nullptr
+/// \param world_to_cameras0 [n_cameras, 4, 4] row-major
+/// \param world_to_cameras1 [n_cameras, 4, 4] or nullptr (global shutter)
+/// \param shutter_types [n_cameras] or nullptr (global shutter)
+/// \param means [n_gaussians, 3], quats [n_gaussians, 4], scales [n_gaussians, 3]
+/// \param means2d [n_cameras, n_gaussians, 2] output
+/// \param depths [n_cameras, n_gaussians] output
+/// \param covars2d [n_cameras, n_gaussians, 2, 2] output
+/// \param valid_flags [n_cameras, n_gaussians] output
+template <bool USE_CUDA, bool USE_UT = false>
+void launch_projection_forward_batched(
+    const CameraGroups &groups, PROJECTION_FORWARD_BATCHED_SIGNATURE
+) {
+#define TINYREND_LAUNCH_GROUP(TYPE)                                                    \
+    detail::launch_projection_forward_group<TYPE, USE_CUDA, USE_UT>(                   \
+        groups.offsets[static_cast<uint32_t>(TYPE)],                                   \
+        groups.offsets[static_cast<uint32_t>(TYPE) + 1],                               \
+        nullptr,                                                                       \
+        0,                                                                             \
+        TINYREND_BATCHED_ARGS                                                          \
+    )
+    TINYREND_LAUNCH_GROUP(CameraType::PINHOLE);
+    TINYREND_LAUNCH_GROUP(CameraType::FISHEYE);
+    TINYREND_LAUNCH_GROUP(CameraType::ORTHO);
+    TINYREND_LAUNCH_GROUP(CameraType::DISTORTED_PINHOLE);
+    TINYREND_LAUNCH_GROUP(CameraType::DISTORTED_FISHEYE);
+#undef TINYREND_LAUNCH_GROUP
+}
+
+/// \brief Project Gaussians into a batch of cameras of mixed types, choosing
+/// the linearized path or the unscented transform per (camera, Gaussian) pair.
+///
+/// A first launch per type group estimates the linearization error of every
+/// pair (`projection_nonlinearity`) and records the choice in `use_ut_flags`.
+/// The group's pairs are then compacted into one index list per path (a stable
+/// prefix-sum partition of the flags), and each path is launched over its own
+/// list only. Every launch thus runs a single path over densely packed pairs,
+/// so no warp executes both. Distorted fisheye cameras always use the
+/// unscented transform.
+///
+/// \param ut_error_threshold Estimated linearization error (pixels) above
+///        which the unscented transform is used
+/// \param use_ut_flags [n_cameras, n_gaussians] output: path taken per pair
+/// \see launch_projection_forward_batched for the remaining parameters
+template <bool USE_CUDA>
+void launch_projection_forward_adaptive(
+    const CameraGroups &groups,
+    const float ut_error_threshold,
+    bool *__restrict__ use_ut_flags,
+    PROJECTION_FORWARD_BATCHED_SIGNATURE
+) {
+    uint32_t max_group = 0;
+    for (uint32_t t = 0; t < N_CAMERA_TYPES; ++t)
+        max_group = std::max(max_group, groups.offsets[t + 1] - groups.offsets[t]);
+    detail::PairList<USE_CUDA> pair_list(size_t(max_group) * n_gaussians);
+    size_t *pairs = nullptr;
+    if constexpr (USE_CUDA) {
+#ifdef __CUDACC__
+        pairs = thrust::raw_pointer_cast(pair_list.data());
+#endif
+    } else {
+        pairs = pair_list.data();
+    }
+
+#define TINYREND_LAUNCH_GROUP(TYPE)                                                    \
+    do {                                                                               \
+        const uint32_t begin = groups.offsets[static_cast<uint32_t>(TYPE)];            \
+        const uint32_t end = groups.offsets[static_cast<uint32_t>(TYPE) + 1];          \
+        const size_t n_elements = size_t(end - begin) * n_gaussians;                   \
+        if (n_elements == 0)                                                           \
+            break;                                                                     \
+        detail::launch_classify_group<TYPE, USE_CUDA>(                                 \
+            begin,                                                                     \
+            end,                                                                       \
+            camera_order,                                                              \
+            intrinsics,                                                                \
+            distortion_coeffs,                                                         \
+            world_to_cameras0,                                                         \
+            world_to_cameras1,                                                         \
+            shutter_types,                                                             \
+            width,                                                                     \
+            height,                                                                    \
+            n_gaussians,                                                               \
+            means,                                                                     \
+            scales,                                                                    \
+            ut_error_threshold,                                                        \
+            use_ut_flags                                                               \
+        );                                                                             \
+        const size_t n_linear = detail::partition_pairs<USE_CUDA>(                     \
+            begin, n_elements, camera_order, n_gaussians, use_ut_flags, pairs          \
+        );                                                                             \
+        detail::launch_projection_forward_group<TYPE, USE_CUDA, false>(                \
+            begin, end, pairs, n_linear, TINYREND_BATCHED_ARGS                         \
+        );                                                                             \
+        detail::launch_projection_forward_group<TYPE, USE_CUDA, true>(                 \
+            begin, end, pairs + n_linear, n_elements - n_linear, TINYREND_BATCHED_ARGS \
+        );                                                                             \
+    } while (false)
+    TINYREND_LAUNCH_GROUP(CameraType::PINHOLE);
+    TINYREND_LAUNCH_GROUP(CameraType::FISHEYE);
+    TINYREND_LAUNCH_GROUP(CameraType::ORTHO);
+    TINYREND_LAUNCH_GROUP(CameraType::DISTORTED_PINHOLE);
+    TINYREND_LAUNCH_GROUP(CameraType::DISTORTED_FISHEYE);
+#undef TINYREND_LAUNCH_GROUP
+}
+
+#undef TINYREND_BATCHED_ARGS
+
+namespace detail {
+
+// Backward of one (camera, Gaussian) pair; returns false if it was culled.
+template <CameraType CAMERA_TYPE>
+inline auto projection_backward_pair(
+    const float *intrinsic,
+    const float *dist_coeffs,
+    const float near_plane,
+    const float far_plane,
+    const float *world_to_camera0,
+    const float *world_to_camera1,
+    const tinyrend::camera::shutter::Type shutter_type,
+    const uint32_t width,
+    const uint32_t height,
+    const float margin_factor,
+    const float *mean,
+    const float *quat,
+    const float *scale,
+    const float *v_mean2d,
+    const float *v_depth,
+    const float *v_covar2d
+) -> ProjectionBackwardResult {
+    if constexpr (CAMERA_TYPE == CameraType::DISTORTED_FISHEYE) {
+        throw std::invalid_argument(
+            "projection backward is not implemented for distorted fisheye cameras"
+        );
+    } else {
+        return projection_backward<CAMERA_TYPE>(
+            intrinsic,
+            near_plane,
+            far_plane,
+            world_to_camera0,
+            world_to_camera1,
+            shutter_type,
+            width,
+            height,
+            mean,
+            quat,
+            scale,
+            v_mean2d,
+            v_depth,
+            v_covar2d,
+            margin_factor,
+            make_distortion_parameters<CAMERA_TYPE>(dist_coeffs)
+        );
+    }
+}
+
+} // namespace detail
+
+/// \brief Backward of `launch_projection_forward_batched` (linearized path) on
+/// the CPU.
+///
+/// Gaussians are partitioned over the workers of the global thread pool, so
+/// their gradients are written without contention. The pose gradients are
+/// shared by all Gaussians: every worker accumulates them into its own
+/// [n_cameras, 2, 4, 4] buffer, and the buffers are summed at the end.
+///
+/// \param camera_types [n_cameras] (host memory)
+/// \param v_means2d [n_cameras, n_gaussians, 2] gradient of `means2d`
+/// \param v_depths [n_cameras, n_gaussians] gradient of `depths`
+/// \param v_covars2d [n_cameras, n_gaussians, 2, 2] gradient of `covars2d`
+/// \param v_means [n_gaussians, 3] output
+/// \param v_quats [n_gaussians, 4] output
+/// \param v_scales [n_gaussians, 3] output
+/// \param v_world_to_cameras0 [n_cameras, 4, 4] output (row-major) or nullptr
+/// \param v_world_to_cameras1 [n_cameras, 4, 4] output (row-major) or nullptr
+/// \tparam USE_CUDA Must be false: there is no device path yet, and USE_CUDA =
+///         true is rejected at compile time rather than silently run on the host
+/// \see launch_projection_forward_batched for the remaining parameters
+/// \throws std::invalid_argument for distorted fisheye cameras
+template <bool USE_CUDA = false>
+void projection_backward_batched(
+    const size_t n_cameras,
+    const CameraType *camera_types,
+    const float *intrinsics,
+    const float *distortion_coeffs,
+    const float *world_to_cameras0,
+    const float *world_to_cameras1,
+    const tinyrend::camera::shutter::Type *shutter_types,
+    const uint32_t width,
+    const uint32_t height,
+    const float near_plane,
+    const float far_plane,
+    const float margin_factor,
+    const size_t n_gaussians,
+    const float *means,
+    const float *quats,
+    const float *scales,
+    const float *v_means2d,
+    const float *v_depths,
+    const float *v_covars2d,
+    float *v_means,
+    float *v_quats,
+    float *v_scales,
+    float *v_world_to_cameras0,
+    float *v_world_to_cameras1
+) {
+    static_assert(!USE_CUDA, "projection_backward_batched has no CUDA path");
+    for (size_t c = 0; c < n_cameras; ++c) {
+        if (camera_types[c] == CameraType::DISTORTED_FISHEYE)
+            throw std::invalid_argument(
+                "projection backward is not implemented for distorted fisheye cameras"
+            );
+    }
+
+    auto &pool = thread_pool::global_pool();
+    // per-worker pose gradients, glm layout
+    std::vector<glm::fmat4> v_poses(pool.size() * n_cameras * 2, glm::fmat4(0.f));
+    pool.run([&](size_t w) {
+        const auto [begin, end] = pool.partition(n_gaussians, w);
+        glm::fmat4 *v_pose = &v_poses[w * n_cameras * 2];
+        for (size_t g = begin; g < end; ++g) {
+            auto v_mean = glm::fvec3(0.f);
+            auto v_quat = glm::fvec4(0.f);
+            auto v_scale = glm::fvec3(0.f);
+            for (size_t c = 0; c < n_cameras; ++c) {
+                const size_t pair = c * n_gaussians + g;
+                const auto shutter_type = shutter_types == nullptr
+                                              ? tinyrend::camera::shutter::Type::GLOBAL
+                                              : shutter_types[c];
+                ProjectionBackwardResult r;
+#define TINYREND_BACKWARD_PAIR(TYPE)                                                   \
+    detail::projection_backward_pair<TYPE>(                                            \
+        intrinsics + c * 9,                                                            \
+        distortion_coeffs == nullptr ? nullptr                                         \
+                                     : distortion_coeffs + c * N_DISTORTION_COEFFS,    \
+        near_plane,                                                                    \
+        far_plane,                                                                     \
+        world_to_cameras0 + c * 16,                                                    \
+        world_to_cameras1 == nullptr ? nullptr : world_to_cameras1 + c * 16,           \
+        shutter_type,                                                                  \
+        width,                                                                         \
+        height,                                                                        \
+        margin_factor,                                                                 \
+        means + g * 3,                                                                 \
+        quats + g * 4,                                                                 \
+        scales + g * 3,                                                                \
+        v_means2d + pair * 2,                                                          \
+        v_depths + pair,                                                               \
+        v_covars2d + pair * 4                                                          \
+    )
+                switch (camera_types[c]) {
+                case CameraType::PINHOLE:
+                    r = TINYREND_BACKWARD_PAIR(CameraType::PINHOLE);
+                    break;
+                case CameraType::FISHEYE:
+                    r = TINYREND_BACKWARD_PAIR(CameraType::FISHEYE);
+                    break;
+                case CameraType::ORTHO:
+                    r = TINYREND_BACKWARD_PAIR(CameraType::ORTHO);
+                    break;
+                case CameraType::DISTORTED_PINHOLE:
+                    r = TINYREND_BACKWARD_PAIR(CameraType::DISTORTED_PINHOLE);
+                    break;
+                default:
+                    continue;
+                }
+#undef TINYREND_BACKWARD_PAIR
+                v_mean += r.v_mean;
+                v_quat += r.v_quat;
+                v_scale += r.v_scale;
+                v_pose[c * 2 + 0] += r.v_world_to_camera0;
+                v_pose[c * 2 + 1] += r.v_world_to_camera1;
+            }
+            for (int k = 0; k < 3; ++k) {
+                v_means[g * 3 + k] = v_mean[k];
+                v_scales[g * 3 + k] = v_scale[k];
+            }
+            for (int k = 0; k < 4; ++k)
+                v_quats[g * 4 + k] = v_quat[k];
+        }
+    });
+
+    // reduce the worker buffers, written back row-major
+    float *outputs[2] = {v_world_to_cameras0, v_world_to_cameras1};
+    for (size_t c = 0; c < n_cameras; ++c) {
+        for (int k = 0; k < 2; ++k) {
+            if (outputs[k] == nullptr)
+                continue;
+            auto sum = glm::fmat4(0.f);
+            for (size_t w = 0; w < pool.size(); ++w)
+                sum += v_poses[(w * n_cameras + c) * 2 + k];
+            for (int row = 0; row < 4; ++row)
+                for (int col = 0; col < 4; ++col)
+                    outputs[k][c * 16 + row * 4 + col] = sum[col][row];
+        }
+    }
+}
+
+} // namespace tinyrend::impl
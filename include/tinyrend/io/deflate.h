@@ -0,0 +1,264 @@
+#pragma once
+
+/*
+ * Checksums and a small DEFLATE (RFC 1951) encoder for the image writers.
+ *
+ * The encoder emits fixed-Huffman blocks with greedy hash-chain LZ77 matching.
+ * It is written so that independent pieces of one zlib stream can be
+ * compressed in parallel: `deflate_chunk` compresses a chunk without
+ * back-references to earlier chunks and ends it on a byte boundary (empty
+ * stored block, as in zlib's Z_SYNC_FLUSH), so chunks can be concatenated
+ * as they are. The stream is closed with `deflate_finish`, and the adler32 of
+ * the whole input is assembled from the per-chunk sums with `adler32_combine`.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tinyrend::io {
+
+namespace detail {
+
+inline auto crc32_table() -> const std::array<uint32_t, 256> & {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+} // namespace detail
+
+/// \brief Update a CRC-32 (ISO 3309, as used by PNG) with `n` bytes.
+/// \param crc Running value; start from 0
+inline auto crc32(uint32_t crc, const uint8_t *data, size_t n) -> uint32_t {
+    auto const &table = detail::crc32_table();
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+constexpr uint32_t ADLER_MOD = 65521;
+
+/// \brief Update an adler32 checksum with `n` bytes.
+/// \param adler Running value; start from 1
+inline auto adler32(uint32_t adler, const uint8_t *data, size_t n) -> uint32_t {
+    uint32_t a = adler & 0xFFFF, b = adler >> 16;
+    while (n > 0) {
+        // largest block for which b cannot overflow 32 bits
+        const size_t block = std::min<size_t>(n, 5552);
+        for (size_t i = 0; i < block; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= ADLER_MOD;
+        b %= ADLER_MOD;
+        data += block;
+        n -= block;
+    }
+    return (b << 16) | a;
+}
+
+/// \brief adler32 of the concatenation A|B from adler32(A), adler32(B) and |B|.
+inline auto adler32_combine(uint32_t adler_a, uint32_t adler_b, size_t len_b)
+    -> uint32_t {
+    const uint64_t a1 = adler_a & 0xFFFF, b1 = adler_a >> 16;
+    const uint64_t a2 = adler_b & 0xFFFF, b2 = adler_b >> 16;
+    const uint64_t len = len_b % ADLER_MOD;
+    const uint64_t a = (a1 + a2 + ADLER_MOD - 1) % ADLER_MOD;
+    const uint64_t b = (b1 + b2 + len * ((a1 + ADLER_MOD - 1) % ADLER_MOD)) % ADLER_MOD;
+    return uint32_t((b << 16) | a);
+}
+
+namespace detail {
+
+/// LSB-first bit writer (DEFLATE bit order).
+class BitWriter {
+  public:
+    explicit BitWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+    void put(uint32_t bits, int n_bits) {
+        acc_ |= uint64_t(bits) << n_acc_;
+        n_acc_ += n_bits;
+        while (n_acc_ >= 8) {
+            out_.push_back(uint8_t(acc_));
+            acc_ >>= 8;
+            n_acc_ -= 8;
+        }
+    }
+
+    /// Huffman codes are defined MSB-first.
+    void put_code(uint32_t code, int n_bits) {
+        uint32_t rev = 0;
+        for (int i = 0; i < n_bits; ++i)
+            rev |= ((code >> i) & 1u) << (n_bits - 1 - i);
+        put(rev, n_bits);
+    }
+
+    void align() {
+        if (n_acc_ > 0)
+            put(0, 8 - n_acc_);
+    }
+
+  private:
+    std::vector<uint8_t> &out_;
+    uint64_t acc_ = 0;
+    int n_acc_ = 0;
+};
+
+// RFC 1951 3.2.5: base values and extra bits of the length and distance codes.
+constexpr uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,
+                                      15, 17, 19, 23, 27, 31, 35, 43,  51,  59,
+                                      67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                      2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t DIST_BASE[30] = {1,    2,    3,    4,    5,    7,     9,     13,
+                                    17,   25,   33,   49,   65,   97,    129,   193,
+                                    257,  385,  513,  769,  1025, 1537,  2049,  3073,
+                                    4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t DIST_EXTRA[30] = {0, 0, 0,  0,  1,  1,  2,  2,  3,  3,
+                                    4, 4, 5,  5,  6,  6,  7,  7,  8,  8,
+                                    9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/// Fixed literal/length code of RFC 1951 3.2.6.
+inline void put_fixed_symbol(BitWriter &bw, uint32_t sym) {
+    if (sym < 144)
+        bw.put_code(0x30 + sym, 8);
+    else if (sym < 256)
+        bw.put_code(0x190 + sym - 144, 9);
+    else if (sym < 280)
+        bw.put_code(sym - 256, 7);
+    else
+        bw.put_code(0xC0 + sym - 280, 8);
+}
+
+inline void put_match(BitWriter &bw, uint32_t length, uint32_t distance) {
+    int lc = 28;
+    while (LENGTH_BASE[lc] > length)
+        --lc;
+    put_fixed_symbol(bw, 257 + lc);
+    if (LENGTH_EXTRA[lc] > 0)
+        bw.put(length - LENGTH_BASE[lc], LENGTH_EXTRA[lc]);
+    int dc = 29;
+    while (DIST_BASE[dc] > distance)
+        --dc;
+    bw.put_code(dc, 5);
+    if (DIST_EXTRA[dc] > 0)
+        bw.put(distance - DIST_BASE[dc], DIST_EXTRA[dc]);
+}
+
+} // namespace detail
+
+/// \brief Compression effort of `deflate_chunk`.
+struct DeflateConfig {
+    /// Hash-chain candidates examined per position (0 = literals only).
+    uint32_t max_chain = 16;
+    /// Stop searching once a match at least this long is found.
+    uint32_t nice_length = 64;
+};
+
+/// \brief Compress `data[0, n)` as fixed-Huffman blocks and append them to
+/// `out`, ending on a byte boundary with an empty stored block.
+///
+/// The chunk never references data outside itself, so chunks of one stream
+/// can be compressed concurrently and concatenated in order.
+inline void deflate_chunk(
+    const uint8_t *data,
+    size_t n,
+    std::vector<uint8_t> &out,
+    const DeflateConfig &cfg = {}
+) {
+    constexpr size_t WINDOW = 32768, MIN_MATCH = 3, MAX_MATCH = 258;
+    constexpr int HASH_BITS = 15;
+    constexpr uint32_t NONE = UINT32_MAX;
+
+    out.reserve(out.size() + n / 2 + 64);
+    detail::BitWriter bw(out);
+    bw.put(0b010, 3); // BFINAL = 0, BTYPE = 01 (fixed Huffman)
+
+    // head[h]: last position with hash h; prev[i % WINDOW]: previous one.
+    std::vector<uint32_t> head(size_t(1) << HASH_BITS, NONE);
+    std::vector<uint32_t> prev(cfg.max_chain > 0 ? std::min(n, WINDOW) : 0);
+    auto const hash = [&](size_t i) {
+        const uint32_t v = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16);
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    };
+    auto const insert = [&](size_t i) {
+        const uint32_t h = hash(i);
+        prev[i % WINDOW] = head[h];
+        head[h] = uint32_t(i);
+    };
+
+    size_t i = 0;
+    while (i < n) {
+        size_t best_len = 0, best_dist = 0;
+        if (cfg.max_chain > 0 && i + MIN_MATCH <= n) {
+            const size_t max_len = std::min(MAX_MATCH, n - i);
+            uint32_t cand = head[hash(i)];
+            for (uint32_t chain = 0; chain < cfg.max_chain && cand != NONE; ++chain) {
+                if (i - cand > WINDOW - 1)
+                    break;
+                if (data[cand + best_len] == data[i + best_len] || best_len == 0) {
+                    size_t len = 0;
+                    while (len < max_len && data[cand + len] == data[i + len])
+                        ++len;
+                    if (len > best_len) {
+                        best_len = len;
+                        best_dist = i - cand;
+                        if (len >= cfg.nice_length || len == max_len)
+                            break;
+                    }
+                }
+                const uint32_t next = prev[cand % WINDOW];
+                if (next == NONE || next >= cand)
+                    break;
+                cand = next;
+            }
+            insert(i);
+        }
+        if (best_len >= MIN_MATCH) {
+            detail::put_match(bw, uint32_t(best_len), uint32_t(best_dist));
+            for (size_t k = i + 1; k < i + best_len && k + MIN_MATCH <= n; ++k)
+                insert(k);
+            i += best_len;
+        } else {
+            detail::put_fixed_symbol(bw, data[i]);
+            ++i;
+        }
+    }
+    detail::put_fixed_symbol(bw, 256); // end of block
+    bw.put(0b000, 3);                  // empty stored block: LEN = 0, NLEN = ~0
+    bw.align();
+    out.insert(out.end(), {0x00, 0x00, 0xFF, 0xFF});
+}
+
+/// \brief Append the zlib header (RFC 1950, 32K window, no dictionary).
+inline void zlib_header(std::vector<uint8_t> &out) {
+    out.insert(out.end(), {0x78, 0x01});
+}
+
+/// \brief Close a stream built from `deflate_chunk`s: a final empty fixed
+/// block followed by the big-endian adler32 of all uncompressed bytes.
+inline void deflate_finish(std::vector<uint8_t> &out, uint32_t adler) {
+    out.insert(
+        out.end(),
+        {0x03,
+         0x00,
+         uint8_t(adler >> 24),
+         uint8_t(adler >> 16),
+         uint8_t(adler >> 8),
+         uint8_t(adler)}
+    );
+}
+
+} // namespace tinyrend::io
@@ -0,0 +1,732 @@
+#pragma once
+
+/*
+ * Writers for the renderer's [n_images, H, W, C] float outputs.
+ *
+ * - `quantize_u8` / `quantize_u16`: parallel float -> integer conversion.
+ *   With AVX, 8 samples are clamped, rounded and narrowed per iteration.
+ * - `write_png`: 8 or 16 bit PNG. Every image is cut into row bands; all bands
+ *   of the batch are filtered and deflated in parallel (see io/deflate.h) and
+ *   each band becomes one IDAT chunk, so the files are standard PNGs.
+ * - `write_qoi`: QOI (https://qoiformat.org); the format is a single
+ *   sequential stream per image, so images are encoded in parallel.
+ * - `write_pfm` / `write_npy`: uncompressed float32. The file is sized with
+ *   ftruncate, mapped, and the header and pixel rows are written straight into
+ *   the mapping by the pool workers.
+ * - `AsyncImageWriter`: queues batches and encodes them from a background
+ *   thread, so writing frame k overlaps with rendering frame k + 1.
+ *
+ * All writers throw std::invalid_argument for unsupported shapes and
+ * std::runtime_error on I/O failure.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/io/deflate.h"
+
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace tinyrend::io {
+
+/// \brief Read-only view of a batch of images stored as [n_images, H, W, C].
+struct ImageBatch {
+    const float *data = nullptr;
+    size_t n_images = 1;
+    uint32_t height = 0;
+    uint32_t width = 0;
+    uint32_t channels = 0;
+
+    size_t image_size() const { return size_t(height) * width * channels; }
+    size_t size() const { return n_images * image_size(); }
+    const float *image(size_t i) const { return data + i * image_size(); }
+};
+
+/// \brief Value range mapped to [0, max integer] by quantization.
+struct QuantizeConfig {
+    float value_min = 0.0f;
+    float value_max = 1.0f;
+};
+
+namespace detail {
+
+/// Quantize `in[begin, end)`: clamp (in - lo) * scale to [0, max_value] and
+/// round half up. T is uint8_t or uint16_t.
+template <typename T>
+void quantize_range(
+    const float *in, size_t begin, size_t end, T *out, float lo, float scale,
+    float max_value
+) {
+    size_t i = begin;
+#if !defined(__CUDA_ARCH__) && defined(__AVX__)
+    const __m256 lo8 = _mm256_set1_ps(lo), scale8 = _mm256_set1_ps(scale);
+    const __m256 max8 = _mm256_set1_ps(max_value), half8 = _mm256_set1_ps(0.5f);
+    const __m256 zero8 = _mm256_setzero_ps();
+    for (; i + 8 <= end; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i), lo8), scale8);
+        // maxps returns its second operand for NaN, so NaN maps to 0
+        v = _mm256_min_ps(_mm256_max_ps(v, zero8), max8);
+        const __m256i q = _mm256_cvttps_epi32(_mm256_add_ps(v, half8));
+        const __m128i q16 = _mm_packus_epi32(
+            _mm256_castsi256_si128(q), _mm256_extractf128_si256(q, 1)
+        );
+        if constexpr (sizeof(T) == 1) {
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(q16, q16)
+            );
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), q16);
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        // NaN maps to 0 (std::max returns its first argument)
+        float v = std::max(0.0f, (in[i] - lo) * scale);
+        v = std::min(v, max_value);
+        out[i] = T(v + 0.5f);
+    }
+}
+
+template <typename T>
+void quantize(
+    const float *in, size_t n, T *out, float max_value, const QuantizeConfig &cfg,
+    thread_pool::ThreadPool &pool
+) {
+    if (!(cfg.value_max > cfg.value_min))
+        throw std::invalid_argument("quantize: value_max must exceed value_min");
+    const float lo = cfg.value_min;
+    const float scale = max_value / (cfg.value_max - cfg.value_min);
+    pool.parallel_for(
+        n,
+        [&](size_t begin, size_t end) {
+            quantize_range(in, begin, end, out, lo, scale, max_value);
+        },
+        size_t(1) << 16
+    );
+}
+
+inline void check_batch(const ImageBatch &batch, const char *what) {
+    if (batch.data == nullptr && batch.size() > 0)
+        throw std::invalid_argument(std::string(what) + ": null image data");
+    if (batch.width == 0 || batch.height == 0)
+        throw std::invalid_argument(std::string(what) + ": empty image");
+}
+
+inline void check_paths(
+    const ImageBatch &batch, const std::vector<std::string> &paths, const char *what
+) {
+    if (paths.size() != batch.n_images)
+        throw std::invalid_argument(
+            std::string(what) + ": expected one path per image, got " +
+            std::to_string(paths.size()) + " for " + std::to_string(batch.n_images)
+        );
+}
+
+inline void write_file(const std::string &path, const std::vector<uint8_t> &bytes) {
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr)
+        throw std::runtime_error("cannot open image file: " + path);
+    const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    if (std::fclose(f) != 0 || !ok)
+        throw std::runtime_error("failed to write image file: " + path);
+}
+
+inline void put_be32(std::vector<uint8_t> &out, uint32_t v) {
+    out.insert(
+        out.end(), {uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v)}
+    );
+}
+
+/// Create `path` with `bytes` bytes and map it writable.
+class MappedOutput {
+  public:
+    MappedOutput(const std::string &path, size_t bytes) : bytes_(bytes) {
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::runtime_error("cannot open image file: " + path);
+        if (ftruncate(fd, off_t(bytes)) != 0) {
+            close(fd);
+            throw std::runtime_error("ftruncate failed for " + path);
+        }
+        void *data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            throw std::runtime_error("mmap failed for " + path);
+        data_ = static_cast<uint8_t *>(data);
+    }
+    ~MappedOutput() { munmap(data_, bytes_); }
+    MappedOutput(const MappedOutput &) = delete;
+    MappedOutput &operator=(const MappedOutput &) = delete;
+
+    uint8_t *data() const { return data_; }
+
+  private:
+    uint8_t *data_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+inline auto paeth(int a, int b, int c) -> int {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    return pb <= pc ? b : c;
+}
+
+/// Filter one PNG scanline with every filter type and keep the one with the
+/// smallest sum of absolute (signed) residuals. `prior` is the previous
+/// scanline (all zeros for the first one); `out` receives the filter byte
+/// followed by the filtered row.
+inline void filter_row(
+    const uint8_t *row, const uint8_t *prior, size_t n, size_t bpp, uint8_t *scratch,
+    uint8_t *out
+) {
+    uint64_t best_cost = UINT64_MAX;
+    for (uint8_t type = 0; type < 5; ++type) {
+        // the first `bpp` bytes have no left neighbour (a = c = 0)
+        for (size_t i = 0; i < std::min(bpp, n); ++i) {
+            const int b = prior[i];
+            const int pred = type == 2 || type == 4 ? b : type == 3 ? b >> 1 : 0;
+            scratch[i] = uint8_t(row[i] - pred);
+        }
+        switch (type) {
+        case 0: std::memcpy(scratch, row, n); break;
+        case 1:
+            for (size_t i = bpp; i < n; ++i)
+                scratch[i] = uint8_t(row[i] - row[i - bpp]);
+            break;
+        case 2:
+            for (size_t i = bpp; i < n; ++i)
+                scratch[i] = uint8_t(row[i] - prior[i]);
+            break;
+        case 3:
+            for (size_t i = bpp; i < n; ++i)
+                scratch[i] = uint8_t(row[i] - ((row[i - bpp] + prior[i]) >> 1));
+            break;
+        default:
+            for (size_t i = bpp; i < n; ++i)
+                scratch[i] =
+                    uint8_t(row[i] - paeth(row[i - bpp], prior[i], prior[i - bpp]));
+            break;
+        }
+        uint64_t cost = 0;
+        for (size_t i = 0; i < n; ++i)
+            cost += scratch[i] < 128 ? scratch[i] : 256 - scratch[i];
+        if (cost < best_cost) {
+            best_cost = cost;
+            out[0] = type;
+            std::memcpy(out + 1, scratch, n);
+        }
+    }
+}
+
+/// QOI stream of one image of 8-bit RGB(A) pixels.
+inline void encode_qoi_image(
+    const uint8_t *px, uint32_t width, uint32_t height, uint32_t C,
+    std::vector<uint8_t> &out
+) {
+    const size_t n_pixels = size_t(width) * height;
+    out.reserve(14 + n_pixels * (C + 1) + 8);
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    put_be32(out, width);
+    put_be32(out, height);
+    out.insert(out.end(), {uint8_t(C), 0}); // sRGB, linear alpha
+
+    uint8_t index[64][4] = {};
+    uint8_t prev[4] = {0, 0, 0, 255}, cur[4] = {0, 0, 0, 255};
+    uint32_t run = 0;
+    for (size_t i = 0; i < n_pixels; ++i) {
+        std::memcpy(cur, px + i * C, C);
+        if (std::memcmp(cur, prev, 4) == 0) {
+            if (++run == 62 || i + 1 == n_pixels) {
+                out.push_back(uint8_t(0xC0 | (run - 1))); // QOI_OP_RUN
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(uint8_t(0xC0 | (run - 1)));
+            run = 0;
+        }
+        const uint32_t h = (cur[0] * 3 + cur[1] * 5 + cur[2] * 7 + cur[3] * 11) % 64;
+        if (std::memcmp(index[h], cur, 4) == 0) {
+            out.push_back(uint8_t(h)); // QOI_OP_INDEX
+        } else if (cur[3] != prev[3]) {
+            std::memcpy(index[h], cur, 4);
+            out.insert(out.end(), {0xFF, cur[0], cur[1], cur[2], cur[3]}); // RGBA
+        } else {
+            std::memcpy(index[h], cur, 4);
+            const int dr = int8_t(cur[0] - prev[0]);
+            const int dg = int8_t(cur[1] - prev[1]);
+            const int db = int8_t(cur[2] - prev[2]);
+            const int dr_dg = dr - dg, db_dg = db - dg;
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                out.push_back(uint8_t(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+            } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 &&
+                       db_dg >= -8 && db_dg <= 7) {
+                out.push_back(uint8_t(0x80 | (dg + 32))); // QOI_OP_LUMA
+                out.push_back(uint8_t((dr_dg + 8) << 4 | (db_dg + 8)));
+            } else {
+                out.insert(out.end(), {0xFE, cur[0], cur[1], cur[2]}); // QOI_OP_RGB
+            }
+        }
+        std::memcpy(prev, cur, 4);
+    }
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+}
+
+} // namespace detail
+
+/// \brief Map floats from [value_min, value_max] to [0, 255], rounding and
+/// clamping (NaN maps to 0).
+inline void quantize_u8(
+    const float *in, size_t n, uint8_t *out, const QuantizeConfig &cfg = {},
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    detail::quantize(in, n, out, 255.0f, cfg, pool);
+}
+
+/// \brief Map floats from [value_min, value_max] to [0, 65535].
+inline void quantize_u16(
+    const float *in, size_t n, uint16_t *out, const QuantizeConfig &cfg = {},
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    detail::quantize(in, n, out, 65535.0f, cfg, pool);
+}
+
+/// \brief Options of `write_png`.
+struct PngConfig {
+    QuantizeConfig quantize;
+    /// 8 or 16 bits per sample.
+    uint32_t bit_depth = 8;
+    /// Rows per independently deflated band (0 = about 256 KiB of samples).
+    uint32_t band_rows = 0;
+    DeflateConfig deflate;
+};
+
+/// \brief Encode a batch as PNGs (1: gray, 2: gray+alpha, 3: RGB, 4: RGBA).
+/// \return One encoded file per image
+inline auto encode_png(
+    const ImageBatch &batch, const PngConfig &cfg = {},
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) -> std::vector<std::vector<uint8_t>> {
+    detail::check_batch(batch, "encode_png");
+    if (batch.channels < 1 || batch.channels > 4)
+        throw std::invalid_argument("encode_png: channels must be 1 to 4");
+    if (cfg.bit_depth != 8 && cfg.bit_depth != 16)
+        throw std::invalid_argument("encode_png: bit_depth must be 8 or 16");
+
+    const size_t bytes_per_sample = cfg.bit_depth / 8;
+    const size_t bpp = batch.channels * bytes_per_sample;
+    const size_t row_bytes = size_t(batch.width) * bpp;
+    const uint32_t H = batch.height;
+
+    // Quantized samples, already in PNG (big-endian) byte order.
+    std::vector<uint8_t> samples(batch.size() * bytes_per_sample);
+    if (cfg.bit_depth == 8) {
+        quantize_u8(batch.data, batch.size(), samples.data(), cfg.quantize, pool);
+    } else {
+        auto *s16 = reinterpret_cast<uint16_t *>(samples.data());
+        quantize_u16(batch.data, batch.size(), s16, cfg.quantize, pool);
+        pool.parallel_for(batch.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const uint16_t v = s16[i];
+                samples[2 * i] = uint8_t(v >> 8);
+                samples[2 * i + 1] = uint8_t(v);
+            }
+        });
+    }
+
+    const uint32_t band_rows =
+        cfg.band_rows > 0
+            ? cfg.band_rows
+            : uint32_t(std::clamp<size_t>((size_t(1) << 18) / row_bytes, 1, H));
+    const size_t n_bands = (H + band_rows - 1) / band_rows;
+
+    // One IDAT chunk (length, type, data, crc) per band; bands of all images
+    // are independent jobs.
+    struct Band {
+        std::vector<uint8_t> chunk;
+        uint32_t adler = 1;
+        size_t raw_bytes = 0;
+    };
+    std::vector<Band> bands(batch.n_images * n_bands);
+    pool.parallel_for(
+        bands.size(),
+        [&](size_t begin, size_t end) {
+            std::vector<uint8_t> filtered, scratch(row_bytes), zero_row(row_bytes);
+            for (size_t job = begin; job < end; ++job) {
+                const size_t image = job / n_bands, band = job % n_bands;
+                const uint32_t r0 = uint32_t(band * band_rows);
+                const uint32_t r1 = std::min<uint32_t>(r0 + band_rows, H);
+                const uint8_t *pixels = samples.data() + image * H * row_bytes;
+
+                filtered.resize((r1 - r0) * (row_bytes + 1));
+                for (uint32_t r = r0; r < r1; ++r) {
+                    detail::filter_row(
+                        pixels + r * row_bytes,
+                        r > 0 ? pixels + (r - 1) * row_bytes : zero_row.data(),
+                        row_bytes,
+                        bpp,
+                        scratch.data(),
+                        filtered.data() + (r - r0) * (row_bytes + 1)
+                    );
+                }
+                Band &b = bands[job];
+                b.raw_bytes = filtered.size();
+                b.adler = adler32(1, filtered.data(), filtered.size());
+                b.chunk.assign({0, 0, 0, 0, 'I', 'D', 'A', 'T'});
+                if (band == 0)
+                    zlib_header(b.chunk);
+                deflate_chunk(filtered.data(), filtered.size(), b.chunk, cfg.deflate);
+                const uint32_t length = uint32_t(b.chunk.size() - 8);
+                for (int k = 0; k < 4; ++k)
+                    b.chunk[k] = uint8_t(length >> (24 - 8 * k));
+                detail::put_be32(
+                    b.chunk, crc32(0, b.chunk.data() + 4, b.chunk.size() - 4)
+                );
+            }
+        },
+        1
+    );
+
+    std::vector<std::vector<uint8_t>> files(batch.n_images);
+    for (size_t image = 0; image < batch.n_images; ++image) {
+        auto &out = files[image];
+        size_t total = 0;
+        for (size_t band = 0; band < n_bands; ++band)
+            total += bands[image * n_bands + band].chunk.size();
+        out.reserve(total + 64);
+
+        out.insert(out.end(), {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'});
+        static const uint8_t COLOR_TYPE[5] = {0, 0, 4, 2, 6};
+        std::vector<uint8_t> ihdr = {'I', 'H', 'D', 'R'};
+        detail::put_be32(ihdr, batch.width);
+        detail::put_be32(ihdr, H);
+        ihdr.insert(
+            ihdr.end(), {uint8_t(cfg.bit_depth), COLOR_TYPE[batch.channels], 0, 0, 0}
+        );
+        detail::put_be32(out, 13);
+        out.insert(out.end(), ihdr.begin(), ihdr.end());
+        detail::put_be32(out, crc32(0, ihdr.data(), ihdr.size()));
+
+        uint32_t adler = 1;
+        for (size_t band = 0; band < n_bands; ++band) {
+            auto const &b = bands[image * n_bands + band];
+            out.insert(out.end(), b.chunk.begin(), b.chunk.end());
+            adler = adler32_combine(adler, b.adler, b.raw_bytes);
+        }
+        // final deflate block and adler32 in their own IDAT chunk
+        std::vector<uint8_t> tail = {'I', 'D', 'A', 'T'};
+        deflate_finish(tail, adler);
+        detail::put_be32(out, uint32_t(tail.size() - 4));
+        out.insert(out.end(), tail.begin(), tail.end());
+        detail::put_be32(out, crc32(0, tail.data(), tail.size()));
+
+        const uint8_t iend[4] = {'I', 'E', 'N', 'D'};
+        detail::put_be32(out, 0);
+        out.insert(out.end(), iend, iend + 4);
+        detail::put_be32(out, crc32(0, iend, 4));
+    }
+    return files;
+}
+
+/// \brief Write `batch` as one PNG file per image.
+inline void write_png(
+    const ImageBatch &batch, const std::vector<std::string> &paths,
+    const PngConfig &cfg = {},
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    detail::check_paths(batch, paths, "write_png");
+    auto const files = encode_png(batch, cfg, pool);
+    pool.parallel_for(
+        files.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                detail::write_file(paths[i], files[i]);
+        },
+        1
+    );
+}
+
+/// \brief Encode a batch of RGB (3) or RGBA (4) images as QOI files.
+inline auto encode_qoi(
+    const ImageBatch &batch, const QuantizeConfig &cfg = {},
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) -> std::vector<std::vector<uint8_t>> {
+    detail::check_batch(batch, "encode_qoi");
+    if (batch.channels != 3 && batch.channels != 4)
+        throw std::invalid_argument("encode_qoi: channels must be 3 or 4");
+    const size_t C = batch.channels, n_pixels = size_t(batch.width) * batch.height;
+    std::vector<uint8_t> samples(batch.size());
+    quantize_u8(batch.data, batch.size(), samples.data(), cfg, pool);
+
+    std::vector<std::vector<uint8_t>> files(batch.n_images);
+    pool.parallel_for(
+        batch.n_images,
+        [&](size_t begin, size_t end) {
+            for (size_t image = begin; image < end; ++image) {
+                detail::encode_qoi_image(
+                    samples.data() + image * n_pixels * C,
+                    batch.width,
+                    batch.height,
+                    batch.channels,
+                    files[image]
+                );
+            }
+        },
+        1
+    );
+    return files;
+}
+
+/// \brief Write `batch` as one QOI file per image.
+inline void write_qoi(
+    const ImageBatch &batch, const std::vector<std::string> &paths,
+    const QuantizeConfig &cfg = {},
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    detail::check_paths(batch, paths, "write_qoi");
+    auto const files = encode_qoi(batch, cfg, pool);
+    pool.parallel_for(
+        files.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                detail::write_file(paths[i], files[i]);
+        },
+        1
+    );
+}
+
+/// \brief Write `batch` as one little-endian PFM file per image (1: "Pf"
+/// grayscale, 3: "PF" color). PFM stores rows bottom to top.
+inline void write_pfm(
+    const ImageBatch &batch, const std::vector<std::string> &paths,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    detail::check_batch(batch, "write_pfm");
+    detail::check_paths(batch, paths, "write_pfm");
+    if (batch.channels != 1 && batch.channels != 3)
+        throw std::invalid_argument("write_pfm: channels must be 1 or 3");
+    const std::string header = std::string(batch.channels == 3 ? "PF\n" : "Pf\n") +
+                               std::to_string(batch.width) + " " +
+                               std::to_string(batch.height) + "\n-1.0\n";
+    const size_t row_bytes = size_t(batch.width) * batch.channels * sizeof(float);
+    const uint32_t H = batch.height;
+
+    for (size_t image = 0; image < batch.n_images; ++image) {
+        detail::MappedOutput file(paths[image], header.size() + H * row_bytes);
+        std::memcpy(file.data(), header.data(), header.size());
+        uint8_t *rows = file.data() + header.size();
+        auto const *src = reinterpret_cast<const uint8_t *>(batch.image(image));
+        pool.parallel_for(H, [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                auto *dst = rows + (H - 1 - r) * row_bytes;
+                std::memcpy(dst, src + r * row_bytes, row_bytes);
+            }
+        });
+    }
+}
+
+/// \brief Write the whole batch to one .npy file of float32 [n_images, H, W, C].
+inline void write_npy(
+    const ImageBatch &batch, const std::string &path,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    detail::check_batch(batch, "write_npy");
+    std::string dict = "{'descr': '<f4', 'fortran_order': False, 'shape': (" +
+                       std::to_string(batch.n_images) + ", " +
+                       std::to_string(batch.height) + ", " +
+                       std::to_string(batch.width) + ", " +
+                       std::to_string(batch.channels) + "), }";
+    // magic (6) + version (2) + header length (2) + dict, padded to 64 bytes
+    const size_t padded = (10 + dict.size() + 1 + 63) / 64 * 64;
+    dict.append(padded - 10 - dict.size() - 1, ' ');
+    dict.push_back('\n');
+    const size_t data_bytes = batch.size() * sizeof(float);
+
+    detail::MappedOutput file(path, padded + data_bytes);
+    uint8_t *dst = file.data();
+    const uint8_t magic[8] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    std::memcpy(dst, magic, 8);
+    dst[8] = uint8_t(dict.size());
+    dst[9] = uint8_t(dict.size() >> 8);
+    std::memcpy(dst + 10, dict.data(), dict.size());
+    auto const *src = reinterpret_cast<const uint8_t *>(batch.data);
+    pool.parallel_for(
+        data_bytes,
+        [&](size_t begin, size_t end) {
+            std::memcpy(dst + padded + begin, src + begin, end - begin);
+        },
+        size_t(1) << 20
+    );
+}
+
+/// \brief Output format of `AsyncImageWriter`.
+enum class ImageFormat { PNG, PNG16, QOI, PFM, NPY };
+
+/// \brief Encodes and writes batches in the background.
+///
+/// `submit` copies the batch (or takes ownership of a moved buffer) and
+/// returns immediately, so the caller can render the next frame into its
+/// buffers while this one is encoded. The encoding jobs are issued from a
+/// background thread to `pool` (the global pool by default), where they
+/// interleave with the rendering jobs instead of oversubscribing the CPUs
+/// with a second set of workers. At most `max_pending` batches are queued;
+/// further `submit`s block until one is written. Errors raised while writing
+/// are rethrown by the next `submit` or `wait`.
+///
+/// Call `wait` before destroying the writer: the destructor still writes the
+/// queued batches, but it cannot throw, so an error that has not been
+/// reported by then is lost.
+class AsyncImageWriter {
+  public:
+    /// \param max_pending Queued batches before `submit` blocks
+    /// \param pool Pool running the encoders
+    explicit AsyncImageWriter(
+        size_t max_pending = 2,
+        thread_pool::ThreadPool &pool = thread_pool::global_pool()
+    )
+        : pool_(pool), max_pending_(std::max<size_t>(max_pending, 1)),
+          thread_([this] { loop(); }) {}
+
+    /// Writes the remaining batches; errors not yet reported are dropped.
+    ~AsyncImageWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    AsyncImageWriter(const AsyncImageWriter &) = delete;
+    AsyncImageWriter &operator=(const AsyncImageWriter &) = delete;
+
+    /// \brief Queue `batch` for writing. `paths` has one entry per image,
+    /// or a single entry for NPY.
+    void submit(
+        const ImageBatch &batch, ImageFormat format, std::vector<std::string> paths,
+        const QuantizeConfig &cfg = {}
+    ) {
+        std::vector<float> data(batch.data, batch.data + batch.size());
+        submit(std::move(data), batch, format, std::move(paths), cfg);
+    }
+
+    /// \brief Queue a batch whose buffer is handed over; `shape` gives the
+    /// dimensions (its data pointer is ignored).
+    void submit(
+        std::vector<float> &&data, const ImageBatch &shape, ImageFormat format,
+        std::vector<std::string> paths, const QuantizeConfig &cfg = {}
+    ) {
+        if (data.size() != shape.size())
+            throw std::invalid_argument("AsyncImageWriter: data does not match shape");
+        Job job{std::move(data), shape, format, std::move(paths), cfg};
+        job.batch.data = job.data.data();
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return queue_.size() < max_pending_ || error_; });
+        rethrow_locked();
+        queue_.push_back(std::move(job));
+        cv_.notify_all();
+    }
+
+    /// \brief Block until every queued batch is written.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return (queue_.empty() && !busy_) || error_; });
+        rethrow_locked();
+    }
+
+  private:
+    struct Job {
+        std::vector<float> data;
+        ImageBatch batch;
+        ImageFormat format;
+        std::vector<std::string> paths;
+        QuantizeConfig cfg;
+    };
+
+    void rethrow_locked() {
+        if (error_) {
+            auto error = std::exchange(error_, nullptr);
+            queue_.clear();
+            std::rethrow_exception(error);
+        }
+    }
+
+    void write(const Job &job) {
+        switch (job.format) {
+        case ImageFormat::PNG:
+        case ImageFormat::PNG16: {
+            PngConfig cfg;
+            cfg.quantize = job.cfg;
+            cfg.bit_depth = job.format == ImageFormat::PNG16 ? 16 : 8;
+            write_png(job.batch, job.paths, cfg, pool_);
+            break;
+        }
+        case ImageFormat::QOI: write_qoi(job.batch, job.paths, job.cfg, pool_); break;
+        case ImageFormat::PFM: write_pfm(job.batch, job.paths, pool_); break;
+        case ImageFormat::NPY:
+            if (job.paths.size() != 1)
+                throw std::invalid_argument("AsyncImageWriter: NPY takes one path");
+            write_npy(job.batch, job.paths[0], pool_);
+            break;
+        }
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            if (queue_.empty())
+                return;
+            Job job = std::move(queue_.front());
+            queue_.pop_front();
+            busy_ = true;
+            cv_.notify_all();
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                write(job);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            busy_ = false;
+            if (error && !error_)
+                error_ = error;
+            cv_.notify_all();
+        }
+    }
+
+    thread_pool::ThreadPool &pool_;
+    size_t max_pending_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Job> queue_;
+    std::exception_ptr error_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // namespace tinyrend::io
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "tinyrend/ipc/ring.h"
+#include "tinyrend/ipc/scene.h"
+
+namespace tinyrend::ipc {
+
+enum class JobKind : uint32_t { RENDER = 0, STOP = 1 };
+
+/// \brief A unit of work: tiles [tile_begin, tile_end) of image `image_id`.
+struct RenderJob {
+    uint64_t job_id;
+    JobKind kind;
+    uint32_t image_id;
+    uint32_t tile_begin;
+    uint32_t tile_end;
+};
+
+/// \brief Completion record pushed by a worker. `status` is the handler's
+/// return value (0 = success).
+struct RenderResult {
+    uint64_t job_id;
+    uint32_t worker_id;
+    int32_t status;
+};
+
+/// \brief Per-worker channel in the control segment.
+struct WorkerChannel {
+    static constexpr uint32_t RING_CAPACITY = 256;
+
+    Ring<RenderJob, RING_CAPACITY> jobs;       // coordinator -> worker
+    Ring<RenderResult, RING_CAPACITY> results; // worker -> coordinator
+    std::atomic<int32_t> pid{0};               // set by the worker on attach
+};
+
+struct ControlHeader {
+    static constexpr uint64_t MAGIC = 0x324c5254434e5254ull; // "TRNCTRL2"
+
+    uint64_t magic;
+    uint32_t n_workers;
+    int32_t coordinator_pid; // workers exit once it is gone
+};
+
+/// \brief Bytes of a control segment for `n_workers` workers.
+inline size_t control_segment_bytes(uint32_t n_workers) {
+    const size_t header = (sizeof(ControlHeader) + 63) / 64 * 64;
+    return header + n_workers * sizeof(WorkerChannel);
+}
+
+inline WorkerChannel *control_channels(void *base) {
+    const size_t header = (sizeof(ControlHeader) + 63) / 64 * 64;
+    return reinterpret_cast<WorkerChannel *>(static_cast<char *>(base) + header);
+}
+
+/// \brief Split `n_images` images of `n_tiles` tiles each into jobs of at most
+/// `tiles_per_job` tiles. Use `tiles_per_job >= n_tiles` for one job per image.
+inline std::vector<RenderJob>
+partition_tiles(uint32_t n_images, uint32_t n_tiles, uint32_t tiles_per_job) {
+    tiles_per_job = std::max<uint32_t>(tiles_per_job, 1);
+    std::vector<RenderJob> jobs;
+    for (uint32_t image = 0; image < n_images; ++image) {
+        for (uint32_t begin = 0; begin < n_tiles; begin += tiles_per_job) {
+            const uint32_t end = std::min(begin + tiles_per_job, n_tiles);
+            jobs.push_back({jobs.size(), JobKind::RENDER, image, begin, end});
+        }
+    }
+    return jobs;
+}
+
+/// \brief Whether a process is still running (zombies count as dead).
+///
+/// pid <= 0 is a slot nobody has attached to yet and counts as alive; the
+/// coordinator bounds that with an attach deadline.
+inline bool is_process_alive(int32_t pid) {
+    if (pid <= 0)
+        return true;
+    if (kill(pid, 0) != 0 && errno == ESRCH)
+        return false;
+    char path[64];
+    std::snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE *f = std::fopen(path, "r");
+    if (f == nullptr)
+        return true;
+    int scanned_pid = 0;
+    char state = 'R';
+    const int n = std::fscanf(f, "%d %*s %c", &scanned_pid, &state);
+    std::fclose(f);
+    return n != 2 || (state != 'Z' && state != 'X');
+}
+
+/// \brief Coordinator side of a multi-process render node.
+///
+/// Owns a shared control segment with one job ring and one result ring per
+/// worker. Jobs are handed out pull-style (at most `max_inflight` per worker),
+/// so faster workers get more tiles. If a worker process dies, or never
+/// attaches before its deadline, its unfinished jobs are reassigned to the
+/// remaining workers.
+class Coordinator {
+  public:
+    /// \brief Create the control segment `name` (e.g. "/tinyrend_ctrl").
+    /// \param attach_timeout Time each worker slot has to attach before it is
+    ///        treated as dead
+    static Coordinator create(
+        const std::string &name,
+        uint32_t n_workers,
+        std::chrono::milliseconds attach_timeout = std::chrono::seconds(10)
+    ) {
+        if (n_workers == 0)
+            throw std::runtime_error("Coordinator needs at least one worker");
+        const size_t bytes = control_segment_bytes(n_workers);
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("shm_open failed for " + name);
+        Coordinator c;
+        c.name_ = name;
+        try {
+            if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+                throw std::runtime_error("ftruncate failed for " + name);
+            c.region_ = map_fd(fd, true);
+        } catch (...) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw;
+        }
+        close(fd);
+        auto *header = new (c.region_.data()) ControlHeader{
+            ControlHeader::MAGIC, n_workers, static_cast<int32_t>(getpid())
+        };
+        WorkerChannel *channels = control_channels(c.region_.data());
+        for (uint32_t w = 0; w < n_workers; ++w)
+            new (&channels[w]) WorkerChannel();
+        c.n_workers_ = header->n_workers;
+        c.attach_deadlines_.assign(
+            n_workers, std::chrono::steady_clock::now() + attach_timeout
+        );
+        return c;
+    }
+
+    Coordinator() = default;
+    Coordinator(Coordinator &&o) noexcept
+        : name_(std::move(o.name_)), region_(std::move(o.region_)),
+          n_workers_(std::exchange(o.n_workers_, 0)),
+          attach_deadlines_(std::move(o.attach_deadlines_)) {}
+    Coordinator &operator=(Coordinator &&o) noexcept {
+        if (this != &o) {
+            release();
+            name_ = std::move(o.name_);
+            region_ = std::move(o.region_);
+            n_workers_ = std::exchange(o.n_workers_, 0);
+            attach_deadlines_ = std::move(o.attach_deadlines_);
+        }
+        return *this;
+    }
+    ~Coordinator() { release(); }
+
+    uint32_t n_workers() const { return n_workers_; }
+    const std::string &name() const { return name_; }
+
+    /// \brief Dispatch `jobs` over the workers and wait for all results.
+    ///
+    /// \param jobs Jobs to run (job_id must be unique)
+    /// \param timeout Overall deadline
+    /// \param max_inflight Jobs queued per worker at any time
+    /// \return One result per job, in completion order
+    /// \throws std::runtime_error on timeout or if every worker has died
+    std::vector<RenderResult> run(
+        const std::vector<RenderJob> &jobs,
+        std::chrono::milliseconds timeout,
+        uint32_t max_inflight = 4
+    ) {
+        max_inflight = std::clamp<uint32_t>(max_inflight, 1, WorkerChannel::RING_CAPACITY);
+        WorkerChannel *channels = control_channels(region_.data());
+        std::deque<RenderJob> pending(jobs.begin(), jobs.end());
+        std::vector<std::vector<RenderJob>> inflight(n_workers_);
+        std::vector<bool> dead(n_workers_, false);
+        std::vector<RenderResult> results;
+        results.reserve(jobs.size());
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        auto collect = [&](uint32_t w) {
+            bool progressed = false;
+            RenderResult r;
+            while (channels[w].results.try_pop(r)) {
+                auto &q = inflight[w];
+                auto it = std::find_if(q.begin(), q.end(), [&](const RenderJob &j) {
+                    return j.job_id == r.job_id;
+                });
+                if (it != q.end())
+                    q.erase(it);
+                results.push_back(r);
+                progressed = true;
+            }
+            return progressed;
+        };
+
+        while (results.size() < jobs.size()) {
+            bool progressed = false;
+            uint32_t n_alive = 0;
+            for (uint32_t w = 0; w < n_workers_; ++w) {
+                if (dead[w])
+                    continue;
+                progressed |= collect(w);
+                if (!is_worker_alive(w)) {
+                    // The worker can no longer consume or produce: drain what it
+                    // finished, then hand its remaining jobs to other workers.
+                    dead[w] = true;
+                    collect(w);
+                    for (auto it = inflight[w].rbegin(); it != inflight[w].rend(); ++it)
+                        pending.push_front(*it);
+                    inflight[w].clear();
+                    channels[w].jobs.head.store(
+                        channels[w].jobs.tail.load(std::memory_order_acquire),
+                        std::memory_order_release
+                    );
+                    continue;
+                }
+                ++n_alive;
+                while (!pending.empty() && inflight[w].size() < max_inflight &&
+                       channels[w].jobs.try_push(pending.front())) {
+                    inflight[w].push_back(pending.front());
+                    pending.pop_front();
+                    progressed = true;
+                }
+            }
+            if (n_alive == 0)
+                throw std::runtime_error("all render workers have exited");
+            if (std::chrono::steady_clock::now() >= deadline)
+                throw std::runtime_error("render jobs timed out");
+            if (!progressed)
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        return results;
+    }
+
+    /// \brief Ask every worker to exit after its queued jobs.
+    void shutdown() {
+        WorkerChannel *channels = control_channels(region_.data());
+        for (uint32_t w = 0; w < n_workers_; ++w) {
+            const RenderJob stop{~uint64_t(0), JobKind::STOP, 0, 0, 0};
+            wait_until(
+                [&] {
+                    return channels[w].jobs.try_push(stop) || !is_worker_alive(w);
+                },
+                std::chrono::seconds(1)
+            );
+        }
+    }
+
+  private:
+    // A slot that never attached is dead once its attach deadline has passed.
+    bool is_worker_alive(uint32_t w) const {
+        const int32_t pid =
+            control_channels(region_.data())[w].pid.load(std::memory_order_acquire);
+        if (pid <= 0)
+            return std::chrono::steady_clock::now() < attach_deadlines_[w];
+        return is_process_alive(pid);
+    }
+
+    void release() {
+        region_.reset();
+        if (!name_.empty())
+            shm_unlink(name_.c_str());
+        name_.clear();
+    }
+
+    std::string name_;
+    MappedRegion region_;
+    uint32_t n_workers_ = 0;
+    std::vector<std::chrono::steady_clock::time_point> attach_deadlines_;
+};
+
+/// \brief Worker-side loop: attach to the control segment and run `handler` on
+/// every job until a STOP job arrives, or until the coordinator process is
+/// gone (checked at least once a second while waiting on a ring).
+///
+/// The handler typically renders from a `SharedScene::attach`-ed scene.
+///
+/// \param control_name Name passed to `Coordinator::create`
+/// \param worker_id Index of this worker in [0, n_workers)
+/// \param handler Callable `int32_t(const RenderJob &)`
+/// \return Number of jobs processed
+inline size_t run_worker(
+    const std::string &control_name,
+    uint32_t worker_id,
+    const std::function<int32_t(const RenderJob &)> &handler
+) {
+    const int fd = shm_open(control_name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw std::runtime_error("shm_open failed for " + control_name);
+    MappedRegion region;
+    try {
+        region = map_fd(fd, true);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+    const auto *header = static_cast<const ControlHeader *>(region.data());
+    if (header->magic != ControlHeader::MAGIC || worker_id >= header->n_workers)
+        throw std::runtime_error("invalid control segment or worker id");
+
+    WorkerChannel &channel = control_channels(region.data())[worker_id];
+    channel.pid.store(static_cast<int32_t>(getpid()), std::memory_order_release);
+
+    auto const coordinator_alive = [&] {
+        return is_process_alive(header->coordinator_pid);
+    };
+    size_t n_processed = 0;
+    for (;;) {
+        RenderJob job;
+        const auto pop = [&] { return channel.jobs.try_pop(job); };
+        if (!wait_until(pop, std::chrono::seconds(1))) {
+            if (!coordinator_alive())
+                break;
+            continue;
+        }
+        if (job.kind == JobKind::STOP)
+            break;
+        RenderResult result{job.job_id, worker_id, 0};
+        try {
+            result.status = handler(job);
+        } catch (...) {
+            result.status = -1;
+        }
+        const auto push = [&] { return channel.results.try_push(result); };
+        while (!wait_until(push, std::chrono::seconds(1))) {
+            if (!coordinator_alive())
+                return n_processed;
+        }
+        ++n_processed;
+    }
+    return n_processed;
+}
+
+} // namespace tinyrend::ipc
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace tinyrend::ipc {
+
+/// \brief Single-producer single-consumer ring usable across processes.
+///
+/// The ring is a plain struct without pointers so it can live inside a shared
+/// memory mapping (placement-new it once in the creating process). Head and
+/// tail are lock-free 64-bit atomics, which are address-free and therefore
+/// valid when the same page is mapped at different addresses.
+template <typename T, uint32_t CAPACITY> struct Ring {
+    static_assert(std::is_trivially_copyable_v<T>, "Ring slots must be POD");
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+    static_assert(
+        std::atomic<uint64_t>::is_always_lock_free,
+        "Process-shared rings need lock-free 64-bit atomics"
+    );
+
+    alignas(64) std::atomic<uint64_t> head{0}; // next slot to pop (consumer)
+    alignas(64) std::atomic<uint64_t> tail{0}; // next slot to push (producer)
+    alignas(64) T slots[CAPACITY];
+
+    static constexpr uint32_t capacity() { return CAPACITY; }
+
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool try_push(const T &value) {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= CAPACITY)
+            return false;
+        slots[t & (CAPACITY - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T &value) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        value = slots[h & (CAPACITY - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/// \brief Spin-then-sleep wait until `pred()` holds or `timeout` expires.
+/// \return true if the predicate became true
+template <typename Pred>
+bool wait_until(Pred &&pred, std::chrono::microseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (int spins = 0;; ++spins) {
+        if (pred())
+            return true;
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        if (spins < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+} // namespace tinyrend::ipc
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tinyrend/core/huge_pages.h"
+
+namespace tinyrend::ipc {
+
+/// \brief Memory-mappable scene format.
+///
+/// A scene is a single contiguous blob: a fixed-size header followed by
+/// structure-of-arrays Gaussian attributes, each array 64-byte aligned. The
+/// blob contains no pointers, so it can be written to a file, mapped from a
+/// file, or placed in a shared memory segment and used in place.
+///
+///   means     [n_primitives, 3]
+///   quats     [n_primitives, 4]
+///   scales    [n_primitives, 3]
+///   opacities [n_primitives]
+///   features  [n_primitives, feature_dim]
+struct SceneHeader {
+    static constexpr uint64_t MAGIC = 0x31454e4353525254ull; // "TRRSCNE1"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t feature_dim;
+    uint64_t n_primitives;
+    uint64_t offset_means;
+    uint64_t offset_quats;
+    uint64_t offset_scales;
+    uint64_t offset_opacities;
+    uint64_t offset_features;
+    uint64_t total_bytes;
+};
+
+/// \brief Read-only view of a scene blob. Pointers alias the blob.
+struct SceneView {
+    size_t n_primitives = 0;
+    uint32_t feature_dim = 0;
+    const float *means = nullptr;     // [n_primitives, 3]
+    const float *quats = nullptr;     // [n_primitives, 4]
+    const float *scales = nullptr;    // [n_primitives, 3]
+    const float *opacities = nullptr; // [n_primitives]
+    const float *features = nullptr;  // [n_primitives, feature_dim]
+};
+
+/// \brief Compute the header (offsets and total size) of a scene blob.
+inline SceneHeader scene_layout(size_t n_primitives, uint32_t feature_dim) {
+    auto align = [](uint64_t x) { return (x + 63) / 64 * 64; };
+    SceneHeader h{};
+    h.magic = SceneHeader::MAGIC;
+    h.version = SceneHeader::VERSION;
+    h.feature_dim = feature_dim;
+    h.n_primitives = n_primitives;
+    uint64_t offset = align(sizeof(SceneHeader));
+    h.offset_means = offset;
+    offset = align(offset + n_primitives * 3 * sizeof(float));
+    h.offset_quats = offset;
+    offset = align(offset + n_primitives * 4 * sizeof(float));
+    h.offset_scales = offset;
+    offset = align(offset + n_primitives * 3 * sizeof(float));
+    h.offset_opacities = offset;
+    offset = align(offset + n_primitives * sizeof(float));
+    h.offset_features = offset;
+    offset = align(offset + n_primitives * feature_dim * sizeof(float));
+    h.total_bytes = offset;
+    return h;
+}
+
+/// \brief Serialize a scene into `dst`, which must hold
+/// `scene_layout(n_primitives, feature_dim).total_bytes` bytes.
+inline void write_scene(
+    void *dst,
+    size_t n_primitives,
+    uint32_t feature_dim,
+    const float *means,
+    const float *quats,
+    const float *scales,
+    const float *opacities,
+    const float *features
+) {
+    const SceneHeader h = scene_layout(n_primitives, feature_dim);
+    char *base = static_cast<char *>(dst);
+    std::memset(base, 0, h.total_bytes);
+    std::memcpy(base, &h, sizeof(h));
+    std::memcpy(base + h.offset_means, means, n_primitives * 3 * sizeof(float));
+    std::memcpy(base + h.offset_quats, quats, n_primitives * 4 * sizeof(float));
+    std::memcpy(base + h.offset_scales, scales, n_primitives * 3 * sizeof(float));
+    std::memcpy(base + h.offset_opacities, opacities, n_primitives * sizeof(float));
+    if (feature_dim > 0)
+        std::memcpy(
+            base + h.offset_features, features, n_primitives * feature_dim * sizeof(float)
+        );
+}
+
+/// \brief Write a scene file that can later be opened with `map_scene_file`.
+/// \throws std::runtime_error on I/O failure
+inline void save_scene_file(
+    const std::string &path,
+    size_t n_primitives,
+    uint32_t feature_dim,
+    const float *means,
+    const float *quats,
+    const float *scales,
+    const float *opacities,
+    const float *features
+) {
+    const SceneHeader h = scene_layout(n_primitives, feature_dim);
+    std::vector<char> blob(h.total_bytes);
+    write_scene(
+        blob.data(), n_primitives, feature_dim, means, quats, scales, opacities, features
+    );
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr)
+        throw std::runtime_error("cannot open scene file: " + path);
+    const bool ok = std::fwrite(blob.data(), 1, blob.size(), f) == blob.size();
+    if (std::fclose(f) != 0 || !ok)
+        throw std::runtime_error("failed to write scene file: " + path);
+}
+
+/// \brief Validate a scene blob and return a view into it.
+/// \throws std::runtime_error if the blob is truncated or not a scene.
+inline SceneView view_scene(const void *src, size_t bytes) {
+    if (bytes < sizeof(SceneHeader))
+        throw std::runtime_error("scene blob too small");
+    SceneHeader h;
+    std::memcpy(&h, src, sizeof(h));
+    if (h.magic != SceneHeader::MAGIC || h.version != SceneHeader::VERSION)
+        throw std::runtime_error("not a tinyrend scene blob");
+    const SceneHeader expected = scene_layout(h.n_primitives, h.feature_dim);
+    if (std::memcmp(&h, &expected, sizeof(h)) != 0 || h.total_bytes > bytes)
+        throw std::runtime_error("corrupt or truncated scene blob");
+
+    const char *base = static_cast<const char *>(src);
+    SceneView v;
+    v.n_primitives = h.n_primitives;
+    v.feature_dim = h.feature_dim;
+    v.means = reinterpret_cast<const float *>(base + h.offset_means);
+    v.quats = reinterpret_cast<const float *>(base + h.offset_quats);
+    v.scales = reinterpret_cast<const float *>(base + h.offset_scales);
+    v.opacities = reinterpret_cast<const float *>(base + h.offset_opacities);
+    v.features = reinterpret_cast<const float *>(base + h.offset_features);
+    return v;
+}
+
+/// \brief RAII wrapper over an mmap'ed region.
+class MappedRegion {
+  public:
+    MappedRegion() = default;
+    MappedRegion(void *data, size_t bytes) : data_(data), bytes_(bytes) {}
+    ~MappedRegion() { reset(); }
+
+    MappedRegion(MappedRegion &&o) noexcept
+        : data_(std::exchange(o.data_, nullptr)), bytes_(std::exchange(o.bytes_, 0)) {}
+    MappedRegion &operator=(MappedRegion &&o) noexcept {
+        if (this != &o) {
+            reset();
+            data_ = std::exchange(o.data_, nullptr);
+            bytes_ = std::exchange(o.bytes_, 0);
+        }
+        return *this;
+    }
+    MappedRegion(const MappedRegion &) = delete;
+    MappedRegion &operator=(const MappedRegion &) = delete;
+
+    void *data() const { return data_; }
+    size_t size() const { return bytes_; }
+
+    void reset() {
+        if (data_ != nullptr)
+            munmap(data_, bytes_);
+        data_ = nullptr;
+        bytes_ = 0;
+    }
+
+  private:
+    void *data_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+/// \brief Map an existing file descriptor (file or shm object) in full.
+/// \throws std::runtime_error on failure
+inline MappedRegion map_fd(int fd, bool writable) {
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        throw std::runtime_error("fstat failed");
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *data = mmap(nullptr, bytes, prot, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("mmap failed");
+    return MappedRegion(data, bytes);
+}
+
+/// \brief Map a scene file written with `save_scene_file` read-only.
+inline MappedRegion map_scene_file(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open scene file: " + path);
+    MappedRegion region;
+    try {
+        region = map_fd(fd, false);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+    view_scene(region.data(), region.size());
+    return region;
+}
+
+/// \brief Read a scene file written with `save_scene_file` into anonymous
+/// memory backed according to `huge` (see core/huge_pages.h).
+///
+/// Unlike `map_scene_file`, the attributes end up in private memory that can
+/// use 2 MiB pages, which the page cache behind a file mapping usually cannot.
+/// \throws std::runtime_error on I/O failure or if the file is not a scene
+inline huge_pages::Buffer read_scene_file(
+    const std::string &path, huge_pages::Mode huge = huge_pages::default_mode()
+) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open scene file: " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("fstat failed for " + path);
+    }
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    huge_pages::Buffer buffer;
+    try {
+        buffer = huge_pages::Buffer::allocate(bytes, huge);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    char *dst = static_cast<char *>(buffer.data());
+    size_t done = 0;
+    while (done < bytes) {
+        const ssize_t n = pread(fd, dst + done, bytes - done, off_t(done));
+        if (n <= 0) {
+            close(fd);
+            throw std::runtime_error("failed to read scene file: " + path);
+        }
+        done += size_t(n);
+    }
+    close(fd);
+    view_scene(buffer.data(), bytes);
+    return buffer;
+}
+
+/// \brief A scene blob living in a POSIX shared memory object.
+///
+/// The coordinator process calls `create` once; render workers call `attach`
+/// and get a read-only mapping of the same physical pages, so N workers share
+/// one copy of the scene.
+class SharedScene {
+  public:
+    /// \brief Create the shm object `name` (e.g. "/tinyrend_scene") and copy
+    /// the scene into it. The object is unlinked when the owner is destroyed.
+    static SharedScene create(
+        const std::string &name,
+        size_t n_primitives,
+        uint32_t feature_dim,
+        const float *means,
+        const float *quats,
+        const float *scales,
+        const float *opacities,
+        const float *features
+    ) {
+        const SceneHeader h = scene_layout(n_primitives, feature_dim);
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("shm_open failed for " + name);
+        if (ftruncate(fd, static_cast<off_t>(h.total_bytes)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("ftruncate failed for " + name);
+        }
+        SharedScene scene;
+        scene.name_ = name;
+        scene.owner_ = true;
+        try {
+            scene.region_ = map_fd(fd, true);
+        } catch (...) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw;
+        }
+        close(fd);
+        // Effective when shmem THP is enabled
+        // (/sys/kernel/mm/transparent_hugepage/shmem_enabled = advise).
+        if (huge_pages::default_mode() != huge_pages::Mode::OFF)
+            huge_pages::advise(scene.region_.data(), scene.region_.size());
+        write_scene(
+            scene.region_.data(),
+            n_primitives,
+            feature_dim,
+            means,
+            quats,
+            scales,
+            opacities,
+            features
+        );
+        // The scene is immutable from here on, for the owner as well.
+        mprotect(scene.region_.data(), scene.region_.size(), PROT_READ);
+        scene.view_ = view_scene(scene.region_.data(), scene.region_.size());
+        return scene;
+    }
+
+    /// \brief Attach read-only to a scene created by another process.
+    static SharedScene attach(const std::string &name) {
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            throw std::runtime_error("shm_open failed for " + name);
+        SharedScene scene;
+        scene.name_ = name;
+        try {
+            scene.region_ = map_fd(fd, false);
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+        close(fd);
+        scene.view_ = view_scene(scene.region_.data(), scene.region_.size());
+        return scene;
+    }
+
+    SharedScene() = default;
+    SharedScene(SharedScene &&o) noexcept
+        : name_(std::move(o.name_)), owner_(std::exchange(o.owner_, false)),
+          region_(std::move(o.region_)), view_(o.view_) {}
+    SharedScene &operator=(SharedScene &&o) noexcept {
+        if (this != &o) {
+            release();
+            name_ = std::move(o.name_);
+            owner_ = std::exchange(o.owner_, false);
+            region_ = std::move(o.region_);
+            view_ = o.view_;
+        }
+        return *this;
+    }
+    ~SharedScene() { release(); }
+
+    const SceneView &view() const { return view_; }
+    const std::string &name() const { return name_; }
+
+  private:
+    void release() {
+        region_.reset();
+        if (owner_)
+            shm_unlink(name_.c_str());
+        owner_ = false;
+    }
+
+    std::string name_;
+    bool owner_ = false;
+    MappedRegion region_;
+    SceneView view_;
+};
+
+} // namespace tinyrend::ipc
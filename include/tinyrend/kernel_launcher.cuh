@@ -1,9 +1,14 @@
 #pragma once
 
+#ifdef __CUDACC__
 #include <cuda_runtime.h>
+#endif
+
+#include "tinyrend/core/thread_pool.h"
 
 namespace tinyrend {
 
+#ifdef __CUDACC__
 // Template for generating a linear kernel launcher
 template <typename Func, typename... Args>
 __global__ void linear_kernel_cuda(size_t n_elements, Func func, Args... args) {
@@ -20,18 +25,27 @@ void launch_linear_kernel_cuda(size_t n_elements, Func func, Args... args) {
     const int num_blocks = (n_elements + BLOCK_SIZE - 1) / BLOCK_SIZE;
     linear_kernel_cuda<<<num_blocks, BLOCK_SIZE>>>(n_elements, func, args...);
 }
+#endif
 
+// CPU counterpart: elements are statically partitioned over the NUMA-pinned
+// global pool (see core/thread_pool.h), matching `first_touch_fill`.
 template <typename Func, typename... Args>
 void launch_linear_kernel_cpu(size_t n_elements, Func func, Args... args) {
-    for (size_t i = 0; i < n_elements; i++) {
-        func(i, args...);
-    }
+    thread_pool::parallel_for(n_elements, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            func(i, args...);
+        }
+    });
 }
 
 template <bool USE_CUDA, typename Func, typename... Args>
 void launch_linear_kernel(size_t n_elements, Func func, Args... args) {
     if constexpr (USE_CUDA) {
+#ifdef __CUDACC__
         launch_linear_kernel_cuda(n_elements, func, args...);
+#else
+        static_assert(!USE_CUDA, "CUDA launches require compiling with nvcc");
+#endif
     } else {
         launch_linear_kernel_cpu(n_elements, func, args...);
     }
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "tinyrend/core/huge_pages.h"
+#include "tinyrend/core/thread_pool.h"
+
+namespace tinyrend::rasterization {
+
+/*
+    CPU generation of the primitive-tile intersection lists consumed by
+    `rasterize_kernel` (isect_primitive_ids + isect_prefix_sum_per_tile).
+
+    Tiles are numbered image-major: tile `image_id * n_tiles_per_image +
+    tile_y * n_tiles_x + tile_x`. The prefix sum is inclusive, and within each
+    tile primitives are sorted front to back by depth (ties by primitive id).
+    Operators that composite order-independently (see `oit.h`) can turn the
+    sort off with `sort_by_depth = false`; the order within a tile is then
+    unspecified.
+
+    Two modes are supported:
+    - TWO_PASS: count tiles per primitive, prefix-sum, then write. Reads the
+      projected primitives twice.
+    - SINGLE_PASS: write into a buffer pre-sized from a capacity prediction.
+      Workers reserve chunks of the buffer from a shared cursor, so the pass
+      needs no counting. A reservation is kept by its worker across the
+      `parallel_for` calls, so at most one partially used chunk per worker is
+      wasted and the buffer keeps room for those on top of the prediction. If
+      the prediction was too small, the pass is retried once with the exact
+      count that the overflowing pass records; the retry cannot overflow.
+*/
+
+enum class BinningMode { TWO_PASS, SINGLE_PASS };
+
+struct BinningConfig {
+    uint32_t n_images = 1;
+    uint32_t image_width = 0;
+    uint32_t image_height = 0;
+    uint32_t tile_width = 16;
+    uint32_t tile_height = 16;
+    // false = leave each tile's primitives unsorted (order-independent
+    // operators only)
+    bool sort_by_depth = true;
+
+    BinningMode mode = BinningMode::SINGLE_PASS;
+    // SINGLE_PASS only: predicted number of intersections, e.g. the previous
+    // frame's `n_isects`. 0 = estimate from a sample of the radii.
+    size_t predicted_n_isects = 0;
+    // SINGLE_PASS only: capacity = predicted_n_isects * slack.
+    float slack = 1.25f;
+    // SINGLE_PASS only: number of slots a worker reserves at a time.
+    uint32_t chunk_size = 1024;
+};
+
+struct BinningResult {
+    std::vector<uint32_t> isect_primitive_ids;       // [n_isects]
+    std::vector<uint32_t> isect_prefix_sum_per_tile; // [n_images * n_tiles]
+    size_t n_isects = 0;
+    size_t n_passes = 0; // passes over the primitives (1 = no retry)
+};
+
+namespace detail {
+
+struct TileRange {
+    uint32_t x_min, x_max, y_min, y_max; // [min, max)
+
+    auto count() const -> size_t {
+        return size_t(x_max - x_min) * size_t(y_max - y_min);
+    }
+};
+
+struct IsectEntry {
+    uint32_t tile; // global tile id, UINT32_MAX marks an unused slot
+    uint32_t primitive_id;
+    float depth;
+};
+
+// The entry lists are the largest buffers of the binning and are scattered
+// into by tile, so they are allocated huge-page aligned (see core/huge_pages.h).
+using IsectEntries = std::vector<IsectEntry, huge_pages::Allocator<IsectEntry>>;
+
+inline auto tile_range(
+    const BinningConfig &cfg, const float *means2d, const float *radii, size_t i
+) -> TileRange {
+    const uint32_t n_tiles_x = (cfg.image_width + cfg.tile_width - 1) / cfg.tile_width;
+    const uint32_t n_tiles_y = (cfg.image_height + cfg.tile_height - 1) / cfg.tile_height;
+    const float rx = radii[2 * i], ry = radii[2 * i + 1];
+    if (!(rx > 0.f && ry > 0.f))
+        return {0, 0, 0, 0};
+    const float mx = means2d[2 * i], my = means2d[2 * i + 1];
+    auto clamp_tile = [](float v, uint32_t n) -> uint32_t {
+        if (!(v > 0.f))
+            return 0;
+        return v >= float(n) ? n : static_cast<uint32_t>(v);
+    };
+    TileRange r;
+    r.x_min = clamp_tile(std::floor((mx - rx) / cfg.tile_width), n_tiles_x);
+    r.x_max = clamp_tile(std::ceil((mx + rx) / cfg.tile_width), n_tiles_x);
+    r.y_min = clamp_tile(std::floor((my - ry) / cfg.tile_height), n_tiles_y);
+    r.y_max = clamp_tile(std::ceil((my + ry) / cfg.tile_height), n_tiles_y);
+    if (r.x_min >= r.x_max || r.y_min >= r.y_max)
+        return {0, 0, 0, 0};
+    return r;
+}
+
+template <typename Emit>
+inline auto for_each_tile(
+    const BinningConfig &cfg,
+    const TileRange &r,
+    uint32_t image_id,
+    Emit &&emit
+) -> void {
+    const uint32_t n_tiles_x = (cfg.image_width + cfg.tile_width - 1) / cfg.tile_width;
+    const uint32_t n_tiles_y = (cfg.image_height + cfg.tile_height - 1) / cfg.tile_height;
+    const uint32_t offset = image_id * n_tiles_x * n_tiles_y;
+    for (uint32_t ty = r.y_min; ty < r.y_max; ++ty)
+        for (uint32_t tx = r.x_min; tx < r.x_max; ++tx)
+            emit(offset + ty * n_tiles_x + tx);
+}
+
+// Bucket the entries by tile, sort each tile by depth (if `sort_by_depth`) and
+// fill the result.
+inline auto finalize(
+    const IsectEntries &entries,
+    size_t n_tiles,
+    bool sort_by_depth,
+    BinningResult &result,
+    thread_pool::ThreadPool &pool
+) -> void {
+    std::vector<std::atomic<uint32_t>> counts(n_tiles);
+    pool.parallel_for(entries.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (entries[i].tile != UINT32_MAX)
+                counts[entries[i].tile].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    auto &prefix = result.isect_prefix_sum_per_tile;
+    prefix.resize(n_tiles);
+    uint32_t running = 0;
+    for (size_t t = 0; t < n_tiles; ++t) {
+        running += counts[t].load(std::memory_order_relaxed);
+        prefix[t] = running;
+    }
+    result.n_isects = running;
+
+    // Scatter (tile order), then sort each tile's range by depth.
+    for (size_t t = 0; t < n_tiles; ++t)
+        counts[t].store(t == 0 ? 0 : prefix[t - 1], std::memory_order_relaxed);
+    result.isect_primitive_ids.resize(running);
+    if (!sort_by_depth) {
+        pool.parallel_for(entries.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (entries[i].tile == UINT32_MAX)
+                    continue;
+                const uint32_t slot =
+                    counts[entries[i].tile].fetch_add(1, std::memory_order_relaxed);
+                result.isect_primitive_ids[slot] = entries[i].primitive_id;
+            }
+        });
+        return;
+    }
+    IsectEntries sorted(running);
+    pool.parallel_for(entries.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (entries[i].tile == UINT32_MAX)
+                continue;
+            const uint32_t slot =
+                counts[entries[i].tile].fetch_add(1, std::memory_order_relaxed);
+            sorted[slot] = entries[i];
+        }
+    });
+
+    pool.parallel_for(n_tiles, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            const uint32_t start = t == 0 ? 0 : prefix[t - 1];
+            auto first = sorted.begin() + start, last = sorted.begin() + prefix[t];
+            std::sort(first, last, [](const IsectEntry &a, const IsectEntry &b) {
+                return a.depth < b.depth ||
+                       (a.depth == b.depth && a.primitive_id < b.primitive_id);
+            });
+            for (uint32_t k = start; k < prefix[t]; ++k)
+                result.isect_primitive_ids[k] = sorted[k].primitive_id;
+        }
+    });
+}
+
+} // namespace detail
+
+/// \brief Predict the intersection buffer size for the next frame.
+/// \param prev_n_isects Intersection count of the previous frame
+/// \param slack Multiplicative headroom (>= 1)
+inline auto predict_isect_capacity(size_t prev_n_isects, float slack = 1.25f) -> size_t {
+    return static_cast<size_t>(std::ceil(double(prev_n_isects) * std::max(slack, 1.0f)));
+}
+
+/// \brief Estimate the intersection count from every `stride`-th primitive.
+inline auto estimate_isect_capacity(
+    const BinningConfig &cfg,
+    size_t n_primitives,
+    const float *means2d, // [n_primitives, 2]
+    const float *radii,   // [n_primitives, 2]
+    size_t stride = 64
+) -> size_t {
+    stride = std::max<size_t>(stride, 1);
+    size_t sampled = 0, n_sampled = 0;
+    for (size_t i = 0; i < n_primitives; i += stride, ++n_sampled)
+        sampled += detail::tile_range(cfg, means2d, radii, i).count();
+    if (n_sampled == 0)
+        return 0;
+    return static_cast<size_t>(double(sampled) * double(n_primitives) / double(n_sampled));
+}
+
+/// \brief Build the per-tile, depth-sorted (unless `cfg.sort_by_depth` is false)
+/// intersection lists.
+///
+/// \param n_primitives Number of projected primitives
+/// \param means2d Projected centers in pixels [n_primitives, 2]
+/// \param radii Screen-space radii in pixels [n_primitives, 2], <= 0 = culled
+/// \param depths View depths [n_primitives]
+/// \param image_ids Image of each primitive [n_primitives], nullptr = image 0
+/// \param cfg Image/tile layout and binning mode
+/// \param pool Thread pool the binning runs on
+/// \return Intersection lists ready for `rasterize_kernel`
+inline auto bin_primitives(
+    size_t n_primitives,
+    const float *means2d,
+    const float *radii,
+    const float *depths,
+    const uint32_t *image_ids,
+    const BinningConfig &cfg,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) -> BinningResult {
+    const size_t n_tiles_x = (cfg.image_width + cfg.tile_width - 1) / cfg.tile_width;
+    const size_t n_tiles_y = (cfg.image_height + cfg.tile_height - 1) / cfg.tile_height;
+    const size_t n_tiles = cfg.n_images * n_tiles_x * n_tiles_y;
+    auto image_of = [&](size_t i) -> uint32_t { return image_ids ? image_ids[i] : 0; };
+
+    BinningResult result;
+    detail::IsectEntries entries;
+
+    if (cfg.mode == BinningMode::TWO_PASS) {
+        // Pass 1: count.
+        std::vector<size_t> offsets(n_primitives + 1, 0);
+        pool.parallel_for(n_primitives, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                offsets[i + 1] = detail::tile_range(cfg, means2d, radii, i).count();
+        });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        entries.resize(offsets[n_primitives]);
+        // Pass 2: write.
+        pool.parallel_for(n_primitives, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto r = detail::tile_range(cfg, means2d, radii, i);
+                size_t slot = offsets[i];
+                detail::for_each_tile(cfg, r, image_of(i), [&](uint32_t tile) {
+                    entries[slot++] = {tile, uint32_t(i), depths[i]};
+                });
+            }
+        });
+        result.n_passes = 2;
+        detail::finalize(entries, n_tiles, cfg.sort_by_depth, result, pool);
+        return result;
+    }
+
+    const size_t chunk = std::max<uint32_t>(cfg.chunk_size, 1);
+    const size_t predicted =
+        cfg.predicted_n_isects > 0
+            ? predict_isect_capacity(cfg.predicted_n_isects, cfg.slack)
+            : predict_isect_capacity(
+                  estimate_isect_capacity(cfg, n_primitives, means2d, radii), cfg.slack
+              );
+
+    // One chunk reservation per worker, plus one for a caller that runs the
+    // loop inline (single worker or nested call).
+    struct alignas(64) Reservation {
+        size_t slot = 0, end = 0;
+    };
+    const size_t n_holders = pool.size() + 1;
+    std::vector<Reservation> reservations(n_holders);
+
+    // Writes the entries into a buffer sized for `n_expected` intersections.
+    // Returns false if it overflowed; `n_exact` receives the exact count.
+    auto single_pass = [&](size_t n_expected, size_t &n_exact) -> bool {
+        // Each holder leaves at most one partially used chunk.
+        const size_t capacity =
+            (n_expected + chunk - 1) / chunk * chunk + chunk * n_holders;
+        entries.assign(capacity, detail::IsectEntry{UINT32_MAX, 0, 0.f});
+        std::fill(reservations.begin(), reservations.end(), Reservation{});
+        std::atomic<size_t> cursor{0};
+        std::atomic<size_t> exact{0};
+        std::atomic<bool> overflow{false};
+        result.n_passes += 1;
+
+        pool.parallel_for(n_primitives, [&](size_t begin, size_t end) {
+            const long w = pool.current_worker();
+            auto &res = reservations[w >= 0 ? size_t(w) : n_holders - 1];
+            size_t local_count = 0;
+            for (size_t i = begin; i < end; ++i) {
+                const auto r = detail::tile_range(cfg, means2d, radii, i);
+                local_count += r.count();
+                if (overflow.load(std::memory_order_relaxed))
+                    continue; // only count from here on
+                detail::for_each_tile(cfg, r, image_of(i), [&](uint32_t tile) {
+                    if (res.slot == res.end) {
+                        if (overflow.load(std::memory_order_relaxed))
+                            return;
+                        res.slot = cursor.fetch_add(chunk, std::memory_order_relaxed);
+                        res.end = res.slot + chunk;
+                        if (res.end > capacity) {
+                            overflow.store(true, std::memory_order_relaxed);
+                            res.slot = res.end = 0;
+                            return;
+                        }
+                    }
+                    entries[res.slot++] = {tile, uint32_t(i), depths[i]};
+                });
+            }
+            exact.fetch_add(local_count, std::memory_order_relaxed);
+        });
+        n_exact = exact.load();
+        return !overflow.load();
+    };
+
+    size_t n_exact = 0;
+    if (!single_pass(predicted, n_exact)) {
+        // A holder claims at most (its count) / chunk + 1 chunks, so with the
+        // exact count the padded capacity always suffices.
+        single_pass(n_exact, n_exact);
+    }
+    detail::finalize(entries, n_tiles, cfg.sort_by_depth, result, pool);
+    return result;
+}
+
+} // namespace tinyrend::rasterization
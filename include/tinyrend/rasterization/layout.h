@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tinyrend/core/macros.h"
+
+namespace tinyrend::rasterization {
+
+/*
+    Memory layouts of the per-pixel render outputs (features, alpha, last
+    index) and of their gradients.
+
+    - HWC:   [n_images, H, W, C], channels interleaved (the default).
+    - CHW:   [n_images, C, H, W], one plane per channel, as consumed by CNN
+             heads and encoders.
+    - TILED: [n_images, n_tiles_y, n_tiles_x, tile_height, tile_width, C], every
+             tile a contiguous HWC block. Edge tiles are padded to the full tile
+             size; padding pixels are never written.
+
+    Operators write straight into the requested layout, so no transpose pass
+    over the output is needed. Single-channel outputs (alpha, last index) use
+    the same layout with C = 1, so CHW and HWC coincide for them.
+*/
+
+enum class LayoutKind : uint8_t { HWC, CHW, TILED };
+
+struct OutputLayout {
+    LayoutKind kind = LayoutKind::HWC;
+    uint32_t tile_width = 16;  // TILED only
+    uint32_t tile_height = 16; // TILED only
+
+    /// Number of elements of one image with `n_channels` channels.
+    inline GSPLAT_HOST_DEVICE auto image_size(
+        uint32_t image_width, uint32_t image_height, uint32_t n_channels
+    ) const -> size_t {
+        if (kind != LayoutKind::TILED)
+            return size_t(image_width) * image_height * n_channels;
+        auto const n_tiles_x = (image_width + tile_width - 1) / tile_width;
+        auto const n_tiles_y = (image_height + tile_height - 1) / tile_height;
+        return size_t(n_tiles_x) * n_tiles_y * tile_width * tile_height * n_channels;
+    }
+
+    /// Distance between two consecutive channels of the same pixel.
+    inline GSPLAT_HOST_DEVICE auto
+    channel_stride(uint32_t image_width, uint32_t image_height) const -> size_t {
+        return kind == LayoutKind::CHW ? size_t(image_width) * image_height : 1;
+    }
+
+    /// Offset of channel 0 of pixel (x, y) of image `image_id`.
+    inline GSPLAT_HOST_DEVICE auto offset(
+        uint32_t image_id,
+        uint32_t x,
+        uint32_t y,
+        uint32_t image_width,
+        uint32_t image_height,
+        uint32_t n_channels
+    ) const -> size_t {
+        auto const base = image_id * image_size(image_width, image_height, n_channels);
+        switch (kind) {
+        case LayoutKind::CHW:
+            return base + size_t(y) * image_width + x;
+        case LayoutKind::TILED: {
+            auto const n_tiles_x = (image_width + tile_width - 1) / tile_width;
+            auto const tile = size_t(y / tile_height) * n_tiles_x + x / tile_width;
+            auto const in_tile = (y % tile_height) * tile_width + x % tile_width;
+            return base + (tile * tile_width * tile_height + in_tile) * n_channels;
+        }
+        default:
+            return base + (size_t(y) * image_width + x) * n_channels;
+        }
+    }
+
+    /// Write `n_channels` values (anything indexable with []) of one pixel,
+    /// converted to the element type of `out` (e.g. f16 / bf16 storage).
+    template <typename T, typename FeatureType>
+    inline GSPLAT_HOST_DEVICE auto store(
+        T *out,
+        const FeatureType &value,
+        uint32_t image_id,
+        uint32_t x,
+        uint32_t y,
+        uint32_t image_width,
+        uint32_t image_height,
+        uint32_t n_channels
+    ) const -> void {
+        auto const o = offset(image_id, x, y, image_width, image_height, n_channels);
+        auto const stride = channel_stride(image_width, image_height);
+        for (uint32_t c = 0; c < n_channels; ++c)
+            out[o + c * stride] = T(value[c]);
+    }
+
+    /// Read `n_channels` values of one pixel into `value`.
+    template <typename T, typename FeatureType>
+    inline GSPLAT_HOST_DEVICE auto load(
+        const T *in,
+        FeatureType &value,
+        uint32_t image_id,
+        uint32_t x,
+        uint32_t y,
+        uint32_t image_width,
+        uint32_t image_height,
+        uint32_t n_channels
+    ) const -> void {
+        auto const o = offset(image_id, x, y, image_width, image_height, n_channels);
+        auto const stride = channel_stride(image_width, image_height);
+        for (uint32_t c = 0; c < n_channels; ++c)
+            value[c] = float(in[o + c * stride]);
+    }
+};
+
+} // namespace tinyrend::rasterization
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "tinyrend/core/macros.h"
+
+namespace tinyrend::rasterization {
+
+/*
+    Weighted-blended order-independent transparency (McGuire & Bavoil 2013)
+    for sort-free preview rendering.
+
+    The exact renderer composites front to back,
+
+        C = sum_i T_i a_i c_i,  T_i = prod_{j<i} (1 - a_j),  A = 1 - prod_i (1 - a_i)
+
+    which needs the primitives of each tile sorted by depth. The weighted-
+    blended approximation replaces the transmittance weights T_i by a fixed
+    function of the depth,
+
+        C ~= A * sum_i w(z_i) a_i c_i / sum_i w(z_i) a_i
+
+    which is order independent, so the intersection lists can be binned with
+    `BinningConfig::sort_by_depth = false`. The coverage A is still exact; the
+    color is exact for a single layer and is otherwise a depth-weighted average
+    in which nearer primitives dominate. The summation order within a tile is
+    unspecified without the sort, so results may differ in the last bits
+    between runs.
+
+    `compositing_error` reports how far such a preview is from the exact
+    render of the same view.
+*/
+
+/// \brief Depth weight w(z) * alpha, eq. (7) of McGuire & Bavoil with the
+/// depth measured in units of `depth_scale`.
+inline GSPLAT_HOST_DEVICE auto
+weighted_blended_weight(const float alpha, const float depth, const float depth_scale)
+    -> float {
+    auto const z = depth / depth_scale;
+    auto const z2 = z * z;
+    auto const z_far = z / 40.0f;
+    auto const z_far3 = z_far * z_far * z_far;
+    auto const w = 10.0f / (1e-5f + z2 + z_far3 * z_far3);
+    return alpha * fminf(fmaxf(w, 1e-2f), 3e3f);
+}
+
+/// Per-pixel accumulator of the weighted-blended composite. FeatureType needs
+/// `+=` and multiplication by a float (e.g. `fvec<N>` or `glm::fvec3`).
+template <typename FeatureType> struct WeightedBlendedAccumulator {
+    FeatureType weighted_feature = FeatureType(0.0f); // sum_i w_i a_i c_i
+    float weight = 0.0f;                              // sum_i w_i a_i
+    float revealage = 1.0f;                           // prod_i (1 - a_i)
+
+    inline GSPLAT_HOST_DEVICE auto add(
+        const float alpha,
+        const float depth,
+        const FeatureType &feature,
+        const float depth_scale
+    ) -> void {
+        auto const w = weighted_blended_weight(alpha, depth, depth_scale);
+        weighted_feature += w * feature;
+        weight += w;
+        revealage *= 1.0f - alpha;
+    }
+
+    /// Coverage 1 - prod_i (1 - a_i), as in the exact renderer.
+    inline GSPLAT_HOST_DEVICE auto alpha() const -> float { return 1.0f - revealage; }
+
+    /// Composited feature, premultiplied by the coverage like the exact
+    /// renderer's output.
+    inline GSPLAT_HOST_DEVICE auto feature() const -> FeatureType {
+        if (!(weight > 0.0f))
+            return FeatureType(0.0f);
+        return (alpha() / weight) * weighted_feature;
+    }
+};
+
+struct CompositingErrorReport {
+    float max_abs_feature = 0.f;  // over all pixels and channels
+    float mean_abs_feature = 0.f; // over all pixels and channels
+    float rmse_feature = 0.f;
+    float psnr = INFINITY; // dB, w.r.t. `peak`; inf for identical features
+    float max_abs_alpha = 0.f;
+    float mean_abs_alpha = 0.f;
+};
+
+/// \brief Compare an approximate render against the exact one.
+/// \param n_pixels Number of pixels (over all images)
+/// \param feature_dim Feature channels per pixel
+/// \param ref_features Exact render [n_pixels, feature_dim]
+/// \param ref_alphas Exact coverage [n_pixels] or nullptr
+/// \param features Approximate render [n_pixels, feature_dim]
+/// \param alphas Approximate coverage [n_pixels] or nullptr
+/// \param peak Peak feature value for the PSNR
+inline auto compositing_error(
+    const size_t n_pixels,
+    const uint32_t feature_dim,
+    const float *ref_features,
+    const float *ref_alphas,
+    const float *features,
+    const float *alphas,
+    const float peak = 1.0f
+) -> CompositingErrorReport {
+    CompositingErrorReport report;
+    const size_t n_values = n_pixels * feature_dim;
+    if (n_values > 0) {
+        double sum_abs = 0.0, sum_sq = 0.0;
+        for (size_t k = 0; k < n_values; ++k) {
+            auto const d = std::abs(double(features[k]) - double(ref_features[k]));
+            report.max_abs_feature = std::max(report.max_abs_feature, float(d));
+            sum_abs += d;
+            sum_sq += d * d;
+        }
+        report.mean_abs_feature = float(sum_abs / double(n_values));
+        report.rmse_feature = float(std::sqrt(sum_sq / double(n_values)));
+        if (sum_sq > 0.0)
+            report.psnr = float(
+                20.0 * std::log10(double(peak)) - 10.0 * std::log10(sum_sq / n_values)
+            );
+    }
+    if (ref_alphas != nullptr && alphas != nullptr && n_pixels > 0) {
+        double sum_abs = 0.0;
+        for (size_t k = 0; k < n_pixels; ++k) {
+            auto const d = std::abs(alphas[k] - ref_alphas[k]);
+            report.max_abs_alpha = std::max(report.max_abs_alpha, d);
+            sum_abs += d;
+        }
+        report.mean_abs_alpha = float(sum_abs / double(n_pixels));
+    }
+    return report;
+}
+
+} // namespace tinyrend::rasterization
@@ -3,9 +3,11 @@
 #include <cooperative_groups.h>
 #include <cstdint>
 
+#include "tinyrend/core/half.h"
 #include "tinyrend/core/vec.h"
 #include "tinyrend/core/warp.cuh"
 #include "tinyrend/rasterization/base.cuh"
+#include "tinyrend/rasterization/layout.h"
 
 namespace tinyrend::rasterization {
 
@@ -65,24 +67,25 @@ inline __device__ auto evaluate_light_attenuation_backward(
                fvec3{0.5f * ctx.dx * ctx.dx, ctx.dx * ctx.dy, 0.5f * ctx.dy * ctx.dy};
 }
 
-template <size_t FEATURE_DIM>
+template <size_t FEATURE_DIM, typename StorageT = float>
 struct ImageGaussianRasterizeKernelForwardOperator
     : BaseRasterizeKernelOperator<
-          ImageGaussianRasterizeKernelForwardOperator<FEATURE_DIM>> {
+          ImageGaussianRasterizeKernelForwardOperator<FEATURE_DIM, StorageT>> {
 
-    using FeatureType = fvec<FEATURE_DIM>;
+    using FeatureType = fvec<FEATURE_DIM>;             // fp32 registers
+    using FeatureStorage = vec<StorageT, FEATURE_DIM>; // float, f16 or bf16 in memory
 
     // Inputs
     float *opacity_ptr; // [N, 1]
     fvec2 *mean_ptr;    // [N, 2]
     fvec3 *conic_ptr;   // [N, 3]
-    FeatureType
+    FeatureStorage
         *feature_ptr; // [N, FEATURE_DIM] (e.g., 3 for RGB or 256 for neural features)
 
-    // Outputs
+    // Outputs, stored in `output_layout` (shapes given for HWC)
     int32_t *render_last_index_ptr; // [n_images, image_height, image_width, 1]
     float *render_alpha_ptr;        // [n_images, image_height, image_width, 1]
-    FeatureType
+    FeatureStorage
         *render_feature_ptr; // [n_images, image_height, image_width, FEATURE_DIM]
 
     // Internal variables
@@ -96,6 +99,7 @@ struct ImageGaussianRasterizeKernelForwardOperator
     const float maximum_alpha = 0.999f; // For backward numerical stability.
     const float stop_if_next_trans_smaller_than =
         1e-4f; // For backward numerical stability.
+    OutputLayout output_layout = {}; // HWC, CHW or TILED outputs
 
     static inline __host__ auto sm_size_per_primitive_impl() -> uint32_t {
         // cache the opacity, mean, conic, and primitive_id
@@ -157,7 +161,8 @@ struct ImageGaussianRasterizeKernelForwardOperator
         // this is better than prefetching it to shared memory and loading it from
         // there.
         auto const primitive_id = sm_primitive_id_ptr[t];
-        this->_expected_feature += weight * this->feature_ptr[primitive_id];
+        this->_expected_feature +=
+            weight * this->feature_ptr[primitive_id].template cast<float>();
 
         // update the transmittance
         this->_T = next_T;
@@ -170,43 +175,63 @@ struct ImageGaussianRasterizeKernelForwardOperator
     }
 
     inline __device__ auto pixel_postprocess_impl() -> void {
-        // write to the output buffer
-        auto const offset_pixel =
-            this->image_id * this->image_height * this->image_width + this->pixel_id;
+        // write to the output buffer, directly in the requested layout
+        auto const &layout = this->output_layout;
+        auto const offset_pixel = layout.offset(
+            this->image_id, this->pixel_x, this->pixel_y, this->image_width,
+            this->image_height, 1
+        );
         this->render_alpha_ptr[offset_pixel] = 1.0f - this->_T;
         this->render_last_index_ptr[offset_pixel] = this->_last_index;
-        this->render_feature_ptr[offset_pixel] = this->_expected_feature;
+        if (layout.kind == LayoutKind::HWC) {
+            this->render_feature_ptr[offset_pixel] =
+                this->_expected_feature.template cast<StorageT>();
+        } else {
+            layout.store(
+                reinterpret_cast<StorageT *>(this->render_feature_ptr),
+                this->_expected_feature,
+                this->image_id,
+                this->pixel_x,
+                this->pixel_y,
+                this->image_width,
+                this->image_height,
+                FEATURE_DIM
+            );
+        }
     }
 };
 
-template <size_t FEATURE_DIM>
+template <size_t FEATURE_DIM, typename StorageT = float>
 struct ImageGaussianRasterizeKernelBackwardOperator
     : BaseRasterizeKernelOperator<
-          ImageGaussianRasterizeKernelBackwardOperator<FEATURE_DIM>> {
+          ImageGaussianRasterizeKernelBackwardOperator<FEATURE_DIM, StorageT>> {
 
-    using FeatureType = fvec<FEATURE_DIM>;
+    using FeatureType = fvec<FEATURE_DIM>;             // fp32 registers
+    using FeatureStorage = vec<StorageT, FEATURE_DIM>; // float, f16 or bf16 in memory
 
     // Forward Inputs
     float *opacity_ptr; // [N, 1]
     fvec2 *mean_ptr;    // [N, 2]
     fvec3 *conic_ptr;   // [N, 3]
-    FeatureType
+    FeatureStorage
         *feature_ptr; // [N, FEATURE_DIM] (e.g., 3 for RGB or 256 for neural features)
 
-    // Forward Outputs
+    // Forward Outputs and their gradients, stored in `output_layout`
     int32_t *render_last_index_ptr; // [n_images, image_height, image_width, 1]
     float *render_alpha_ptr;        // [n_images, image_height, image_width, 1]
 
     // Gradients for Forward Outputs
     float *v_render_alpha_ptr; // [n_images, image_height, image_width, 1]
-    FeatureType
+    FeatureStorage
         *v_render_feature_ptr; // [n_images, image_height, image_width, FEATURE_DIM]
 
     // Gradients for Forward Inputs
     float *v_opacity_ptr;       // [N, 1]
     fvec2 *v_mean_ptr;          // [N, 2]
     fvec3 *v_conic_ptr;         // [N, 3]
-    FeatureType *v_feature_ptr; // [N, FEATURE_DIM]
+    // [N, FEATURE_DIM] fp32 accumulator; round it to the storage type after
+    // the pass with `precision::round_accumulator`
+    FeatureType *v_feature_ptr;
 
     // Internal variables
     float _T_final;                // final transmittance
@@ -220,6 +245,7 @@ struct ImageGaussianRasterizeKernelBackwardOperator
     const float maximum_alpha = 0.999f; // For backward numerical stability.
     const float stop_if_next_trans_smaller_than =
         1e-4f; // For backward numerical stability.
+    OutputLayout output_layout = {}; // layout used by the forward pass
 
     static inline __host__ auto sm_size_per_primitive_impl() -> uint32_t {
         // cache the opacity, mean, conic, primitive_id, and feature
@@ -229,10 +255,27 @@ struct ImageGaussianRasterizeKernelBackwardOperator
 
     inline __device__ auto initialize_impl() -> bool {
         // load the gradient for this pixel
-        auto const offset_pixel =
-            this->image_id * this->image_height * this->image_width + this->pixel_id;
+        auto const &layout = this->output_layout;
+        auto const offset_pixel = layout.offset(
+            this->image_id, this->pixel_x, this->pixel_y, this->image_width,
+            this->image_height, 1
+        );
         this->_v_render_alpha = this->v_render_alpha_ptr[offset_pixel];
-        this->_v_render_feature = this->v_render_feature_ptr[offset_pixel];
+        if (layout.kind == LayoutKind::HWC) {
+            this->_v_render_feature =
+                this->v_render_feature_ptr[offset_pixel].template cast<float>();
+        } else {
+            layout.load(
+                reinterpret_cast<const StorageT *>(this->v_render_feature_ptr),
+                this->_v_render_feature,
+                this->image_id,
+                this->pixel_x,
+                this->pixel_y,
+                this->image_width,
+                this->image_height,
+                FEATURE_DIM
+            );
+        }
 
         // load the initial transmittance as remaining transmittance
         this->_T_final = 1.0f - this->render_alpha_ptr[offset_pixel];
@@ -256,7 +299,8 @@ struct ImageGaussianRasterizeKernelBackwardOperator
         sm_mean_ptr[this->thread_rank] = this->mean_ptr[primitive_id];
         sm_conic_ptr[this->thread_rank] = this->conic_ptr[primitive_id];
         sm_primitive_id_ptr[this->thread_rank] = primitive_id;
-        sm_feature_ptr[this->thread_rank] = this->feature_ptr[primitive_id];
+        sm_feature_ptr[this->thread_rank] =
+            this->feature_ptr[primitive_id].template cast<float>();
     }
 
     template <class WarpT>
@@ -0,0 +1,145 @@
+// Sort-free preview variant of ImageGaussianRasterizeKernelForwardOperator: the
+// Gaussians of a tile are composited with weighted-blended OIT (see
+// tinyrend/rasterization/oit.h), so the intersection lists do not need to be
+// sorted by depth. Forward only.
+
+#pragma once
+
+#include <cooperative_groups.h>
+#include <cstdint>
+
+#include "tinyrend/core/vec.h"
+#include "tinyrend/rasterization/base.cuh"
+#include "tinyrend/rasterization/layout.h"
+#include "tinyrend/rasterization/oit.h"
+#include "tinyrend/rasterization/operators/image_gaussian.cuh"
+
+namespace tinyrend::rasterization {
+
+namespace cg = cooperative_groups;
+
+template <size_t FEATURE_DIM, typename StorageT = float>
+struct ImageGaussianWeightedBlendedRasterizeKernelForwardOperator
+    : BaseRasterizeKernelOperator<
+          ImageGaussianWeightedBlendedRasterizeKernelForwardOperator<
+              FEATURE_DIM,
+              StorageT>> {
+
+    using FeatureType = fvec<FEATURE_DIM>;             // fp32 registers
+    using FeatureStorage = vec<StorageT, FEATURE_DIM>; // float, f16 or bf16 in memory
+
+    // Inputs
+    float *opacity_ptr; // [N, 1]
+    fvec2 *mean_ptr;    // [N, 2]
+    fvec3 *conic_ptr;   // [N, 3]
+    float *depth_ptr;   // [N, 1] view depth
+    FeatureStorage
+        *feature_ptr; // [N, FEATURE_DIM] (e.g., 3 for RGB or 256 for neural features)
+
+    // Outputs, stored in `output_layout` (shapes given for HWC)
+    float *render_alpha_ptr; // [n_images, image_height, image_width, 1]
+    FeatureStorage
+        *render_feature_ptr; // [n_images, image_height, image_width, FEATURE_DIM]
+
+    // Internal variables
+    WeightedBlendedAccumulator<FeatureType> _accumulator;
+
+    // Configs
+    const float skip_if_alpha_smaller_than = 1.0f / 255.0f;
+    const float maximum_alpha = 0.999f; // Same clamp as the exact renderer.
+    float depth_scale = 5.0f;           // Depth unit of the blending weights.
+    OutputLayout output_layout = {};    // HWC, CHW or TILED outputs
+
+    static inline __host__ auto sm_size_per_primitive_impl() -> uint32_t {
+        // cache the opacity, mean, conic, depth, and primitive_id
+        return sizeof(float) + sizeof(fvec2) + sizeof(fvec3) + sizeof(float) +
+               sizeof(uint32_t);
+    }
+
+    inline __device__ auto initialize_impl() -> bool { return true; }
+
+    inline __device__ auto primitive_preprocess_impl(uint32_t primitive_id) -> void {
+        // cache data to shared memory
+        auto const sm_opacity_ptr = reinterpret_cast<float *>(this->sm_ptr);
+        auto const sm_mean_ptr =
+            reinterpret_cast<fvec2 *>(&sm_opacity_ptr[this->n_threads_per_block]);
+        auto const sm_conic_ptr =
+            reinterpret_cast<fvec3 *>(&sm_mean_ptr[this->n_threads_per_block]);
+        auto const sm_depth_ptr =
+            reinterpret_cast<float *>(&sm_conic_ptr[this->n_threads_per_block]);
+        auto const sm_primitive_id_ptr =
+            reinterpret_cast<uint32_t *>(&sm_depth_ptr[this->n_threads_per_block]);
+        sm_opacity_ptr[this->thread_rank] = this->opacity_ptr[primitive_id];
+        sm_mean_ptr[this->thread_rank] = this->mean_ptr[primitive_id];
+        sm_conic_ptr[this->thread_rank] = this->conic_ptr[primitive_id];
+        sm_depth_ptr[this->thread_rank] = this->depth_ptr[primitive_id];
+        sm_primitive_id_ptr[this->thread_rank] = primitive_id;
+    }
+
+    template <class WarpT>
+    inline __device__ auto
+    rasterize_impl(uint32_t batch_start, uint32_t t, WarpT &warp) -> bool {
+        // load data from shared memory
+        auto const sm_opacity_ptr = reinterpret_cast<float *>(this->sm_ptr);
+        auto const sm_mean_ptr =
+            reinterpret_cast<fvec2 *>(&sm_opacity_ptr[this->n_threads_per_block]);
+        auto const sm_conic_ptr =
+            reinterpret_cast<fvec3 *>(&sm_mean_ptr[this->n_threads_per_block]);
+        auto const sm_depth_ptr =
+            reinterpret_cast<float *>(&sm_conic_ptr[this->n_threads_per_block]);
+        auto const sm_primitive_id_ptr =
+            reinterpret_cast<uint32_t *>(&sm_depth_ptr[this->n_threads_per_block]);
+
+        // compute the light attenuation
+        auto const &[alpha, _ctx] = evaluate_light_attenuation_forward(
+            sm_opacity_ptr[t],
+            sm_mean_ptr[t],
+            sm_conic_ptr[t],
+            this->pixel_x,
+            this->pixel_y,
+            this->maximum_alpha
+        );
+        // skip if the alpha is smaller than the threshold
+        if (alpha < this->skip_if_alpha_smaller_than) {
+            return false; // continue
+        }
+
+        // Without a depth order there is no transmittance-based early stop: a
+        // later primitive may still be the nearest one.
+        auto const primitive_id = sm_primitive_id_ptr[t];
+        this->_accumulator.add(
+            alpha,
+            sm_depth_ptr[t],
+            this->feature_ptr[primitive_id].template cast<float>(),
+            this->depth_scale
+        );
+        return false;
+    }
+
+    inline __device__ auto pixel_postprocess_impl() -> void {
+        // write to the output buffer, directly in the requested layout
+        auto const &layout = this->output_layout;
+        auto const offset_pixel = layout.offset(
+            this->image_id, this->pixel_x, this->pixel_y, this->image_width,
+            this->image_height, 1
+        );
+        this->render_alpha_ptr[offset_pixel] = this->_accumulator.alpha();
+        if (layout.kind == LayoutKind::HWC) {
+            this->render_feature_ptr[offset_pixel] =
+                this->_accumulator.feature().template cast<StorageT>();
+        } else {
+            layout.store(
+                reinterpret_cast<StorageT *>(this->render_feature_ptr),
+                this->_accumulator.feature(),
+                this->image_id,
+                this->pixel_x,
+                this->pixel_y,
+                this->image_width,
+                this->image_height,
+                FEATURE_DIM
+            );
+        }
+    }
+};
+
+} // namespace tinyrend::rasterization
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/rasterization/layout.h"
+
+namespace tinyrend::rasterization {
+
+/*
+    CPU writers that flush rasterized tiles into an `OutputLayout`.
+
+    A CPU rasterizer accumulates one tile in a small dense [tile_h, tile_w, C]
+    scratch buffer (which stays in L1) and hands it to `store_tile`. The output
+    is written with non-temporal stores: full cache lines go straight to
+    memory instead of evicting the scene data the next tiles still need, and
+    the lines are not read before they are overwritten. Partial lines at run
+    boundaries use regular stores. Streaming stores are weakly ordered: call
+    `stream_fence` before another thread reads the output (the helpers below
+    that run on the pool do so on every worker).
+*/
+
+/// \brief Order preceding non-temporal stores before any later store.
+inline void stream_fence() {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+namespace detail {
+
+// dst[i] = src[i * src_stride] for i < n, streaming the 64-byte aligned part.
+inline void stream_run(float *dst, const float *src, size_t n, size_t src_stride) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    constexpr size_t LINE = 16; // floats per cache line
+    auto const misalign = reinterpret_cast<uintptr_t>(dst) % 64;
+    if (misalign % sizeof(float) == 0) {
+        const size_t head = misalign == 0 ? 0 : (64 - misalign) / sizeof(float);
+        if (head + LINE <= n) {
+            for (; i < head; ++i)
+                dst[i] = src[i * src_stride];
+            for (; i + LINE <= n; i += LINE) {
+                for (size_t k = 0; k < LINE; k += 4) {
+                    __m128 v;
+                    if (src_stride == 1) {
+                        v = _mm_loadu_ps(src + i + k);
+                    } else {
+                        auto const *s = src + (i + k) * src_stride;
+                        v = _mm_setr_ps(
+                            s[0], s[src_stride], s[2 * src_stride], s[3 * src_stride]
+                        );
+                    }
+                    _mm_stream_ps(dst + i + k, v);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i)
+        dst[i] = src[i * src_stride];
+}
+
+} // namespace detail
+
+/// \brief Write one rasterized tile into `out` in `layout`.
+///
+/// \param tile Tile scratch [tile_h, tile_w, n_channels]; rows and columns
+///   beyond the image border are ignored
+/// \param out Output buffer of `n_images * layout.image_size(...)` floats
+/// \param x0, y0 Pixel of the tile's top-left corner
+/// \param tile_pitch Floats between tile rows (0 = tile_w * n_channels)
+inline void store_tile(
+    const OutputLayout &layout,
+    uint32_t image_width,
+    uint32_t image_height,
+    uint32_t n_channels,
+    uint32_t image_id,
+    uint32_t x0,
+    uint32_t y0,
+    uint32_t tile_w,
+    uint32_t tile_h,
+    const float *tile,
+    float *out,
+    size_t tile_pitch = 0
+) {
+    if (x0 >= image_width || y0 >= image_height)
+        return;
+    const uint32_t w = std::min(tile_w, image_width - x0);
+    const uint32_t h = std::min(tile_h, image_height - y0);
+    const size_t C = n_channels;
+    const size_t pitch = tile_pitch > 0 ? tile_pitch : size_t(tile_w) * C;
+    auto const offset = [&](uint32_t x, uint32_t y) {
+        return layout.offset(image_id, x, y, image_width, image_height, n_channels);
+    };
+
+    for (uint32_t r = 0; r < h; ++r) {
+        const uint32_t y = y0 + r;
+        const float *row = tile + r * pitch;
+        switch (layout.kind) {
+        case LayoutKind::CHW: {
+            const size_t plane = layout.channel_stride(image_width, image_height);
+            for (size_t c = 0; c < C; ++c)
+                detail::stream_run(out + offset(x0, y) + c * plane, row + c, w, C);
+            break;
+        }
+        case LayoutKind::TILED:
+            // a row is contiguous up to the next layout tile boundary
+            for (uint32_t x = x0; x < x0 + w;) {
+                const uint32_t end =
+                    std::min(x0 + w, (x / layout.tile_width + 1) * layout.tile_width);
+                detail::stream_run(
+                    out + offset(x, y), row + (x - x0) * C, (end - x) * C, 1
+                );
+                x = end;
+            }
+            break;
+        default:
+            detail::stream_run(out + offset(x0, y), row, w * C, 1);
+            break;
+        }
+    }
+}
+
+/// \brief Re-layout HWC images [n_images, H, W, C] into `layout`, tile by tile
+/// with streaming stores, on the pool.
+///
+/// For producers that can only write HWC; operators that support
+/// `OutputLayout` should write the target layout directly instead.
+inline void convert_layout(
+    const OutputLayout &layout,
+    size_t n_images,
+    uint32_t image_width,
+    uint32_t image_height,
+    uint32_t n_channels,
+    const float *hwc,
+    float *out,
+    thread_pool::ThreadPool &pool = thread_pool::global_pool()
+) {
+    if (hwc == out)
+        throw std::invalid_argument("convert_layout: cannot convert in place");
+    // Tiles of the layout itself, or 16 x 16 for the row-major layouts.
+    const uint32_t tw = layout.kind == LayoutKind::TILED ? layout.tile_width : 16;
+    const uint32_t th = layout.kind == LayoutKind::TILED ? layout.tile_height : 16;
+    const size_t n_tiles_x = (image_width + tw - 1) / tw;
+    const size_t n_tiles_y = (image_height + th - 1) / th;
+    const size_t n_jobs = n_images * n_tiles_y; // one row of tiles per job
+    const size_t image_pixels = size_t(image_width) * image_height;
+    pool.parallel_for(
+        n_jobs,
+        [&](size_t begin, size_t end) {
+            for (size_t job = begin; job < end; ++job) {
+                const uint32_t image_id = uint32_t(job / n_tiles_y);
+                const uint32_t y0 = uint32_t(job % n_tiles_y) * th;
+                // a tile of the source is a tile scratch with a row pitch of W * C
+                for (size_t tx = 0; tx < n_tiles_x; ++tx) {
+                    const uint32_t x0 = uint32_t(tx) * tw;
+                    const size_t pixel =
+                        image_id * image_pixels + size_t(y0) * image_width + x0;
+                    store_tile(
+                        layout,
+                        image_width,
+                        image_height,
+                        n_channels,
+                        image_id,
+                        x0,
+                        y0,
+                        tw,
+                        th,
+                        hwc + pixel * n_channels,
+                        out,
+                        size_t(image_width) * n_channels
+                    );
+                }
+            }
+            stream_fence();
+        },
+        1
+    );
+}
+
+} // namespace tinyrend::rasterization
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/gaussian.h"
+
+namespace tinyrend::raytracing {
+
+/*
+    Uniform-grid acceleration structure over 3D Gaussians for CPU ray queries.
+
+    Every Gaussian is bounded by the axis-aligned box of its ellipsoid at the
+    level where its opacity drops to `alpha_min`, and listed in every grid cell
+    that box overlaps (CSR layout: `cell_offsets` / `cell_primitive_ids`).
+    Gaussians whose opacity is below `alpha_min` are left out entirely.
+
+    Rays visit the cells they cross front to back with a 3D-DDA
+    (Amanatides & Woo, "A Fast Voxel Traversal Algorithm for Ray Tracing",
+    1987). Per Gaussian the grid keeps the whitening transform
+    W = S⁻¹ Rᵀ (covar⁻¹ = Wᵀ W), so a ray query needs no quaternion math.
+*/
+
+/// \brief Read-only structure-of-arrays view of the Gaussians.
+struct GaussianPrimitives {
+    size_t n_primitives = 0;
+    const float *means = nullptr;     // [n_primitives, 3]
+    const float *quats = nullptr;     // [n_primitives, 4]
+    const float *scales = nullptr;    // [n_primitives, 3]
+    const float *opacities = nullptr; // [n_primitives]
+};
+
+struct GridConfig {
+    /// Opacity below which a Gaussian's response is ignored.
+    float alpha_min = 1.f / 255.f;
+    /// Target number of grid cells per (non-culled) Gaussian.
+    float cells_per_primitive = 1.f;
+    /// Upper bound on the resolution along each axis.
+    uint32_t max_resolution = 512;
+};
+
+struct GaussianGrid {
+    glm::fvec3 bbox_min{0.f};
+    glm::fvec3 cell_size{1.f};
+    glm::uvec3 resolution{0};
+    float alpha_min = 1.f / 255.f;
+
+    std::vector<uint32_t> cell_offsets;       // [n_cells + 1]
+    std::vector<uint32_t> cell_primitive_ids; // [n_entries], ascending per cell
+
+    // per primitive, indexed by primitive id
+    std::vector<glm::fvec3> means;
+    std::vector<glm::fmat3> whitening; // W = S⁻¹ Rᵀ
+    std::vector<float> opacities;
+    std::vector<float> log_opacities;
+
+    auto n_cells() const -> size_t {
+        return size_t(resolution.x) * resolution.y * resolution.z;
+    }
+    auto cell_index(const glm::uvec3 &c) const -> size_t {
+        return (size_t(c.z) * resolution.y + c.y) * resolution.x + c.x;
+    }
+};
+
+namespace detail {
+
+struct CellRange {
+    glm::uvec3 min, max; // [min, max)
+
+    auto empty() const -> bool {
+        return min.x >= max.x || min.y >= max.y || min.z >= max.z;
+    }
+    auto count() const -> size_t {
+        return empty() ? 0 : size_t(max.x - min.x) * (max.y - min.y) * (max.z - min.z);
+    }
+};
+
+inline auto cell_range(
+    const GaussianGrid &grid, const glm::fvec3 &lo, const glm::fvec3 &hi
+) -> CellRange {
+    CellRange r;
+    for (int k = 0; k < 3; ++k) {
+        auto clamp_cell = [&](float v) -> uint32_t {
+            if (!(v > 0.f))
+                return 0;
+            return v >= float(grid.resolution[k]) ? grid.resolution[k]
+                                                  : static_cast<uint32_t>(v);
+        };
+        auto const lo_k = (lo[k] - grid.bbox_min[k]) / grid.cell_size[k];
+        auto const hi_k = (hi[k] - grid.bbox_min[k]) / grid.cell_size[k];
+        r.min[k] = clamp_cell(std::floor(lo_k));
+        r.max[k] = clamp_cell(std::floor(hi_k) + 1);
+    }
+    return r;
+}
+
+} // namespace detail
+
+/// \brief Build the uniform grid over a set of Gaussians.
+/// \param primitives Gaussians (host memory)
+/// \param cfg Culling threshold and grid resolution
+/// \return Grid, empty (zero resolution) if no Gaussian is visible
+inline auto build_grid(
+    const GaussianPrimitives &primitives, const GridConfig &cfg = {}
+) -> GaussianGrid {
+    const size_t n = primitives.n_primitives;
+    GaussianGrid grid;
+    grid.alpha_min = cfg.alpha_min;
+    grid.means.resize(n);
+    grid.whitening.resize(n);
+    grid.opacities.resize(n);
+    grid.log_opacities.resize(n);
+
+    // Whitening transforms and bounding boxes of the ellipsoids where the
+    // response falls to alpha_min: |W (x - mu)|² = 2 ln(opacity / alpha_min).
+    std::vector<glm::fvec3> lo(n), hi(n);
+    std::vector<uint8_t> visible(n);
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto const mean = glm::make_vec3(primitives.means + 3 * i);
+            auto const quat = glm::make_vec4(primitives.quats + 4 * i);
+            auto const scale = glm::make_vec3(primitives.scales + 3 * i);
+            auto const opacity = primitives.opacities[i];
+            auto const R = tinyrend::gaussian::quat_to_rotmat(quat);
+            auto const Sinv = glm::fmat3(
+                1.f / scale[0],
+                0.f,
+                0.f,
+                0.f,
+                1.f / scale[1],
+                0.f,
+                0.f,
+                0.f,
+                1.f / scale[2]
+            );
+            grid.means[i] = mean;
+            grid.whitening[i] = glm::transpose(R * Sinv);
+            grid.opacities[i] = opacity;
+            grid.log_opacities[i] = std::log(opacity);
+            visible[i] = opacity >= cfg.alpha_min;
+            if (!visible[i])
+                continue;
+            auto const k2 = 2.f * std::log(opacity / cfg.alpha_min);
+            // half extent along axis a: k * sqrt(covar_aa), covar = R S² Rᵀ
+            glm::fvec3 extent;
+            for (int a = 0; a < 3; ++a) {
+                float var = 0.f;
+                for (int j = 0; j < 3; ++j)
+                    var += R[j][a] * R[j][a] * scale[j] * scale[j];
+                extent[a] = std::sqrt(k2 * var);
+            }
+            lo[i] = mean - extent;
+            hi[i] = mean + extent;
+        }
+    });
+
+    // Scene bounds and resolution
+    auto bbox_min = glm::fvec3(std::numeric_limits<float>::max());
+    auto bbox_max = glm::fvec3(std::numeric_limits<float>::lowest());
+    size_t n_visible = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!visible[i])
+            continue;
+        bbox_min = glm::min(bbox_min, lo[i]);
+        bbox_max = glm::max(bbox_max, hi[i]);
+        n_visible += 1;
+    }
+    if (n_visible == 0) {
+        grid.cell_offsets.assign(1, 0);
+        return grid;
+    }
+    auto const extent = glm::max(bbox_max - bbox_min, glm::fvec3(1e-6f));
+    auto const target_cells =
+        std::max(1.0, double(n_visible) * cfg.cells_per_primitive);
+    auto const side = std::cbrt(double(extent.x) * extent.y * extent.z / target_cells);
+    for (int k = 0; k < 3; ++k) {
+        auto const cells = std::ceil(double(extent[k]) / side);
+        grid.resolution[k] =
+            static_cast<uint32_t>(std::clamp(cells, 1.0, double(cfg.max_resolution)));
+    }
+    grid.bbox_min = bbox_min;
+    grid.cell_size = extent / glm::fvec3(grid.resolution);
+
+    // Count, scan, scatter, then sort each cell for deterministic results.
+    const size_t n_cells = grid.n_cells();
+    std::vector<std::atomic<uint32_t>> counts(n_cells);
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!visible[i])
+                continue;
+            auto const r = detail::cell_range(grid, lo[i], hi[i]);
+            for (uint32_t z = r.min.z; z < r.max.z; ++z)
+                for (uint32_t y = r.min.y; y < r.max.y; ++y)
+                    for (uint32_t x = r.min.x; x < r.max.x; ++x)
+                        counts[grid.cell_index({x, y, z})].fetch_add(
+                            1, std::memory_order_relaxed
+                        );
+        }
+    });
+    grid.cell_offsets.resize(n_cells + 1);
+    grid.cell_offsets[0] = 0;
+    for (size_t c = 0; c < n_cells; ++c) {
+        grid.cell_offsets[c + 1] =
+            grid.cell_offsets[c] + counts[c].load(std::memory_order_relaxed);
+        counts[c].store(grid.cell_offsets[c], std::memory_order_relaxed);
+    }
+    grid.cell_primitive_ids.resize(grid.cell_offsets[n_cells]);
+    thread_pool::parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!visible[i])
+                continue;
+            auto const r = detail::cell_range(grid, lo[i], hi[i]);
+            for (uint32_t z = r.min.z; z < r.max.z; ++z)
+                for (uint32_t y = r.min.y; y < r.max.y; ++y)
+                    for (uint32_t x = r.min.x; x < r.max.x; ++x) {
+                        const uint32_t slot =
+                            counts[grid.cell_index({x, y, z})].fetch_add(
+                                1, std::memory_order_relaxed
+                            );
+                        grid.cell_primitive_ids[slot] = static_cast<uint32_t>(i);
+                    }
+        }
+    });
+    thread_pool::parallel_for(n_cells, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+            std::sort(
+                grid.cell_primitive_ids.begin() + grid.cell_offsets[c],
+                grid.cell_primitive_ids.begin() + grid.cell_offsets[c + 1]
+            );
+    });
+    return grid;
+}
+
+/// \brief Visit the cells crossed by the ray segment o + t d, t in [t_min, t_max],
+/// front to back.
+/// \param visit Called as `visit(cell_index, t_enter, t_exit) -> bool`; returning
+/// false stops the traversal
+template <typename Visit>
+inline auto for_each_cell(
+    const GaussianGrid &grid,
+    const glm::fvec3 &ray_o,
+    const glm::fvec3 &ray_d,
+    float t_min,
+    float t_max,
+    Visit &&visit
+) -> void {
+    if (grid.n_cells() == 0)
+        return;
+
+    // clip the segment to the grid bounds (slab test)
+    auto const bbox_max = grid.bbox_min + grid.cell_size * glm::fvec3(grid.resolution);
+    glm::fvec3 inv_d;
+    for (int k = 0; k < 3; ++k) {
+        inv_d[k] = 1.f / ray_d[k];
+        auto t0 = (grid.bbox_min[k] - ray_o[k]) * inv_d[k];
+        auto t1 = (bbox_max[k] - ray_o[k]) * inv_d[k];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        if (std::isnan(t0) || std::isnan(t1)) {
+            // parallel to the slab with the origin on its boundary
+            t0 = -std::numeric_limits<float>::infinity();
+            t1 = std::numeric_limits<float>::infinity();
+        }
+        t_min = std::max(t_min, t0);
+        t_max = std::min(t_max, t1);
+    }
+    if (!(t_min <= t_max))
+        return;
+
+    // starting cell and DDA state
+    auto const p = ray_o + t_min * ray_d;
+    glm::ivec3 cell, step, limit;
+    glm::fvec3 t_next, t_delta;
+    for (int k = 0; k < 3; ++k) {
+        auto const f = (p[k] - grid.bbox_min[k]) / grid.cell_size[k];
+        cell[k] = std::clamp(int(std::floor(f)), 0, int(grid.resolution[k]) - 1);
+        if (ray_d[k] > 0.f) {
+            step[k] = 1;
+            limit[k] = int(grid.resolution[k]);
+            auto const boundary =
+                grid.bbox_min[k] + float(cell[k] + 1) * grid.cell_size[k];
+            t_next[k] = (boundary - ray_o[k]) * inv_d[k];
+            t_delta[k] = grid.cell_size[k] * inv_d[k];
+        } else if (ray_d[k] < 0.f) {
+            step[k] = -1;
+            limit[k] = -1;
+            auto const boundary = grid.bbox_min[k] + float(cell[k]) * grid.cell_size[k];
+            t_next[k] = (boundary - ray_o[k]) * inv_d[k];
+            t_delta[k] = -grid.cell_size[k] * inv_d[k];
+        } else {
+            step[k] = 0;
+            limit[k] = -1;
+            t_next[k] = std::numeric_limits<float>::infinity();
+            t_delta[k] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    float t_enter = t_min;
+    while (true) {
+        int axis = 0;
+        if (t_next[1] < t_next[axis])
+            axis = 1;
+        if (t_next[2] < t_next[axis])
+            axis = 2;
+        auto const t_exit = std::min(t_next[axis], t_max);
+        if (!visit(grid.cell_index(glm::uvec3(cell)), t_enter, t_exit))
+            return;
+        if (t_next[axis] >= t_max)
+            return;
+        cell[axis] += step[axis];
+        if (cell[axis] == limit[axis])
+            return;
+        t_enter = t_next[axis];
+        t_next[axis] += t_delta[axis];
+    }
+}
+
+} // namespace tinyrend::raytracing
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "tinyrend/core/morton.h"
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/raytracing/grid.h"
+#include "tinyrend/raytracing/point_queries.h"
+
+namespace tinyrend::raytracing {
+
+/*
+    Iso-surface extraction from the Gaussian density field (`point_density`).
+
+    The sampling lattice (spacing `voxel_size`) over the grid bounds is split
+    into blocks of block_size³ cubes. A block is sampled only if one of the
+    grid cells it overlaps lists a Gaussian, i.e. if some Gaussian's bounds
+    reach it; everything else is known to be empty and is never evaluated.
+
+    Occupied blocks are polygonized in parallel. Every cube is split into the
+    six tetrahedra of the Kuhn (Freudenthal) triangulation, which is the same
+    in every cube, so the surface is watertight across cubes and blocks
+    without the ambiguity resolution of the 256-case marching-cubes tables.
+    A surface vertex lies on a lattice edge, identified by its lower lattice
+    vertex and one of 7 directions (axes, face and body diagonals). Blocks
+    emit vertices keyed by that id; the keys of all blocks are then radix
+    sorted and de-duplicated, so shared vertices are merged exactly.
+
+    Triangles are oriented counter-clockwise seen from outside (density below
+    the iso level).
+*/
+
+struct MeshExtractionConfig {
+    /// Density of the surface; should be above the grid's alpha_min.
+    float iso_level = 0.5f;
+    /// Lattice spacing.
+    float voxel_size = 0.01f;
+    /// Cubes per block side.
+    uint32_t block_size = 16;
+};
+
+struct Mesh {
+    std::vector<glm::fvec3> vertices;
+    std::vector<glm::uvec3> triangles;
+    size_t n_occupied_blocks = 0;
+    size_t n_blocks = 0;
+};
+
+namespace detail {
+
+// Corner offsets (bit 0 = x, bit 1 = y, bit 2 = z) of the 6 tetrahedra: the
+// monotone paths from corner 0 to corner 7.
+constexpr std::array<std::array<uint8_t, 4>, 6> KUHN_TETRAHEDRA = {{
+    {0, 1, 3, 7},
+    {0, 1, 5, 7},
+    {0, 2, 3, 7},
+    {0, 2, 6, 7},
+    {0, 4, 5, 7},
+    {0, 4, 6, 7},
+}};
+
+struct EdgeVertex {
+    uint64_t key;
+    glm::fvec3 position;
+};
+
+struct BlockMesh {
+    std::vector<EdgeVertex> vertices;
+    std::vector<std::array<uint64_t, 3>> triangles; // vertex keys
+};
+
+/// Polygonize one lattice cube given its corner values, corner keys (lattice
+/// index * 8) and corner positions; appends to `out`.
+inline auto polygonize_cube(
+    const float v[8],
+    const uint64_t keys[8],
+    const glm::fvec3 points[8],
+    const float iso_level,
+    BlockMesh &out
+) -> void {
+    // surface vertex on the edge between corners a < b (b's bits are a superset
+    // of a's), keyed by its lower lattice vertex and direction
+    auto const edge = [&](int a, int b) -> uint64_t {
+        if (a > b)
+            std::swap(a, b);
+        auto const key = keys[a] + uint64_t(a ^ b);
+        auto const t = (iso_level - v[a]) / (v[b] - v[a]);
+        out.vertices.push_back({key, glm::mix(points[a], points[b], t)});
+        return key;
+    };
+    auto const pos = [&](size_t back) {
+        return out.vertices[out.vertices.size() - back].position;
+    };
+    // orient the last emitted vertices away from the inside corner `inner`
+    auto const emit = [&](int inner,
+                          uint64_t k0,
+                          uint64_t k1,
+                          uint64_t k2,
+                          size_t back0,
+                          size_t back1,
+                          size_t back2) {
+        auto const p0 = pos(back0);
+        auto const n = glm::cross(pos(back1) - p0, pos(back2) - p0);
+        if (glm::dot(n, points[inner] - p0) > 0.f)
+            std::swap(k1, k2);
+        out.triangles.push_back({k0, k1, k2});
+    };
+
+    for (auto const &tet : KUHN_TETRAHEDRA) {
+        int in[4], n_in = 0, outside[4], n_out = 0;
+        for (int k = 0; k < 4; ++k) {
+            if (v[tet[k]] >= iso_level)
+                in[n_in++] = tet[k];
+            else
+                outside[n_out++] = tet[k];
+        }
+        if (n_in == 0 || n_out == 0)
+            continue;
+        if (n_in == 1 || n_out == 1) {
+            // one corner separated from the other three
+            auto const single = n_in == 1 ? in[0] : outside[0];
+            auto const *others = n_in == 1 ? outside : in;
+            auto const k0 = edge(single, others[0]);
+            auto const k1 = edge(single, others[1]);
+            auto const k2 = edge(single, others[2]);
+            emit(n_in == 1 ? single : others[0], k0, k1, k2, 3, 2, 1);
+        } else {
+            // two and two: a quad, split into two triangles
+            auto const k0 = edge(in[0], outside[0]);
+            auto const k1 = edge(in[0], outside[1]);
+            auto const k2 = edge(in[1], outside[1]);
+            auto const k3 = edge(in[1], outside[0]);
+            emit(in[0], k0, k1, k2, 4, 3, 2);
+            emit(in[0], k0, k2, k3, 4, 2, 1);
+        }
+    }
+}
+
+} // namespace detail
+
+/// \brief Extract the iso-surface of the density field of the Gaussians.
+/// \param grid Spatial index of the Gaussians, see `build_grid`
+/// \param cfg Iso level, resolution and block size
+/// \return Indexed triangle mesh
+inline auto extract_mesh(const GaussianGrid &grid, const MeshExtractionConfig &cfg = {})
+    -> Mesh {
+    Mesh mesh;
+    if (grid.n_cells() == 0)
+        return mesh;
+
+    // lattice over the grid bounds
+    auto const extent = grid.cell_size * glm::fvec3(grid.resolution);
+    auto const B = std::max<uint32_t>(cfg.block_size, 1);
+    glm::uvec3 n_cubes, n_blocks;
+    for (int k = 0; k < 3; ++k) {
+        auto const cubes = std::ceil(double(extent[k]) / cfg.voxel_size);
+        n_cubes[k] = static_cast<uint32_t>(std::clamp(cubes, 1.0, double(1u << 30)));
+        n_blocks[k] = (n_cubes[k] + B - 1) / B;
+    }
+    auto const n_lattice = n_cubes + 1u;
+    auto const lattice_index = [&](uint32_t x, uint32_t y, uint32_t z) -> uint64_t {
+        return (uint64_t(z) * n_lattice.y + y) * n_lattice.x + x;
+    };
+    auto const lattice_point = [&](uint32_t x, uint32_t y, uint32_t z) -> glm::fvec3 {
+        return grid.bbox_min +
+               cfg.voxel_size * glm::fvec3(float(x), float(y), float(z));
+    };
+    auto const block_origin = [&](size_t b) -> glm::uvec3 {
+        return glm::uvec3(
+                   uint32_t(b % n_blocks.x),
+                   uint32_t(b / n_blocks.x % n_blocks.y),
+                   uint32_t(b / (size_t(n_blocks.x) * n_blocks.y))
+               ) *
+               B;
+    };
+
+    // block occupancy from the Gaussian bounds held by the grid cells
+    const size_t total_blocks = size_t(n_blocks.x) * n_blocks.y * n_blocks.z;
+    mesh.n_blocks = total_blocks;
+    std::vector<uint8_t> occupied(total_blocks);
+    thread_pool::parallel_for(total_blocks, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            auto const origin = block_origin(b);
+            auto const lo = lattice_point(origin.x, origin.y, origin.z);
+            auto const hi = lo + cfg.voxel_size * float(B);
+            auto const r = detail::cell_range(grid, lo, hi);
+            bool any = false;
+            for (uint32_t z = r.min.z; z < r.max.z && !any; ++z)
+                for (uint32_t y = r.min.y; y < r.max.y && !any; ++y)
+                    for (uint32_t x = r.min.x; x < r.max.x && !any; ++x) {
+                        auto const c = grid.cell_index({x, y, z});
+                        any = grid.cell_offsets[c + 1] > grid.cell_offsets[c];
+                    }
+            occupied[b] = any;
+        }
+    });
+    std::vector<size_t> blocks;
+    for (size_t b = 0; b < total_blocks; ++b) {
+        if (occupied[b])
+            blocks.push_back(b);
+    }
+    mesh.n_occupied_blocks = blocks.size();
+
+    // sample and polygonize the occupied blocks
+    std::vector<detail::BlockMesh> block_meshes(blocks.size());
+    thread_pool::parallel_for(
+        blocks.size(),
+        [&](size_t begin, size_t end) {
+            std::vector<float> values;
+            for (size_t i = begin; i < end; ++i) {
+                auto const origin = block_origin(blocks[i]);
+                auto const size = glm::min(glm::uvec3(B), n_cubes - origin);
+                auto const n_samples = size + 1u;
+                auto const local = [&](uint32_t x, uint32_t y, uint32_t z) -> size_t {
+                    return (size_t(z) * n_samples.y + y) * n_samples.x + x;
+                };
+
+                values.resize(size_t(n_samples.x) * n_samples.y * n_samples.z);
+                for (uint32_t z = 0; z < n_samples.z; ++z)
+                    for (uint32_t y = 0; y < n_samples.y; ++y)
+                        for (uint32_t x = 0; x < n_samples.x; ++x)
+                            values[local(x, y, z)] = point_density(
+                                grid,
+                                lattice_point(origin.x + x, origin.y + y, origin.z + z)
+                            );
+
+                auto &out = block_meshes[i];
+                for (uint32_t z = 0; z < size.z; ++z)
+                    for (uint32_t y = 0; y < size.y; ++y)
+                        for (uint32_t x = 0; x < size.x; ++x) {
+                            float v[8];
+                            bool any_in = false, any_out = false;
+                            for (int c = 0; c < 8; ++c) {
+                                auto const dx = c & 1, dy = c >> 1 & 1, dz = c >> 2;
+                                v[c] = values[local(x + dx, y + dy, z + dz)];
+                                (v[c] >= cfg.iso_level ? any_in : any_out) = true;
+                            }
+                            if (!any_in || !any_out)
+                                continue;
+                            auto const g = origin + glm::uvec3(x, y, z);
+                            uint64_t corner_keys[8];
+                            glm::fvec3 corners[8];
+                            for (int c = 0; c < 8; ++c) {
+                                auto const p =
+                                    g + glm::uvec3(c & 1, c >> 1 & 1, c >> 2);
+                                corner_keys[c] = lattice_index(p.x, p.y, p.z) * 8;
+                                corners[c] = lattice_point(p.x, p.y, p.z);
+                            }
+                            detail::polygonize_cube(
+                                v, corner_keys, corners, cfg.iso_level, out
+                            );
+                        }
+            }
+        },
+        1
+    );
+
+    // merge the vertices shared between cubes and blocks
+    std::vector<size_t> vertex_offsets(blocks.size() + 1, 0);
+    for (size_t i = 0; i < blocks.size(); ++i)
+        vertex_offsets[i + 1] = vertex_offsets[i] + block_meshes[i].vertices.size();
+    const size_t n_edge_vertices = vertex_offsets.back();
+    std::vector<uint64_t> keys(n_edge_vertices);
+    std::vector<glm::fvec3> positions(n_edge_vertices);
+    thread_pool::parallel_for(blocks.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t k = 0; k < block_meshes[i].vertices.size(); ++k) {
+                keys[vertex_offsets[i] + k] = block_meshes[i].vertices[k].key;
+                positions[vertex_offsets[i] + k] = block_meshes[i].vertices[k].position;
+            }
+        }
+    });
+    auto const perm = morton::sort_permutation(n_edge_vertices, keys.data());
+    std::vector<uint64_t> unique_keys;
+    for (size_t k = 0; k < n_edge_vertices; ++k) {
+        auto const key = keys[perm[k]];
+        if (unique_keys.empty() || unique_keys.back() != key) {
+            unique_keys.push_back(key);
+            mesh.vertices.push_back(positions[perm[k]]);
+        }
+    }
+
+    std::vector<size_t> triangle_offsets(blocks.size() + 1, 0);
+    for (size_t i = 0; i < blocks.size(); ++i)
+        triangle_offsets[i + 1] =
+            triangle_offsets[i] + block_meshes[i].triangles.size();
+    mesh.triangles.resize(triangle_offsets.back());
+    thread_pool::parallel_for(blocks.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t t = 0; t < block_meshes[i].triangles.size(); ++t) {
+                glm::uvec3 tri;
+                for (int k = 0; k < 3; ++k) {
+                    auto const key = block_meshes[i].triangles[t][k];
+                    tri[k] = static_cast<uint32_t>(
+                        std::lower_bound(unique_keys.begin(), unique_keys.end(), key) -
+                        unique_keys.begin()
+                    );
+                }
+                mesh.triangles[triangle_offsets[i] + t] = tri;
+            }
+        }
+    });
+    return mesh;
+}
+
+} // namespace tinyrend::raytracing
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <vector>
+
+#include "tinyrend/core/morton.h"
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/raytracing/grid.h"
+
+namespace tinyrend::raytracing {
+
+/*
+    Point queries against a `GaussianGrid`: summed density and blended
+    features of the Gaussians at arbitrary 3D points.
+
+        density(x) = sum_i opacity_i * exp(-0.5 |W_i (x - mu_i)|²)
+        feature(x) = sum_i w_i f_i / sum_i w_i,  w_i = the i-th density term
+
+    Only the Gaussians listed in the cell containing x are evaluated, and of
+    those only the terms >= grid.alpha_min are summed, which is exactly the
+    set the grid's opacity-aware extents keep. The query points are visited
+    in Morton order, so consecutive points of a worker hit the same cells and
+    Gaussians while they are still in cache; outputs keep the input order.
+*/
+
+/// \brief Density at a single point
+/// \param features Features of the Gaussians [n_primitives, feature_dim] or
+/// nullptr
+/// \param feature Output blended feature [feature_dim] (ignored if `features`
+/// is nullptr), zero where the density is zero
+/// \return Summed density
+inline auto point_density(
+    const GaussianGrid &grid,
+    const glm::fvec3 &point,
+    const float *features = nullptr,
+    const uint32_t feature_dim = 0,
+    float *feature = nullptr
+) -> float {
+    if (features != nullptr) {
+        for (uint32_t k = 0; k < feature_dim; ++k)
+            feature[k] = 0.f;
+    }
+    if (grid.n_cells() == 0)
+        return 0.f;
+    glm::uvec3 cell;
+    for (int k = 0; k < 3; ++k) {
+        auto const f = std::floor((point[k] - grid.bbox_min[k]) / grid.cell_size[k]);
+        if (!(f >= 0.f && f < float(grid.resolution[k])))
+            return 0.f;
+        cell[k] = static_cast<uint32_t>(f);
+    }
+    auto const c = grid.cell_index(cell);
+
+    float density = 0.f;
+    for (uint32_t k = grid.cell_offsets[c]; k < grid.cell_offsets[c + 1]; ++k) {
+        auto const id = grid.cell_primitive_ids[k];
+        auto const x = grid.whitening[id] * (point - grid.means[id]);
+        auto const w = grid.opacities[id] * std::exp(-0.5f * glm::dot(x, x));
+        if (w < grid.alpha_min)
+            continue;
+        density += w;
+        if (features != nullptr) {
+            const float *f = features + size_t(id) * feature_dim;
+            for (uint32_t j = 0; j < feature_dim; ++j)
+                feature[j] += w * f[j];
+        }
+    }
+    if (features != nullptr && density > 0.f) {
+        for (uint32_t j = 0; j < feature_dim; ++j)
+            feature[j] /= density;
+    }
+    return density;
+}
+
+/// \brief Batched `point_density` over the global thread pool, in Morton order.
+/// \param n_points Number of query points
+/// \param points Query points [n_points, 3]
+/// \param densities Output [n_points]
+/// \param features Features of the Gaussians [n_primitives, feature_dim] or
+/// nullptr
+/// \param feature_dim Feature dimension
+/// \param blended_features Output [n_points, feature_dim] (if `features`)
+/// \param morton_bits Bits per axis of the Morton keys of the points
+inline auto query_points(
+    const GaussianGrid &grid,
+    const size_t n_points,
+    const float *points,
+    float *densities,
+    const float *features = nullptr,
+    const uint32_t feature_dim = 0,
+    float *blended_features = nullptr,
+    uint32_t morton_bits = 10
+) -> void {
+    morton_bits = std::clamp<uint32_t>(morton_bits, 1, 21);
+    std::vector<uint64_t> keys(n_points);
+    morton::compute_keys(
+        n_points, points, keys.data(), morton::Curve::MORTON, morton_bits
+    );
+    auto const order = morton::sort_permutation(n_points, keys.data(), 3 * morton_bits);
+    thread_pool::parallel_for(n_points, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const size_t i = order[k];
+            densities[i] = point_density(
+                grid,
+                glm::make_vec3(points + 3 * i),
+                features,
+                feature_dim,
+                features == nullptr ? nullptr : blended_features + i * feature_dim
+            );
+        }
+    });
+}
+
+} // namespace tinyrend::raytracing
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/raytracing/grid.h"
+
+namespace tinyrend::raytracing {
+
+/*
+    Secondary-ray queries against a `GaussianGrid`: how much light gets from
+    o to o + t_max d through the Gaussians.
+
+    Each Gaussian is hit once per ray, at its point of maximum response
+    t* = argmin_t |W (o + t d - mu)|², with alpha = min(max_alpha,
+    opacity * exp(-sigma)) and sigma = |W (o + t* d - mu)|² / 2 (the same
+    particle model as `gaussian::gaussian_max_response_along_ray`). Hits with
+    t* outside [0, t_max] are ignored.
+
+    - Transmittance: T = prod (1 - alpha). The product does not depend on the
+      order, so nothing is sorted: a Gaussian listed in several cells is
+      counted only in the cell that contains its t*. The traversal stops once
+      T < min_transmittance, in which case the returned T is only known to be
+      below the threshold.
+    - Any-hit: true as soon as one Gaussian reaches alpha >= hit_alpha. No
+      product and no de-duplication are needed, and the test compares sigma
+      against log(opacity) - log(hit_alpha) instead of evaluating exp().
+*/
+
+struct RayQueryConfig {
+    /// Transmittance below which a transmittance query stops early.
+    float min_transmittance = 1e-4f;
+    /// Clamp of the per-Gaussian alpha.
+    float max_alpha = 0.99f;
+    /// Alpha at which a Gaussian counts as a hit for `ray_any_hit`.
+    float hit_alpha = 0.5f;
+};
+
+namespace detail {
+
+struct RayHit {
+    float t;     // ray parameter of the maximum response
+    float sigma; // 0.5 * squared Mahalanobis distance there
+};
+
+inline auto ray_hit(
+    const GaussianGrid &grid,
+    uint32_t id,
+    const glm::fvec3 &ray_o,
+    const glm::fvec3 &ray_d
+) -> RayHit {
+    auto const &W = grid.whitening[id];
+    auto const gro = W * (ray_o - grid.means[id]);
+    auto const grd = W * ray_d;
+    auto const grd2 = glm::dot(grd, grd);
+    auto const t = grd2 > 0.f ? -glm::dot(gro, grd) / grd2 : 0.f;
+    auto const x = gro + t * grd;
+    return {t, 0.5f * glm::dot(x, x)};
+}
+
+} // namespace detail
+
+/// \brief Transmittance along the segment o + t d, t in [0, t_max].
+/// \param first_hit_t If not null, receives the smallest t* of the Gaussians
+/// that contributed (alpha >= grid.alpha_min), or +inf if there was none
+/// \return Transmittance in [0, 1]
+inline auto ray_transmittance(
+    const GaussianGrid &grid,
+    const glm::fvec3 &ray_o,
+    const glm::fvec3 &ray_d,
+    const float t_max,
+    const RayQueryConfig &cfg = {},
+    float *first_hit_t = nullptr
+) -> float {
+    float T = 1.f;
+    float t_hit = std::numeric_limits<float>::infinity();
+    auto const visit = [&](size_t cell, float t0, float t1) {
+        auto const first = grid.cell_offsets[cell], last = grid.cell_offsets[cell + 1];
+        for (uint32_t k = first; k < last; ++k) {
+            auto const id = grid.cell_primitive_ids[k];
+            auto const hit = detail::ray_hit(grid, id, ray_o, ray_d);
+            // each Gaussian is counted in the cell that contains its hit only
+            if (!(hit.t >= t0 && hit.t < t1) && !(hit.t == t_max && t1 == t_max))
+                continue;
+            auto const alpha =
+                std::min(cfg.max_alpha, grid.opacities[id] * std::exp(-hit.sigma));
+            if (alpha < grid.alpha_min)
+                continue;
+            T *= 1.f - alpha;
+            t_hit = std::min(t_hit, hit.t);
+        }
+        return T >= cfg.min_transmittance;
+    };
+    for_each_cell(grid, ray_o, ray_d, 0.f, t_max, visit);
+    if (first_hit_t != nullptr)
+        *first_hit_t = t_hit;
+    return T;
+}
+
+/// \brief Whether any Gaussian along o + t d, t in [0, t_max], reaches
+/// alpha >= cfg.hit_alpha.
+inline auto ray_any_hit(
+    const GaussianGrid &grid,
+    const glm::fvec3 &ray_o,
+    const glm::fvec3 &ray_d,
+    const float t_max,
+    const RayQueryConfig &cfg = {}
+) -> bool {
+    bool hit_found = false;
+    auto const log_hit_alpha = std::log(cfg.hit_alpha);
+    auto const log_max_alpha = std::log(cfg.max_alpha);
+    auto const visit = [&](size_t cell, float, float) {
+        auto const first = grid.cell_offsets[cell], last = grid.cell_offsets[cell + 1];
+        for (uint32_t k = first; k < last; ++k) {
+            auto const id = grid.cell_primitive_ids[k];
+            // min(max_alpha, opacity * exp(-sigma)) >= hit_alpha
+            auto const log_opacity = std::min(log_max_alpha, grid.log_opacities[id]);
+            if (log_opacity < log_hit_alpha)
+                continue;
+            auto const hit = detail::ray_hit(grid, id, ray_o, ray_d);
+            if (hit.t >= 0.f && hit.t <= t_max &&
+                hit.sigma <= log_opacity - log_hit_alpha) {
+                hit_found = true;
+                return false;
+            }
+        }
+        return true;
+    };
+    for_each_cell(grid, ray_o, ray_d, 0.f, t_max, visit);
+    return hit_found;
+}
+
+/// \brief Batched `ray_transmittance` over the global thread pool.
+/// \param n_rays Number of rays
+/// \param rays_o Origins [n_rays, 3]
+/// \param rays_d Directions [n_rays, 3] (t is measured in units of |d|)
+/// \param t_max Segment ends [n_rays]
+/// \param transmittances Output [n_rays]
+/// \param first_hit_t Output [n_rays] or nullptr
+inline auto trace_transmittance(
+    const GaussianGrid &grid,
+    const size_t n_rays,
+    const float *rays_o,
+    const float *rays_d,
+    const float *t_max,
+    float *transmittances,
+    float *first_hit_t = nullptr,
+    const RayQueryConfig &cfg = {}
+) -> void {
+    thread_pool::parallel_for(n_rays, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            transmittances[i] = ray_transmittance(
+                grid,
+                glm::make_vec3(rays_o + 3 * i),
+                glm::make_vec3(rays_d + 3 * i),
+                t_max[i],
+                cfg,
+                first_hit_t == nullptr ? nullptr : first_hit_t + i
+            );
+        }
+    });
+}
+
+/// \brief Batched `ray_any_hit` over the global thread pool.
+/// \param hits Output [n_rays]
+/// \see trace_transmittance for the remaining parameters
+inline auto trace_any_hit(
+    const GaussianGrid &grid,
+    const size_t n_rays,
+    const float *rays_o,
+    const float *rays_d,
+    const float *t_max,
+    bool *hits,
+    const RayQueryConfig &cfg = {}
+) -> void {
+    thread_pool::parallel_for(n_rays, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hits[i] = ray_any_hit(
+                grid,
+                glm::make_vec3(rays_o + 3 * i),
+                glm::make_vec3(rays_d + 3 * i),
+                t_max[i],
+                cfg
+            );
+        }
+    });
+}
+
+} // namespace tinyrend::raytracing
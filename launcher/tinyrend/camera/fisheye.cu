@@ -4,13 +4,13 @@
 
 namespace tinyrend::camera::fisheye {
 
-#define FISHEYE_PROJECT_SIGNATURE                                                      \
-    const size_t n_elements, const glm::fvec3 *__restrict__ camera_points,             \
-        const glm::fvec2 *__restrict__ focal_lengths,                                  \
-        const glm::fvec2 *__restrict__ principal_points,                               \
-        glm::fvec2 *__restrict__ image_points
+#define FISHEYE_PROJECT_SIGNATURE(T)                                                   \
+    const size_t n_elements, const glm::vec<3, T> *__restrict__ camera_points,         \
+        const glm::vec<2, T> *__restrict__ focal_lengths,                              \
+        const glm::vec<2, T> *__restrict__ principal_points,                           \
+        glm::vec<2, T> *__restrict__ image_points
 
-template <bool USE_CUDA> void launch_project(FISHEYE_PROJECT_SIGNATURE) {
+template <bool USE_CUDA, typename T> void launch_project(FISHEYE_PROJECT_SIGNATURE(T)) {
     tinyrend::launch_linear_kernel<USE_CUDA>(
         n_elements,
         [camera_points,
@@ -24,7 +24,9 @@ template <bool USE_CUDA> void launch_project(FISHEYE_PROJECT_SIGNATURE) {
     );
 }
 
-template void launch_project<true>(FISHEYE_PROJECT_SIGNATURE);
-template void launch_project<false>(FISHEYE_PROJECT_SIGNATURE);
+template void launch_project<true, float>(FISHEYE_PROJECT_SIGNATURE(float));
+template void launch_project<false, float>(FISHEYE_PROJECT_SIGNATURE(float));
+template void launch_project<true, double>(FISHEYE_PROJECT_SIGNATURE(double));
+template void launch_project<false, double>(FISHEYE_PROJECT_SIGNATURE(double));
 
 } // namespace tinyrend::camera::fisheye
\ No newline at end of file
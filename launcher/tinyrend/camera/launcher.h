@@ -4,13 +4,14 @@
 
 namespace tinyrend::camera::fisheye {
 
-template <bool USE_CUDA>
+// Instantiated for T = float and T = double.
+template <bool USE_CUDA, typename T = float>
 void launch_project(
     const size_t n_elements,
-    const glm::fvec3 *__restrict__ camera_points,
-    const glm::fvec2 *__restrict__ focal_lengths,
-    const glm::fvec2 *__restrict__ principal_points,
-    glm::fvec2 *__restrict__ image_points
+    const glm::vec<3, T> *__restrict__ camera_points,
+    const glm::vec<2, T> *__restrict__ focal_lengths,
+    const glm::vec<2, T> *__restrict__ principal_points,
+    glm::vec<2, T> *__restrict__ image_points
 );
 
 } // namespace tinyrend::camera::fisheye
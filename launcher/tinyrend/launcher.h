@@ -1,4 +1,5 @@
 #pragma once
 
 #include "tinyrend/camera/launcher.h"
+#include "tinyrend/projection/launcher.h"
 #include "tinyrend/rasterization/launcher.h"
\ No newline at end of file
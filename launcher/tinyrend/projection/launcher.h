@@ -0,0 +1,33 @@
+#pragma once
+
+#include "tinyrend/impl_batched.cuh"
+
+namespace tinyrend::impl {
+
+// Instantiated in projection/batched.cu
+extern template void launch_projection_forward_batched<true, false>(
+    const CameraGroups &groups, PROJECTION_FORWARD_BATCHED_SIGNATURE
+);
+extern template void launch_projection_forward_batched<true, true>(
+    const CameraGroups &groups, PROJECTION_FORWARD_BATCHED_SIGNATURE
+);
+extern template void launch_projection_forward_batched<false, false>(
+    const CameraGroups &groups, PROJECTION_FORWARD_BATCHED_SIGNATURE
+);
+extern template void launch_projection_forward_batched<false, true>(
+    const CameraGroups &groups, PROJECTION_FORWARD_BATCHED_SIGNATURE
+);
+extern template void launch_projection_forward_adaptive<true>(
+    const CameraGroups &groups,
+    const float ut_error_threshold,
+    bool *__restrict__ use_ut_flags,
+    PROJECTION_FORWARD_BATCHED_SIGNATURE
+);
+extern template void launch_projection_forward_adaptive<false>(
+    const CameraGroups &groups,
+    const float ut_error_threshold,
+    bool *__restrict__ use_ut_flags,
+    PROJECTION_FORWARD_BATCHED_SIGNATURE
+);
+
+} // namespace tinyrend::impl
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cmath>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/attributes.h"
+#include "tinyrend/core/thread_pool.h"
+
+using namespace tinyrend::attributes;
+
+struct Params {
+    std::vector<float> means, quats, scales, opacities;
+
+    explicit Params(size_t n)
+        : means(3 * n), quats(4 * n), scales(3 * n), opacities(n) {
+        uint32_t state = 12345;
+        auto const next = [&]() {
+            state = state * 1664525u + 1013904223u;
+            return float(state >> 8) / float(1 << 24) * 2.f - 1.f;
+        };
+        for (auto &v : means)
+            v = 10.f * next();
+        for (auto &v : quats)
+            v = next();
+        for (auto &v : scales)
+            v = 3.f * next();
+        for (auto &v : opacities)
+            v = 4.f * next();
+    }
+
+    RawGaussians raw() const {
+        return {opacities.size(), means.data(), quats.data(), scales.data(),
+                opacities.data()};
+    }
+};
+
+static bool close(float a, float b, float tol = 1e-5f) {
+    return std::fabs(a - b) <= tol * std::max(1.f, std::fabs(b));
+}
+
+int test_activate() {
+    int fails = 0;
+    // not a multiple of the block size, several blocks per worker
+    const size_t n = 3 * 256 + 37;
+    Params p(n);
+    p.quats[4] = p.quats[5] = p.quats[6] = p.quats[7] = 0.f; // zero quaternion
+    tinyrend::thread_pool::ThreadPool pool(3);
+
+    // Test case 1: SoA columns hold the activated attributes
+    {
+        SoAStorage soa(n);
+        activate_to_soa(p.raw(), soa.view(), pool);
+        auto const &v = soa.view();
+        bool ok = true;
+        for (size_t i = 0; i < n; ++i) {
+            const float *q = &p.quats[4 * i];
+            auto const norm =
+                std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            for (int k = 0; k < 3; ++k) {
+                ok = ok && v.means[k][i] == p.means[3 * i + k];
+                ok = ok && close(v.scales[k][i], std::exp(p.scales[3 * i + k]));
+            }
+            for (int k = 0; k < 4; ++k)
+                ok = ok && close(v.quats[k][i], norm > 0.f ? q[k] / norm : 0.f);
+            ok = ok && close(v.opacities[i], 1.f / (1.f + std::exp(-p.opacities[i])));
+        }
+        if (!ok) {
+            printf("\n=== Testing Activate ===\n");
+            printf("\n[FAIL] Test 1: SoA activation is wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: The AoS variant matches the SoA one
+    {
+        SoAStorage soa(n);
+        activate_to_soa(p.raw(), soa.view(), pool);
+        std::vector<float> quats(4 * n), scales(3 * n), opacities(n);
+        activate(p.raw(), quats.data(), scales.data(), opacities.data(), pool);
+        auto const &v = soa.view();
+        bool ok = true;
+        for (size_t i = 0; i < n; ++i) {
+            for (int k = 0; k < 4; ++k)
+                ok = ok && quats[4 * i + k] == v.quats[k][i];
+            for (int k = 0; k < 3; ++k)
+                ok = ok && scales[3 * i + k] == v.scales[k][i];
+            ok = ok && opacities[i] == v.opacities[i];
+        }
+        if (!ok) {
+            printf("\n=== Testing Activate ===\n");
+            printf("\n[FAIL] Test 2: AoS activation differs from SoA\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_activate_vjp() {
+    int fails = 0;
+    const size_t n = 300;
+    Params p(n);
+    Params g(n); // arbitrary upstream gradients
+    SoAStorage v_soa(n);
+    auto const &v = v_soa.view();
+    for (size_t i = 0; i < n; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            v.means[k][i] = g.means[3 * i + k];
+            v.scales[k][i] = g.scales[3 * i + k];
+        }
+        for (int k = 0; k < 4; ++k)
+            v.quats[k][i] = g.quats[4 * i + k];
+        v.opacities[i] = g.opacities[i];
+    }
+    std::vector<float> v_means(3 * n), v_quats(4 * n), v_scales(3 * n), v_opac(n);
+    activate_to_soa_vjp(
+        p.raw(), v, v_means.data(), v_quats.data(), v_scales.data(), v_opac.data()
+    );
+
+    // loss = sum <v, activate(raw)>
+    auto const loss = [&](const Params &x) {
+        SoAStorage soa(n);
+        activate_to_soa(x.raw(), soa.view());
+        double l = 0.0;
+        auto const &a = soa.view();
+        for (size_t i = 0; i < n; ++i) {
+            for (int k = 0; k < 3; ++k)
+                l += double(v.means[k][i]) * a.means[k][i] +
+                     double(v.scales[k][i]) * a.scales[k][i];
+            for (int k = 0; k < 4; ++k)
+                l += double(v.quats[k][i]) * a.quats[k][i];
+            l += double(v.opacities[i]) * a.opacities[i];
+        }
+        return l;
+    };
+
+    // Test case 1: Gradients match central finite differences
+    {
+        const float eps = 1e-2f;
+        bool ok = true;
+        auto const check = [&](std::vector<float> Params::*field,
+                               const std::vector<float> &grad) {
+            for (size_t i = 0; i < grad.size(); i += 7) {
+                Params plus = p, minus = p;
+                (plus.*field)[i] += eps;
+                (minus.*field)[i] -= eps;
+                auto const fd = float((loss(plus) - loss(minus)) / (2.0 * eps));
+                if (std::fabs(fd - grad[i]) > 2e-2f * std::max(1.f, std::fabs(fd)))
+                    ok = false;
+            }
+        };
+        check(&Params::means, v_means);
+        check(&Params::quats, v_quats);
+        check(&Params::scales, v_scales);
+        check(&Params::opacities, v_opac);
+        if (!ok) {
+            printf("\n=== Testing Activate VJP ===\n");
+            printf("\n[FAIL] Test 1: Gradients differ from finite differences\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_activate();
+    fails += test_activate_vjp();
+
+    if (fails > 0) {
+        printf("[attributes.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[attributes.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
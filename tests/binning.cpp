@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/rasterization/binning.h"
+
+using namespace tinyrend::rasterization;
+
+struct Projected {
+    std::vector<float> means2d, radii, depths;
+    std::vector<uint32_t> image_ids;
+};
+
+Projected make_projected(size_t n, const BinningConfig &cfg, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> ux(-20.f, cfg.image_width + 20.f);
+    std::uniform_real_distribution<float> uy(-20.f, cfg.image_height + 20.f);
+    std::uniform_real_distribution<float> ur(0.f, 40.f);
+    std::uniform_real_distribution<float> ud(0.1f, 10.f);
+    Projected p;
+    for (size_t i = 0; i < n; ++i) {
+        p.means2d.insert(p.means2d.end(), {ux(rng), uy(rng)});
+        // every 10th primitive is culled
+        const float r = (i % 10 == 0) ? 0.f : ur(rng);
+        p.radii.insert(p.radii.end(), {r, 0.5f * r + 1.f});
+        p.depths.push_back(ud(rng));
+        p.image_ids.push_back(static_cast<uint32_t>(i % cfg.n_images));
+    }
+    return p;
+}
+
+// Brute force reference: per tile, collect overlapping primitives by depth.
+BinningResult reference(const Projected &p, const BinningConfig &cfg) {
+    const uint32_t ntx = (cfg.image_width + cfg.tile_width - 1) / cfg.tile_width;
+    const uint32_t nty = (cfg.image_height + cfg.tile_height - 1) / cfg.tile_height;
+    BinningResult r;
+    for (uint32_t img = 0; img < cfg.n_images; ++img) {
+        for (uint32_t ty = 0; ty < nty; ++ty) {
+            for (uint32_t tx = 0; tx < ntx; ++tx) {
+                std::vector<std::pair<float, uint32_t>> hits;
+                for (size_t i = 0; i < p.depths.size(); ++i) {
+                    const float rx = p.radii[2 * i], ry = p.radii[2 * i + 1];
+                    if (p.image_ids[i] != img || !(rx > 0.f))
+                        continue;
+                    const float x0 = std::floor((p.means2d[2 * i] - rx) / cfg.tile_width);
+                    const float x1 = std::ceil((p.means2d[2 * i] + rx) / cfg.tile_width);
+                    const float y0 = std::floor((p.means2d[2 * i + 1] - ry) / cfg.tile_height);
+                    const float y1 = std::ceil((p.means2d[2 * i + 1] + ry) / cfg.tile_height);
+                    if (tx >= x0 && tx < x1 && ty >= y0 && ty < y1)
+                        hits.push_back({p.depths[i], uint32_t(i)});
+                }
+                std::sort(hits.begin(), hits.end());
+                for (auto &h : hits)
+                    r.isect_primitive_ids.push_back(h.second);
+                r.isect_prefix_sum_per_tile.push_back(r.isect_primitive_ids.size());
+            }
+        }
+    }
+    r.n_isects = r.isect_primitive_ids.size();
+    return r;
+}
+
+int check(const BinningResult &out, const BinningResult &ref, const char *name) {
+    if (out.n_isects != ref.n_isects ||
+        out.isect_primitive_ids != ref.isect_primitive_ids ||
+        out.isect_prefix_sum_per_tile != ref.isect_prefix_sum_per_tile) {
+        printf("\n[FAIL] %s: %zu isects, expected %zu\n", name, out.n_isects, ref.n_isects);
+        return 1;
+    }
+    return 0;
+}
+
+int test_bin_primitives() {
+    int fails = 0;
+
+    BinningConfig cfg;
+    cfg.n_images = 2;
+    cfg.image_width = 130;
+    cfg.image_height = 70;
+    cfg.tile_width = 16;
+    cfg.tile_height = 8;
+    auto const p = make_projected(3000, cfg, 0);
+    auto const ref = reference(p, cfg);
+    auto bin = [&](const BinningConfig &c) {
+        return bin_primitives(
+            p.depths.size(),
+            p.means2d.data(),
+            p.radii.data(),
+            p.depths.data(),
+            p.image_ids.data(),
+            c
+        );
+    };
+
+    // Test case 1: Two-pass mode matches the reference
+    {
+        auto c = cfg;
+        c.mode = BinningMode::TWO_PASS;
+        fails += check(bin(c), ref, "Test 1: Two-pass");
+    }
+
+    // Test case 2: Single pass with a good prediction needs no retry
+    {
+        auto c = cfg;
+        c.mode = BinningMode::SINGLE_PASS;
+        c.predicted_n_isects = ref.n_isects;
+        c.chunk_size = 64;
+        auto const out = bin(c);
+        fails += check(out, ref, "Test 2: Single-pass");
+        if (out.n_passes != 1) {
+            printf("\n[FAIL] Test 2: %zu passes, expected 1\n", out.n_passes);
+            fails += 1;
+        }
+    }
+
+    // Test case 3: Single pass with a too small prediction retries once
+    {
+        auto c = cfg;
+        c.mode = BinningMode::SINGLE_PASS;
+        c.predicted_n_isects = 10;
+        c.slack = 1.0f;
+        c.chunk_size = 16;
+        auto const out = bin(c);
+        fails += check(out, ref, "Test 3: Overflow retry");
+        if (out.n_passes != 2) {
+            printf("\n[FAIL] Test 3: %zu passes, expected 2\n", out.n_passes);
+            fails += 1;
+        }
+    }
+
+    // Test case 4: Single pass with the radii-based estimate
+    {
+        auto c = cfg;
+        c.mode = BinningMode::SINGLE_PASS;
+        fails += check(bin(c), ref, "Test 4: Estimated capacity");
+    }
+
+    // Test case 5: Without the depth sort each tile holds the same primitives
+    for (auto const mode : {BinningMode::TWO_PASS, BinningMode::SINGLE_PASS}) {
+        auto c = cfg;
+        c.mode = mode;
+        c.sort_by_depth = false;
+        auto out = bin(c);
+        if (out.isect_prefix_sum_per_tile != ref.isect_prefix_sum_per_tile) {
+            printf("\n[FAIL] Test 5: Tile offsets differ from the reference\n");
+            fails += 1;
+            continue;
+        }
+        for (size_t t = 0; t < ref.isect_prefix_sum_per_tile.size(); ++t) {
+            const uint32_t start = t == 0 ? 0 : ref.isect_prefix_sum_per_tile[t - 1];
+            const uint32_t end = ref.isect_prefix_sum_per_tile[t];
+            auto first = out.isect_primitive_ids.begin();
+            std::sort(first + start, first + end);
+            auto expected = std::vector<uint32_t>(
+                ref.isect_primitive_ids.begin() + start,
+                ref.isect_primitive_ids.begin() + end
+            );
+            std::sort(expected.begin(), expected.end());
+            if (!std::equal(expected.begin(), expected.end(), first + start)) {
+                printf("\n[FAIL] Test 5: Tile %zu holds other primitives\n", t);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    return fails;
+}
+
+int test_bin_primitives_multithreaded() {
+    int fails = 0;
+
+    BinningConfig cfg;
+    cfg.n_images = 2;
+    cfg.image_width = 130;
+    cfg.image_height = 70;
+    cfg.tile_width = 16;
+    cfg.tile_height = 8;
+    auto const p = make_projected(3000, cfg, 1);
+    auto const ref = reference(p, cfg);
+
+    // 100 primitives inside a single tile each: far fewer intersections than
+    // one chunk per worker
+    BinningConfig small_cfg = cfg;
+    small_cfg.n_images = 1;
+    Projected small;
+    for (uint32_t i = 0; i < 100; ++i) {
+        small.means2d.insert(small.means2d.end(), {8.f + 16.f * (i % 8), 4.f});
+        small.radii.insert(small.radii.end(), {1.f, 1.f});
+        small.depths.push_back(float(i));
+        small.image_ids.push_back(0);
+    }
+    auto const small_ref = reference(small, small_cfg);
+
+    for (size_t n_workers : {8, 32}) {
+        tinyrend::thread_pool::ThreadPool pool(n_workers);
+        auto bin = [&](const Projected &q, const BinningConfig &c) {
+            return bin_primitives(
+                q.depths.size(),
+                q.means2d.data(),
+                q.radii.data(),
+                q.depths.data(),
+                q.image_ids.data(),
+                c,
+                pool
+            );
+        };
+
+        // Test case 1: An exact prediction needs a single pass
+        {
+            auto c = cfg;
+            c.predicted_n_isects = ref.n_isects;
+            c.slack = 1.0f;
+            c.chunk_size = 64;
+            auto const out = bin(p, c);
+            fails += check(out, ref, "Test 1: Exact prediction");
+            if (out.n_passes != 1) {
+                printf("\n=== Testing bin_primitives (%zu workers) ===\n", n_workers);
+                printf("\n[FAIL] Test 1: %zu passes, expected 1\n", out.n_passes);
+                fails += 1;
+            }
+        }
+
+        // Test case 2: An overflowing pass is retried exactly once
+        for (uint32_t chunk_size : {1u, 16u, 1024u}) {
+            auto c = cfg;
+            c.predicted_n_isects = 1;
+            c.slack = 1.0f;
+            c.chunk_size = chunk_size;
+            auto const out = bin(p, c);
+            fails += check(out, ref, "Test 2: Overflow retry");
+            if (out.n_passes > 2) {
+                printf("\n=== Testing bin_primitives (%zu workers) ===\n", n_workers);
+                printf("\n[FAIL] Test 2: %zu passes, expected <= 2\n", out.n_passes);
+                fails += 1;
+            }
+        }
+
+        // Test case 3: Few intersections with large chunks
+        {
+            auto c = small_cfg;
+            c.predicted_n_isects = 1;
+            c.slack = 1.0f;
+            fails += check(bin(small, c), small_ref, "Test 3: Single-tile primitives");
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_bin_primitives();
+    fails += test_bin_primitives_multithreaded();
+
+    if (fails > 0) {
+        printf("[binning.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[binning.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/camera/batched.h"
+#include "tinyrend/camera/fisheye.h"
+#include "tinyrend/camera/pinhole.h"
+#include "tinyrend/core/thread_pool.h"
+
+using namespace tinyrend::camera;
+
+// Camera points in front of the camera, some of them on the optical axis.
+template <typename T> static std::vector<T> camera_points(size_t n) {
+    std::vector<T> points(3 * n);
+    uint32_t state = 2024;
+    auto const next = [&]() {
+        state = state * 1664525u + 1013904223u;
+        return T(state >> 8) / T(1 << 24) * T(2) - T(1);
+    };
+    for (size_t i = 0; i < n; ++i) {
+        auto const on_axis = i % 97 == 0;
+        points[3 * i] = on_axis ? T(0) : next();
+        points[3 * i + 1] = on_axis ? T(0) : next();
+        points[3 * i + 2] = T(1.5) + next();
+    }
+    return points;
+}
+
+template <typename T> static bool close(T a, T b, T rtol) {
+    return std::abs(a - b) <= rtol * std::max(T(1), std::abs(b));
+}
+
+template <typename T> int test_pinhole_project(T rtol) {
+    int fails = 0;
+    // not a multiple of the block size, several blocks per worker
+    const size_t n = 5 * 256 + 11;
+    auto const points = camera_points<T>(n);
+    batched::PinholeIntrinsics<T> intrinsics;
+    intrinsics.focal_length = {T(500), T(480)};
+    intrinsics.principal_point = {T(320), T(240)};
+    // k4 = 1 rejects the points with the largest radii (icD < 0.8)
+    intrinsics.radial_coeffs = {T(0.1), T(-0.05), T(0.01), T(1), T(0), T(0)};
+    intrinsics.tangential_coeffs = {T(0.001), T(-0.002)};
+    intrinsics.thin_prism_coeffs = {T(0.0005), T(0), T(-0.0005), T(0)};
+    tinyrend::thread_pool::ThreadPool pool(3);
+
+    // Test case 1: Matches the per-point model, including rejected points
+    {
+        std::vector<T> image(2 * n, T(-1));
+        std::unique_ptr<bool[]> valid(new bool[n]);
+        batched::pinhole_project(
+            n, points.data(), intrinsics, image.data(), valid.get(), pool
+        );
+        bool ok = true;
+        size_t n_rejected = 0;
+        for (size_t i = 0; i < n; ++i) {
+            auto const &[ip, v] = pinhole::project(
+                glm::vec<3, T>(points[3 * i], points[3 * i + 1], points[3 * i + 2]),
+                glm::vec<2, T>(intrinsics.focal_length[0], intrinsics.focal_length[1]),
+                glm::vec<2, T>(
+                    intrinsics.principal_point[0], intrinsics.principal_point[1]
+                ),
+                intrinsics.radial_coeffs,
+                intrinsics.tangential_coeffs,
+                intrinsics.thin_prism_coeffs
+            );
+            n_rejected += !v;
+            ok = ok && valid[i] == v && close(image[2 * i], ip.x, rtol) &&
+                 close(image[2 * i + 1], ip.y, rtol);
+        }
+        if (!ok || n_rejected == 0 || n_rejected == n) {
+            printf("\n=== Testing batched pinhole_project ===\n");
+            printf("\n[FAIL] Test 1: Differs from pinhole::project\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+template <typename T> int test_fisheye_project(T rtol) {
+    int fails = 0;
+    const size_t n = 3 * 256 + 5;
+    auto const points = camera_points<T>(n);
+    batched::FisheyeIntrinsics<T> intrinsics;
+    intrinsics.focal_length = {T(300), T(310)};
+    intrinsics.principal_point = {T(640), T(360)};
+    intrinsics.radial_coeffs = {T(-0.02), T(0.003), T(-0.0004), T(0.00002)};
+    intrinsics.max_theta = T(0.9);
+    tinyrend::thread_pool::ThreadPool pool(3);
+
+    // Test case 1: Matches the per-point model, including the image center
+    // and the points beyond max_theta
+    {
+        std::vector<T> image(2 * n, T(-1));
+        batched::fisheye_project(
+            n, points.data(), intrinsics, image.data(), nullptr, pool
+        );
+        bool ok = true;
+        for (size_t i = 0; i < n; ++i) {
+            auto const &[ip, v] = fisheye::project(
+                glm::vec<3, T>(points[3 * i], points[3 * i + 1], points[3 * i + 2]),
+                glm::vec<2, T>(intrinsics.focal_length[0], intrinsics.focal_length[1]),
+                glm::vec<2, T>(
+                    intrinsics.principal_point[0], intrinsics.principal_point[1]
+                ),
+                intrinsics.radial_coeffs,
+                intrinsics.min_2d_norm,
+                intrinsics.max_theta
+            );
+            ok = ok && close(image[2 * i], ip.x, rtol) &&
+                 close(image[2 * i + 1], ip.y, rtol) &&
+                 (v || (image[2 * i] == T(0) && image[2 * i + 1] == T(0)));
+        }
+        if (!ok) {
+            printf("\n=== Testing batched fisheye_project ===\n");
+            printf("\n[FAIL] Test 1: Differs from fisheye::project\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_double_precision() {
+    int fails = 0;
+
+    // Test case 1: A double round trip through the distorted pinhole model is
+    // exact to well below float resolution
+    {
+        auto const camera_point = glm::dvec3(0.3, -0.2, 1.0);
+        auto const focal_length = glm::dvec2(1000.0, 1000.0);
+        auto const principal_point = glm::dvec2(960.0, 540.0);
+        auto const radial_coeffs = std::array<double, 6>{0.2, -0.1, 0.02, 0, 0, 0};
+        auto const tangential_coeffs = std::array<double, 2>{0.001, -0.001};
+        auto const thin_prism_coeffs = std::array<double, 4>{0, 0, 0, 0};
+        auto const [image_point, valid] = pinhole::project(
+            camera_point,
+            focal_length,
+            principal_point,
+            radial_coeffs,
+            tangential_coeffs,
+            thin_prism_coeffs
+        );
+        auto const [dir, dir_valid] = pinhole::unproject(
+            image_point,
+            focal_length,
+            principal_point,
+            radial_coeffs,
+            tangential_coeffs,
+            thin_prism_coeffs
+        );
+        auto const error = glm::length(dir - glm::normalize(camera_point));
+        if (!valid || !dir_valid || !(error < 1e-12)) {
+            printf("\n=== Testing double precision ===\n");
+            printf("\n[FAIL] Test 1: Pinhole round trip error %g\n", error);
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_pinhole_project<float>(1e-5f);
+    fails += test_pinhole_project<double>(1e-13);
+    fails += test_fisheye_project<float>(1e-5f);
+    fails += test_fisheye_project<double>(1e-13);
+    fails += test_double_precision();
+
+    if (fails > 0) {
+        printf("[camera/batched.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[camera/batched.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
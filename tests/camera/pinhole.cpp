@@ -57,9 +57,59 @@ auto test_project_distorted() -> int {
     return fails;
 }
 
+// Test the analytic VJP of the distorted pinhole Jacobian
+auto test_project_jac_vjp_distorted() -> int {
+    int fails = 0;
+
+    // Test case 1: Matches central differences of <v_J, J(p)>
+    {
+        auto const focal_length = glm::dvec2(300.0, 280.0);
+        auto const radial_coeffs =
+            std::array<double, 6>{0.1, -0.05, 0.01, 0.02, -0.01, 0.005};
+        auto const tangential_coeffs = std::array<double, 2>{0.002, -0.003};
+        auto const thin_prism_coeffs =
+            std::array<double, 4>{0.001, -0.002, 0.003, 0.0005};
+        auto const v_J = glm::dmat3x2(0.3, -1.2, 0.7, 0.4, -0.5, 1.1);
+        auto const inner = [&](const glm::dvec3 &p) {
+            auto const [J, valid] = project_jac(
+                p, focal_length, radial_coeffs, tangential_coeffs, thin_prism_coeffs
+            );
+            double sum = 0.0;
+            for (int c = 0; c < 3; ++c)
+                sum += glm::dot(v_J[c], J[c]);
+            return sum;
+        };
+
+        const glm::dvec3 points[] = {
+            {0.3, -0.2, 2.0}, {-0.8, 0.5, 1.5}, {0.05, 0.6, 4.0}
+        };
+        for (auto const &p : points) {
+            auto const v_p = project_jac_vjp(
+                p,
+                focal_length,
+                radial_coeffs,
+                tangential_coeffs,
+                thin_prism_coeffs,
+                v_J
+            );
+            auto const expected = numerical_gradient(p, inner, 1e-5f);
+            if (!is_close(v_p, expected, 1e-4f, 1e-4f)) {
+                printf("\n=== Testing project_jac_vjp (distorted pinhole) ===\n");
+                printf("\n[FAIL] Test 1:\n");
+                printf("  v_camera_point: %s\n", glm::to_string(v_p).c_str());
+                printf("  Expected: %s\n", glm::to_string(expected).c_str());
+                fails += 1;
+            }
+        }
+    }
+
+    return fails;
+}
+
 auto main() -> int {
     int fails = 0;
     fails += test_project_distorted();
+    fails += test_project_jac_vjp_distorted();
 
     if (fails == 0) {
         printf("\nAll tests passed!\n");
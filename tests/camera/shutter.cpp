@@ -4,6 +4,7 @@
 #include <stdio.h>
 
 #include "../helpers.h"
+#include "tinyrend/camera/pinhole.h"
 #include "tinyrend/camera/shutter.h"
 
 using namespace tinyrend::camera::shutter;
@@ -190,11 +191,90 @@ auto test_point_world_to_image_mat() -> int {
     return fails;
 }
 
+// Test rolling_shutter_jac against finite differences of the fixed point
+auto test_rolling_shutter_jac() -> int {
+    int fails = 0;
+
+    auto const resolution = std::array<uint32_t, 2>{640, 480};
+    auto const focal_length = glm::fvec2(200.f, 200.f);
+    auto const principal_point = glm::fvec2(320.f, 240.f);
+    auto const pose_r_start = glm::fmat3(1.f);
+    auto const pose_t_start = glm::fvec3(0.f);
+    auto const angle = 0.05f; // about the y axis
+    auto const pose_r_end = glm::fmat3(
+        glm::fvec3(std::cos(angle), 0.f, -std::sin(angle)),
+        glm::fvec3(0.f, 1.f, 0.f),
+        glm::fvec3(std::sin(angle), 0.f, std::cos(angle))
+    );
+    auto const pose_t_end = glm::fvec3(0.2f, 0.05f, 0.f);
+
+    for (auto const shutter_type :
+         {Type::ROLLING_TOP_TO_BOTTOM, Type::ROLLING_RIGHT_TO_LEFT}) {
+        auto const time_grad = relative_frame_time_grad(resolution, shutter_type);
+        // Continuous frame time (no row quantization), reversed shutters start
+        // at the far image border
+        auto const reversed = time_grad.x < 0.f || time_grad.y < 0.f;
+        auto const time_origin =
+            reversed ? glm::fvec2(resolution[0], resolution[1]) : glm::fvec2(0.f);
+        auto const solve = [&](const glm::fvec3 &world_point) {
+            auto image_point = principal_point;
+            std::pair<glm::fmat3, glm::fvec3> pose;
+            for (int i = 0; i < 50; ++i) {
+                auto const t = glm::dot(time_grad, image_point - time_origin);
+                pose = tinyrend::se3::interpolate(
+                    t, pose_r_start, pose_t_start, pose_r_end, pose_t_end
+                );
+                image_point = tinyrend::camera::pinhole::project(
+                    pose.first * world_point + pose.second,
+                    focal_length,
+                    principal_point
+                );
+            }
+            return std::make_pair(image_point, pose);
+        };
+
+        auto const world_point = glm::fvec3(0.5f, -0.3f, 3.f);
+        glm::fmat3x2 J_fd;
+        for (int k = 0; k < 3; ++k) {
+            auto dx = glm::fvec3(0.f);
+            dx[k] = 1e-3f;
+            auto const u_plus = solve(world_point + dx).first;
+            auto const u_minus = solve(world_point - dx).first;
+            J_fd[k] = (u_plus - u_minus) / 2e-3f;
+        }
+
+        auto const [pose_r, pose_t] = solve(world_point).second;
+        auto const project_jac = tinyrend::camera::pinhole::project_jac(
+            pose_r * world_point + pose_t, focal_length
+        );
+        auto const velocity = camera_point_velocity(
+            world_point, pose_r, pose_r_start, pose_t_start, pose_r_end, pose_t_end
+        );
+        auto const J = rolling_shutter_jac(project_jac, pose_r, velocity, time_grad);
+
+        if (!is_close(J, J_fd, 1e-2f, 1e-2f)) {
+            printf("\n=== Testing rolling_shutter_jac ===\n");
+            printf("\n[FAIL] Test 1: Jacobian mismatch\n");
+            printf("  Expected: %s\n", glm::to_string(J_fd).c_str());
+            printf("  Got: %s\n", glm::to_string(J).c_str());
+            fails += 1;
+        }
+        // Without the time coupling the Jacobian is noticeably off
+        if (is_close(project_jac * pose_r, J_fd, 1e-2f, 1e-2f)) {
+            printf("\n[FAIL] Test 2: Time coupling has no effect\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
 auto main() -> int {
     int fails = 0;
 
     fails += test_point_world_to_image_quat();
     fails += test_point_world_to_image_mat();
+    fails += test_rolling_shutter_jac();
 
     if (fails > 0) {
         printf("\nTotal number of failures: %d\n", fails);
@@ -0,0 +1,168 @@
+#include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/string_cast.hpp>
+#include <stdio.h>
+
+#include "../helpers.h"
+#include "tinyrend/camera/pinhole.h"
+#include "tinyrend/camera/trajectory.h"
+
+using namespace tinyrend::camera;
+using namespace tinyrend::camera::trajectory;
+
+// Knots of a constant velocity motion: rotation about z, linear translation.
+auto make_linear_trajectory(size_t n_knots, float dt) -> BSplineTrajectory {
+    std::vector<glm::fquat> rotations;
+    std::vector<glm::fvec3> translations;
+    for (size_t k = 0; k < n_knots; ++k) {
+        auto const half = 0.5f * 0.02f * k; // 0.02 rad per knot
+        rotations.push_back(glm::fquat(std::cos(half), 0.f, 0.f, std::sin(half)));
+        translations.push_back(glm::fvec3(0.1f * k, -0.05f * k, 0.f));
+    }
+    return BSplineTrajectory(rotations, translations, 0.f, dt);
+}
+
+auto test_bspline_trajectory() -> int {
+    int fails = 0;
+
+    // Test case 1: Constant velocity motion is reproduced exactly
+    {
+        auto const trajectory = make_linear_trajectory(8, 0.5f);
+        for (float t : {0.5f, 0.8f, 1.7f, 2.5f, 3.0f}) {
+            auto const [rot, transl] = trajectory.evaluate(t);
+            auto const k = t / 0.5f;
+            auto const half = 0.5f * 0.02f * k;
+            auto const expected_rot =
+                glm::mat3_cast(glm::fquat(std::cos(half), 0.f, 0.f, std::sin(half)));
+            auto const expected_transl = glm::fvec3(0.1f * k, -0.05f * k, 0.f);
+            if (!is_close(rot, expected_rot, 1e-5f, 0.f) ||
+                !is_close(transl, expected_transl, 1e-5f, 0.f)) {
+                printf("\n=== Testing BSplineTrajectory ===\n");
+                printf("\n[FAIL] Test 1: Pose at t = %g\n", t);
+                printf("  Got: %s\n", glm::to_string(transl).c_str());
+                printf("  Expected: %s\n", glm::to_string(expected_transl).c_str());
+                fails += 1;
+            }
+        }
+    }
+
+    // Test case 2: Too few knots are rejected
+    {
+        bool thrown = false;
+        try {
+            BSplineTrajectory(
+                {glm::fquat(1.f, 0.f, 0.f, 0.f)}, {glm::fvec3(0.f)}, 0.f, 1.f
+            );
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        if (!thrown) {
+            printf("\n[FAIL] Test 2: Single knot accepted\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+auto test_pose_table() -> int {
+    int fails = 0;
+
+    auto const resolution = std::array<uint32_t, 2>{64, 48};
+    auto const focal_length = glm::fvec2(50.f, 50.f);
+    auto const principal_point = glm::fvec2(32.f, 24.f);
+    auto const project_fn = [&](const glm::fvec3 &p) -> std::pair<glm::fvec2, bool> {
+        if (p.z <= 0.f)
+            return {glm::fvec2{}, false};
+        return {pinhole::project(p, focal_length, principal_point), true};
+    };
+
+    // Frame exposed from knot 2 to knot 3 of a constant velocity trajectory,
+    // where the spline coincides with the two-pose interpolation.
+    auto const trajectory = make_linear_trajectory(6, 1.f);
+    auto const [pose_r_start, pose_t_start] = trajectory.evaluate(2.f);
+    auto const [pose_r_end, pose_t_end] = trajectory.evaluate(3.f);
+    auto const storage = build_pose_table(
+        trajectory, 2.f, 3.f, resolution, shutter::Type::ROLLING_TOP_TO_BOTTOM
+    );
+    auto const poses = storage.view();
+
+    // Test case 1: Table lookup agrees with the two-pose fixed point
+    {
+        if (poses.n_rows != resolution[1]) {
+            printf("\n=== Testing pose table ===\n");
+            printf("\n[FAIL] Test 1: %u rows, expected 48\n", poses.n_rows);
+            fails += 1;
+        }
+        for (auto const world_point :
+             {glm::fvec3(0.2f, 0.3f, 3.f), glm::fvec3(-0.5f, -0.2f, 2.f)}) {
+            auto const ref = shutter::point_world_to_image(
+                project_fn,
+                resolution,
+                world_point,
+                pose_r_start,
+                pose_t_start,
+                pose_r_end,
+                pose_t_end,
+                shutter::Type::ROLLING_TOP_TO_BOTTOM
+            );
+            auto const out =
+                shutter::point_world_to_image(project_fn, world_point, poses);
+            if (!out.valid_flag || !ref.valid_flag ||
+                !is_close(out.image_point, ref.image_point, 1e-3f, 0.f)) {
+                printf("\n[FAIL] Test 1: Image point mismatch\n");
+                printf("  Got: %s\n", glm::to_string(out.image_point).c_str());
+                printf("  Expected: %s\n", glm::to_string(ref.image_point).c_str());
+                fails += 1;
+            }
+        }
+    }
+
+    // Test case 2: A point on a generated ray projects back to its pixel
+    {
+        auto const image_point = glm::fvec2(40.5f, 30.5f);
+        auto const camera_ray_d =
+            pinhole::unproject(image_point, focal_length, principal_point);
+        auto const [ray_o, ray_d] = shutter::image_point_to_world_ray(
+            poses, image_point, glm::fvec3(0.f), camera_ray_d
+        );
+        auto const world_point = ray_o + 4.f * ray_d;
+        auto const out = shutter::point_world_to_image(project_fn, world_point, poses);
+        if (!out.valid_flag || !is_close(out.image_point, image_point, 1e-3f, 0.f)) {
+            printf("\n[FAIL] Test 2: Ray does not project back to its pixel\n");
+            printf("  Got: %s\n", glm::to_string(out.image_point).c_str());
+            fails += 1;
+        }
+    }
+
+    // Test case 3: An empty table is rejected
+    {
+        bool thrown = false;
+        try {
+            PoseTableStorage{}.view();
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        if (!thrown) {
+            printf("\n[FAIL] Test 3: Empty pose table accepted\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+auto main() -> int {
+    int fails = 0;
+
+    fails += test_bspline_trajectory();
+    fails += test_pose_table();
+
+    if (fails > 0) {
+        printf("\nTotal number of failures: %d\n", fails);
+        return 1;
+    }
+
+    printf("[camera/trajectory.cpp] All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/core/half.h"
+
+using namespace tinyrend;
+
+static uint32_t bits_of(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static float float_of(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Floats spread over every exponent, plus the rounding corner cases.
+static std::vector<float> sample_floats() {
+    std::vector<float> v;
+    for (uint64_t u = 0; u <= 0xffffffffull; u += 65537)
+        v.push_back(float_of(uint32_t(u)));
+    for (float f : {0.f, -0.f, 1.f, 65504.f, 65519.99f, 65520.f, 5.9604645e-8f,
+                    2.9802322e-8f, 2.9802326e-8f, 6.1035156e-5f, 1.f + 0x1p-11f,
+                    1.f + 3 * 0x1p-11f, INFINITY, -INFINITY, NAN})
+        v.push_back(f);
+    return v;
+}
+
+int test_f16() {
+    int fails = 0;
+
+    // Test case 1: Every half round-trips through float exactly
+    {
+        bool ok = true;
+        for (uint32_t h = 0; h < 0x10000u && ok; ++h) {
+            f16 x;
+            x.bits = uint16_t(h);
+            const float f = x;
+            const bool nan = (h & 0x7c00u) == 0x7c00u && (h & 0x3ffu) != 0;
+            ok = nan ? std::isnan(f) : f16(f).bits == h;
+        }
+        if (!ok) {
+            printf("\n=== Testing f16 ===\n");
+            printf("\n[FAIL] Test 1: Round trip is not exact\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Rounding to nearest even, overflow and subnormals
+    {
+        const bool ok = f16(1.f + 0x1p-11f).bits == 0x3c00u && // tie to even
+                        f16(1.f + 3 * 0x1p-11f).bits == 0x3c02u &&
+                        f16(65504.f).bits == 0x7bffu &&
+                        f16(65520.f).bits == 0x7c00u && // rounds to inf
+                        f16(-0x1p-24f).bits == 0x8001u && // smallest subnormal
+                        f16(0x1p-25f).bits == 0x0000u &&  // tie to even (zero)
+                        f16(3 * 0x1p-25f).bits == 0x0002u &&
+                        (f16(NAN).bits & 0x7fffu) > 0x7c00u;
+        if (!ok) {
+            printf("\n=== Testing f16 ===\n");
+            printf("\n[FAIL] Test 2: Rounding is wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 3: The bulk converters match the scalar ones
+    {
+        auto const in = sample_floats();
+        const size_t n = in.size();
+        std::vector<f16> h(n);
+        std::vector<float> back(n);
+        precision::from_float(in.data(), h.data(), n);
+        precision::to_float(h.data(), back.data(), n);
+        bool ok = true;
+        for (size_t i = 0; i < n && ok; ++i) {
+            const f16 ref(in[i]);
+            const bool nan = std::isnan(in[i]);
+            ok = nan ? std::isnan(back[i]) : h[i].bits == ref.bits;
+            ok = ok && (nan || bits_of(back[i]) == bits_of(float(ref)));
+        }
+        if (!ok) {
+            printf("\n=== Testing f16 ===\n");
+            printf("\n[FAIL] Test 3: Bulk conversion differs from scalar\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_bf16() {
+    int fails = 0;
+
+    // Test case 1: Rounding to nearest even keeps the fp32 range
+    {
+        const bool ok = bf16(1.f).bits == 0x3f80u &&
+                        bf16(1.f + 0x1p-8f).bits == 0x3f80u && // tie to even
+                        bf16(1.f + 3 * 0x1p-8f).bits == 0x3f82u &&
+                        bf16(3e38f).bits == 0x7f62u && float(bf16(1e-40f)) > 0.f &&
+                        std::isnan(float(bf16(NAN)));
+        if (!ok) {
+            printf("\n=== Testing bf16 ===\n");
+            printf("\n[FAIL] Test 1: Rounding is wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: The bulk converters match the scalar ones
+    {
+        auto const in = sample_floats();
+        const size_t n = in.size();
+        std::vector<bf16> b(n);
+        std::vector<float> back(n);
+        precision::from_float(in.data(), b.data(), n);
+        precision::to_float(b.data(), back.data(), n);
+        bool ok = true;
+        for (size_t i = 0; i < n && ok; ++i) {
+            const bf16 ref(in[i]);
+            if (std::isnan(in[i])) {
+                ok = std::isnan(back[i]);
+                continue;
+            }
+            // AVX-512 BF16 flushes fp32 subnormal inputs to zero
+            const bool subnormal = (bits_of(in[i]) & 0x7f800000u) == 0;
+            ok = subnormal ? float(b[i]) == float(ref) || float(b[i]) == 0.f
+                           : b[i].bits == ref.bits;
+            ok = ok && bits_of(back[i]) == uint32_t(b[i].bits) << 16;
+        }
+        if (!ok) {
+            printf("\n=== Testing bf16 ===\n");
+            printf("\n[FAIL] Test 2: Bulk conversion differs from scalar\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_round_accumulator() {
+    int fails = 0;
+
+    // Test case 1: A gradient summed in fp32 and rounded once matches the
+    // rounded exact sum; summing in 16 bits loses the small contributions
+    {
+        // per-pixel contributions of one primitive: a few large, many small
+        std::vector<float> contributions(20000, 1e-3f);
+        for (size_t i = 0; i < contributions.size(); i += 1000)
+            contributions[i] = 4.f;
+        double exact = 0.0;
+        float acc = 0.f;
+        f16 acc_f16(0.f);
+        bf16 acc_bf16(0.f);
+        for (float c : contributions) {
+            exact += c;
+            acc += c;
+            acc_f16 = f16(float(acc_f16) + c);
+            acc_bf16 = bf16(float(acc_bf16) + c);
+        }
+        f16 out_f16;
+        bf16 out_bf16;
+        precision::round_accumulator<false>(&acc, &out_f16, 1);
+        precision::round_accumulator<false>(&acc, &out_bf16, 1);
+        auto const rel = [&](float v) { return std::fabs(v - exact) / exact; };
+        const bool ok = rel(float(out_f16)) <= 0x1p-11 &&
+                        rel(float(out_bf16)) <= 0x1p-8 && rel(float(acc_f16)) > 0.1 &&
+                        rel(float(acc_bf16)) > 0.1;
+        if (!ok) {
+            printf("\n=== Testing round_accumulator ===\n");
+            printf("\n[FAIL] Test 1: Rounded fp32 accumulation is inaccurate\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Bulk rounding matches the scalar conversion
+    {
+        auto const in = sample_floats();
+        std::vector<bf16> out(in.size());
+        precision::round_accumulator<false>(in.data(), out.data(), in.size());
+        bool ok = true;
+        for (size_t i = 0; i < in.size() && ok; ++i) {
+            if (std::isnan(in[i])) {
+                ok = std::isnan(float(out[i]));
+                continue;
+            }
+            // AVX-512 BF16 flushes fp32 subnormal inputs to zero
+            const bool subnormal = (bits_of(in[i]) & 0x7f800000u) == 0;
+            ok = subnormal ? float(out[i]) == float(bf16(in[i])) || float(out[i]) == 0.f
+                           : out[i].bits == bf16(in[i]).bits;
+        }
+        if (!ok) {
+            printf("\n=== Testing round_accumulator ===\n");
+            printf("\n[FAIL] Test 2: Bulk rounding differs from scalar\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_f16();
+    fails += test_bf16();
+    fails += test_round_accumulator();
+
+    if (fails > 0) {
+        printf("[core/half.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[core/half.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
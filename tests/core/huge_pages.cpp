@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/core/huge_pages.h"
+#include "tinyrend/core/thread_pool.h"
+
+using namespace tinyrend::huge_pages;
+
+static bool aligned(const void *ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+int test_buffer() {
+    int fails = 0;
+
+    // Test case 1: Every mode yields usable, zeroed, suitably aligned memory
+    for (Mode mode : {Mode::OFF, Mode::TRANSPARENT, Mode::EXPLICIT}) {
+        const size_t bytes = 5 * HUGE_PAGE_SIZE + 123;
+        Buffer b = Buffer::allocate(bytes, mode);
+        auto *p = static_cast<uint8_t *>(b.data());
+        bool ok = p != nullptr && b.size() >= bytes;
+        // OFF never reports huge pages; the others may fall back but keep the
+        // 2 MiB alignment unless they ended up on regular pages.
+        ok = ok && (mode != Mode::OFF || b.backing() == Mode::OFF);
+        ok = ok && (b.backing() == Mode::OFF || aligned(p, HUGE_PAGE_SIZE));
+        ok = ok && (mode == Mode::EXPLICIT || b.backing() != Mode::EXPLICIT);
+        for (size_t i = 0; ok && i < bytes; i += 4093)
+            ok = p[i] == 0;
+        for (size_t i = 0; ok && i < bytes; i += 4093)
+            p[i] = uint8_t(i);
+        for (size_t i = 0; ok && i < bytes; i += 4093)
+            ok = p[i] == uint8_t(i);
+        if (!ok) {
+            printf("\n=== Testing Buffer ===\n");
+            printf("\n[FAIL] Test 1: Mode %d (backing %d)\n",
+                   int(mode), int(b.backing()));
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Moves transfer ownership, small and empty buffers
+    {
+        Buffer a = Buffer::allocate(100, Mode::TRANSPARENT);
+        void *p = a.data();
+        Buffer b = std::move(a);
+        Buffer empty = Buffer::allocate(0);
+        if (a.data() != nullptr || b.data() != p || b.size() != SMALL_PAGE_SIZE ||
+            b.backing() != Mode::OFF || empty.data() != nullptr) {
+            printf("\n=== Testing Buffer ===\n");
+            printf("\n[FAIL] Test 2: Move or small allocation is wrong\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_allocators() {
+    int fails = 0;
+
+    // Test case 1: Large vectors are 2 MiB aligned, small ones are not padded
+    {
+        const Allocator<float> alloc(Mode::TRANSPARENT);
+        std::vector<float, Allocator<float>> big(3 * HUGE_PAGE_SIZE / 4, 1.f, alloc);
+        std::vector<float, Allocator<float>> small(10, 2.f);
+        big.back() = 3.f;
+        if (!aligned(big.data(), HUGE_PAGE_SIZE) || big[0] != 1.f ||
+            big.back() != 3.f || small[9] != 2.f) {
+            printf("\n=== Testing Allocator ===\n");
+            printf("\n[FAIL] Test 1: Allocation is wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: first_touch_alloc honours the mode
+    {
+        const size_t n = 2 * HUGE_PAGE_SIZE / sizeof(int) + 1;
+        using namespace tinyrend::thread_pool;
+        int *data = first_touch_alloc<int>(n, 7, Mode::TRANSPARENT);
+        if (!aligned(data, HUGE_PAGE_SIZE) || data[0] != 7 || data[n - 1] != 7) {
+            printf("\n=== Testing Allocator ===\n");
+            printf("\n[FAIL] Test 2: first_touch_alloc is wrong\n");
+            fails += 1;
+        }
+        first_touch_free(data);
+    }
+
+    // Test case 3: Mode names
+    if (parse_mode("thp") != Mode::TRANSPARENT ||
+        parse_mode("hugetlb") != Mode::EXPLICIT || parse_mode("off") != Mode::OFF ||
+        parse_mode(nullptr) != Mode::OFF) {
+        printf("\n=== Testing Allocator ===\n");
+        printf("\n[FAIL] Test 3: parse_mode is wrong\n");
+        fails += 1;
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_buffer();
+    fails += test_allocators();
+
+    if (fails > 0) {
+        printf("[core/huge_pages.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[core/huge_pages.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/core/morton.h"
+
+using namespace tinyrend::morton;
+
+int test_morton_encode() {
+    int fails = 0;
+
+    // Test case 1: Bit interleaving x0 y0 z0 x1 y1 z1 ...
+    {
+        struct Case {
+            uint32_t x, y, z;
+            uint64_t key;
+        };
+        const Case cases[] = {
+            {0, 0, 0, 0}, {1, 0, 0, 1}, {0, 1, 0, 2}, {0, 0, 1, 4}, {3, 0, 0, 9},
+            {1, 1, 1, 7}, {(1u << 21) - 1, 0, 0, 0x1249249249249249ull},
+        };
+        for (const auto &c : cases) {
+            const uint64_t key = morton_encode(c.x, c.y, c.z);
+            if (key != c.key) {
+                printf("\n=== Testing morton_encode ===\n");
+                printf("\n[FAIL] Test 1: (%u, %u, %u) -> %llx, expected %llx\n",
+                       c.x, c.y, c.z, (unsigned long long)key, (unsigned long long)c.key);
+                fails += 1;
+            }
+        }
+    }
+
+    return fails;
+}
+
+int test_hilbert_encode() {
+    int fails = 0;
+
+    // Test case 1: Bijection onto [0, 8^bits) with face-adjacent neighbours
+    {
+        const uint32_t bits = 3, side = 1u << bits;
+        std::vector<int> cell_of(side * side * side, -1);
+        for (uint32_t x = 0; x < side; ++x)
+            for (uint32_t y = 0; y < side; ++y)
+                for (uint32_t z = 0; z < side; ++z) {
+                    const uint64_t key = hilbert_encode(x, y, z, bits);
+                    if (key >= cell_of.size() || cell_of[key] != -1) {
+                        printf("\n=== Testing hilbert_encode ===\n");
+                        printf("\n[FAIL] Test 1: Key %llu invalid or repeated\n",
+                               (unsigned long long)key);
+                        return fails + 1;
+                    }
+                    cell_of[key] = (x * side + y) * side + z;
+                }
+        for (size_t k = 1; k < cell_of.size(); ++k) {
+            const int a = cell_of[k - 1], b = cell_of[k];
+            const int dist = std::abs(a / 64 - b / 64) + std::abs(a / 8 % 8 - b / 8 % 8) +
+                             std::abs(a % 8 - b % 8);
+            if (dist != 1) {
+                printf("\n[FAIL] Test 1: Keys %zu and %zu are %d cells apart\n", k - 1, k, dist);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    return fails;
+}
+
+int test_reorder() {
+    int fails = 0;
+
+    // Test case 1: Buffers are permuted consistently and keys become sorted
+    for (Curve curve : {Curve::MORTON, Curve::HILBERT}) {
+        const size_t n = 20000;
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> u(-5.f, 5.f);
+        std::vector<float> means(3 * n), opacities(n), adam_m(4 * n);
+        for (size_t i = 0; i < n; ++i) {
+            for (int k = 0; k < 3; ++k)
+                means[3 * i + k] = u(rng);
+            opacities[i] = float(i);
+            for (int k = 0; k < 4; ++k)
+                adam_m[4 * i + k] = float(i) + 0.25f * k;
+        }
+        const auto means_before = means;
+
+        auto const perm = reorder(
+            n,
+            means.data(),
+            {{means.data(), 3 * sizeof(float)},
+             {opacities.data(), sizeof(float)},
+             {adam_m.data(), 4 * sizeof(float)}},
+            curve
+        );
+
+        bool ok = perm.size() == n;
+        for (size_t i = 0; ok && i < n; ++i) {
+            const uint32_t j = perm[i];
+            ok = opacities[i] == float(j) && adam_m[4 * i + 3] == float(j) + 0.75f &&
+                 means[3 * i] == means_before[3 * j];
+        }
+        std::vector<uint64_t> keys(n);
+        compute_keys(n, means.data(), keys.data(), curve);
+        ok = ok && std::is_sorted(keys.begin(), keys.end());
+        auto const inv = invert_permutation(n, perm.data());
+        for (size_t i = 0; ok && i < n; ++i)
+            ok = perm[inv[i]] == i;
+        if (!ok) {
+            printf("\n=== Testing reorder ===\n");
+            printf("\n[FAIL] Test 1: Reorder mismatch (curve %d)\n", int(curve));
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_morton_encode();
+    fails += test_hilbert_encode();
+    fails += test_reorder();
+
+    if (fails > 0) {
+        printf("[core/morton.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[core/morton.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -0,0 +1,168 @@
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "tinyrend/core/scheduler.h"
+#include "tinyrend/core/thread_pool.h"
+
+using namespace tinyrend::scheduler;
+using tinyrend::thread_pool::ThreadPool;
+
+int test_all_tiles_run() {
+    int fails = 0;
+
+    // Test case 1: Concurrent frames from several contexts all complete
+    {
+        ThreadPool pool(4, false);
+        Scheduler sched(3, pool);
+        auto a = sched.create_context(Priority::INTERACTIVE);
+        auto b = sched.create_context(Priority::BATCH, 2.0f);
+        const size_t n = 1000;
+        std::vector<std::atomic<int>> hits_a(n), hits_b(n);
+        std::vector<std::shared_ptr<Frame>> frames;
+        for (int i = 0; i < 4; ++i) {
+            frames.push_back(sched.submit(a, n / 4, [&, i](size_t t) {
+                hits_a[i * (n / 4) + t] += 1;
+            }));
+            frames.push_back(sched.submit(b, n / 4, [&, i](size_t t) {
+                hits_b[i * (n / 4) + t] += 1;
+            }));
+        }
+        for (auto &f : frames)
+            f->wait();
+        for (size_t i = 0; i < n; ++i) {
+            if (hits_a[i] != 1 || hits_b[i] != 1) {
+                printf("\n=== Testing Scheduler ===\n");
+                printf("\n[FAIL] Test 1: Tile %zu ran %d / %d times\n", i,
+                       hits_a[i].load(), hits_b[i].load());
+                fails += 1;
+                break;
+            }
+        }
+        if (sched.stats(a).n_frames != 4 || sched.stats(b).n_frames != 4) {
+            printf("\n[FAIL] Test 1: Frame counts %zu / %zu\n",
+                   sched.stats(a).n_frames, sched.stats(b).n_frames);
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Tiles share the pool with parallel loops issued from them
+    // and from outside
+    {
+        ThreadPool pool(4, false);
+        Scheduler sched(2, pool);
+        auto ctx = sched.create_context(Priority::BATCH);
+        const size_t n_tiles = 16, n = 1000;
+        std::vector<std::atomic<size_t>> sums(n_tiles);
+        auto frame = sched.submit(ctx, n_tiles, [&](size_t t) {
+            pool.parallel_for(n, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    sums[t] += i;
+            });
+        });
+        std::atomic<size_t> outside{0};
+        pool.parallel_for(n, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                outside += i;
+        });
+        frame->wait();
+        bool ok = outside == n * (n - 1) / 2;
+        for (auto &s : sums)
+            ok = ok && s == n * (n - 1) / 2;
+        if (!ok) {
+            printf("\n=== Testing Scheduler ===\n");
+            printf("\n[FAIL] Test 2: Parallel loops inside tiles are incomplete\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_preemption() {
+    int fails = 0;
+
+    // Test case 1: An interactive frame overtakes a running batch frame
+    {
+        ThreadPool pool(1, false);
+        Scheduler sched(2, pool);
+        auto batch = sched.create_context(Priority::BATCH);
+        auto interactive = sched.create_context(Priority::INTERACTIVE);
+        auto big = sched.submit(batch, 200, [](size_t) {
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto small = sched.submit(interactive, 4, [](size_t) {});
+        small->wait();
+        if (big->done()) {
+            printf("\n=== Testing preemption ===\n");
+            printf("\n[FAIL] Test 1: Interactive frame waited for the batch frame\n");
+            fails += 1;
+        }
+        big->wait();
+        if (sched.stats(interactive).p99_ms >= sched.stats(batch).p99_ms) {
+            printf("\n[FAIL] Test 1: Interactive p99 %f >= batch p99 %f\n",
+                   sched.stats(interactive).p99_ms, sched.stats(batch).p99_ms);
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_weighted_share() {
+    int fails = 0;
+
+    // Test case 1: Weight 3 context gets ~3x the tiles of weight 1 context
+    {
+        ThreadPool pool(1, false);
+        Scheduler sched(1, pool);
+        auto gate_ctx = sched.create_context(Priority::INTERACTIVE);
+        auto light = sched.create_context(Priority::BATCH, 1.0f);
+        auto heavy = sched.create_context(Priority::BATCH, 3.0f);
+
+        // Hold the only worker until both batch frames are queued.
+        std::atomic<bool> open{false};
+        auto gate = sched.submit(gate_ctx, 1, [&](size_t) {
+            while (!open)
+                std::this_thread::yield();
+        });
+        std::atomic<size_t> light_done{0};
+        size_t light_at_heavy_end = 0;
+        auto fl = sched.submit(light, 400, [&](size_t) { light_done += 1; });
+        auto fh = sched.submit(heavy, 400, [&](size_t t) {
+            if (t == 399)
+                light_at_heavy_end = light_done.load();
+        });
+        open = true;
+        gate->wait();
+        fl->wait();
+        fh->wait();
+        if (light_at_heavy_end < 110 || light_at_heavy_end > 160) {
+            printf("\n=== Testing weighted share ===\n");
+            printf("\n[FAIL] Test 1: Light context ran %zu tiles (expected ~133)\n",
+                   light_at_heavy_end);
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_all_tiles_run();
+    fails += test_preemption();
+    fails += test_weighted_share();
+
+    if (fails > 0) {
+        printf("[core/scheduler.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[core/scheduler.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -2,7 +2,9 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <random>
 #include <stdio.h>
+#include <vector>
 
 #include "../helpers.h"
 #include "tinyrend/core/se3.h"
@@ -632,6 +634,159 @@ int test_invtransform_covar() {
     return fails;
 }
 
+int test_nlerp() {
+    int fails = 0;
+
+    // Test case 1: nlerp stays within its error bound of slerp
+    {
+        auto const axis = glm::normalize(glm::fvec3(0.3f, -0.5f, 0.8f));
+        auto const rot1 = glm::normalize(glm::fquat(0.9f, 0.1f, 0.3f, -0.2f));
+        for (float angle : {1e-3f, 0.01f, 0.1f, 0.3f, 0.6f, 1.0f}) {
+            auto const half = 0.5f * angle;
+            auto const delta = glm::fquat(
+                std::cos(half),
+                axis.x * std::sin(half),
+                axis.y * std::sin(half),
+                axis.z * std::sin(half)
+            );
+            // -rot2 is the same rotation, nlerp must take the short path
+            auto const rot2 = -(rot1 * delta);
+            float max_err = 0.f;
+            for (int k = 0; k <= 64; ++k) {
+                auto const ratio = k / 64.f;
+                auto const a = nlerp(ratio, rot1, rot2);
+                auto const b = glm::slerp(rot1, rot2, ratio);
+                // angle of the difference rotation, from its vector part
+                auto const d = glm::conjugate(a) * b;
+                auto const sin_half = glm::length(glm::fvec3(d.x, d.y, d.z));
+                max_err = std::max(max_err, 2.f * std::asin(std::min(sin_half, 1.f)));
+            }
+            if (max_err > nlerp_max_error(angle) + 1e-6f) {
+                printf("\n=== Testing nlerp ===\n");
+                printf("\n[FAIL] Test 1: angle %g error %g > bound %g\n",
+                       angle, max_err, nlerp_max_error(angle));
+                fails += 1;
+            }
+        }
+        // the bound is tight up to one radian
+        if (!(nlerp_max_error(1.f) > 0.00406f)) {
+            printf("\n[FAIL] Test 1: Bound below the measured worst case\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: PoseInterpolator matches interpolate and picks nlerp only
+    // for small angles
+    {
+        auto const rot1 =
+            glm::mat3_cast(glm::normalize(glm::fquat(1.f, 0.1f, 0.f, 0.f)));
+        auto const transl1 = glm::fvec3(0.f, 1.f, 2.f);
+        auto const transl2 = glm::fvec3(1.f, -1.f, 0.f);
+        for (float angle : {0.02f, 0.5f}) {
+            auto const delta = glm::fquat(
+                std::cos(0.5f * angle), 0.f, std::sin(0.5f * angle), 0.f
+            ); // about y
+            auto const rot2 = rot1 * glm::mat3_cast(delta);
+            auto const interp =
+                PoseInterpolator<glm::fmat3>(rot1, transl1, rot2, transl2);
+            if (interp.use_nlerp != (angle < 0.1f)) {
+                printf("\n[FAIL] Test 2: angle %g wrong method\n", angle);
+                fails += 1;
+            }
+            for (float ratio : {0.f, 0.3f, 0.7f, 1.f}) {
+                auto const [rot, transl] = interp(ratio);
+                auto const [ref_rot, ref_transl] =
+                    interpolate(ratio, rot1, transl1, rot2, transl2);
+                if (!is_close(rot, ref_rot, 1e-5f, 0.f) ||
+                    !is_close(transl, ref_transl, 1e-5f, 0.f)) {
+                    printf("\n[FAIL] Test 2: angle %g ratio %g\n", angle, ratio);
+                    fails += 1;
+                }
+            }
+        }
+    }
+
+    return fails;
+}
+
+int test_transform_batch() {
+    int fails = 0;
+
+    const size_t n = 37;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> u(-2.f, 2.f);
+    auto const rot =
+        glm::mat3_cast(glm::normalize(glm::fquat(0.8f, 0.2f, -0.4f, 0.3f)));
+    auto const transl = glm::fvec3(0.5f, -1.f, 2.f);
+
+    // Test case 1: Points, directions and rays match the per-element versions
+    {
+        std::vector<float> points(3 * n), dirs(3 * n), out_o(3 * n), out_d(3 * n);
+        for (auto &v : points)
+            v = u(rng);
+        for (auto &v : dirs)
+            v = u(rng);
+        transform_rays(
+            rot, transl, n, points.data(), dirs.data(), out_o.data(), out_d.data()
+        );
+        for (size_t i = 0; i < n; ++i) {
+            auto const p = glm::fvec3(points[i], points[n + i], points[2 * n + i]);
+            auto const d = glm::fvec3(dirs[i], dirs[n + i], dirs[2 * n + i]);
+            auto const [o_ref, d_ref] = transform_ray(rot, transl, p, d);
+            auto const o = glm::fvec3(out_o[i], out_o[n + i], out_o[2 * n + i]);
+            auto const d_out = glm::fvec3(out_d[i], out_d[n + i], out_d[2 * n + i]);
+            if (!is_close(o, o_ref, 1e-5f, 1e-5f) ||
+                !is_close(d_out, d_ref, 1e-5f, 1e-5f)) {
+                printf("\n=== Testing batched transforms ===\n");
+                printf("\n[FAIL] Test 1: Ray %zu mismatch\n", i);
+                fails += 1;
+                break;
+            }
+        }
+        // in place
+        transform_points(rot, transl, n, points.data(), points.data());
+        if (points != out_o) {
+            printf("\n[FAIL] Test 1: In-place transform differs\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Covariances match the per-element version
+    {
+        std::vector<float> covars(6 * n), out(6 * n);
+        std::vector<glm::fmat3> full(n);
+        for (size_t i = 0; i < n; ++i) {
+            glm::fmat3 a;
+            for (int c = 0; c < 3; ++c)
+                a[c] = glm::fvec3(u(rng), u(rng), u(rng));
+            full[i] = a * glm::transpose(a);
+            const float upper[6] = {
+                full[i][0][0], full[i][1][0], full[i][2][0],
+                full[i][1][1], full[i][2][1], full[i][2][2]
+            };
+            for (int k = 0; k < 6; ++k)
+                covars[k * n + i] = upper[k];
+        }
+        transform_covars(rot, n, covars.data(), out.data());
+        for (size_t i = 0; i < n; ++i) {
+            auto const ref = transform_covar(rot, full[i]);
+            const float upper[6] = {
+                ref[0][0], ref[1][0], ref[2][0], ref[1][1], ref[2][1], ref[2][2]
+            };
+            bool ok = true;
+            for (int k = 0; k < 6; ++k)
+                ok &= is_close(out[k * n + i], upper[k], 1e-4f, 1e-4f);
+            if (!ok) {
+                printf("\n[FAIL] Test 2: Covariance %zu mismatch\n", i);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    return fails;
+}
+
 int main() {
     int fails = 0;
 
@@ -644,6 +799,8 @@ int main() {
     fails += test_invtransform_ray();
     fails += test_transform_covar();
     fails += test_invtransform_covar();
+    fails += test_nlerp();
+    fails += test_transform_batch();
 
     if (fails > 0) {
         printf("[core/se3.cpp] %d tests failed!\n", fails);
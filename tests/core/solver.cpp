@@ -199,6 +199,21 @@ int test_polyN_minimal_positive_newton() {
         }
     }
 
+    // Test case 3: Double precision (float literals bind to the double model)
+    {
+        auto const poly = std::array<double, 5>{
+            2.0, 0.0, -3.0, 0.0, 1.0
+        }; // (x^2 - 1)(x^2 - 2) = 0, roots 1 and sqrt(2)
+        auto const root = polyN_minimal_positive_newton<20>(poly, 0.0f, 1.3f, -1.0f);
+        if (std::abs(root - std::sqrt(2.0)) > 1e-14) {
+            printf("\n=== Testing polyN_minimal_positive_newton ===\n");
+            printf("\n[FAIL] Test 3: Double precision\n");
+            printf("  Root: %.17g\n", root);
+            printf("  Expected: %.17g\n", std::sqrt(2.0));
+            fails += 1;
+        }
+    }
+
     return fails;
 }
 
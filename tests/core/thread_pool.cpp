@@ -0,0 +1,145 @@
+#include <atomic>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/core/numa.h"
+#include "tinyrend/core/thread_pool.h"
+
+using namespace tinyrend::thread_pool;
+
+int test_parse_cpulist() {
+    int fails = 0;
+
+    auto const cpus = tinyrend::numa::parse_cpulist("0-3,8,10-11");
+    std::vector<int> const expected = {0, 1, 2, 3, 8, 10, 11};
+    if (cpus != expected) {
+        printf("\n=== Testing parse_cpulist ===\n");
+        printf("\n[FAIL] Test 1: Ranges and singletons\n");
+        printf("  Output size: %zu, expected size: %zu\n", cpus.size(), expected.size());
+        fails += 1;
+    }
+
+    return fails;
+}
+
+int test_parallel_for() {
+    int fails = 0;
+
+    // Test case 1: Every element visited exactly once, with and without stealing
+    for (size_t grain : {size_t(0), size_t(1), size_t(7), size_t(1000)}) {
+        ThreadPool pool(4, false);
+        const size_t n = 10007;
+        std::vector<std::atomic<int>> hits(n);
+        pool.parallel_for(
+            n,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    hits[i].fetch_add(1);
+            },
+            grain
+        );
+        for (size_t i = 0; i < n; ++i) {
+            if (hits[i].load() != 1) {
+                printf("\n=== Testing parallel_for ===\n");
+                printf("\n[FAIL] Test 1: Element %zu hit %d times (grain %zu)\n",
+                       i, hits[i].load(), grain);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    // Test case 2: Static partition covers [0, n) contiguously
+    {
+        ThreadPool pool(3, false);
+        size_t expected_begin = 0;
+        for (size_t w = 0; w < pool.size(); ++w) {
+            const auto [begin, end] = pool.partition(10, w);
+            if (begin != expected_begin || end < begin) {
+                printf("\n[FAIL] Test 2: Partition of worker %zu is [%zu, %zu)\n",
+                       w, begin, end);
+                fails += 1;
+            }
+            expected_begin = end;
+        }
+        if (expected_begin != 10) {
+            printf("\n[FAIL] Test 2: Partition ends at %zu\n", expected_begin);
+            fails += 1;
+        }
+    }
+
+    // Test case 3: Nested parallel_for runs inline instead of deadlocking
+    {
+        std::atomic<size_t> total{0};
+        parallel_for(64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                parallel_for(16, [&](size_t b, size_t e) { total += e - b; });
+            }
+        });
+        if (total.load() != 64 * 16) {
+            printf("\n[FAIL] Test 3: Nested total %zu, expected %d\n", total.load(), 64 * 16);
+            fails += 1;
+        }
+    }
+
+    // Test case 4: Posted tasks run on the workers, interleaved with loops
+    {
+        std::atomic<size_t> on_worker{0}, total{0};
+        {
+            ThreadPool pool(3, false);
+            for (int i = 0; i < 100; ++i) {
+                pool.post([&] {
+                    if (pool.current_worker() >= 0)
+                        on_worker += 1;
+                });
+            }
+            pool.parallel_for(1000, [&](size_t begin, size_t end) {
+                total += end - begin;
+            });
+        } // destruction runs the tasks still queued
+        if (on_worker.load() != 100 || total.load() != 1000) {
+            printf("\n[FAIL] Test 4: %zu posted tasks ran on workers, loop total %zu\n",
+                   on_worker.load(), total.load());
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_first_touch() {
+    int fails = 0;
+
+    // Test case 1: Buffer is fully initialized
+    {
+        const size_t n = 1 << 20;
+        float *data = first_touch_alloc<float>(n, 1.5f);
+        for (size_t i = 0; i < n; ++i) {
+            if (data[i] != 1.5f) {
+                printf("\n=== Testing first_touch_alloc ===\n");
+                printf("\n[FAIL] Test 1: data[%zu] = %f\n", i, data[i]);
+                fails += 1;
+                break;
+            }
+        }
+        first_touch_free(data);
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_parse_cpulist();
+    fails += test_parallel_for();
+    fails += test_first_touch();
+
+    if (fails > 0) {
+        printf("[core/thread_pool.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[core/thread_pool.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -0,0 +1,125 @@
+"""Smoke test of the torch-free CPU module (built with -DBUILD_PYTHON=ON).
+
+Calls the module through the `tinyrend.cpu` wrappers and checks the outputs
+against values produced by the C++ functions for the same inputs. Run it with
+`cmake --build <build> --target test_python`, or directly with the repository's
+`bindings` directory on PYTHONPATH.
+"""
+
+import os
+import sys
+
+import numpy as np
+
+sys.path.insert(
+    0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "bindings")
+)
+
+from tinyrend import cpu  # noqa: E402
+
+PINHOLE, FISHEYE = 0, 1
+
+
+def test_projection_forward():
+    # Two pinhole cameras and a fisheye one, with the second pinhole shifted by
+    # 0.25 along x; the last Gaussian is behind every camera.
+    camera_types = np.array([PINHOLE, FISHEYE, PINHOLE], dtype=np.int32)
+    intrinsics = np.tile(
+        np.array([[100, 0, 32], [0, 100, 24], [0, 0, 1]], dtype=np.float32), (3, 1, 1)
+    )
+    world_to_cameras = np.tile(np.eye(4, dtype=np.float32), (3, 1, 1))
+    world_to_cameras[2, 0, 3] = 0.25
+    means = np.array(
+        [[0, 0, 2], [0.1, -0.05, 3], [-0.2, 0.1, 4], [0, 0, -1]], dtype=np.float32
+    )
+    quats = np.array(
+        [[1, 0, 0, 0], [0.9238795, 0, 0.3826834, 0], [1, 0, 0, 0], [1, 0, 0, 0]],
+        dtype=np.float32,
+    )
+    scales = np.array(
+        [[0.02, 0.03, 0.04], [0.05, 0.01, 0.02], [0.03, 0.03, 0.03], [0.1, 0.1, 0.1]],
+        dtype=np.float32,
+    )
+
+    means2d, depths, covars2d, valid_flags = cpu.projection_forward(
+        camera_types, intrinsics, world_to_cameras, means, quats, scales, 64, 48
+    )
+    assert means2d.shape == (3, 4, 2) and means2d.dtype == np.float32
+    assert depths.shape == (3, 4) and covars2d.shape == (3, 4, 2, 2)
+    assert valid_flags.shape == (3, 4) and valid_flags.dtype == np.bool_
+
+    expected_valid = np.array([[1, 1, 1, 0]] * 3, dtype=bool)
+    expected_means2d = np.array(
+        [
+            [[32, 24], [35.3333321, 22.333334], [27, 26.5], [0, 0]],
+            [[32, 24], [35.3317909, 22.3341045], [27.0051994, 26.4974003], [0, 0]],
+            [[44.5, 24], [43.6666679, 22.333334], [33.25, 26.5], [0, 0]],
+        ]
+    )
+    expected_depths = np.array([[2, 3, 4, 0]] * 3)
+    expected_covars2d = np.array(
+        [
+            [
+                [[1, 0], [0, 2.25]],
+                [[1.69067907, -0.0203395132], [-0.0203395132, 0.111558653]],
+                [[0.563906252, -0.000703124970], [-0.000703124970, 0.562851548]],
+                [[0, 0], [0, 0]],
+            ],
+            [
+                [[1, 0], [0, 2.25]],
+                [[1.68660188, -0.0196362846], [-0.0196362864, 0.111399427]],
+                [[0.560864389, 0.000233280589], [0.000233280589, 0.561214268]],
+                [[0, 0], [0, 0]],
+            ],
+            [
+                [[1.0625, 0], [0, 2.25]],
+                [[1.90526259, -0.0225771684], [-0.0225771666, 0.111558653]],
+                [[0.562587917, 0.000175781228], [0.000175781228, 0.562851548]],
+                [[0, 0], [0, 0]],
+            ],
+        ]
+    )
+    # culled pairs are zero-filled
+    np.testing.assert_array_equal(valid_flags, expected_valid)
+    np.testing.assert_allclose(means2d, expected_means2d, rtol=1e-5)
+    np.testing.assert_allclose(depths, expected_depths, rtol=1e-6)
+    np.testing.assert_allclose(covars2d, expected_covars2d, rtol=1e-4, atol=1e-7)
+
+
+def test_bin_primitives():
+    # 64x48 image, 16x16 tiles (4x3); primitive 3 has a zero radius.
+    means2d = np.array([[8, 8], [30, 20], [60, 40], [5, 5], [40, 10]], dtype=np.float32)
+    radii = np.array([[4, 4], [10, 6], [8, 12], [0, 0], [3, 3]], dtype=np.float32)
+    depths = np.array([3, 1, 2, 0.5, 1.5], dtype=np.float32)
+
+    isect_primitive_ids, isect_prefix_sum_per_tile = cpu.bin_primitives(
+        means2d, radii, depths, image_width=64, image_height=48
+    )
+    assert isect_primitive_ids.dtype == np.uint32
+    assert isect_prefix_sum_per_tile.dtype == np.uint32
+    np.testing.assert_array_equal(isect_primitive_ids, [0, 1, 1, 4, 1, 1, 2, 2])
+    np.testing.assert_array_equal(
+        isect_prefix_sum_per_tile, [1, 2, 4, 4, 4, 5, 6, 7, 7, 7, 7, 8]
+    )
+
+    # image_ids place every primitive in the second image
+    isect_primitive_ids, isect_prefix_sum_per_tile = cpu.bin_primitives(
+        means2d,
+        radii,
+        depths,
+        image_width=64,
+        image_height=48,
+        image_ids=np.ones(5, dtype=np.uint32),
+        n_images=2,
+    )
+    np.testing.assert_array_equal(isect_primitive_ids, [0, 1, 1, 4, 1, 1, 2, 2])
+    np.testing.assert_array_equal(isect_prefix_sum_per_tile[:12], 0)
+    np.testing.assert_array_equal(
+        isect_prefix_sum_per_tile[12:], [1, 2, 4, 4, 4, 5, 6, 7, 7, 7, 7, 8]
+    )
+
+
+if __name__ == "__main__":
+    test_projection_forward()
+    test_bin_primitives()
+    print("[tests/cpu_module.py] All tests passed!")
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/dynamic/temporal.h"
+
+using namespace tinyrend::dynamic;
+
+int test_evaluate_at() {
+    int fails = 0;
+
+    // Test case 1: Active set and per-time parameters match brute force
+    {
+        const size_t n = 5000;
+        const uint32_t D = 2;
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<float> u(-1.f, 1.f), u01(0.f, 1.f);
+        std::uniform_real_distribution<float> tc(0.f, 100.f), ts(0.2f, 2.f);
+        std::vector<float> means, motions, quats, omegas, scales, opacities;
+        std::vector<float> t_centers, t_scales;
+        for (size_t i = 0; i < n; ++i) {
+            means.insert(means.end(), {u(rng), u(rng), u(rng)});
+            for (uint32_t d = 0; d < 3 * D; ++d)
+                motions.push_back(0.1f * u(rng));
+            quats.insert(quats.end(), {u(rng), u(rng), u(rng), u(rng)});
+            omegas.insert(omegas.end(), {u(rng), u(rng), u(rng), u(rng)});
+            scales.insert(scales.end(), {u01(rng), u01(rng), u01(rng)});
+            opacities.push_back(u01(rng));
+            t_centers.push_back(tc(rng));
+            // every 50th Gaussian never fades
+            t_scales.push_back(i % 50 == 0 ? std::numeric_limits<float>::infinity()
+                                           : ts(rng));
+        }
+        DynamicGaussians g;
+        g.n_gaussians = n;
+        g.motion_degree = D;
+        g.means = means.data();
+        g.motions = motions.data();
+        g.quats = quats.data();
+        g.angular_velocities = omegas.data();
+        g.scales = scales.data();
+        g.opacities = opacities.data();
+        g.t_centers = t_centers.data();
+        g.t_scales = t_scales.data();
+        auto const index = build_temporal_index(g);
+
+        DynamicFrame frame;
+        for (float t : {-5.f, 0.f, 12.34f, 50.f, 99.9f, 120.f}) {
+            evaluate_at(index, t, frame);
+            std::vector<uint32_t> expected;
+            for (size_t i = 0; i < n; ++i) {
+                auto const dt = t - t_centers[i];
+                auto const z = std::isinf(t_scales[i]) ? 0.f : dt / t_scales[i];
+                if (opacities[i] * std::exp(-0.5f * z * z) >= index.alpha_min)
+                    expected.push_back(uint32_t(i));
+            }
+            auto ids = frame.ids;
+            std::sort(ids.begin(), ids.end());
+            if (ids != expected) {
+                printf("\n=== Testing evaluate_at ===\n");
+                printf("\n[FAIL] Test 1: t = %f: %zu active, expected %zu\n",
+                       t, ids.size(), expected.size());
+                fails += 1;
+                continue;
+            }
+            // per-frame work follows the active set, not the sequence
+            if (frame.n_candidates > 4 * frame.n_active + 200) {
+                printf("\n=== Testing evaluate_at ===\n");
+                printf("\n[FAIL] Test 1: t = %f: %zu candidates for %zu active\n",
+                       t, frame.n_candidates, frame.n_active);
+                fails += 1;
+            }
+
+            float max_err = 0.f;
+            for (size_t k = 0; k < frame.n_active; ++k) {
+                auto const i = frame.ids[k];
+                auto const dt = t - t_centers[i];
+                for (int a = 0; a < 3; ++a) {
+                    float m = means[3 * i + a], p = dt;
+                    for (uint32_t d = 0; d < D; ++d, p *= dt)
+                        m += motions[(i * D + d) * 3 + a] * p;
+                    max_err = std::max(max_err, std::abs(frame.means[3 * k + a] - m));
+                    max_err = std::max(
+                        max_err, std::abs(frame.scales[3 * k + a] - scales[3 * i + a])
+                    );
+                }
+                float q[4], norm = 0.f;
+                for (int a = 0; a < 4; ++a) {
+                    q[a] = quats[4 * i + a] + omegas[4 * i + a] * dt;
+                    norm += q[a] * q[a];
+                }
+                for (int a = 0; a < 4; ++a) {
+                    auto const err =
+                        std::abs(frame.quats[4 * k + a] - q[a] / std::sqrt(norm));
+                    max_err = std::max(max_err, err);
+                }
+                auto const z = std::isinf(t_scales[i]) ? 0.f : dt / t_scales[i];
+                auto const opacity = opacities[i] * std::exp(-0.5f * z * z);
+                max_err = std::max(max_err, std::abs(frame.opacities[k] - opacity));
+            }
+            if (max_err > 1e-3f) {
+                printf("\n=== Testing evaluate_at ===\n");
+                printf("\n[FAIL] Test 1: t = %f: max error %f\n", t, max_err);
+                fails += 1;
+            }
+        }
+
+        // evaluating again reuses the per-worker scratch buffers
+        evaluate_at(index, 50.f, frame);
+        std::vector<const uint32_t *> buffers;
+        for (auto const &a : frame.scratch)
+            buffers.push_back(a.ids.data());
+        evaluate_at(index, 50.f, frame);
+        for (size_t w = 0; w < buffers.size(); ++w) {
+            if (frame.scratch[w].ids.data() != buffers[w]) {
+                printf("\n=== Testing evaluate_at ===\n");
+                printf("\n[FAIL] Test 1: Worker %zu scratch reallocated\n", w);
+                fails += 1;
+            }
+        }
+    }
+
+    // Test case 2: Static Gaussians only, no motion
+    {
+        std::vector<float> means = {1.f, 2.f, 3.f}, quats = {2.f, 0.f, 0.f, 0.f};
+        std::vector<float> scales = {0.1f, 0.2f, 0.3f}, opacities = {0.5f};
+        std::vector<float> t_centers = {0.f}, t_scales = {0.f};
+        DynamicGaussians g;
+        g.n_gaussians = 1;
+        g.means = means.data();
+        g.quats = quats.data();
+        g.scales = scales.data();
+        g.opacities = opacities.data();
+        g.t_centers = t_centers.data();
+        g.t_scales = t_scales.data();
+        auto const index = build_temporal_index(g);
+        DynamicFrame frame;
+        evaluate_at(index, 1e6f, frame);
+        if (frame.n_active != 1 || frame.means[2] != 3.f || frame.quats[0] != 1.f ||
+            frame.opacities[0] != 0.5f) {
+            printf("\n=== Testing evaluate_at ===\n");
+            printf("\n[FAIL] Test 2: Static Gaussian not evaluated as is\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_evaluate_at();
+
+    if (fails > 0) {
+        printf("[dynamic/temporal.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[dynamic/temporal.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -2,7 +2,9 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <cmath>
 #include <glm/gtx/string_cast.hpp>
+#include <stdexcept>
 #include <stdio.h>
+#include <vector>
 
 #include "../helpers.h"
 #include "tinyrend/estimator/ghq.h"
@@ -160,11 +162,90 @@ int test_ghq_hessian() {
     return fails;
 }
 
+int test_ghq_batched() {
+    int fails = 0;
+
+    // Test case 1: Blocked GEMM matches the naive product on ragged sizes
+    {
+        const int rows = 10, inner = 27, cols = 37;
+        std::vector<float> A(rows * inner), B(inner * cols), C(rows * cols);
+        for (size_t i = 0; i < A.size(); ++i)
+            A[i] = std::sin(0.3f * i);
+        for (size_t i = 0; i < B.size(); ++i)
+            B[i] = std::cos(0.7f * i);
+        gemm_blocked(rows, inner, cols, A.data(), B.data(), C.data());
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                float ref = 0.f;
+                for (int k = 0; k < inner; ++k)
+                    ref += A[i * inner + k] * B[k * cols + j];
+                if (!is_close(C[i * cols + j], ref, 1e-5f, 1e-5f)) {
+                    printf("\n=== Testing GHQ batched ===\n");
+                    printf("\n[FAIL] Test 1: GEMM mismatch at (%d, %d)\n", i, j);
+                    return fails + 1;
+                }
+            }
+        }
+    }
+
+    // Test case 2: Batched estimates match the single-point estimates
+    {
+        const size_t n = 1000;
+        std::vector<glm::vec3> mus(n), std_devs(n);
+        for (size_t i = 0; i < n; ++i) {
+            mus[i] = glm::vec3(std::sin(0.1f * i), std::cos(0.2f * i), 0.001f * i);
+            // the float Hessian estimate carries ~eps * |f| / std_dev^2 of
+            // rounding noise; 0.1 keeps it well below the tolerance
+            std_devs[i] = glm::vec3(1e-1f);
+        }
+        std::vector<glm::mat2x3> J(n);
+        std::vector<std::array<glm::mat3, 2>> H(n);
+        estimate_jacobian_and_hessian_batched<3, 2>(
+            test_function, n, mus.data(), std_devs.data(), J.data(), H.data()
+        );
+        for (size_t i = 0; i < n; ++i) {
+            auto [J_ref, H_ref] =
+                estimate_jacobian_and_hessian<3, 2>(test_function, mus[i], std_devs[i]);
+            if (!is_close(J[i], J_ref, 1e-4f, 1e-4f) ||
+                !is_close(H[i][0], H_ref[0], 1e-3f, 1e-3f) ||
+                !is_close(H[i][1], H_ref[1], 1e-3f, 1e-3f)) {
+                printf("\n=== Testing GHQ batched ===\n");
+                printf("\n[FAIL] Test 2: Point %zu mismatch\n", i);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    // Test case 3: Empty blocks are rejected
+    {
+        glm::vec3 mu(0.f), std_dev(1e-2f);
+        glm::mat2x3 J;
+        std::array<glm::mat3, 2> H;
+        bool thrown = false;
+        try {
+            estimate_jacobian_and_hessian_batched<3, 2>(
+                test_function, 1, &mu, &std_dev, &J, &H, 0
+            );
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        if (!thrown) {
+            printf("\n=== Testing GHQ batched ===\n");
+            printf("\n[FAIL] Test 3: block_points = 0 accepted\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
 int main() {
     int fails = 0;
 
     fails += test_ghq_jacobian();
     fails += test_ghq_hessian();
+    fails += test_ghq_batched();
 
     if (fails > 0) {
         printf("[estimator/ghq.cpp] %d tests failed!\n", fails);
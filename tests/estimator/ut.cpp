@@ -244,12 +244,95 @@ int test_failing_transform() {
     return failures;
 }
 
+int test_transform_vjp() {
+    int failures = 0;
+
+    // f(x) = A x + b + scale * x², with the center image as aux data
+    using Aux = glm::vec3;
+    auto const A = glm::mat3x3(0.5f, 0.2f, -0.1f, 0.3f, 1.0f, 0.4f, -0.2f, 0.1f, 0.8f);
+    auto const b = glm::vec3(0.1f, -0.2f, 0.3f);
+    const float scale = 0.7f;
+    auto f = [&](const glm::vec3 &x) -> std::tuple<glm::vec3, bool, Aux> {
+        auto const y = A * x + b + scale * x * x;
+        return {y, true, y};
+    };
+    auto vjp_f = [&](const glm::vec3 &x, const glm::vec3 &v_y, const Aux &v_aux) {
+        auto const v = v_y + v_aux;
+        return glm::transpose(A) * v + 2.f * scale * x * v;
+    };
+
+    auto const mu = glm::vec3(0.2f, -0.4f, 0.6f);
+    auto const sqrt_covar =
+        glm::mat3x3(0.3f, 0.05f, 0.0f, -0.1f, 0.2f, 0.02f, 0.0f, 0.04f, 0.25f);
+    auto const v_mu = glm::vec3(0.5f, -1.0f, 0.25f);
+    auto const v_covar =
+        glm::mat3x3(1.0f, 0.2f, -0.3f, 0.1f, 0.5f, 0.4f, -0.2f, 0.3f, 2.0f);
+    auto const v_aux = glm::vec3(0.3f, 0.2f, -0.1f);
+
+    auto loss = [&](const glm::vec3 &m, const glm::mat3x3 &L) {
+        auto const r = transform<3, 3, Aux>(f, m, L);
+        float value = glm::dot(v_mu, r.mu) + glm::dot(v_aux, r.aux);
+        for (int i = 0; i < 3; i++) {
+            value += glm::dot(v_covar[i], r.covar[i]);
+        }
+        return value;
+    };
+
+    // Test case 1: Cached VJP matches finite differences
+    UnscentedTransformCache<3, 3> cache;
+    auto const result = transform<3, 3, Aux>(f, mu, sqrt_covar, &cache);
+    auto const grad = transform_vjp<3, 3, Aux>(vjp_f, cache, v_mu, v_covar, v_aux);
+    auto const v_mu_fd = numerical_gradient(
+        mu, [&](const glm::vec3 &x) { return loss(x, sqrt_covar); }, 1e-3f
+    );
+    auto v_sqrt_covar_fd = glm::mat3x3{};
+    for (int i = 0; i < 3; i++) {
+        v_sqrt_covar_fd[i] = numerical_gradient(
+            sqrt_covar[i],
+            [&](const glm::vec3 &x) {
+                auto L = sqrt_covar;
+                L[i] = x;
+                return loss(mu, L);
+            },
+            1e-3f
+        );
+    }
+    if (!result.valid_flag || !is_close(grad.v_mu, v_mu_fd) ||
+        !is_close(grad.v_sqrt_covar, v_sqrt_covar_fd)) {
+        printf("Transform VJP test 1 failed:\n");
+        printf("v_mu: %s vs %s\n",
+               glm::to_string(grad.v_mu).c_str(),
+               glm::to_string(v_mu_fd).c_str());
+        printf("v_sqrt_covar: %s vs %s\n",
+               glm::to_string(grad.v_sqrt_covar).c_str(),
+               glm::to_string(v_sqrt_covar_fd).c_str());
+        failures++;
+    }
+
+    // Test case 2: Recomputing the sigma points gives the cached result. Both
+    // calls run the same code, but FMA contraction may differ between the
+    // two inlined copies, and the alpha = 0.1 weights (w0 = 1 - 1 / alpha^2)
+    // amplify that rounding about a hundredfold.
+    bool valid_flag = false;
+    auto const grad_recompute = transform_vjp<3, 3, Aux>(
+        f, vjp_f, mu, sqrt_covar, v_mu, v_covar, v_aux, valid_flag
+    );
+    if (!valid_flag || !is_close(grad_recompute.v_mu, grad.v_mu, 1e-4f, 1e-4f) ||
+        !is_close(grad_recompute.v_sqrt_covar, grad.v_sqrt_covar, 1e-4f, 1e-4f)) {
+        printf("Transform VJP test 2 failed: recomputed gradients differ\n");
+        failures++;
+    }
+
+    return failures;
+}
+
 int main() {
     int failures = 0;
 
     failures += test_linear_transform();
     failures += test_quadratic_transform();
     failures += test_failing_transform();
+    failures += test_transform_vjp();
 
     if (failures == 0) {
         printf("All tests passed!\n");
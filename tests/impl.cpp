@@ -1,12 +1,16 @@
 #include <glm/glm.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <cmath>
+#include <memory>
+#include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <stdio.h>
+#include <vector>
 
 #include "helpers.h"
 #include "tinyrend/camera/shutter.h"
 #include "tinyrend/impl.h"
+#include "tinyrend/impl_batched.cuh"
 
 using namespace tinyrend::impl;
 using namespace tinyrend::camera::shutter;
@@ -154,9 +158,601 @@ auto test_projection() -> int {
     return fails;
 }
 
+// Test batched projection over cameras of mixed types
+auto test_projection_batched() -> int {
+    int fails = 0;
+
+    const uint32_t width = 640;
+    const uint32_t height = 480;
+    const float near_plane = 0.0f;
+    const float far_plane = 100.0f;
+    const float margin_factor = 0.15f;
+
+    const std::vector<CameraType> camera_types = {
+        CameraType::DISTORTED_PINHOLE,
+        CameraType::PINHOLE,
+        CameraType::FISHEYE,
+        CameraType::PINHOLE,
+        CameraType::DISTORTED_PINHOLE,
+    };
+    const size_t n_cameras = camera_types.size();
+
+    std::vector<float> intrinsics, viewmats, coeffs;
+    for (size_t c = 0; c < n_cameras; ++c) {
+        const float f = 100.0f + 10.0f * c;
+        intrinsics.insert(intrinsics.end(), {f, 0, 320, 0, f, 240, 0, 0, 1});
+        const float tx = 0.05f * c;
+        viewmats.insert(
+            viewmats.end(), {1, 0, 0, tx, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}
+        );
+        const float k = 0.01f * c;
+        coeffs.insert(coeffs.end(), {k, 0, 0, 0, 0, 0, 0.001f, 0, 0, 0, 0, 0});
+    }
+
+    // The last Gaussian is behind every camera.
+    const std::vector<float> means = {1, 1, 3, -0.5f, 0.2f, 2, 0, 0, 5, 0, 0, -1};
+    const std::vector<float> quats = {
+        1, 0, 0, 0, 0.9f, 0.1f, 0, 0, 1, 0, 0.2f, 0, 1, 0, 0, 0
+    };
+    const std::vector<float> scales = {
+        0.1f, 0.1f, 0.1f, 0.2f, 0.1f, 0.05f, 0.1f, 0.3f, 0.1f, 0.1f, 0.1f, 0.1f
+    };
+    const size_t n_gaussians = means.size() / 3;
+
+    auto const groups = group_cameras_by_type(n_cameras, camera_types.data());
+    const std::vector<uint32_t> expected_order = {1, 3, 2, 0, 4};
+    if (groups.order != expected_order) {
+        printf("\n=== Testing batched projection ===\n");
+        printf("\n[FAIL] Test 1: Camera grouping is not stable\n");
+        fails += 1;
+    }
+
+    // Outputs start as garbage; culled pairs must be zero-filled.
+    std::vector<float> means2d(n_cameras * n_gaussians * 2, NAN);
+    std::vector<float> depths(n_cameras * n_gaussians, NAN);
+    std::vector<float> covars2d(n_cameras * n_gaussians * 4, NAN);
+    bool valid_flags[64] = {};
+    launch_projection_forward_batched<false>(
+        groups,
+        groups.order.data(),
+        intrinsics.data(),
+        coeffs.data(),
+        viewmats.data(),
+        nullptr,
+        nullptr,
+        width,
+        height,
+        near_plane,
+        far_plane,
+        margin_factor,
+        n_gaussians,
+        means.data(),
+        quats.data(),
+        scales.data(),
+        means2d.data(),
+        depths.data(),
+        covars2d.data(),
+        valid_flags
+    );
+
+    for (size_t c = 0; c < n_cameras; ++c) {
+        for (size_t g = 0; g < n_gaussians; ++g) {
+            auto project = [&](auto camera_type, auto dist) {
+                return projection_forward<decltype(camera_type)::value>(
+                    intrinsics.data() + 9 * c,
+                    near_plane,
+                    far_plane,
+                    viewmats.data() + 16 * c,
+                    nullptr,
+                    Type::GLOBAL,
+                    width,
+                    height,
+                    means.data() + 3 * g,
+                    quats.data() + 4 * g,
+                    scales.data() + 3 * g,
+                    margin_factor,
+                    dist
+                );
+            };
+            ProjectionForwardResult ref;
+            if (camera_types[c] == CameraType::PINHOLE) {
+                ref = project(
+                    std::integral_constant<CameraType, CameraType::PINHOLE>{},
+                    DistortionParameters<CameraType::PINHOLE>{}
+                );
+            } else if (camera_types[c] == CameraType::FISHEYE) {
+                ref = project(
+                    std::integral_constant<CameraType, CameraType::FISHEYE>{},
+                    DistortionParameters<CameraType::FISHEYE>{}
+                );
+            } else {
+                DistortionParameters<CameraType::DISTORTED_PINHOLE> dist;
+                dist.radial_coeffs = coeffs.data() + 12 * c;
+                dist.tangential_coeffs = coeffs.data() + 12 * c + 6;
+                dist.thin_prism_coeffs = coeffs.data() + 12 * c + 8;
+                ref = project(
+                    std::integral_constant<CameraType, CameraType::DISTORTED_PINHOLE>{},
+                    dist
+                );
+            }
+            const size_t i = c * n_gaussians + g;
+            bool success = ref.valid_flag == valid_flags[i];
+            auto const mean2d = glm::fvec2(means2d[2 * i], means2d[2 * i + 1]);
+            auto const covar2d = glm::make_mat2(covars2d.data() + 4 * i);
+            if (success && ref.valid_flag) {
+                success &= is_close(ref.means2d, mean2d);
+                success &= is_close(ref.depth, depths[i]);
+                success &= is_close(ref.covar2d, covar2d);
+            } else if (success) {
+                success &= mean2d == glm::fvec2(0.f) && depths[i] == 0.f;
+                success &= covar2d == glm::fmat2(0.f);
+            }
+            if (!success) {
+                printf("\n[FAIL] Test 2: Camera %zu, Gaussian %zu mismatch\n", c, g);
+                fails += 1;
+            }
+        }
+    }
+
+    // Test case 3: Pairs are split into one increasing index list per path
+    {
+        const std::vector<uint32_t> order = {2, 0, 1};
+        const size_t n_g = 37;
+        std::unique_ptr<bool[]> flags(new bool[order.size() * n_g]);
+        for (size_t i = 0; i < order.size() * n_g; ++i)
+            flags[i] = (i * 7919) % 5 < 2;
+        // group of the cameras order[1, 3)
+        const size_t n_elements = 2 * n_g;
+        std::vector<size_t> pairs(n_elements), linear, ut;
+        const size_t n_linear = detail::partition_pairs<false>(
+            1, n_elements, order.data(), n_g, flags.get(), pairs.data()
+        );
+        for (size_t idx = 0; idx < n_elements; ++idx) {
+            const bool use_ut = flags[order[1 + idx / n_g] * n_g + idx % n_g];
+            (use_ut ? ut : linear).push_back(idx);
+        }
+        linear.insert(linear.end(), ut.begin(), ut.end());
+        if (n_linear != n_elements - ut.size() || pairs != linear) {
+            printf("\n=== Testing adaptive projection ===\n");
+            printf("\n[FAIL] Test 3: Pair lists differ from a stable partition\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+auto test_projection_adaptive() -> int {
+    int fails = 0;
+
+    const uint32_t width = 640;
+    const uint32_t height = 480;
+    const float near_plane = 0.0f;
+    const float far_plane = 100.0f;
+    const float margin_factor = 0.15f;
+
+    // Camera 0: distorted pinhole, global shutter.
+    // Camera 1: pinhole, rolling shutter moving along x during readout.
+    const std::vector<CameraType> camera_types = {
+        CameraType::DISTORTED_PINHOLE, CameraType::PINHOLE
+    };
+    const std::vector<float> intrinsics = {
+        200, 0, 320, 0, 200, 240, 0, 0, 1, 200, 0, 320, 0, 200, 240, 0, 0, 1
+    };
+    const std::vector<float> viewmats0 = {
+        1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+        1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+    };
+    const std::vector<float> viewmats1 = {
+        1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+        1, 0, 0, 0.3f, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1,
+    };
+    const std::vector<Type> shutter_types = {
+        Type::GLOBAL, Type::ROLLING_TOP_TO_BOTTOM
+    };
+    std::vector<float> coeffs(2 * N_DISTORTION_COEFFS, 0.f);
+    coeffs[0] = 0.1f;  // k1
+    coeffs[6] = 0.01f; // p1
+    const size_t n_cameras = camera_types.size();
+
+    // Gaussian 0 is small and central, Gaussian 1 is large and off-axis.
+    const std::vector<float> means = {0.05f, -0.05f, 5, 0.8f, 0.5f, 1.5f};
+    const std::vector<float> quats = {1, 0, 0, 0, 0.9f, 0.1f, 0.2f, 0};
+    const std::vector<float> scales = {0.01f, 0.01f, 0.02f, 0.3f, 0.2f, 0.25f};
+    const size_t n_gaussians = means.size() / 3;
+
+    auto const groups = group_cameras_by_type(n_cameras, camera_types.data());
+    std::vector<float> means2d(n_cameras * n_gaussians * 2);
+    std::vector<float> depths(n_cameras * n_gaussians);
+    std::vector<float> covars2d(n_cameras * n_gaussians * 4);
+    bool valid_flags[4] = {}, use_ut_flags[4] = {};
+    launch_projection_forward_adaptive<false>(
+        groups,
+        0.5f,
+        use_ut_flags,
+        groups.order.data(),
+        intrinsics.data(),
+        coeffs.data(),
+        viewmats0.data(),
+        viewmats1.data(),
+        shutter_types.data(),
+        width,
+        height,
+        near_plane,
+        far_plane,
+        margin_factor,
+        n_gaussians,
+        means.data(),
+        quats.data(),
+        scales.data(),
+        means2d.data(),
+        depths.data(),
+        covars2d.data(),
+        valid_flags
+    );
+
+    // Test case 1: Only the large Gaussian takes the unscented transform
+    const bool expected_use_ut[4] = {false, true, false, true};
+    for (size_t i = 0; i < 4; ++i) {
+        if (use_ut_flags[i] != expected_use_ut[i]) {
+            printf("\n=== Testing adaptive projection ===\n");
+            printf("\n[FAIL] Test 1: Pair %zu use_ut = %d\n", i, use_ut_flags[i]);
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Outputs match the chosen path
+    for (size_t c = 0; c < n_cameras; ++c) {
+        for (size_t g = 0; g < n_gaussians; ++g) {
+            const size_t i = c * n_gaussians + g;
+            auto project = [&](auto camera_type, auto use_ut, auto dist) {
+                return projection_forward<
+                    decltype(camera_type)::value,
+                    decltype(use_ut)::value>(
+                    intrinsics.data() + 9 * c,
+                    near_plane,
+                    far_plane,
+                    viewmats0.data() + 16 * c,
+                    viewmats1.data() + 16 * c,
+                    shutter_types[c],
+                    width,
+                    height,
+                    means.data() + 3 * g,
+                    quats.data() + 4 * g,
+                    scales.data() + 3 * g,
+                    margin_factor,
+                    dist
+                );
+            };
+            auto project_path = [&](auto camera_type, auto dist) {
+                return use_ut_flags[i]
+                           ? project(camera_type, std::true_type{}, dist)
+                           : project(camera_type, std::false_type{}, dist);
+            };
+            ProjectionForwardResult ref;
+            if (camera_types[c] == CameraType::PINHOLE) {
+                ref = project_path(
+                    std::integral_constant<CameraType, CameraType::PINHOLE>{},
+                    DistortionParameters<CameraType::PINHOLE>{}
+                );
+            } else {
+                DistortionParameters<CameraType::DISTORTED_PINHOLE> dist;
+                dist.radial_coeffs = coeffs.data() + 12 * c;
+                dist.tangential_coeffs = coeffs.data() + 12 * c + 6;
+                dist.thin_prism_coeffs = coeffs.data() + 12 * c + 8;
+                ref = project_path(
+                    std::integral_constant<CameraType, CameraType::DISTORTED_PINHOLE>{},
+                    dist
+                );
+            }
+            bool success = ref.valid_flag && valid_flags[i];
+            if (success) {
+                auto const mean2d = glm::fvec2(means2d[2 * i], means2d[2 * i + 1]);
+                auto const covar2d = glm::make_mat2(covars2d.data() + 4 * i);
+                success &= is_close(ref.means2d, mean2d);
+                success &= is_close(ref.depth, depths[i]);
+                success &= is_close(ref.covar2d, covar2d);
+            }
+            if (!success) {
+                printf("\n[FAIL] Test 2: Camera %zu, Gaussian %zu mismatch\n", c, g);
+                fails += 1;
+            }
+        }
+    }
+
+    return fails;
+}
+
+auto test_projection_backward() -> int {
+    int fails = 0;
+
+    const uint32_t width = 640;
+    const uint32_t height = 480;
+    const float near_plane = 0.0f;
+    const float far_plane = 100.0f;
+    const float margin_factor = 0.15f;
+
+    const float intrinsic[9] = {200, 0, 320, 0, 200, 240, 0, 0, 1};
+    const float c = std::cos(0.1f), s = std::sin(0.1f);
+    const float viewmat[16] = {
+        c, 0, s, 0.1f, 0, 1, 0, -0.2f, -s, 0, c, 0.5f, 0, 0, 0, 1
+    };
+    const float coeffs[12] = {0.05f, -0.01f, 0, 0, 0, 0, 0.001f, -0.002f, 0, 0, 0, 0};
+    const auto mean = glm::fvec3(0.3f, -0.2f, 3.0f);
+    const auto quat = glm::fvec4(0.9f, 0.1f, 0.2f, 0.3f);
+    const auto scale = glm::fvec3(0.2f, 0.1f, 0.3f);
+
+    // loss = <a, means2d> + b * depth + <C, covar2d>
+    const float v_mean2d[2] = {0.3f, -0.7f};
+    const float v_depth[1] = {0.5f};
+    const float v_covar2d[4] = {1e-3f, 2e-3f, -1e-3f, 3e-3f};
+
+    auto check = [&](auto camera_type, auto dist, const char *name) {
+        constexpr CameraType TYPE = decltype(camera_type)::value;
+        auto loss = [&](
+                        const glm::fvec3 &mu,
+                        const glm::fvec4 &q,
+                        const glm::fvec3 &sc,
+                        const float *world_to_camera
+                    ) {
+            auto const r = projection_forward<TYPE>(
+                intrinsic,
+                near_plane,
+                far_plane,
+                world_to_camera,
+                nullptr,
+                Type::GLOBAL,
+                width,
+                height,
+                glm::value_ptr(mu),
+                glm::value_ptr(q),
+                glm::value_ptr(sc),
+                margin_factor,
+                dist
+            );
+            return v_mean2d[0] * r.means2d[0] + v_mean2d[1] * r.means2d[1] +
+                   v_depth[0] * r.depth + v_covar2d[0] * r.covar2d[0][0] +
+                   v_covar2d[1] * r.covar2d[0][1] + v_covar2d[2] * r.covar2d[1][0] +
+                   v_covar2d[3] * r.covar2d[1][1];
+        };
+        auto const result = projection_backward<TYPE>(
+            intrinsic,
+            near_plane,
+            far_plane,
+            viewmat,
+            nullptr,
+            Type::GLOBAL,
+            width,
+            height,
+            glm::value_ptr(mean),
+            glm::value_ptr(quat),
+            glm::value_ptr(scale),
+            v_mean2d,
+            v_depth,
+            v_covar2d,
+            margin_factor,
+            dist
+        );
+
+        const float eps = 1e-3f;
+        auto const v_mean = numerical_gradient(
+            mean,
+            [&](const glm::fvec3 &x) { return loss(x, quat, scale, viewmat); },
+            eps
+        );
+        auto const v_quat = numerical_gradient(
+            quat,
+            [&](const glm::fvec4 &x) { return loss(mean, x, scale, viewmat); },
+            eps
+        );
+        auto const v_scale = numerical_gradient(
+            scale,
+            [&](const glm::fvec3 &x) { return loss(mean, quat, x, viewmat); },
+            eps
+        );
+        auto v_viewmat = glm::fmat4(0.f);
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 4; ++col) {
+                float plus[16], minus[16];
+                std::copy(viewmat, viewmat + 16, plus);
+                std::copy(viewmat, viewmat + 16, minus);
+                plus[row * 4 + col] += eps;
+                minus[row * 4 + col] -= eps;
+                v_viewmat[col][row] = (loss(mean, quat, scale, plus) -
+                                       loss(mean, quat, scale, minus)) /
+                                      (2.f * eps);
+            }
+        }
+
+        bool success = is_close(result.v_mean, v_mean) &&
+                       is_close(result.v_quat, v_quat) &&
+                       is_close(result.v_scale, v_scale) &&
+                       is_close(result.v_world_to_camera0, v_viewmat) &&
+                       is_close(result.v_world_to_camera1, glm::fmat4(0.f));
+        if (!success) {
+            printf("\n=== Testing projection backward ===\n");
+            printf("\n[FAIL] Test 1: Gradients mismatch for %s\n", name);
+            printf("v_mean: %s vs %s\n",
+                   glm::to_string(result.v_mean).c_str(),
+                   glm::to_string(v_mean).c_str());
+            printf("v_quat: %s vs %s\n",
+                   glm::to_string(result.v_quat).c_str(),
+                   glm::to_string(v_quat).c_str());
+            printf("v_scale: %s vs %s\n",
+                   glm::to_string(result.v_scale).c_str(),
+                   glm::to_string(v_scale).c_str());
+            printf("v_viewmat: %s vs %s\n",
+                   glm::to_string(result.v_world_to_camera0).c_str(),
+                   glm::to_string(v_viewmat).c_str());
+            return 1;
+        }
+        return 0;
+    };
+
+    // Test case 1: Finite differences, global shutter
+    fails += check(
+        std::integral_constant<CameraType, CameraType::PINHOLE>{},
+        DistortionParameters<CameraType::PINHOLE>{},
+        "pinhole"
+    );
+    fails += check(
+        std::integral_constant<CameraType, CameraType::FISHEYE>{},
+        DistortionParameters<CameraType::FISHEYE>{},
+        "fisheye"
+    );
+    fails += check(
+        std::integral_constant<CameraType, CameraType::ORTHO>{},
+        DistortionParameters<CameraType::ORTHO>{},
+        "ortho"
+    );
+    fails += check(
+        std::integral_constant<CameraType, CameraType::DISTORTED_PINHOLE>{},
+        DistortionParameters<CameraType::DISTORTED_PINHOLE>{
+            coeffs, coeffs + 6, coeffs + 8
+        },
+        "distorted pinhole"
+    );
+
+    // Test case 2: Batched backward sums the per-pair gradients
+    {
+        const std::vector<CameraType> camera_types = {
+            CameraType::PINHOLE, CameraType::DISTORTED_PINHOLE, CameraType::FISHEYE
+        };
+        const size_t n_cameras = camera_types.size();
+        const size_t n_gaussians = 257;
+        std::vector<float> intrinsics, viewmats, dist_coeffs;
+        for (size_t k = 0; k < n_cameras; ++k) {
+            intrinsics.insert(intrinsics.end(), intrinsic, intrinsic + 9);
+            viewmats.insert(viewmats.end(), viewmat, viewmat + 16);
+            viewmats[k * 16 + 3] += 0.1f * k;
+            dist_coeffs.insert(dist_coeffs.end(), coeffs, coeffs + 12);
+        }
+        std::vector<float> means(n_gaussians * 3), quats(n_gaussians * 4),
+            scales(n_gaussians * 3);
+        for (size_t g = 0; g < n_gaussians; ++g) {
+            const float u = float(g) / n_gaussians;
+            means[g * 3 + 0] = u - 0.5f;
+            means[g * 3 + 1] = 0.3f * std::sin(10.f * u);
+            means[g * 3 + 2] = 2.f + u;
+            quats[g * 4 + 0] = 1.f;
+            quats[g * 4 + 1] = u;
+            for (int k = 0; k < 3; ++k)
+                scales[g * 3 + k] = 0.05f + 0.1f * u;
+        }
+        std::vector<float> v_means2d(n_cameras * n_gaussians * 2, 0.1f);
+        std::vector<float> v_depths(n_cameras * n_gaussians, -0.2f);
+        std::vector<float> v_covars2d(n_cameras * n_gaussians * 4, 1e-3f);
+        std::vector<float> v_means(n_gaussians * 3), v_quats(n_gaussians * 4),
+            v_scales(n_gaussians * 3), v_viewmats(n_cameras * 16);
+        projection_backward_batched(
+            n_cameras,
+            camera_types.data(),
+            intrinsics.data(),
+            dist_coeffs.data(),
+            viewmats.data(),
+            nullptr,
+            nullptr,
+            width,
+            height,
+            near_plane,
+            far_plane,
+            margin_factor,
+            n_gaussians,
+            means.data(),
+            quats.data(),
+            scales.data(),
+            v_means2d.data(),
+            v_depths.data(),
+            v_covars2d.data(),
+            v_means.data(),
+            v_quats.data(),
+            v_scales.data(),
+            v_viewmats.data(),
+            nullptr
+        );
+
+        std::vector<glm::fvec3> ref_means(n_gaussians, glm::fvec3(0.f));
+        std::vector<glm::fmat4> ref_viewmats(n_cameras, glm::fmat4(0.f));
+        for (size_t k = 0; k < n_cameras; ++k) {
+            for (size_t g = 0; g < n_gaussians; ++g) {
+                const size_t i = k * n_gaussians + g;
+                auto backward = [&](auto camera_type, auto dist) {
+                    return projection_backward<decltype(camera_type)::value>(
+                        intrinsics.data() + 9 * k,
+                        near_plane,
+                        far_plane,
+                        viewmats.data() + 16 * k,
+                        nullptr,
+                        Type::GLOBAL,
+                        width,
+                        height,
+                        means.data() + 3 * g,
+                        quats.data() + 4 * g,
+                        scales.data() + 3 * g,
+                        v_means2d.data() + 2 * i,
+                        v_depths.data() + i,
+                        v_covars2d.data() + 4 * i,
+                        margin_factor,
+                        dist
+                    );
+                };
+                ProjectionBackwardResult r;
+                if (camera_types[k] == CameraType::PINHOLE) {
+                    r = backward(
+                        std::integral_constant<CameraType, CameraType::PINHOLE>{},
+                        DistortionParameters<CameraType::PINHOLE>{}
+                    );
+                } else if (camera_types[k] == CameraType::FISHEYE) {
+                    r = backward(
+                        std::integral_constant<CameraType, CameraType::FISHEYE>{},
+                        DistortionParameters<CameraType::FISHEYE>{}
+                    );
+                } else {
+                    using DistortedPinhole = std::integral_constant<
+                        CameraType,
+                        CameraType::DISTORTED_PINHOLE>;
+                    r = backward(
+                        DistortedPinhole{},
+                        DistortionParameters<CameraType::DISTORTED_PINHOLE>{
+                            coeffs, coeffs + 6, coeffs + 8
+                        }
+                    );
+                }
+                ref_means[g] += r.v_mean;
+                ref_viewmats[k] += r.v_world_to_camera0;
+            }
+        }
+
+        bool success = true;
+        for (size_t g = 0; g < n_gaussians; ++g) {
+            success &= is_close(
+                glm::fvec3(v_means[g * 3], v_means[g * 3 + 1], v_means[g * 3 + 2]),
+                ref_means[g],
+                1e-4f,
+                1e-4f
+            );
+        }
+        for (size_t k = 0; k < n_cameras; ++k) {
+            auto const v_viewmat =
+                glm::transpose(glm::make_mat4(v_viewmats.data() + 16 * k));
+            success &= is_close(v_viewmat, ref_viewmats[k], 1e-3f, 1e-4f);
+        }
+        if (!success) {
+            printf("\n=== Testing projection backward ===\n");
+            printf("\n[FAIL] Test 2: Batched gradients mismatch\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
 auto main() -> int {
     int fails = 0;
     fails += test_projection();
+    fails += test_projection_batched();
+    fails += test_projection_adaptive();
+    fails += test_projection_backward();
 
     if (fails == 0) {
         printf("\nAll tests passed!\n");
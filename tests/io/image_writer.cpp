@@ -0,0 +1,486 @@
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "tinyrend/io/image_writer.h"
+
+using namespace tinyrend::io;
+
+// Minimal inflate for the block types the encoder emits (stored and fixed
+// Huffman). Returns false on malformed input.
+struct Inflater {
+    const std::vector<uint8_t> &in;
+    size_t pos = 0;
+    uint32_t bit = 0;
+
+    uint32_t bits(int n) {
+        uint32_t v = 0;
+        for (int i = 0; i < n; ++i, ++bit) {
+            if (pos + bit / 8 >= in.size())
+                throw std::runtime_error("inflate: truncated");
+            v |= ((in[pos + bit / 8] >> (bit % 8)) & 1u) << i;
+        }
+        return v;
+    }
+    uint32_t code(int n) { // MSB-first Huffman code
+        uint32_t v = 0;
+        for (int i = 0; i < n; ++i)
+            v = (v << 1) | bits(1);
+        return v;
+    }
+    int literal() {
+        uint32_t c = code(7);
+        if (c <= 23)
+            return 256 + c;
+        c = (c << 1) | bits(1);
+        if (c >= 0x30 && c <= 0xBF)
+            return c - 0x30;
+        if (c >= 0xC0 && c <= 0xC7)
+            return 280 + c - 0xC0;
+        c = (c << 1) | bits(1);
+        return 144 + c - 0x190;
+    }
+
+    bool inflate(std::vector<uint8_t> &out) {
+        for (bool last = false; !last;) {
+            last = bits(1);
+            const uint32_t type = bits(2);
+            if (type == 0) {
+                bit = (bit + 7) / 8 * 8;
+                const uint32_t len = bits(16), nlen = bits(16);
+                if ((len ^ 0xFFFF) != nlen)
+                    return false;
+                for (uint32_t i = 0; i < len; ++i)
+                    out.push_back(uint8_t(bits(8)));
+            } else if (type == 1) {
+                for (;;) {
+                    const int sym = literal();
+                    if (sym < 256) {
+                        out.push_back(uint8_t(sym));
+                        continue;
+                    }
+                    if (sym == 256)
+                        break;
+                    const int lc = sym - 257;
+                    const uint32_t len =
+                        detail::LENGTH_BASE[lc] + bits(detail::LENGTH_EXTRA[lc]);
+                    const uint32_t dc = code(5);
+                    const uint32_t dist =
+                        detail::DIST_BASE[dc] + bits(detail::DIST_EXTRA[dc]);
+                    if (dist > out.size())
+                        return false;
+                    for (uint32_t i = 0; i < len; ++i)
+                        out.push_back(out[out.size() - dist]);
+                }
+            } else {
+                return false;
+            }
+        }
+        pos += (bit + 7) / 8;
+        bit = 0;
+        return true;
+    }
+};
+
+static uint32_t be32(const uint8_t *p) {
+    return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | p[3];
+}
+
+// Decode a PNG written by encode_png into raw (big-endian for 16 bit) samples.
+static bool decode_png(
+    const std::vector<uint8_t> &file, uint32_t &width, uint32_t &height,
+    uint32_t &channels, uint32_t &depth, std::vector<uint8_t> &samples
+) {
+    if (file.size() < 8 || std::memcmp(file.data(), "\x89PNG\r\n\x1a\n", 8) != 0)
+        return false;
+    std::vector<uint8_t> zlib;
+    size_t p = 8;
+    while (p + 12 <= file.size()) {
+        const uint32_t len = be32(&file[p]);
+        const uint8_t *type = &file[p + 4];
+        if (crc32(0, type, len + 4) != be32(&file[p + 8 + len]))
+            return false;
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            width = be32(type + 4);
+            height = be32(type + 8);
+            depth = type[12];
+            const uint8_t ct = type[13];
+            channels = ct == 0 ? 1 : ct == 4 ? 2 : ct == 2 ? 3 : 4;
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            zlib.insert(zlib.end(), type + 4, type + 4 + len);
+        }
+        p += 12 + len;
+    }
+    if (zlib.size() < 6 || zlib[0] != 0x78 || (zlib[0] * 256 + zlib[1]) % 31 != 0)
+        return false;
+    std::vector<uint8_t> raw;
+    Inflater inf{zlib, 2};
+    if (!inf.inflate(raw) || inf.pos + 4 != zlib.size())
+        return false;
+    if (adler32(1, raw.data(), raw.size()) != be32(&zlib[inf.pos]))
+        return false;
+
+    const size_t bpp = channels * depth / 8, row_bytes = width * bpp;
+    if (raw.size() != height * (row_bytes + 1))
+        return false;
+    samples.assign(height * row_bytes, 0);
+    for (uint32_t r = 0; r < height; ++r) {
+        const uint8_t *src = &raw[r * (row_bytes + 1)];
+        uint8_t *row = &samples[r * row_bytes];
+        const uint8_t *prior = r > 0 ? row - row_bytes : nullptr;
+        for (size_t i = 0; i < row_bytes; ++i) {
+            const int a = i >= bpp ? row[i - bpp] : 0;
+            const int b = prior ? prior[i] : 0;
+            const int c = (i >= bpp && prior) ? prior[i - bpp] : 0;
+            const int pred = src[0] == 0   ? 0
+                             : src[0] == 1 ? a
+                             : src[0] == 2 ? b
+                             : src[0] == 3 ? (a + b) >> 1
+                                           : detail::paeth(a, b, c);
+            row[i] = uint8_t(src[1 + i] + pred);
+        }
+    }
+    return true;
+}
+
+static std::vector<uint8_t> read_file(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(f), {});
+}
+
+// Smooth gradients plus noise in one corner, so bands use different filters.
+static std::vector<float> test_images(size_t n, uint32_t H, uint32_t W, uint32_t C) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> u(-0.1f, 1.1f);
+    std::vector<float> data(n * H * W * C);
+    for (size_t i = 0; i < n; ++i)
+        for (uint32_t y = 0; y < H; ++y)
+            for (uint32_t x = 0; x < W; ++x)
+                for (uint32_t c = 0; c < C; ++c) {
+                    float v = float(x + (c + 1) * y + i) / float(W + H);
+                    if (x < W / 4 && y < H / 4)
+                        v = u(rng);
+                    data[((i * H + y) * W + x) * C + c] = v;
+                }
+    return data;
+}
+
+int test_deflate() {
+    int fails = 0;
+
+    // Test case 1: adler32_combine matches adler32 of the concatenation
+    {
+        std::vector<uint8_t> data(100000);
+        std::mt19937 rng(1);
+        for (auto &v : data)
+            v = uint8_t(rng());
+        const uint32_t whole = adler32(1, data.data(), data.size());
+        uint32_t combined = 1;
+        const size_t cuts[] = {0, 7, 70000, data.size()};
+        for (int k = 0; k < 3; ++k) {
+            const size_t len = cuts[k + 1] - cuts[k];
+            combined = adler32_combine(
+                combined, adler32(1, data.data() + cuts[k], len), len
+            );
+        }
+        const char *check = "123456789";
+        if (combined != whole ||
+            crc32(0, reinterpret_cast<const uint8_t *>(check), 9) != 0xCBF43926u) {
+            printf("\n=== Testing deflate ===\n");
+            printf("\n[FAIL] Test 1: Checksums are wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Independent chunks concatenate into a valid stream
+    {
+        std::vector<uint8_t> data;
+        for (int i = 0; i < 50000; ++i)
+            data.push_back(uint8_t(i % 251 < 100 ? i % 7 : (i * 31) >> 3));
+        std::vector<uint8_t> stream;
+        zlib_header(stream);
+        uint32_t adler = 1;
+        const size_t cuts[] = {0, 1, 1, 20000, data.size()};
+        for (int k = 0; k < 4; ++k) {
+            const size_t len = cuts[k + 1] - cuts[k];
+            deflate_chunk(data.data() + cuts[k], len, stream);
+            adler = adler32_combine(adler, adler32(1, data.data() + cuts[k], len), len);
+        }
+        deflate_finish(stream, adler);
+
+        std::vector<uint8_t> out;
+        Inflater inf{stream, 2};
+        const bool ok = inf.inflate(out);
+        if (!ok || out != data || inf.pos + 4 != stream.size() ||
+            be32(&stream[inf.pos]) != adler32(1, data.data(), data.size()) ||
+            stream.size() > data.size() / 2) {
+            printf("\n=== Testing deflate ===\n");
+            printf("\n[FAIL] Test 2: Round trip failed (%zu -> %zu bytes)\n",
+                   data.size(), stream.size());
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_write_png() {
+    int fails = 0;
+
+    // Test case 1: 8 and 16 bit PNGs decode to the quantized samples
+    for (uint32_t C = 1; C <= 4; ++C) {
+        for (uint32_t depth : {8u, 16u}) {
+            const size_t n = 2;
+            const uint32_t H = 37, W = 29;
+            auto const data = test_images(n, H, W, C);
+            ImageBatch batch{data.data(), n, H, W, C};
+            PngConfig cfg;
+            cfg.bit_depth = depth;
+            cfg.band_rows = 5; // several IDAT bands per image
+            auto const files = encode_png(batch, cfg);
+
+            for (size_t i = 0; i < n; ++i) {
+                uint32_t w = 0, h = 0, c = 0, d = 0;
+                std::vector<uint8_t> samples;
+                bool ok = decode_png(files[i], w, h, c, d, samples);
+                ok = ok && w == W && h == H && c == C && d == depth;
+                for (size_t k = 0; ok && k < batch.image_size(); ++k) {
+                    const float v = std::clamp(batch.image(i)[k], 0.f, 1.f);
+                    const uint32_t expected =
+                        depth == 8 ? uint32_t(std::lround(v * 255.f))
+                                   : uint32_t(std::lround(v * 65535.f));
+                    const uint32_t got = depth == 8
+                                             ? samples[k]
+                                             : uint32_t(samples[2 * k]) << 8 |
+                                                   samples[2 * k + 1];
+                    ok = got == expected;
+                }
+                if (!ok) {
+                    printf("\n=== Testing write_png ===\n");
+                    printf("\n[FAIL] Test 1: C = %u, depth = %u, image %zu\n",
+                           C, depth, i);
+                    fails += 1;
+                }
+            }
+        }
+    }
+
+    // Test case 2: Files on disk, default bands, NaN and out-of-range values
+    {
+        const uint32_t H = 64, W = 48, C = 3;
+        auto data = test_images(1, H, W, C);
+        data[0] = std::nanf("");
+        data[1] = -5.f;
+        data[2] = 5.f;
+        const std::string path =
+            "/tmp/tinyrend_test_png_" + std::to_string(getpid()) + ".png";
+        write_png({data.data(), 1, H, W, C}, {path});
+        uint32_t w, h, c, d;
+        std::vector<uint8_t> samples;
+        const bool ok = decode_png(read_file(path), w, h, c, d, samples);
+        unlink(path.c_str());
+        if (!ok || samples[0] != 0 || samples[1] != 0 || samples[2] != 255) {
+            printf("\n=== Testing write_png ===\n");
+            printf("\n[FAIL] Test 2: PNG file does not decode\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_write_qoi() {
+    int fails = 0;
+
+    // Test case 1: QOI round trip for RGB and RGBA
+    for (uint32_t C : {3u, 4u}) {
+        const uint32_t H = 33, W = 41;
+        auto data = test_images(2, H, W, C);
+        // a long run of one color exercises QOI_OP_RUN
+        for (size_t k = 0; k < 200 * C; ++k)
+            data[(H * W - 200) * C + k] = 0.5f;
+        ImageBatch batch{data.data(), 2, H, W, C};
+        auto const files = encode_qoi(batch);
+        std::vector<uint8_t> expected(batch.size());
+        quantize_u8(data.data(), data.size(), expected.data());
+
+        for (size_t i = 0; i < 2; ++i) {
+            auto const &f = files[i];
+            bool ok = f.size() > 22 && std::memcmp(f.data(), "qoif", 4) == 0 &&
+                      be32(&f[4]) == W && be32(&f[8]) == H && f[12] == C;
+            uint8_t index[64][4] = {}, px[4] = {0, 0, 0, 255};
+            size_t p = 14, run = 0;
+            for (size_t k = 0; ok && k < size_t(H) * W; ++k) {
+                if (run > 0) {
+                    --run;
+                } else {
+                    const uint8_t b = f[p++];
+                    if (b == 0xFE) {
+                        std::memcpy(px, &f[p], 3);
+                        p += 3;
+                    } else if (b == 0xFF) {
+                        std::memcpy(px, &f[p], 4);
+                        p += 4;
+                    } else if ((b >> 6) == 0) {
+                        std::memcpy(px, index[b], 4);
+                    } else if ((b >> 6) == 1) {
+                        px[0] += ((b >> 4) & 3) - 2;
+                        px[1] += ((b >> 2) & 3) - 2;
+                        px[2] += (b & 3) - 2;
+                    } else if ((b >> 6) == 2) {
+                        const int dg = (b & 63) - 32, b2 = f[p++];
+                        px[0] += dg - 8 + (b2 >> 4);
+                        px[1] += dg;
+                        px[2] += dg - 8 + (b2 & 15);
+                    } else {
+                        run = b & 63;
+                    }
+                    const int h = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+                    std::memcpy(index[h], px, 4);
+                }
+                ok = std::memcmp(px, &expected[(i * H * W + k) * C], C) == 0;
+            }
+            const uint8_t end[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+            ok = ok && p + 8 == f.size() && std::memcmp(&f[p], end, 8) == 0;
+            if (!ok || f.size() >= 14 + size_t(H) * W * C) {
+                printf("\n=== Testing write_qoi ===\n");
+                printf("\n[FAIL] Test 1: C = %u, image %zu does not decode\n", C, i);
+                fails += 1;
+            }
+        }
+    }
+
+    return fails;
+}
+
+int test_write_float() {
+    int fails = 0;
+    const std::string base = "/tmp/tinyrend_test_float_" + std::to_string(getpid());
+
+    // Test case 1: PFM rows are stored bottom to top
+    {
+        const uint32_t H = 5, W = 7, C = 3;
+        auto const data = test_images(1, H, W, C);
+        write_pfm({data.data(), 1, H, W, C}, {base + ".pfm"});
+        auto const f = read_file(base + ".pfm");
+        unlink((base + ".pfm").c_str());
+        const std::string header = "PF\n7 5\n-1.0\n";
+        bool ok = f.size() == header.size() + data.size() * 4 &&
+                  std::memcmp(f.data(), header.data(), header.size()) == 0;
+        for (uint32_t y = 0; ok && y < H; ++y)
+            ok = std::memcmp(&f[header.size() + (H - 1 - y) * W * C * 4],
+                             &data[y * W * C], W * C * 4) == 0;
+        if (!ok) {
+            printf("\n=== Testing write_float ===\n");
+            printf("\n[FAIL] Test 1: PFM file is wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: NPY header and payload
+    {
+        const uint32_t H = 9, W = 11, C = 2;
+        auto const data = test_images(3, H, W, C);
+        write_npy({data.data(), 3, H, W, C}, base + ".npy");
+        auto const f = read_file(base + ".npy");
+        unlink((base + ".npy").c_str());
+        const size_t header = 10 + (f[8] | f[9] << 8);
+        const std::string dict(f.begin() + 10, f.begin() + header);
+        const bool ok =
+            header % 64 == 0 && f.size() == header + data.size() * 4 &&
+            dict.find("'shape': (3, 9, 11, 2)") != std::string::npos &&
+            dict.back() == '\n' &&
+            std::memcmp(&f[header], data.data(), data.size() * 4) == 0;
+        if (!ok) {
+            printf("\n=== Testing write_float ===\n");
+            printf("\n[FAIL] Test 2: NPY file is wrong\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_async_writer() {
+    int fails = 0;
+    const std::string base = "/tmp/tinyrend_test_async_" + std::to_string(getpid());
+
+    // Test case 1: Frames written in the background match synchronous encoding
+    {
+        const uint32_t H = 32, W = 32, C = 4;
+        std::vector<std::string> paths;
+        {
+            AsyncImageWriter writer(2);
+            std::vector<float> frame(H * W * C);
+            for (int k = 0; k < 6; ++k) {
+                // the buffer is reused for the next frame right after submit
+                auto const data = test_images(1, H, W, C);
+                for (size_t i = 0; i < frame.size(); ++i)
+                    frame[i] = data[i] * float(k) / 5.f;
+                paths.push_back(base + "_" + std::to_string(k) + ".png");
+                writer.submit(
+                    {frame.data(), 1, H, W, C}, ImageFormat::PNG, {paths.back()}
+                );
+            }
+            writer.wait();
+        }
+        for (int k = 0; k < 6; ++k) {
+            auto const data = test_images(1, H, W, C);
+            std::vector<float> frame(data.size());
+            for (size_t i = 0; i < frame.size(); ++i)
+                frame[i] = data[i] * float(k) / 5.f;
+            auto const expected = encode_png({frame.data(), 1, H, W, C})[0];
+            if (read_file(paths[k]) != expected) {
+                printf("\n=== Testing async_writer ===\n");
+                printf("\n[FAIL] Test 1: Frame %d differs\n", k);
+                fails += 1;
+            }
+            unlink(paths[k].c_str());
+        }
+    }
+
+    // Test case 2: Write errors surface in wait()
+    {
+        AsyncImageWriter writer(1);
+        std::vector<float> frame(4 * 4, 0.5f);
+        writer.submit({frame.data(), 1, 4, 4, 1}, ImageFormat::PFM,
+                      {"/nonexistent_dir/x.pfm"});
+        bool thrown = false;
+        try {
+            writer.wait();
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        if (!thrown) {
+            printf("\n=== Testing async_writer ===\n");
+            printf("\n[FAIL] Test 2: Error was not reported\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_deflate();
+    fails += test_write_png();
+    fails += test_write_qoi();
+    fails += test_write_float();
+    fails += test_async_writer();
+
+    if (fails > 0) {
+        printf("[io/image_writer.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[io/image_writer.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
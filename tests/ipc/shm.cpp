@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <chrono>
+#include <poll.h>
+#include <stdio.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "tinyrend/ipc/coordinator.h"
+#include "tinyrend/ipc/scene.h"
+
+using namespace tinyrend::ipc;
+
+struct TestScene {
+    size_t n = 100;
+    uint32_t feature_dim = 3;
+    std::vector<float> means, quats, scales, opacities, features;
+
+    TestScene() {
+        for (size_t i = 0; i < n; ++i) {
+            means.insert(means.end(), {float(i), 0.f, 1.f});
+            quats.insert(quats.end(), {1.f, 0.f, 0.f, 0.f});
+            scales.insert(scales.end(), {0.1f, 0.2f, 0.3f});
+            opacities.push_back(float(i) / n);
+            features.insert(features.end(), {1.f, 2.f, float(i)});
+        }
+    }
+};
+
+int test_scene_format() {
+    int fails = 0;
+    TestScene s;
+
+    // Test case 1: Round trip through a scene file
+    {
+        const std::string path = "/tmp/tinyrend_test_scene_" + std::to_string(getpid());
+        save_scene_file(
+            path,
+            s.n,
+            s.feature_dim,
+            s.means.data(),
+            s.quats.data(),
+            s.scales.data(),
+            s.opacities.data(),
+            s.features.data()
+        );
+        MappedRegion region = map_scene_file(path);
+        SceneView v = view_scene(region.data(), region.size());
+        if (v.n_primitives != s.n || v.feature_dim != s.feature_dim ||
+            !std::equal(s.means.begin(), s.means.end(), v.means) ||
+            !std::equal(s.features.begin(), s.features.end(), v.features)) {
+            printf("\n=== Testing scene format ===\n");
+            printf("\n[FAIL] Test 1: File round trip mismatch\n");
+            fails += 1;
+        }
+        // read into (possibly huge-page backed) private memory
+        auto const buffer =
+            read_scene_file(path, tinyrend::huge_pages::Mode::TRANSPARENT);
+        SceneView r = view_scene(buffer.data(), buffer.size());
+        if (r.n_primitives != s.n ||
+            !std::equal(s.scales.begin(), s.scales.end(), r.scales) ||
+            !std::equal(s.features.begin(), s.features.end(), r.features)) {
+            printf("\n=== Testing scene format ===\n");
+            printf("\n[FAIL] Test 1: read_scene_file mismatch\n");
+            fails += 1;
+        }
+        unlink(path.c_str());
+    }
+
+    // Test case 2: Truncated blobs are rejected
+    {
+        const SceneHeader h = scene_layout(s.n, s.feature_dim);
+        std::vector<char> blob(h.total_bytes);
+        write_scene(
+            blob.data(),
+            s.n,
+            s.feature_dim,
+            s.means.data(),
+            s.quats.data(),
+            s.scales.data(),
+            s.opacities.data(),
+            s.features.data()
+        );
+        bool threw = false;
+        try {
+            view_scene(blob.data(), blob.size() - 64);
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw) {
+            printf("\n[FAIL] Test 2: Truncated blob accepted\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_multi_process_render() {
+    int fails = 0;
+    TestScene s;
+    const std::string suffix = std::to_string(getpid());
+    const uint32_t n_workers = 3;
+    const uint32_t n_images = 4, n_tiles = 25;
+
+    SharedScene scene = SharedScene::create(
+        "/tinyrend_test_scene_" + suffix,
+        s.n,
+        s.feature_dim,
+        s.means.data(),
+        s.quats.data(),
+        s.scales.data(),
+        s.opacities.data(),
+        s.features.data()
+    );
+    Coordinator coordinator = Coordinator::create("/tinyrend_test_ctrl_" + suffix, n_workers);
+
+    std::vector<pid_t> children;
+    for (uint32_t w = 0; w < n_workers; ++w) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            // Worker: read the shared scene; worker 0 crashes on its first job
+            // so that the coordinator has to reassign its tiles.
+            SharedScene shared = SharedScene::attach(scene.name());
+            run_worker(coordinator.name(), w, [&](const RenderJob &job) -> int32_t {
+                if (w == 0)
+                    _exit(3);
+                const SceneView &v = shared.view();
+                for (uint32_t t = job.tile_begin; t < job.tile_end; ++t) {
+                    if (v.features[t * v.feature_dim + 2] != float(t))
+                        return 1;
+                }
+                return 0;
+            });
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    // Test case 1: Every job completes exactly once despite a crashed worker
+    {
+        auto jobs = partition_tiles(n_images, n_tiles, 7);
+        std::vector<RenderResult> results;
+        try {
+            results = coordinator.run(jobs, std::chrono::seconds(30));
+        } catch (const std::runtime_error &e) {
+            printf("\n=== Testing multi-process render ===\n");
+            printf("\n[FAIL] Test 1: %s\n", e.what());
+            fails += 1;
+        }
+        std::vector<int> seen(jobs.size(), 0);
+        for (const auto &r : results) {
+            if (r.job_id < seen.size())
+                seen[r.job_id] += 1;
+            if (r.status != 0 || r.worker_id == 0) {
+                printf("\n[FAIL] Test 1: Job %lu status %d from worker %u\n",
+                       (unsigned long)r.job_id, r.status, r.worker_id);
+                fails += 1;
+            }
+        }
+        if (results.size() != jobs.size() ||
+            std::any_of(seen.begin(), seen.end(), [](int c) { return c != 1; })) {
+            printf("\n[FAIL] Test 1: %zu results for %zu jobs\n", results.size(), jobs.size());
+            fails += 1;
+        }
+    }
+
+    coordinator.shutdown();
+    for (pid_t pid : children)
+        waitpid(pid, nullptr, 0);
+
+    return fails;
+}
+
+int test_worker_liveness() {
+    int fails = 0;
+    const std::string suffix = std::to_string(getpid());
+
+    // Test case 1: Jobs of a slot that never attaches are reassigned
+    {
+        Coordinator coordinator = Coordinator::create(
+            "/tinyrend_test_ctrl_unattached_" + suffix,
+            2,
+            std::chrono::milliseconds(200)
+        );
+        const pid_t pid = fork();
+        if (pid == 0) {
+            // only worker 1 attaches
+            run_worker(coordinator.name(), 1, [](const RenderJob &) { return 0; });
+            _exit(0);
+        }
+        auto jobs = partition_tiles(2, 16, 4);
+        std::vector<RenderResult> results;
+        try {
+            results = coordinator.run(jobs, std::chrono::seconds(30));
+        } catch (const std::runtime_error &e) {
+            printf("\n=== Testing worker liveness ===\n");
+            printf("\n[FAIL] Test 1: %s\n", e.what());
+            fails += 1;
+        }
+        if (results.size() != jobs.size() ||
+            std::any_of(results.begin(), results.end(), [](const RenderResult &r) {
+                return r.worker_id != 1;
+            })) {
+            printf(
+                "\n[FAIL] Test 1: %zu results for %zu jobs\n",
+                results.size(),
+                jobs.size()
+            );
+            fails += 1;
+        }
+        coordinator.shutdown();
+        waitpid(pid, nullptr, 0);
+    }
+
+    // Test case 2: A worker exits once its coordinator is gone
+    {
+        const std::string name = "/tinyrend_test_ctrl_orphan_" + suffix;
+        int fds[2];
+        if (pipe(fds) != 0) {
+            printf("\n[FAIL] Test 2: pipe failed\n");
+            return fails + 1;
+        }
+        const pid_t coordinator_pid = fork();
+        if (coordinator_pid == 0) {
+            // Coordinator process: start a worker, then die without shutdown.
+            Coordinator coordinator = Coordinator::create(name, 1);
+            if (fork() == 0) {
+                const size_t n =
+                    run_worker(name, 0, [](const RenderJob &) { return 0; });
+                const char done = n == 0 ? 1 : 0;
+                (void)!write(fds[1], &done, 1);
+                _exit(0);
+            }
+            _exit(0);
+        }
+        close(fds[1]);
+        // the coordinator stays a zombie until reaped, which counts as gone
+        pollfd p{fds[0], POLLIN, 0};
+        char done = 0;
+        if (poll(&p, 1, 10000) != 1 || read(fds[0], &done, 1) != 1 || done != 1) {
+            printf("\n=== Testing worker liveness ===\n");
+            printf("\n[FAIL] Test 2: Worker did not exit after its coordinator\n");
+            fails += 1;
+        }
+        close(fds[0]);
+        waitpid(coordinator_pid, nullptr, 0);
+        shm_unlink(name.c_str());
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_scene_format();
+    fails += test_multi_process_render();
+    fails += test_worker_liveness();
+
+    if (fails > 0) {
+        printf("[ipc/shm.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[ipc/shm.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
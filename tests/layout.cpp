@@ -0,0 +1,184 @@
+#include <cstdint>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/core/thread_pool.h"
+#include "tinyrend/rasterization/layout.h"
+#include "tinyrend/rasterization/tile_writer.h"
+
+using namespace tinyrend::rasterization;
+
+static const OutputLayout LAYOUTS[] = {
+    {LayoutKind::HWC, 16, 16},
+    {LayoutKind::CHW, 16, 16},
+    {LayoutKind::TILED, 16, 16},
+    {LayoutKind::TILED, 8, 4},
+};
+
+// Brute-force index of channel c of pixel (x, y) of image n.
+static size_t reference_index(
+    const OutputLayout &l, size_t n, size_t x, size_t y, size_t W, size_t H, size_t C,
+    size_t c
+) {
+    switch (l.kind) {
+    case LayoutKind::CHW:
+        return ((n * C + c) * H + y) * W + x;
+    case LayoutKind::TILED: {
+        const size_t tx = (W + l.tile_width - 1) / l.tile_width;
+        const size_t ty = (H + l.tile_height - 1) / l.tile_height;
+        const size_t tile = (n * ty + y / l.tile_height) * tx + x / l.tile_width;
+        const size_t in_tile = (y % l.tile_height) * l.tile_width + x % l.tile_width;
+        return (tile * l.tile_width * l.tile_height + in_tile) * C + c;
+    }
+    default:
+        return ((n * H + y) * W + x) * C + c;
+    }
+}
+
+static float value_of(size_t n, size_t x, size_t y, size_t c) {
+    return float(n * 1000000 + y * 1000 + x) + 0.25f * float(c);
+}
+
+int test_layout() {
+    int fails = 0;
+    const uint32_t W = 37, H = 21, C = 3, N = 2;
+
+    // Test case 1: offset/store/load match the brute-force indices
+    for (const auto &l : LAYOUTS) {
+        std::vector<float> out(N * l.image_size(W, H, C), -1.f);
+        bool ok = true;
+        for (uint32_t n = 0; n < N; ++n)
+            for (uint32_t y = 0; y < H; ++y)
+                for (uint32_t x = 0; x < W; ++x) {
+                    float v[C], back[C];
+                    for (uint32_t c = 0; c < C; ++c)
+                        v[c] = value_of(n, x, y, c);
+                    l.store(out.data(), v, n, x, y, W, H, C);
+                    l.load(out.data(), back, n, x, y, W, H, C);
+                    for (uint32_t c = 0; c < C; ++c) {
+                        const size_t i = reference_index(l, n, x, y, W, H, C, c);
+                        ok = ok && out[i] == v[c] && back[c] == v[c];
+                    }
+                }
+        if (!ok) {
+            printf("\n=== Testing Layout ===\n");
+            printf("\n[FAIL] Test 1: Layout %d indexing is wrong\n", int(l.kind));
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Padded image sizes and single-channel offsets
+    {
+        const OutputLayout hwc{}, tiled{LayoutKind::TILED, 16, 16};
+        if (hwc.image_size(W, H, C) != size_t(W) * H * C ||
+            tiled.image_size(W, H, C) != size_t(48) * 32 * C ||
+            hwc.offset(1, 5, 7, W, H, 1) !=
+                OutputLayout{LayoutKind::CHW}.offset(1, 5, 7, W, H, 1)) {
+            printf("\n=== Testing Layout ===\n");
+            printf("\n[FAIL] Test 2: Image sizes are wrong\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_tile_writer() {
+    int fails = 0;
+
+    // Test case 1: convert_layout matches per-pixel stores and leaves padding
+    // untouched, for odd sizes where runs start misaligned
+    for (uint32_t C : {1u, 3u, 4u}) {
+        const uint32_t W = 53, H = 19, N = 3;
+        std::vector<float> hwc(size_t(N) * H * W * C);
+        for (uint32_t n = 0; n < N; ++n)
+            for (uint32_t y = 0; y < H; ++y)
+                for (uint32_t x = 0; x < W; ++x)
+                    for (uint32_t c = 0; c < C; ++c)
+                        hwc[((size_t(n) * H + y) * W + x) * C + c] =
+                            value_of(n, x, y, c);
+        tinyrend::thread_pool::ThreadPool pool(3);
+        for (const auto &l : LAYOUTS) {
+            const size_t size = N * l.image_size(W, H, C);
+            std::vector<float> expected(size, -1.f), out(size + 1, -1.f);
+            for (uint32_t n = 0; n < N; ++n)
+                for (uint32_t y = 0; y < H; ++y)
+                    for (uint32_t x = 0; x < W; ++x)
+                        l.store(
+                            expected.data(),
+                            &hwc[((size_t(n) * H + y) * W + x) * C],
+                            n, x, y, W, H, C
+                        );
+            // shift by one float so the streamed runs are misaligned
+            convert_layout(l, N, W, H, C, hwc.data(), out.data() + 1, pool);
+            bool ok = out[0] == -1.f;
+            for (size_t i = 0; ok && i < size; ++i)
+                ok = out[i + 1] == expected[i];
+            if (!ok) {
+                printf("\n=== Testing Tile Writer ===\n");
+                printf("\n[FAIL] Test 1: Layout %d with %u channels is wrong\n",
+                       int(l.kind), C);
+                fails += 1;
+            }
+        }
+    }
+
+    // Test case 2: store_tile clips edge tiles and honours the tile pitch
+    {
+        const uint32_t W = 20, H = 10, C = 4, TW = 16, TH = 16, PITCH = TW * C + 8;
+        std::vector<float> tile(TH * PITCH);
+        for (uint32_t y = 0; y < TH; ++y)
+            for (uint32_t x = 0; x < TW; ++x)
+                for (uint32_t c = 0; c < C; ++c)
+                    tile[y * PITCH + x * C + c] = value_of(0, 16 + x, y, c);
+        const OutputLayout chw{LayoutKind::CHW};
+        std::vector<float> out(chw.image_size(W, H, C), -1.f);
+        store_tile(chw, W, H, C, 0, 16, 0, TW, TH, tile.data(), out.data(), PITCH);
+        stream_fence();
+        bool ok = true;
+        for (uint32_t y = 0; y < H; ++y)
+            for (uint32_t x = 0; x < W; ++x)
+                for (uint32_t c = 0; c < C; ++c) {
+                    const float v = out[reference_index(chw, 0, x, y, W, H, C, c)];
+                    ok = ok && v == (x >= 16 ? value_of(0, x, y, c) : -1.f);
+                }
+        if (!ok) {
+            printf("\n=== Testing Tile Writer ===\n");
+            printf("\n[FAIL] Test 2: Edge tile is wrong\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 3: In-place conversion is rejected
+    {
+        std::vector<float> buffer(64);
+        bool threw = false;
+        try {
+            convert_layout(OutputLayout{}, 1, 4, 4, 4, buffer.data(), buffer.data());
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        if (!threw) {
+            printf("\n=== Testing Tile Writer ===\n");
+            printf("\n[FAIL] Test 3: In-place conversion was accepted\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_layout();
+    fails += test_tile_writer();
+
+    if (fails > 0) {
+        printf("[layout.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[layout.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/rasterization/oit.h"
+
+using namespace tinyrend::rasterization;
+
+struct Layer {
+    float alpha, depth;
+    glm::fvec3 feature;
+};
+
+// Exact front-to-back composite of layers given in depth order.
+std::pair<glm::fvec3, float> composite_sorted(const std::vector<Layer> &layers) {
+    glm::fvec3 feature(0.f);
+    float T = 1.f;
+    for (auto const &l : layers) {
+        feature += T * l.alpha * l.feature;
+        T *= 1.f - l.alpha;
+    }
+    return {feature, 1.f - T};
+}
+
+int test_weighted_blended() {
+    int fails = 0;
+    const float depth_scale = 5.f;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> u01(0.f, 1.f), ud(0.5f, 50.f);
+
+    // Test case 1: A single layer composites exactly
+    {
+        WeightedBlendedAccumulator<glm::fvec3> acc;
+        acc.add(0.6f, 3.f, glm::fvec3(0.2f, 0.5f, 0.9f), depth_scale);
+        auto const [feature, alpha] =
+            composite_sorted({{0.6f, 3.f, {0.2f, 0.5f, 0.9f}}});
+        if (std::abs(acc.alpha() - alpha) > 1e-6f ||
+            glm::length(acc.feature() - feature) > 1e-6f) {
+            printf("\n=== Testing weighted_blended ===\n");
+            printf("\n[FAIL] Test 1: Single layer differs from the exact composite\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Order independent, exact coverage, nearer layers dominate
+    {
+        std::vector<Layer> layers;
+        for (int i = 0; i < 20; ++i) {
+            glm::fvec3 const feature(u01(rng), u01(rng), u01(rng));
+            layers.push_back({0.3f * u01(rng), ud(rng), feature});
+        }
+        WeightedBlendedAccumulator<glm::fvec3> forward, backward;
+        for (size_t i = 0; i < layers.size(); ++i) {
+            auto const &f = layers[i], &b = layers[layers.size() - 1 - i];
+            forward.add(f.alpha, f.depth, f.feature, depth_scale);
+            backward.add(b.alpha, b.depth, b.feature, depth_scale);
+        }
+        std::sort(layers.begin(), layers.end(), [](auto const &a, auto const &b) {
+            return a.depth < b.depth;
+        });
+        auto const [feature, alpha] = composite_sorted(layers);
+        if (glm::length(forward.feature() - backward.feature()) > 1e-5f ||
+            std::abs(forward.alpha() - alpha) > 1e-5f) {
+            printf("\n=== Testing weighted_blended ===\n");
+            printf("\n[FAIL] Test 2: Composite depends on the order\n");
+            fails += 1;
+        }
+        if (!(weighted_blended_weight(0.5f, 1.f, depth_scale) >
+              weighted_blended_weight(0.5f, 20.f, depth_scale))) {
+            printf("\n=== Testing weighted_blended ===\n");
+            printf("\n[FAIL] Test 2: Weight does not decrease with depth\n");
+            fails += 1;
+        }
+    }
+
+    // Test case 3: Error report against the exact composite
+    {
+        const size_t n_pixels = 256;
+        std::vector<float> ref_features, ref_alphas, features, alphas;
+        for (size_t p = 0; p < n_pixels; ++p) {
+            std::vector<Layer> layers;
+            for (int i = 0; i < 8; ++i) {
+                glm::fvec3 const feature(u01(rng), u01(rng), u01(rng));
+                layers.push_back({0.5f * u01(rng), ud(rng), feature});
+            }
+            WeightedBlendedAccumulator<glm::fvec3> acc;
+            for (auto const &l : layers)
+                acc.add(l.alpha, l.depth, l.feature, depth_scale);
+            std::sort(layers.begin(), layers.end(), [](auto const &a, auto const &b) {
+                return a.depth < b.depth;
+            });
+            auto const [feature, alpha] = composite_sorted(layers);
+            auto const approx = acc.feature();
+            for (int k = 0; k < 3; ++k) {
+                ref_features.push_back(feature[k]);
+                features.push_back(approx[k]);
+            }
+            ref_alphas.push_back(alpha);
+            alphas.push_back(acc.alpha());
+        }
+        auto const same = compositing_error(
+            n_pixels,
+            3,
+            ref_features.data(),
+            ref_alphas.data(),
+            ref_features.data(),
+            ref_alphas.data()
+        );
+        auto const report = compositing_error(
+            n_pixels,
+            3,
+            ref_features.data(),
+            ref_alphas.data(),
+            features.data(),
+            alphas.data()
+        );
+        if (same.max_abs_feature != 0.f || !std::isinf(same.psnr) ||
+            !(report.max_abs_feature > 0.f) ||
+            !(report.mean_abs_feature <= report.rmse_feature) ||
+            !(report.rmse_feature <= report.max_abs_feature) ||
+            !(report.psnr > 15.f && std::isfinite(report.psnr)) ||
+            report.max_abs_alpha > 1e-5f) {
+            printf("\n=== Testing weighted_blended ===\n");
+            printf("\n[FAIL] Test 3: max %f mean %f rmse %f psnr %f alpha %f\n",
+                   report.max_abs_feature,
+                   report.mean_abs_feature,
+                   report.rmse_feature,
+                   report.psnr,
+                   report.max_abs_alpha);
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_weighted_blended();
+
+    if (fails > 0) {
+        printf("[oit.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[oit.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
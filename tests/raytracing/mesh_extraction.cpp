@@ -0,0 +1,120 @@
+#include <cmath>
+#include <glm/glm.hpp>
+#include <map>
+#include <stdio.h>
+#include <utility>
+#include <vector>
+
+#include "tinyrend/raytracing/grid.h"
+#include "tinyrend/raytracing/mesh_extraction.h"
+
+using namespace tinyrend::raytracing;
+
+int test_extract_mesh() {
+    int fails = 0;
+
+    // Test case 1: Two distant isotropic Gaussians give two closed spheres
+    {
+        const float s = 0.2f;
+        std::vector<float> means = {0.1f, -0.2f, 0.3f, 2.1f, 0.8f, -0.7f};
+        std::vector<float> quats = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f};
+        std::vector<float> scales = {s, s, s, s, s, s};
+        std::vector<float> opacities = {1.f, 1.f};
+        auto const grid = build_grid(
+            {2, means.data(), quats.data(), scales.data(), opacities.data()},
+            {1.f / 255.f, 512.f, 64}
+        );
+        MeshExtractionConfig cfg;
+        cfg.iso_level = 0.5f;
+        cfg.voxel_size = 0.01f;
+        cfg.block_size = 8;
+        auto const mesh = extract_mesh(grid, cfg);
+        // exp(-r² / 2s²) = iso_level
+        auto const r = s * std::sqrt(2.f * std::log(1.f / cfg.iso_level));
+        const glm::fvec3 centers[2] = {
+            {means[0], means[1], means[2]}, {means[3], means[4], means[5]}
+        };
+
+        if (mesh.triangles.empty() || mesh.n_occupied_blocks >= mesh.n_blocks) {
+            printf("\n=== Testing extract_mesh ===\n");
+            printf("\n[FAIL] Test 1: %zu triangles, %zu / %zu blocks occupied\n",
+                   mesh.triangles.size(), mesh.n_occupied_blocks, mesh.n_blocks);
+            fails += 1;
+        }
+
+        float max_err = 0.f;
+        for (auto const &v : mesh.vertices) {
+            auto const d = std::min(
+                glm::length(v - centers[0]), glm::length(v - centers[1])
+            );
+            max_err = std::max(max_err, std::abs(d - r));
+        }
+        if (max_err > 0.2f * cfg.voxel_size) {
+            printf("\n=== Testing extract_mesh ===\n");
+            printf("\n[FAIL] Test 1: Vertex off the sphere by %f\n", max_err);
+            fails += 1;
+        }
+
+        // every directed edge must be matched by its reverse exactly once
+        std::map<std::pair<uint32_t, uint32_t>, int> edges;
+        float volume = 0.f;
+        for (auto const &t : mesh.triangles) {
+            for (int k = 0; k < 3; ++k)
+                edges[{t[k], t[(k + 1) % 3]}] += 1;
+            auto const &a = mesh.vertices[t.x], &b = mesh.vertices[t.y],
+                        &c = mesh.vertices[t.z];
+            volume += glm::dot(a, glm::cross(b, c)) / 6.f;
+        }
+        bool closed = true;
+        for (auto const &[edge, count] : edges) {
+            auto const it = edges.find({edge.second, edge.first});
+            if (count != 1 || it == edges.end() || it->second != 1)
+                closed = false;
+        }
+        if (!closed) {
+            printf("\n=== Testing extract_mesh ===\n");
+            printf("\n[FAIL] Test 1: Mesh is not closed and consistently oriented\n");
+            fails += 1;
+        }
+
+        auto const expected = 2.f * 4.f / 3.f * float(M_PI) * r * r * r;
+        if (std::abs(volume - expected) > 0.02f * expected) {
+            printf("\n=== Testing extract_mesh ===\n");
+            printf("\n[FAIL] Test 1: Volume %f vs %f\n", volume, expected);
+            fails += 1;
+        }
+    }
+
+    // Test case 2: Nothing above the iso level gives an empty mesh
+    {
+        std::vector<float> means = {0.f, 0.f, 0.f};
+        std::vector<float> quats = {1.f, 0.f, 0.f, 0.f};
+        std::vector<float> scales = {0.1f, 0.1f, 0.1f};
+        std::vector<float> opacities = {0.3f};
+        auto const grid = build_grid(
+            {1, means.data(), quats.data(), scales.data(), opacities.data()}
+        );
+        auto const mesh = extract_mesh(grid);
+        if (!mesh.vertices.empty() || !mesh.triangles.empty()) {
+            printf("\n=== Testing extract_mesh ===\n");
+            printf("\n[FAIL] Test 2: Expected an empty mesh\n");
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_extract_mesh();
+
+    if (fails > 0) {
+        printf("[raytracing/mesh_extraction.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[raytracing/mesh_extraction.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
@@ -0,0 +1,97 @@
+#include <cmath>
+#include <glm/glm.hpp>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/gaussian.h"
+#include "tinyrend/raytracing/grid.h"
+#include "tinyrend/raytracing/point_queries.h"
+
+using namespace tinyrend::raytracing;
+
+int test_query_points() {
+    int fails = 0;
+
+    // Test case 1: Indexed queries match brute force over all Gaussians
+    {
+        const size_t n = 3000;
+        const uint32_t feature_dim = 3;
+        std::mt19937 rng(0);
+        std::uniform_real_distribution<float> pos(-2.f, 2.f), unit(-1.f, 1.f);
+        std::uniform_real_distribution<float> scale(0.05f, 0.3f), u01(0.f, 1.f);
+        std::vector<float> means, quats, scales, opacities, features;
+        for (size_t i = 0; i < n; ++i) {
+            means.insert(means.end(), {pos(rng), pos(rng), pos(rng)});
+            quats.insert(quats.end(), {unit(rng), unit(rng), unit(rng), unit(rng)});
+            scales.insert(scales.end(), {scale(rng), scale(rng), scale(rng)});
+            opacities.push_back(u01(rng));
+            features.insert(features.end(), {u01(rng), u01(rng), u01(rng)});
+        }
+        auto const grid = build_grid(
+            {n, means.data(), quats.data(), scales.data(), opacities.data()}
+        );
+
+        const size_t n_points = 4000;
+        std::vector<float> points;
+        for (size_t p = 0; p < 3 * n_points; ++p)
+            points.push_back(pos(rng));
+        std::vector<float> densities(n_points), blended(n_points * feature_dim);
+        query_points(
+            grid,
+            n_points,
+            points.data(),
+            densities.data(),
+            features.data(),
+            feature_dim,
+            blended.data()
+        );
+
+        for (size_t p = 0; p < n_points; ++p) {
+            auto const x = glm::make_vec3(points.data() + 3 * p);
+            float density = 0.f;
+            glm::fvec3 feature(0.f);
+            for (size_t i = 0; i < n; ++i) {
+                auto const mu = glm::make_vec3(means.data() + 3 * i);
+                auto const covar = tinyrend::gaussian::quat_scale_to_covar(
+                    glm::make_vec4(quats.data() + 4 * i),
+                    glm::make_vec3(scales.data() + 3 * i)
+                );
+                auto const d = x - mu;
+                auto const mahalanobis2 = glm::dot(d, glm::inverse(covar) * d);
+                auto const w = opacities[i] * std::exp(-0.5f * mahalanobis2);
+                if (w < grid.alpha_min)
+                    continue;
+                density += w;
+                feature += w * glm::make_vec3(features.data() + 3 * i);
+            }
+            if (density > 0.f)
+                feature /= density;
+            auto const out = glm::make_vec3(blended.data() + 3 * p);
+            if (std::abs(densities[p] - density) > 1e-3f * (1.f + density) ||
+                glm::length(out - feature) > 1e-3f) {
+                printf("\n=== Testing query_points ===\n");
+                printf("\n[FAIL] Test 1: Point %zu: %f vs %f\n",
+                       p, densities[p], density);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_query_points();
+
+    if (fails > 0) {
+        printf("[raytracing/point_queries.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[raytracing/point_queries.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}
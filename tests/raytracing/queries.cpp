@@ -0,0 +1,193 @@
+#include <cmath>
+#include <glm/glm.hpp>
+#include <limits>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "tinyrend/raytracing/grid.h"
+#include "tinyrend/raytracing/queries.h"
+
+using namespace tinyrend::raytracing;
+
+struct Scene {
+    std::vector<float> means, quats, scales, opacities;
+
+    auto view() const -> GaussianPrimitives {
+        return {
+            opacities.size(),
+            means.data(),
+            quats.data(),
+            scales.data(),
+            opacities.data()
+        };
+    }
+};
+
+static auto random_scene(size_t n, uint32_t seed) -> Scene {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-2.f, 2.f), unit(-1.f, 1.f);
+    std::uniform_real_distribution<float> scale(0.02f, 0.2f), opacity(0.f, 1.f);
+    Scene scene;
+    for (size_t i = 0; i < n; ++i) {
+        scene.means.insert(scene.means.end(), {pos(rng), pos(rng), pos(rng)});
+        scene.quats.insert(
+            scene.quats.end(), {unit(rng), unit(rng), unit(rng), unit(rng)}
+        );
+        scene.scales.insert(scene.scales.end(), {scale(rng), scale(rng), scale(rng)});
+        scene.opacities.push_back(opacity(rng));
+    }
+    return scene;
+}
+
+int test_transmittance() {
+    int fails = 0;
+
+    // Test case 1: Grid traversal matches brute force over all Gaussians
+    {
+        auto const scene = random_scene(2000, 0);
+        auto const grid = build_grid(scene.view());
+        RayQueryConfig cfg;
+        cfg.min_transmittance = 0.f; // no early exit
+
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> pos(-3.f, 3.f);
+        const size_t n_rays = 256;
+        std::vector<float> rays_o, rays_d, t_max;
+        for (size_t r = 0; r < n_rays; ++r) {
+            auto const a = glm::fvec3(pos(rng), pos(rng), pos(rng));
+            auto const b = glm::fvec3(pos(rng), pos(rng), pos(rng));
+            rays_o.insert(rays_o.end(), {a.x, a.y, a.z});
+            rays_d.insert(rays_d.end(), {b.x - a.x, b.y - a.y, b.z - a.z});
+            t_max.push_back(1.f);
+        }
+        std::vector<float> T(n_rays), t_hit(n_rays);
+        trace_transmittance(
+            grid,
+            n_rays,
+            rays_o.data(),
+            rays_d.data(),
+            t_max.data(),
+            T.data(),
+            t_hit.data(),
+            cfg
+        );
+
+        for (size_t r = 0; r < n_rays; ++r) {
+            auto const o = glm::make_vec3(rays_o.data() + 3 * r);
+            auto const d = glm::make_vec3(rays_d.data() + 3 * r);
+            float T_ref = 1.f, t_ref = std::numeric_limits<float>::infinity();
+            for (uint32_t i = 0; i < scene.opacities.size(); ++i) {
+                auto const hit = detail::ray_hit(grid, i, o, d);
+                if (hit.t < 0.f || hit.t > 1.f)
+                    continue;
+                auto const alpha =
+                    std::min(cfg.max_alpha, grid.opacities[i] * std::exp(-hit.sigma));
+                if (alpha < grid.alpha_min)
+                    continue;
+                T_ref *= 1.f - alpha;
+                t_ref = std::min(t_ref, hit.t);
+            }
+            if (std::abs(T[r] - T_ref) > 1e-4f ||
+                (std::isinf(t_ref) ? !std::isinf(t_hit[r])
+                                   : std::abs(t_hit[r] - t_ref) > 1e-5f)) {
+                printf("\n=== Testing ray transmittance ===\n");
+                printf("\n[FAIL] Test 1: Ray %zu: T %f vs %f, t %f vs %f\n", r, T[r],
+                       T_ref, t_hit[r], t_ref);
+                fails += 1;
+                break;
+            }
+        }
+    }
+
+    // Test case 2: Early exit stops below the threshold
+    {
+        Scene scene;
+        for (int i = 0; i < 20; ++i) {
+            scene.means.insert(scene.means.end(), {0.f, 0.f, float(i) * 0.1f});
+            scene.quats.insert(scene.quats.end(), {1.f, 0.f, 0.f, 0.f});
+            scene.scales.insert(scene.scales.end(), {0.05f, 0.05f, 0.05f});
+            scene.opacities.push_back(0.9f);
+        }
+        auto const grid = build_grid(scene.view());
+        RayQueryConfig cfg;
+        cfg.min_transmittance = 0.05f;
+        float t_hit;
+        auto const o = glm::fvec3(0.f, 0.f, -1.f), d = glm::fvec3(0.f, 0.f, 1.f);
+        auto const T = ray_transmittance(grid, o, d, 10.f, cfg, &t_hit);
+        if (!(T < cfg.min_transmittance && T > 1e-6f) ||
+            std::abs(t_hit - 1.f) > 1e-4f) {
+            printf("\n=== Testing ray transmittance ===\n");
+            printf("\n[FAIL] Test 2: T %f, first hit %f\n", T, t_hit);
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int test_any_hit() {
+    int fails = 0;
+
+    // Test case 1: Any-hit matches brute force over all Gaussians
+    {
+        auto const scene = random_scene(2000, 2);
+        auto const grid = build_grid(scene.view());
+        RayQueryConfig cfg;
+
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> pos(-3.f, 3.f);
+        const size_t n_rays = 512;
+        std::vector<float> rays_o, rays_d, t_max;
+        for (size_t r = 0; r < n_rays; ++r) {
+            rays_o.insert(rays_o.end(), {pos(rng), pos(rng), pos(rng)});
+            rays_d.insert(rays_d.end(), {pos(rng), pos(rng), pos(rng)});
+            t_max.push_back(0.5f);
+        }
+        bool hits[n_rays] = {};
+        trace_any_hit(
+            grid, n_rays, rays_o.data(), rays_d.data(), t_max.data(), hits, cfg
+        );
+
+        size_t n_hits = 0;
+        for (size_t r = 0; r < n_rays; ++r) {
+            auto const o = glm::make_vec3(rays_o.data() + 3 * r);
+            auto const d = glm::make_vec3(rays_d.data() + 3 * r);
+            bool ref = false;
+            for (uint32_t i = 0; i < scene.opacities.size() && !ref; ++i) {
+                auto const hit = detail::ray_hit(grid, i, o, d);
+                auto const alpha =
+                    std::min(cfg.max_alpha, grid.opacities[i] * std::exp(-hit.sigma));
+                ref = hit.t >= 0.f && hit.t <= 0.5f && alpha >= cfg.hit_alpha;
+            }
+            n_hits += ref;
+            if (hits[r] != ref) {
+                printf("\n=== Testing ray any-hit ===\n");
+                printf("\n[FAIL] Test 1: Ray %zu: %d vs %d\n", r, hits[r], ref);
+                fails += 1;
+                break;
+            }
+        }
+        if (n_hits == 0 || n_hits == n_rays) {
+            printf("\n[FAIL] Test 1: Degenerate test, %zu hits\n", n_hits);
+            fails += 1;
+        }
+    }
+
+    return fails;
+}
+
+int main() {
+    int fails = 0;
+
+    fails += test_transmittance();
+    fails += test_any_hit();
+
+    if (fails > 0) {
+        printf("[raytracing/queries.cpp] %d tests failed!\n", fails);
+    } else {
+        printf("[raytracing/queries.cpp] All tests passed!\n");
+    }
+
+    return fails;
+}